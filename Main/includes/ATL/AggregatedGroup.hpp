@@ -36,8 +36,9 @@ namespace atl
     class AggregatedGroup : public std::enable_shared_from_this < AggregatedGroup >
     {
         ////////////////////////////////////////////////////////////
-        WeakVector < AggregatedNode > m_nodes ; ///< Nodes for this group.
-        mutable Mutex                 m_mutex ; ///< Mutex to access data.
+        WeakVector < AggregatedNode >    m_nodes ;  ///< Nodes for this group.
+        SharedVector < AggregatedGroup > m_slices ; ///< Slices used by the parallel SCENE-UPDATE.
+        mutable Mutex                    m_mutex ;  ///< Mutex to access data.
         
     public:
         
@@ -70,6 +71,55 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual Weak < AggregatedNode > FindNode( const Shared < AggregatedNode >& node ) const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the slice at given index, creating it if
+        /// needed.
+        ///
+        /// A slice is an AggregatedGroup owned by this group, used by
+        /// 'Node::UpdateParallel()' to let each subtree register its
+        /// AggregatedNodes without contending on this group's mutex.
+        /// Slices are persistent: a subtree updated twice with the same
+        /// slice index finds back its AggregatedNodes (see
+        /// 'AggregatedNode::IsLsnodesEqual()').
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Shared < AggregatedGroup > GetSlice( std::size_t index );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Destroys every slices after the given count.
+        ///
+        /// Called when the number of subtrees updated in parallel
+        /// decreases, so AggregatedNodes of removed subtrees are not
+        /// reported anymore.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void ResizeSlices( std::size_t count );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of slices in this group.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetSlicesCount() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Merges the nodes of this group and of its slices
+        /// (in slice order) and returns them.
+        ///
+        /// Expired nodes are skipped.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual SharedVector < AggregatedNode > GetNodes() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Launches 'AggregatedNode::Aggregation()' on every
+        /// nodes of this group and its slices.
+        ///
+        /// If a ThreadPool is instanced, each slice is aggregated as one
+        /// task. Otherwise, nodes are aggregated on the calling thread.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Aggregation() const ;
+        
     protected:
         
         ////////////////////////////////////////////////////////////
@@ -26,12 +26,18 @@ namespace atl
     /// At the end of aggregation phase, AggregatedMaterial is unlocked and
     /// no writing is possible.
     ///
+    /// Matrices ('Alias::MatrixView' to 'Alias::Matrix3MVP') are stored by
+    /// the AggregatedMaterial itself, as a Material only has components.
+    /// They are not states: each PositionNode composes them, and they are
+    /// reset to identity with the states.
+    ///
     ////////////////////////////////////////////////////////////
     class AggregatedMaterial : public Material
     {
         ////////////////////////////////////////////////////////////
-        mutable Map < Alias , bool > m_states ;
-        mutable Mutex                m_mutex ;
+        mutable Map < Alias , bool >           m_states ;   ///< True for each alias already set in this phase.
+        mutable Map < Alias , ParameterValue > m_matrices ; ///< Matrices aggregated in this phase.
+        mutable Mutex                          m_mutex ;    ///< Access to states and matrices.
         
     public:
         
@@ -68,11 +74,18 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void SetCustom( Alias alias , const ParameterValue& value );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a matrix aggregated in this phase (identity if
+        /// none), or a component of the material.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const ParameterValue GetCustom( Alias alias ) const ;
+        
         ////////////////////////////////////////////////////////////
         virtual void SetTextures( const WeakVector < Texture >& textures );
         
         ////////////////////////////////////////////////////////////
-        /// \brief Reset all states.
+        /// \brief Reset all states, and matrices to identity.
         ///
         /// \note It must be called *before* beginning of an AGGREGATION
         /// phase. Generally it is done by AggregatedNode before initiating
@@ -0,0 +1,151 @@
+//  ========================================================================  //
+//
+//  File    : ATL/BinaryScene.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef BinaryScene_hpp
+#define BinaryScene_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Hash.hpp>
+
+#include <functional>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    class Program ;
+    class Material ;
+    class Mesh ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout of a binary SceneGraph file.
+    ///
+    /// A binary scene is made of a BinarySceneHeader, followed by
+    /// three flat arrays: the nodes, the references and the strings.
+    /// Every offsets are relative to the start of the file, and every
+    /// arrays are aligned on 16 bytes so the file can be used directly
+    /// from a memory mapping. Values are stored in the native byte order
+    /// (little endian on every supported platform).
+    ///
+    /// Nodes are sorted so a node's parent always comes before it. Thus
+    /// the graph can be rebuilt in one pass over the nodes array. The
+    /// first node is the root PositionNode and has no parent.
+    ///
+    /// Resources are not stored in the scene file. A node refers to a
+    /// BinarySceneRef, which gives the content hash and the path of the
+    /// referenced resource.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BinarySceneHeader
+    {
+        char       magic[4] ;      ///< Always 'ATLS'.
+        uint32_t   version ;       ///< Version of the format, 'BinarySceneVersion'.
+        uint32_t   nodescount ;    ///< Number of BinarySceneNode.
+        uint32_t   refscount ;     ///< Number of BinarySceneRef.
+        uint64_t   nodesoffset ;   ///< Offset of the nodes array.
+        uint64_t   refsoffset ;    ///< Offset of the references array.
+        uint64_t   stringsoffset ; ///< Offset of the strings block.
+        uint64_t   stringssize ;   ///< Size of the strings block.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief One node in a binary scene.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BinarySceneNode
+    {
+        uint32_t   parent ;      ///< Index of the parent node, or 'BinarySceneNone' for the root.
+        uint32_t   subtype ;     ///< Node::Subtype of this node.
+        uint32_t   ref ;         ///< Index of the referenced resource, or 'BinarySceneNone'.
+        uint32_t   reserved ;    ///< Padding, always zero.
+        float      position[4] ; ///< Position for PositionNode (w is unused).
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reference to a resource used by one or more nodes.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BinarySceneRef
+    {
+        ContentHash hash ;       ///< Hash of the resource's content, or zero if unknown.
+        uint32_t    subtype ;    ///< Node::Subtype of the nodes using this reference.
+        uint32_t    reserved ;   ///< Padding, always zero.
+        uint64_t    pathoffset ; ///< Offset of the path in the strings block.
+        uint64_t    pathlength ; ///< Length of the path, without terminating zero.
+    };
+
+    ////////////////////////////////////////////////////////////
+    static_assert( sizeof( BinarySceneHeader ) == 48 , "BinarySceneHeader must be 48 bytes." );
+    static_assert( sizeof( BinarySceneNode ) == 32 , "BinarySceneNode must be 32 bytes." );
+    static_assert( sizeof( BinarySceneRef ) == 32 , "BinarySceneRef must be 32 bytes." );
+
+    ////////////////////////////////////////////////////////////
+    static const uint32_t BinarySceneVersion = 1 ;
+    static const uint32_t BinarySceneNone    = 0xFFFFFFFF ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Describes the resource referenced by a Node when it
+    /// is written to a binary scene.
+    ///
+    /// Filled by 'Node::WriteBinaryRecord()'. 'object' identifies the
+    /// resource so nodes sharing it also share the same BinarySceneRef.
+    /// If 'hash' is zero and 'path' is not empty, the writer hashes the
+    /// file's content.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BinarySceneReference
+    {
+        const void* object ;  ///< Referenced object, or null if the node does not reference anything.
+        ContentHash hash ;    ///< Content hash, if known.
+        String      path ;    ///< Path to the resource's file, if any.
+
+        ////////////////////////////////////////////////////////////
+        BinarySceneReference() : object( nullptr ) , hash( 0 ) { }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finds back resources referenced by a binary scene.
+    ///
+    /// Each function receives the reference and its path and must
+    /// return the corresponding resource, or null. They are called once
+    /// per reference, before nodes are created.
+    ///
+    /// When a function is empty, SceneGraph uses the MaterialManager
+    /// and MeshManager to load the path, after checking the file's content
+    /// against the reference's hash: a file modified since the scene was
+    /// saved is still loaded, but an Error::SceneFile is sent. Functions
+    /// given here can check 'BinarySceneRef::hash' themselves. Programs are
+    /// not files, thus 'program' must be given to restore ProgramNodes.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BinarySceneResolver
+    {
+        std::function < Shared < Program >( const BinarySceneRef& , const String& ) >  program ;
+        std::function < Shared < Material >( const BinarySceneRef& , const String& ) > material ;
+        std::function < Shared < Mesh >( const BinarySceneRef& , const String& ) >     mesh ;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resources resolved for one BinarySceneRef.
+    ///
+    /// Nodes only hold weak pointers to their resources: SceneGraph
+    /// keeps those of the last binary scene it loaded.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BinarySceneResolved
+    {
+        Shared < Program >  program ;  ///< Resolved program, if the reference is a program.
+        Shared < Material > material ; ///< Resolved material, if the reference is a material.
+        Shared < Mesh >     mesh ;     ///< Resolved mesh, if the reference is a mesh.
+    };
+}
+
+#endif /* BinaryScene_hpp */
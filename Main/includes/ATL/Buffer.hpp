@@ -38,12 +38,16 @@ namespace atl
         static IDGenerator < BufferId > s_generator ;
         
         ////////////////////////////////////////////////////////////
-        Atomic < BufferId > m_id ; ///< Buffer local id.
+        Atomic < BufferId >    m_id ;   ///< Buffer local id.
+        Atomic < std::size_t > m_size ; ///< Size of the buffer's storage, in bytes.
         
     public:
         
         ////////////////////////////////////////////////////////////
-        Buffer();
+        /// \brief Constructs a buffer with given storage size.
+        ///
+        ////////////////////////////////////////////////////////////
+        Buffer( std::size_t size = 0 );
         
         ////////////////////////////////////////////////////////////
         virtual ~Buffer();
@@ -59,6 +63,24 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void Unbind() = 0 ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes data to a part of the buffer's storage.
+        ///
+        /// Used by BufferArena to fill the ranges it allocates. The
+        /// buffer's binding may be changed, but not the one of the
+        /// current vertex array (if the API has this notion).
+        ///
+        /// \return False if the range is out of the buffer's storage.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Write( std::size_t offset , const void* data , std::size_t size ) = 0 ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of the buffer's storage, in bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetSize() const ;
     };
 }
 
@@ -0,0 +1,192 @@
+//  ========================================================================  //
+//
+//  File    : ATL/BufferArena.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef BufferArena_hpp
+#define BufferArena_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Buffer.hpp>
+
+#include <functional>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    class BufferArena ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A range of bytes allocated in one of the buffers of a
+    /// BufferArena.
+    ///
+    /// The range is given back to its arena when destroyed. It holds
+    /// the buffer, so the buffer lives at least as long as the range,
+    /// but not the arena: a range outliving its arena is simply not
+    /// given back.
+    ///
+    ////////////////////////////////////////////////////////////
+    class BufferRange
+    {
+        ////////////////////////////////////////////////////////////
+        Shared < Buffer >    m_buffer ; ///< Buffer the range is in.
+        std::size_t          m_offset ; ///< Offset of the range in 'm_buffer', in bytes.
+        std::size_t          m_size ;   ///< Size of the range, in bytes.
+        Weak < BufferArena > m_arena ;  ///< Arena the range was allocated from.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        BufferRange( const Shared < Buffer >& buffer , std::size_t offset , std::size_t size , const Weak < BufferArena >& arena );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Gives the range back to its arena.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~BufferRange();
+
+        ////////////////////////////////////////////////////////////
+        BufferRange( const BufferRange& ) = delete ;
+
+        ////////////////////////////////////////////////////////////
+        BufferRange& operator = ( const BufferRange& ) = delete ;
+
+        ////////////////////////////////////////////////////////////
+        virtual const Shared < Buffer >& GetBuffer() const ;
+
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetOffset() const ;
+
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetSize() const ;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Creates an empty buffer of given size for a BufferArena.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function < Shared < Buffer >( std::size_t ) > BufferArenaFactory ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Suballocates ranges in a few large buffers.
+    ///
+    /// Each buffer of the arena (a page) keeps a list of its free
+    /// ranges, sorted by offset. Allocations take the first free range
+    /// large enough, and freed ranges are merged with their free
+    /// neighbours. A new page is created only when no page has room:
+    /// thousands of small allocations share a handful of buffers.
+    ///
+    /// Allocations larger than the page size get a page of their own.
+    ///
+    /// \note Pages are never destroyed before the arena, as the driver's
+    /// Context owns its buffers anyway.
+    ///
+    ////////////////////////////////////////////////////////////
+    class BufferArena : public std::enable_shared_from_this < BufferArena >
+    {
+        ////////////////////////////////////////////////////////////
+        friend class BufferRange ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief One buffer of the arena.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Page
+        {
+            Shared < Buffer >                   buffer ; ///< The page's buffer.
+            std::size_t                         size ;   ///< Size of the buffer, in bytes.
+            std::size_t                         used ;   ///< Allocated bytes.
+            Map < std::size_t , std::size_t >   free ;   ///< Free ranges: size by offset.
+        };
+
+        ////////////////////////////////////////////////////////////
+        BufferArenaFactory m_factory ;   ///< Creates the pages.
+        std::size_t        m_pagesize ;  ///< Size of a new page, in bytes.
+        std::size_t        m_alignment ; ///< Alignment of the ranges, in bytes.
+        Vector < Page >    m_pages ;     ///< Pages, in creation order.
+        mutable Mutex      m_mutex ;     ///< Access to the pages.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        static const std::size_t DefaultPageSize = 4 * 1024 * 1024 ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Constructs an empty arena.
+        ///
+        /// \param factory   Creates the pages. Called when allocating,
+        ///                  so the driver's Context must be current.
+        /// \param pagesize  Size of the pages, in bytes.
+        /// \param alignment Alignment of the ranges' offsets, in bytes.
+        ///                  Must be a power of two.
+        ///
+        ////////////////////////////////////////////////////////////
+        BufferArena( const BufferArenaFactory& factory , std::size_t pagesize = DefaultPageSize , std::size_t alignment = 16 );
+
+        ////////////////////////////////////////////////////////////
+        virtual ~BufferArena();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Allocates a range and fills it with given data.
+        ///
+        /// \param data Data to write in the range, or null to leave it
+        ///             uninitialized.
+        /// \param size Size of the range, in bytes.
+        ///
+        /// \return The range, or null if 'size' is 0, a page can't be
+        /// created or the data can't be written.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Shared < BufferRange > Allocate( const void* data , std::size_t size );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of pages.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetPagesCount() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of allocated bytes, alignment
+        /// included.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetUsedSize() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the total size of the pages, in bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetReservedSize() const ;
+
+    protected:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Gives a range back to its page.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Release( const Buffer* buffer , std::size_t offset , std::size_t size );
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Takes 'size' bytes from the first free range large
+        /// enough in 'page'.
+        ///
+        /// \return True and the range's offset in 'offset', or false if
+        /// the page has no room.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool pTake( Page& page , std::size_t size , std::size_t& offset );
+    };
+}
+
+#endif /* BufferArena_hpp */
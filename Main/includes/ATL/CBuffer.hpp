@@ -14,78 +14,218 @@
 #define CBuffer_hpp
 
 #include <ATL/StdIncludes.hpp>
+#include <ATL/MappedFile.hpp>
+
+#include <functional>
 
 namespace atl
 {
+    ////////////////////////////////////////////////////////////
+    /// \brief Default alignment of the memory allocated by CBuffer,
+    /// suitable for any SIMD load.
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::size_t CBufferAlignment = 64 ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called to free memory adopted by a CBuffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function < void( void* ) > CBufferDeleter ;
+
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Memory shared by one or more CBuffers.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct CBufferStorage
+        {
+            void*          data ;     ///< Beginning of the memory.
+            size_t         size ;     ///< Size of the memory, in bytes.
+            CBufferDeleter deleter ;  ///< Frees 'data' when the storage is destroyed.
+            bool           readonly ; ///< True if the memory must never be written (a mapped file for example).
+
+            ////////////////////////////////////////////////////////////
+            ~CBufferStorage() { if ( deleter ) deleter( data ); }
+        };
+    }
+
     ////////////////////////////////////////////////////////////
     /// \brief Defines a buffer with a generic data type.
     ///
-    /// CBuffer size is allocated and deallocated using a simple
-    /// malloc/free process. Only data that doesn't need to be
-    /// constructed can be allocated this way.
+    /// A CBuffer is a view on a range of bytes held by a shared
+    /// storage. Copying a CBuffer, or taking a sub-range with 'View()',
+    /// never copies the bytes: both buffers share the same storage. The
+    /// storage is copied only when a shared buffer is written, so a CBuffer
+    /// can be handed from a loader to a Mesh or an Image for the price of
+    /// a reference count.
+    ///
+    /// Reading is always free: 'GetData()', 'begin()' and 'end()' never
+    /// copy. Writing must go through 'GetMutableData()', which copies the
+    /// bytes first if the storage is shared or read-only.
+    ///
+    /// Memory allocated by CBuffer is aligned on 'CBufferAlignment' bytes
+    /// unless told otherwise. Memory allocated elsewhere can be adopted
+    /// with 'Adopt()', and freed by the given deleter when the last buffer
+    /// using it is destroyed. Only data that doesn't need to be constructed
+    /// can be stored this way.
+    ///
+    /// \note 'GetMutableData()' may reallocate the storage: pointers
+    /// returned by a previous call are not valid anymore.
+    ///
+    /// \note A CBuffer object is used by one thread at a time. Different
+    /// CBuffers sharing the same storage can be used, copied and destroyed
+    /// by different threads: a storage is written only by the single buffer
+    /// that owns it, and a buffer seeing other owners copies the bytes
+    /// first.
     ///
     ////////////////////////////////////////////////////////////
     class CBuffer
     {
-        size_t iBufSize ; ///< Size of the buffer, in bytes.
-        void*  iBufData ; ///< Pointer to the buffer's data.
-        
+        Shared < Detail::CBufferStorage > iStorage ; ///< Storage of the bytes, shared with other views.
+        size_t                            iBufSize ; ///< Size of the buffer, in bytes.
+        void*                             iBufData ; ///< Pointer to the buffer's data, in 'iStorage'.
+
     public:
-        
+
         ////////////////////////////////////////////////////////////
         CBuffer();
-        
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Shares the storage of 'rhs'.
+        ///
         ////////////////////////////////////////////////////////////
         CBuffer( const CBuffer & rhs );
-        
+
         ////////////////////////////////////////////////////////////
         CBuffer( CBuffer&& rhs );
-        
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copies 'rs' bytes from 'rd' into a new storage
+        /// aligned on 'alignment' bytes.
+        ///
         ////////////////////////////////////////////////////////////
-        CBuffer( const void* rd , size_t rs );
-        
+        CBuffer( const void* rd , size_t rs , size_t alignment = CBufferAlignment );
+
         ////////////////////////////////////////////////////////////
         virtual ~CBuffer();
-        
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a buffer of 'size' uninitialized bytes,
+        /// aligned on 'alignment' bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        static CBuffer Allocate( size_t size , size_t alignment = CBufferAlignment );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a buffer using memory allocated elsewhere.
+        ///
+        /// \param data     Memory to adopt.
+        /// \param size     Size of 'data', in bytes.
+        /// \param deleter  Called with 'data' when the last buffer using
+        ///                 it is destroyed. Can be null if the memory
+        ///                 outlives every buffer.
+        /// \param readonly True if 'data' must never be written: writing
+        ///                 to the buffer will then copy it first.
+        ///
+        ////////////////////////////////////////////////////////////
+        static CBuffer Adopt( void* data , size_t size , const CBufferDeleter& deleter , bool readonly = false );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a read-only buffer mapping the given file.
+        ///
+        /// The file stays mapped while a buffer (or a view) uses it, and
+        /// its pages are read by the kernel on first access, so no byte
+        /// is copied on the heap unless the buffer is written.
+        ///
+        /// \return An empty buffer if the file can't be mapped or is
+        /// empty.
+        ///
+        ////////////////////////////////////////////////////////////
+        static CBuffer MapFile( const String& file , MappedFile::Access access = MappedFile::Access::Sequential );
+
         ////////////////////////////////////////////////////////////
         virtual void Swap( CBuffer& rhs );
-        
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Shares the storage of 'rhs'. No byte is copied.
+        ///
         ////////////////////////////////////////////////////////////
         virtual void Set( const CBuffer& rhs );
-        
+
         ////////////////////////////////////////////////////////////
         virtual void Clear();
-        
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adopts 'data', which must have been allocated with
+        /// 'malloc()'.
+        ///
         ////////////////////////////////////////////////////////////
         virtual void Assign( void* data , size_t sz );
-        
+
         ////////////////////////////////////////////////////////////
-        virtual void* GetData();
-        
+        /// \brief Returns a buffer viewing 'size' bytes from 'offset'
+        /// in this buffer, sharing its storage.
+        ///
         ////////////////////////////////////////////////////////////
-        virtual const void* GetData() const ;
-        
+        virtual CBuffer View( size_t offset , size_t size ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a copy of this buffer with its own storage,
+        /// aligned on 'alignment' bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual CBuffer Copy( size_t alignment = CBufferAlignment ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the storage is used by another
+        /// buffer.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsShared() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copies the bytes to a new storage if the current one
+        /// is shared or read-only. Called by 'GetMutableData()'.
+        ///
         ////////////////////////////////////////////////////////////
-        virtual char* begin();
-        
+        virtual void MakeUnique();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the bytes to write them, after copying them
+        /// with 'MakeUnique()' if they are shared or read-only.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void* GetMutableData();
+
+        ////////////////////////////////////////////////////////////
+        virtual const void* GetData() const ;
+
         ////////////////////////////////////////////////////////////
         virtual const char* begin() const ;
-        
+
         ////////////////////////////////////////////////////////////
         virtual const char* end() const ;
-        
+
         ////////////////////////////////////////////////////////////
         virtual size_t GetSize() const ;
-        
+
         ////////////////////////////////////////////////////////////
         virtual bool Empty() const ;
-        
+
         ////////////////////////////////////////////////////////////
         CBuffer& operator = ( const CBuffer& rhs );
-        
+
+        ////////////////////////////////////////////////////////////
+        CBuffer& operator = ( CBuffer&& rhs );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if both buffers have the same bytes.
+        ///
         ////////////////////////////////////////////////////////////
         bool operator == ( const CBuffer& rhs ) const ;
-        
+
         ////////////////////////////////////////////////////////////
         bool operator != ( const CBuffer& rhs ) const ;
     };
@@ -16,6 +16,7 @@
 #include <ATL/ParameterValue.hpp>
 #include <ATL/Alias.hpp>
 #include <ATL/Stage.hpp>
+#include <ATL/Symbol.hpp>
 
 namespace atl
 {
@@ -31,7 +32,7 @@ namespace atl
         ////////////////////////////////////////////////////////////
         ParameterValue m_value ; ///< Value for this parameter. May hold nothing if this parameter
                                  ///  is used by the program class to store informations about the parameter.
-        String         m_name ;  ///< Actual name of the parameter, may be empty.
+        Symbol         m_name ;  ///< Actual name of the parameter, may be empty.
         int32_t        m_index ; ///< Actual index of the parameter, may be -1 on invalid.
         Alias          m_alias ; ///< Actual alias for this parameter. When it is a user parameter, it is used
                                  ///  to find what is the current parameter in the program. When in a program, this
@@ -63,6 +64,13 @@ namespace atl
         ////////////////////////////////////////////////////////////
         const String& GetName() const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned name, to compare names without
+        /// comparing strings.
+        ///
+        ////////////////////////////////////////////////////////////
+        const Symbol& GetSymbol() const ;
+        
         ////////////////////////////////////////////////////////////
         int32_t GetIndex() const ;
         
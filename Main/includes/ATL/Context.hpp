@@ -15,6 +15,7 @@
 #include <ATL/StdIncludes.hpp>
 #include <ATL/Color.hpp>
 #include <ATL/Buffer.hpp>
+#include <ATL/BufferArena.hpp>
 #include <ATL/Stage.hpp>
 
 namespace atl
@@ -29,9 +30,21 @@ namespace atl
     ////////////////////////////////////////////////////////////
     /// \brief Defines a driver-created Context abstract object.
     ///
+    /// Vertex and index data of VertexCommands are suballocated in two
+    /// BufferArenas ('AllocateVertexRange()' and 'AllocateIndexRange()'),
+    /// whose pages are created with 'CreateVertexBuffer()' and
+    /// 'CreateIndexBuffer()'. Many meshes thus share a few buffers.
+    ///
     ////////////////////////////////////////////////////////////
     class Context : public std::enable_shared_from_this < Context >
     {
+        ////////////////////////////////////////////////////////////
+        Shared < BufferArena > m_varena ; ///< Arena for vertex data.
+        Shared < BufferArena > m_iarena ; ///< Arena for index data.
+        
+        ////////////////////////////////////////////////////////////
+        static Atomic < uint32_t > s_contexts ; ///< Number of living contexts.
+        
     public:
         
         ////////////////////////////////////////////////////////////
@@ -90,6 +103,44 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual Weak < Buffer > CreateIndexBuffer( const void* data , const size_t sz ) = 0 ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Allocates a range of a shared vertex buffer (the
+        /// context must be active before calling this function).
+        ///
+        /// \param data Data to initialize the range with, or null.
+        /// \param sz   Size of the data in bytes.
+        ///
+        /// \return The range, given back to the arena when destroyed,
+        /// or null if 'sz' is 0 or the allocation failed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Shared < BufferRange > AllocateVertexRange( const void* data , const size_t sz );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Allocates a range of a shared index buffer (the
+        /// context must be active before calling this function).
+        ///
+        /// \param data Data to initialize the range with, or null.
+        /// \param sz   Size of the data in bytes.
+        ///
+        /// \return The range, given back to the arena when destroyed,
+        /// or null if 'sz' is 0 or the allocation failed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Shared < BufferRange > AllocateIndexRange( const void* data , const size_t sz );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the arena used by 'AllocateVertexRange()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const Shared < BufferArena >& GetVertexArena() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the arena used by 'AllocateIndexRange()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const Shared < BufferArena >& GetIndexArena() const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Creates a Program from given loaded shader list.
         ///
@@ -129,6 +180,16 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void DrawRenderCommand( const Weak < RenderCommand >& command , const Program& program ) const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Draw a RenderCommand resolved by a RenderQueue.
+        ///
+        /// VertexCommands are resolved through their handles, so no
+        /// Shared pointer is locked nor copied while drawing. Handles
+        /// which do not resolve anymore are skipped.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void DrawRenderCommand( const RenderCommand& command , const Program& program ) const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Draw the given VertexCommand.
         ///
@@ -151,6 +212,20 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void BindViewport( const Viewport& viewport ) const = 0 ;
+        
+    protected:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Clears the default HandlePools if this context is the
+        /// last one living.
+        ///
+        /// Pools keep Shared pointers to the programs, materials and
+        /// commands drawn, which own driver's objects, and the pools live
+        /// until the program exits. Derived contexts must call it in their
+        /// destructor, while they can still destroy their objects.
+        ///
+        ////////////////////////////////////////////////////////////
+        void ClearHandlePools();
     };
 }
 
@@ -81,7 +81,8 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void AddChild( const Shared < Class >& child )
         {
-            Node::AddChild( std::static_pointer_cast < Node >( child ) );
+            // Node is a protected base: the pointer to it shares the ownership of 'child'.
+            Node::AddChild( Shared < Node >( child , &( child->Base() ) ) );
             
             if ( ShouldAddChild( child ) )
             {
@@ -92,7 +93,7 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void RemoveChild( const Shared < Class >& child )
         {
-            Node::RemoveChild( std::static_pointer_cast < Node >( child ) );
+            Node::RemoveChild( Shared < Node >( child , &( child->Base() ) ) );
             
             if ( ShouldRemoveChild( child ) )
             {
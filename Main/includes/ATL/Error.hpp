@@ -24,8 +24,10 @@ namespace atl
         ProgramCreate ,   ///< Launched when Context::CreateProgram() fails and catch an exception.
         PluginError ,     ///< Launched by any Plugin for their errors.
         InvalidWeak ,     ///< A Weak pointer is invalid but should not be.
-        ParameterBinding  ///< A parameter should not be bound to the given value type, or the parameter does
-                          ///  not exist in the program.
+        ParameterBinding , ///< A parameter should not be bound to the given value type, or the parameter does
+                           ///  not exist in the program.
+        SceneFile ,        ///< A binary scene file can't be read or written.
+        LoadingJob         ///< A job of a LoadingQueue threw an exception.
     };
 }
 
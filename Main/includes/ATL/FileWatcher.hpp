@@ -0,0 +1,178 @@
+//  ========================================================================  //
+//
+//  File    : ATL/FileWatcher.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef FileWatcher_hpp
+#define FileWatcher_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Instanced.hpp>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifies a watch registered to a FileWatcher. 0 is
+    /// never a valid identifier.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef uint32_t FileWatchId ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called by the FileWatcher with the canonical path of a
+    /// modified file. Returns false to stop watching it.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function < bool( const String& ) > FileWatchCallback ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Watches files and calls back when they are modified.
+    ///
+    /// On Linux, the directories of the watched files are watched with
+    /// inotify, so saving a file by writing it or by renaming another
+    /// file over it (as most editors do) are both seen. On other
+    /// platforms, the modification time of the files is polled.
+    ///
+    /// Modifications are collected on a background thread, and callbacks
+    /// are called on this thread once the files were left untouched for
+    /// 'GetDelay()': a file written in several steps is reported once.
+    ///
+    /// When a FileWatcher is instanced, Managers with hot reload enabled
+    /// and Programs created by RenderWindow from files use it to reload
+    /// modified resources and shaders.
+    ///
+    ////////////////////////////////////////////////////////////
+    class FileWatcher : public Instanced < FileWatcher >
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief A file watched by one callback.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Entry
+        {
+            String            file ;     ///< Canonical path of the file.
+            FileWatchCallback callback ; ///< Called when the file is modified.
+        };
+
+        ////////////////////////////////////////////////////////////
+        HashMap < FileWatchId , Entry >                m_watches ;   ///< Watches by identifier.
+        HashMap < String , Vector < FileWatchId > >    m_byfile ;    ///< Watches by canonical path.
+        HashMap < String , std::size_t >               m_dirs ;      ///< Number of watched files in each directory.
+        HashMap < String , long long >                 m_mtimes ;    ///< Last modification time of each file, when polling.
+        FileWatchId                                    m_next ;      ///< Next identifier.
+        std::chrono::milliseconds                      m_delay ;     ///< Time a file must be left untouched before it is reported.
+        mutable Mutex                                  m_mutex ;     ///< Access to the watches.
+        Mutex                                          m_dispatch ;  ///< Held while callbacks are called.
+        Atomic < bool >                                m_stop ;      ///< True when the watcher is being destroyed.
+        int                                            m_fd ;        ///< inotify descriptor, or -1.
+        HashMap < int , String >                       m_wdtodir ;   ///< Directories by inotify watch descriptor.
+        HashMap < String , int >                       m_dirtowd ;   ///< inotify watch descriptors by directory.
+        std::thread                                    m_thread ;    ///< Background thread.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Starts the background thread.
+        ///
+        /// \param delay Time a file must be left untouched before it is
+        ///              reported.
+        ///
+        ////////////////////////////////////////////////////////////
+        FileWatcher( std::chrono::milliseconds delay = std::chrono::milliseconds( 100 ) );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Stops the background thread. Callbacks are not called
+        /// anymore once the destructor returns.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~FileWatcher();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Watches given file.
+        ///
+        /// \return The watch's identifier, or 0 if the file can't be
+        /// watched.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual FileWatchId Watch( const String& file , FileWatchCallback callback );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Stops a watch.
+        ///
+        /// When called from another thread than the watcher's one, waits
+        /// for the callbacks being called: the watch's callback is never
+        /// called once this function returns.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Unwatch( FileWatchId watch );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of watches.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetCount() const ;
+
+        ////////////////////////////////////////////////////////////
+        virtual std::chrono::milliseconds GetDelay() const ;
+
+    protected:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Loop of the background thread.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Run();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls the callbacks of given modified files.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Dispatch( const Vector < String >& files );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the modified files among the watched ones,
+        /// waiting for them at most 'timeout'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Vector < String > Poll( std::chrono::milliseconds timeout );
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Starts watching a directory.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool pAddDirectory( const String& directory );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Stops watching a directory.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pRemoveDirectory( const String& directory );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Removes a watch.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pRemove( FileWatchId watch );
+    };
+}
+
+#endif /* FileWatcher_hpp */
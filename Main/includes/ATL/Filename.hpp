@@ -31,6 +31,15 @@ namespace atl
         
         String GetPath() const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the absolute path, with symbolic links and
+        /// '.' or '..' components resolved, or the path itself if the
+        /// file doesn't exist. Two paths designate the same file if their
+        /// canonical paths are equal.
+        ///
+        ////////////////////////////////////////////////////////////
+        String GetCanonicalPath() const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Changes the Filename's path.
         ///
@@ -0,0 +1,436 @@
+//  ========================================================================  //
+//
+//  File    : ATL/Handle.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef Handle_hpp
+#define Handle_hpp
+
+#include <ATL/StdIncludes.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief 32 bits generational handle to an object registered
+    /// in a HandlePool.
+    ///
+    /// The lower 'IndexBits' bits are the index of the slot in the
+    /// pool, and the upper bits are the generation of the slot when
+    /// the handle was created. A handle is valid only if the slot still
+    /// has the same generation. Value 0 is always invalid.
+    ///
+    /// Unlike a Weak pointer, copying or checking a handle does not touch
+    /// any shared control block.
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class >
+    class Handle
+    {
+        ////////////////////////////////////////////////////////////
+        uint32_t m_value ; ///< Generation and index.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        static const uint32_t IndexBits      = 20 ;
+        static const uint32_t IndexMask      = ( 1u << IndexBits ) - 1 ;
+        static const uint32_t GenerationMask = ( 1u << ( 32 - IndexBits ) ) - 1 ;
+
+        ////////////////////////////////////////////////////////////
+        Handle() : m_value( 0 ) { }
+
+        ////////////////////////////////////////////////////////////
+        Handle( uint32_t index , uint32_t generation )
+        : m_value( ( ( generation & GenerationMask ) << IndexBits ) | ( index & IndexMask ) ) { }
+
+        ////////////////////////////////////////////////////////////
+        uint32_t GetIndex() const { return m_value & IndexMask ; }
+
+        ////////////////////////////////////////////////////////////
+        uint32_t GetGeneration() const { return m_value >> IndexBits ; }
+
+        ////////////////////////////////////////////////////////////
+        uint32_t GetValue() const { return m_value ; }
+
+        ////////////////////////////////////////////////////////////
+        bool IsNull() const { return m_value == 0 ; }
+
+        ////////////////////////////////////////////////////////////
+        bool operator == ( const Handle& rhs ) const { return m_value == rhs.m_value ; }
+
+        ////////////////////////////////////////////////////////////
+        bool operator != ( const Handle& rhs ) const { return m_value != rhs.m_value ; }
+
+        ////////////////////////////////////////////////////////////
+        bool operator < ( const Handle& rhs ) const { return m_value < rhs.m_value ; }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Typed pool of objects referenced by Handle.
+    ///
+    /// Objects are registered with 'Register()', which returns a
+    /// Handle. The pool keeps a Shared pointer to every registered object,
+    /// and 'Resolve()' copies it under the pool's mutex after a generation
+    /// compare: the object stays alive while the caller uses it, whatever
+    /// other threads do with the pool. 'IsValid()' only checks the handle,
+    /// without locking anything. Registering the same
+    /// object twice returns the same handle, as objects are identified
+    /// by their local id (the one given by their IDGenerator), but each
+    /// 'Register()' must be balanced by a 'Release()': the object is
+    /// unregistered when its last registration is released.
+    ///
+    /// The pool is the last owner to release an object: 'Collect()'
+    /// destroys released objects, unregisters every object only held by
+    /// the pool, and increments the generation of their slot so existing
+    /// handles become invalid. It is generally called by the render thread
+    /// between two frames. An object resolved by another thread meanwhile
+    /// is destroyed by the last Shared pointer returned by 'Resolve()'.
+    ///
+    /// \note 'Register()' and 'Release()' can be called from any thread.
+    ///
+    /// \note Generations are only 12 bits wide: a handle kept after its
+    /// object was collected may match again once its slot was reused 4096
+    /// times. Holders must drop handles which don't resolve anymore.
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class >
+    class HandlePool
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        typedef Handle < Class > HandleType ;
+        typedef typename std::decay < decltype( std::declval < Class >().GetId() ) >::type IdType ;
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        static const uint32_t ChunkBits  = 12 ;
+        static const uint32_t ChunkSize  = 1u << ChunkBits ;
+        static const uint32_t ChunkCount = ( HandleType::IndexMask + 1 ) / ChunkSize ;
+
+        ////////////////////////////////////////////////////////////
+        struct Slot
+        {
+            Atomic < uint32_t > generation ; ///< Current generation of the slot.
+            Shared < Class >    object ;     ///< Registered object, or null.
+            IdType              id ;         ///< Id of the registered object.
+            uint32_t            refs ;       ///< Registrations not released yet.
+            bool                released ;   ///< True if released but not collected yet.
+        };
+
+        ////////////////////////////////////////////////////////////
+        Atomic < Slot* >         m_chunks[ChunkCount] ; ///< Chunks of slots. Chunks never move once allocated.
+        uint32_t                 m_size ;               ///< Number of slots ever used.
+        Vector < uint32_t >      m_free ;               ///< Free slots' indexes.
+        Map < IdType , uint32_t > m_byid ;              ///< Slot's index by object's id.
+        mutable Mutex            m_mutex ;              ///< Access to slots' allocation.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        HandlePool() : m_size( 0 )
+        {
+            for ( uint32_t i = 0 ; i < ChunkCount ; ++i )
+                m_chunks[i].store( nullptr );
+        }
+
+        ////////////////////////////////////////////////////////////
+        ~HandlePool()
+        {
+            for ( uint32_t i = 0 ; i < ChunkCount ; ++i )
+                delete[] m_chunks[i].load();
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the pool shared by the engine for this type.
+        ///
+        ////////////////////////////////////////////////////////////
+        static HandlePool& GetDefault()
+        {
+            static HandlePool pool ;
+            return pool ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Registers an object and returns its handle. If the
+        /// object is already registered, returns its current handle.
+        ///
+        /// \return A null handle if the object is null or if the pool
+        /// is full.
+        ///
+        ////////////////////////////////////////////////////////////
+        HandleType Register( const Shared < Class >& object )
+        {
+            if ( !object )
+                return HandleType();
+
+            IdType id = object->GetId();
+            MutexLocker lck( m_mutex );
+
+            auto it = m_byid.find( id );
+            if ( it != m_byid.end() )
+            {
+                Slot& slot = GetSlot( it->second );
+                slot.refs++ ;
+                return HandleType( it->second , slot.generation.load( std::memory_order_relaxed ) );
+            }
+
+            uint32_t index ;
+
+            if ( !m_free.empty() )
+            {
+                index = m_free.back();
+                m_free.pop_back();
+            }
+
+            else
+            {
+                if ( m_size > HandleType::IndexMask )
+                    return HandleType();
+
+                index = m_size++ ;
+
+                if ( !m_chunks[index >> ChunkBits].load( std::memory_order_relaxed ) )
+                {
+                    Slot* chunk = new Slot [ChunkSize] ;
+                    for ( uint32_t i = 0 ; i < ChunkSize ; ++i )
+                        chunk[i].generation.store( 1 , std::memory_order_relaxed );
+                    m_chunks[index >> ChunkBits].store( chunk , std::memory_order_release );
+                }
+            }
+
+            Slot& slot  = GetSlot( index );
+            slot.object   = object ;
+            slot.id       = id ;
+            slot.refs     = 1 ;
+            slot.released = false ;
+            m_byid[id]    = index ;
+
+            return HandleType( index , slot.generation.load( std::memory_order_relaxed ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the handle of a registered object by its id,
+        /// or a null handle.
+        ///
+        ////////////////////////////////////////////////////////////
+        HandleType Find( IdType id ) const
+        {
+            MutexLocker lck( m_mutex );
+
+            auto it = m_byid.find( id );
+            if ( it == m_byid.end() )
+                return HandleType();
+
+            const Slot& slot = GetSlot( it->second );
+            return HandleType( it->second , slot.generation.load( std::memory_order_relaxed ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the object referenced by the handle, or null
+        /// if the handle is invalid.
+        ///
+        /// The Shared pointer is copied under the pool's mutex, so the
+        /// object can't be destroyed by a concurrent 'Collect()' or
+        /// 'Clear()' while the caller uses it.
+        ///
+        ////////////////////////////////////////////////////////////
+        Shared < Class > Resolve( HandleType handle ) const
+        {
+            if ( handle.IsNull() )
+                return nullptr ;
+
+            uint32_t index = handle.GetIndex();
+            MutexLocker lck( m_mutex );
+
+            if ( index >= m_size )
+                return nullptr ;
+
+            const Slot& slot = GetSlot( index );
+
+            if ( slot.generation.load( std::memory_order_relaxed ) != handle.GetGeneration() )
+                return nullptr ;
+
+            return slot.object ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the handle references a registered
+        /// object.
+        ///
+        /// It does not lock anything: the object may be released right
+        /// after. Use 'Resolve()' to use the object.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool IsValid( HandleType handle ) const
+        {
+            uint32_t index = handle.GetIndex();
+            const Slot* chunk = m_chunks[index >> ChunkBits].load( std::memory_order_acquire );
+
+            if ( handle.IsNull() || !chunk )
+                return false ;
+
+            const Slot& slot = chunk[index & ( ChunkSize - 1 )] ;
+            return slot.generation.load( std::memory_order_acquire ) == handle.GetGeneration();
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Releases one registration of the object referenced by
+        /// the handle. The last one unregisters the object now, even if it
+        /// is still used elsewhere.
+        ///
+        /// The object itself is kept until the next 'Collect()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        void Release( HandleType handle )
+        {
+            MutexLocker lck( m_mutex );
+
+            uint32_t index = handle.GetIndex();
+            if ( handle.IsNull() || index >= m_size )
+                return ;
+
+            Slot& slot = GetSlot( index );
+            if ( slot.generation.load( std::memory_order_relaxed ) != handle.GetGeneration() || !slot.object )
+                return ;
+
+            if ( --slot.refs )
+                return ;
+
+            m_byid.erase( slot.id );
+
+            // Generation is incremented now so the handle can't be resolved anymore,
+            // but the slot is reused only after 'Collect()' destroyed the object.
+            slot.released = true ;
+            slot.generation.store( NextGeneration( slot.generation.load( std::memory_order_relaxed ) ) , std::memory_order_release );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destroys released objects and releases every object
+        /// only held by this pool.
+        ///
+        /// \return The number of slots freed.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t Collect()
+        {
+            SharedVector < Class > garbage ;
+
+            {
+                MutexLocker lck( m_mutex );
+
+                for ( uint32_t index = 0 ; index < m_size ; ++index )
+                {
+                    Slot& slot = GetSlot( index );
+
+                    if ( !slot.object )
+                        continue ;
+
+                    if ( !slot.released && slot.object.use_count() > 1 )
+                        continue ;
+
+                    FreeSlot( index , garbage );
+                }
+            }
+
+            // Objects are destroyed outside of our mutex, as their destructor may
+            // register or release other objects.
+            return garbage.size();
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Unregisters and releases every object, whoever still
+        /// uses them.
+        ///
+        /// Objects of the default pools generally own driver's objects:
+        /// the Context clears them before being destroyed, so the last
+        /// references held by the pools don't outlive it.
+        ///
+        /// \return The number of slots freed.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t Clear()
+        {
+            SharedVector < Class > garbage ;
+
+            {
+                MutexLocker lck( m_mutex );
+
+                for ( uint32_t index = 0 ; index < m_size ; ++index )
+                {
+                    if ( GetSlot( index ).object )
+                        FreeSlot( index , garbage );
+                }
+            }
+
+            return garbage.size();
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of registered objects.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t GetSize() const
+        {
+            MutexLocker lck( m_mutex );
+            return m_byid.size();
+        }
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Unregisters the object of a slot if not released yet,
+        /// moves it to 'garbage' and makes the slot free. 'm_mutex' must
+        /// be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void FreeSlot( uint32_t index , SharedVector < Class >& garbage )
+        {
+            Slot& slot = GetSlot( index );
+
+            if ( !slot.released )
+            {
+                m_byid.erase( slot.id );
+                slot.generation.store( NextGeneration( slot.generation.load( std::memory_order_relaxed ) ) , std::memory_order_release );
+            }
+
+            garbage.push_back( std::move( slot.object ) );
+            slot.object.reset();
+            slot.id       = IdType();
+            slot.refs     = 0 ;
+            slot.released = false ;
+            m_free.push_back( index );
+        }
+
+        ////////////////////////////////////////////////////////////
+        Slot& GetSlot( uint32_t index )
+        {
+            Slot* chunk = m_chunks[index >> ChunkBits].load( std::memory_order_relaxed );
+            assert( chunk && "Slot's chunk not allocated." );
+            return chunk[index & ( ChunkSize - 1 )] ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        const Slot& GetSlot( uint32_t index ) const
+        {
+            return const_cast < HandlePool* >( this ) -> GetSlot( index );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static uint32_t NextGeneration( uint32_t generation )
+        {
+            generation = ( generation + 1 ) & HandleType::GenerationMask ;
+            return generation ? generation : 1 ;
+        }
+    };
+}
+
+#endif /* Handle_hpp */
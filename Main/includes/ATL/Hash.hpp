@@ -0,0 +1,62 @@
+//  ========================================================================  //
+//
+//  File    : ATL/Hash.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef Hash_hpp
+#define Hash_hpp
+
+#include <ATL/StdIncludes.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief 64 bits hash used to identify a content.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef uint64_t ContentHash ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Hashes the given bytes with FNV-1a (64 bits).
+    ///
+    /// \param data Bytes to hash.
+    /// \param size Number of bytes.
+    /// \param seed Value to start from. Use the result of a previous
+    ///             call to hash data in several parts.
+    ///
+    /// \note This hash is stable between sessions and platforms, thus
+    /// it can be written to files. It is not a cryptographic hash.
+    ///
+    ////////////////////////////////////////////////////////////
+    inline ContentHash HashBytes( const void* data , std::size_t size , ContentHash seed = 14695981039346656037ULL )
+    {
+        const unsigned char* bytes = reinterpret_cast < const unsigned char* >( data );
+        ContentHash hash = seed ;
+        
+        for ( std::size_t i = 0 ; i < size ; ++i )
+        {
+            hash ^= static_cast < ContentHash >( bytes[i] );
+            hash *= 1099511628211ULL ;
+        }
+        
+        return hash ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Hashes the given string with 'HashBytes()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    inline ContentHash HashString( const String& str )
+    {
+        return HashBytes( str.data() , str.size() );
+    }
+}
+
+#endif /* Hash_hpp */
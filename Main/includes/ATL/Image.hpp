@@ -15,25 +15,223 @@
 #include <ATL/CBuffer.hpp>
 
 namespace atl
-{    
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Formats of the pixels of an Image.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class ImageFormat : unsigned int
+    {
+        Unknown = 0 ,
+
+        R8Unorm ,
+        R8G8Unorm ,
+        R8G8B8Unorm ,
+        R8G8B8A8Unorm ,
+        B8G8R8A8Unorm ,
+
+        R32Float ,
+        R32G32B32A32Float ,
+
+        BC1Unorm , ///< 4x4 blocks of 8 bytes: RGB, 4 colors per block.
+        BC3Unorm , ///< 4x4 blocks of 16 bytes: BC1 colors, and 8 alpha values per block.
+        BC5Unorm   ///< 4x4 blocks of 16 bytes: two channels of 8 values per block.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters used to generate the mip levels of an Image.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class ImageFilter : unsigned int
+    {
+        Box ,   ///< Average of 2x2 pixels. Fast, slightly blurry.
+        Kaiser  ///< Kaiser-windowed sinc on 6x6 pixels. Sharper, slower.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A mip level of an Image.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ImageLevel
+    {
+        uint32_t    width ;  ///< Width of the level, in pixels.
+        uint32_t    height ; ///< Height of the level, in pixels.
+        std::size_t offset ; ///< Offset of the level in the Image's buffer, in bytes.
+        std::size_t size ;   ///< Size of the level, in bytes.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decoded pixels of an image file.
+    ///
+    /// Image subclasses are the decoders: registered with a Metaclass
+    /// for their MIME type, they decode their file in their constructor
+    /// and give the pixels with 'SetPixels()'. ImageDecoder runs them
+    /// on the ThreadPool.
+    ///
+    /// Every mip level is in the same buffer, level 0 first, so a Texture
+    /// uploads the whole chain from one buffer. Levels of compressed
+    /// formats hold blocks of 4x4 pixels, uploaded as they are by the
+    /// Texture (see ImageCompressor). Pixels given with
+    /// 'SetBuffer()' have an unknown format and size, and can't have mip
+    /// levels.
+    ///
+    /// \note An Image is not protected against concurrent accesses:
+    /// changing its pixels while another thread reads them is undefined.
+    ///
+    ////////////////////////////////////////////////////////////
     class Image : public Resource
     {
         Filename iFilename ;
         CBuffer  iBuffer ;
         
+        ////////////////////////////////////////////////////////////
+        uint32_t              iWidth ;  ///< Width of level 0, in pixels.
+        uint32_t              iHeight ; ///< Height of level 0, in pixels.
+        ImageFormat           iFormat ; ///< Format of every level.
+        Vector < ImageLevel > iLevels ; ///< Mip levels in 'iBuffer', level 0 first.
+        
     public:
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Version of the data written to the ResourceCache.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const uint32_t s_cacheversion = 1 ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of a pixel, in bytes, or 0 if the
+        /// format is unknown or compressed.
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t GetPixelSizeFor( ImageFormat format );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the format is made of blocks of 4x4
+        /// pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool IsCompressedFor( ImageFormat format );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of a level, in bytes, or 0 if the
+        /// format is unknown. Compressed levels are rounded up to whole
+        /// blocks.
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t GetLevelSizeFor( ImageFormat format , uint32_t width , uint32_t height );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of mip levels of a full chain, down
+        /// to 1x1.
+        ///
+        ////////////////////////////////////////////////////////////
+        static uint32_t GetLevelsCountFor( uint32_t width , uint32_t height );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Lays out 'count' mip levels in one buffer, and returns
+        /// the size of the buffer.
+        ///
+        /// Levels are 16 bytes aligned, for SIMD filters and uploads.
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t GetLayoutFor( uint32_t width , uint32_t height , ImageFormat format ,
+                                         uint32_t count , Vector < ImageLevel >& levels );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Computes the next mip level of some pixels.
+        ///
+        /// The level is 'max( 1 , width / 2 )' by 'max( 1 , height / 2 )'.
+        /// The Box filter of 4 channels formats uses SSE2 when available.
+        /// Rows are split between the workers of the ThreadPool, if one
+        /// is instanced.
+        ///
+        /// \return False if the format is unknown or compressed.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool Downsample( const unsigned char* src , uint32_t width , uint32_t height ,
+                                ImageFormat format , ImageFilter filter , unsigned char* dst );
+        
         Image( const Filename& filename );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Copies an image, with its file and MIME type. Pixels
+        /// are shared until one of the images is modified (see CBuffer).
+        ///
+        ////////////////////////////////////////////////////////////
+        Image( const Image& image );
+        
         virtual ~Image();
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Sets raw pixels, of unknown format and size.
+        ///
+        ////////////////////////////////////////////////////////////
         virtual void SetBuffer( const CBuffer& buf );
         virtual CBuffer& GetBuffer();
         virtual const CBuffer& GetBuffer() const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Sets the decoded pixels of the first 'levels' mip
+        /// levels, laid out as 'GenerateMipmaps()' does.
+        ///
+        /// \return False if the buffer is smaller than the levels, or if
+        /// there are more levels than a full chain.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool SetPixels( const CBuffer& pixels , uint32_t width , uint32_t height , ImageFormat format , uint32_t levels = 1 );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Generates every mip level from level 0.
+        ///
+        /// \return False if the size or format is unknown, or if the
+        /// format is compressed. Does nothing if the levels are already
+        /// there.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool GenerateMipmaps( ImageFilter filter = ImageFilter::Box );
+        
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetWidth() const ;
+        
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetHeight() const ;
+        
+        ////////////////////////////////////////////////////////////
+        virtual ImageFormat GetFormat() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of mip levels, 0 if there are no
+        /// pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetLevelsCount() const ;
+        
+        ////////////////////////////////////////////////////////////
+        virtual const ImageLevel& GetLevel( uint32_t level ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        virtual const unsigned char* GetLevelData( uint32_t level ) const ;
+        
         virtual unsigned char* GetData();
         virtual const unsigned char* GetData() const ;
         
         virtual size_t GetSize() const ;
+        
+        virtual size_t GetCPUSize() const ;
+        
+    protected:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the decoded pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DWriteCache( ResourceCacheWriter& writer ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Views the decoded pixels in the cache file.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DReadCache( const ResourceCacheReader& reader );
     };
 }
 
@@ -0,0 +1,144 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ImageCompressor.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef ImageCompressor_hpp
+#define ImageCompressor_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Instanced.hpp>
+#include <ATL/Image.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief How an ImageCompressor encodes images.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ImageCompressorSettings
+    {
+        bool refine ; ///< Refines the endpoints of each block by least squares. Slower, smaller error.
+        bool alpha ;  ///< Encodes 4 channels images with a non opaque alpha in BC3, instead of BC1
+                      ///  which drops the alpha.
+
+        ////////////////////////////////////////////////////////////
+        ImageCompressorSettings() : refine( true ) , alpha( true )
+        { }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compresses images in blocks of 4x4 pixels, as GPUs sample
+    /// them directly.
+    ///
+    /// Formats are chosen from the image's format:
+    /// - RGBA and BGRA images are encoded in BC1 (8 bytes per block),
+    ///   or in BC3 (16 bytes per block) if their alpha is not opaque.
+    /// - RGB images are encoded in BC1.
+    /// - RG images, like normal maps, are encoded in BC5 (16 bytes per
+    ///   block), each channel on its own.
+    /// Other formats are not compressed. That's 4 to 8 times less memory
+    /// than RGBA pixels.
+    ///
+    /// The endpoints of each block are the extremes of its pixels along
+    /// their principal axis, refined by least squares. The palette search
+    /// uses SSE2 when available, and rows of blocks are split between
+    /// the workers of the ThreadPool, if one is instanced.
+    ///
+    /// When an ImageCompressor is instanced, ImageDecoder compresses the
+    /// images it decodes, after their mip levels are generated, and stores
+    /// them in the ResourceCache: next loads read the blocks directly.
+    /// Tools can also call 'Compress()' offline.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ImageCompressor : public Instanced < ImageCompressor >
+    {
+        ////////////////////////////////////////////////////////////
+        ImageCompressorSettings m_settings ; ///< How to encode.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        ImageCompressor( const ImageCompressorSettings& settings = ImageCompressorSettings() );
+
+        ////////////////////////////////////////////////////////////
+        virtual ~ImageCompressor();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Compresses every mip level of an image in place.
+        ///
+        /// \return False if the image can't be compressed: it is left
+        /// untouched.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Compress( Image& image ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the format an image is compressed in, or
+        /// 'ImageFormat::Unknown' if it can't be compressed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ImageFormat GetFormatFor( const Image& image ) const ;
+
+        ////////////////////////////////////////////////////////////
+        virtual const ImageCompressorSettings& GetSettings() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Compresses a level of 8 bits pixels in a compressed
+        /// format. Partial blocks on the edges repeat the last pixels.
+        ///
+        /// \return False if a format is not supported.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool CompressLevel( const unsigned char* src , uint32_t width , uint32_t height , ImageFormat srcformat ,
+                                   ImageFormat dstformat , unsigned char* dst , bool refine = true );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Encodes 4x4 RGBA pixels, row by row, in a BC1 block of
+        /// 8 bytes. The alpha is ignored.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void EncodeBC1Block( const unsigned char* rgba , unsigned char* block , bool refine = true );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Encodes 4x4 RGBA pixels in a BC3 block of 16 bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void EncodeBC3Block( const unsigned char* rgba , unsigned char* block , bool refine = true );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Encodes the red and green of 4x4 RGBA pixels in a BC5
+        /// block of 16 bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void EncodeBC5Block( const unsigned char* rgba , unsigned char* block , bool refine = true );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decodes a BC1 block in 4x4 RGBA pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void DecodeBC1Block( const unsigned char* block , unsigned char* rgba );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decodes a BC3 block in 4x4 RGBA pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void DecodeBC3Block( const unsigned char* block , unsigned char* rgba );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decodes a BC5 block in 4x4 RGBA pixels, with a blue
+        /// of 0 and an opaque alpha.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void DecodeBC5Block( const unsigned char* block , unsigned char* rgba );
+    };
+}
+
+#endif /* ImageCompressor_hpp */
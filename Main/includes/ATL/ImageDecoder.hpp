@@ -0,0 +1,141 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ImageDecoder.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef ImageDecoder_hpp
+#define ImageDecoder_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Image.hpp>
+#include <ATL/LoadingQueue.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief What an ImageDecoder does after decoding an image.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ImageDecoderSettings
+    {
+        bool        mipmaps ; ///< Generates the mip levels of decoded images.
+        ImageFilter filter ;  ///< Filter used to generate the mip levels.
+
+        ////////////////////////////////////////////////////////////
+        ImageDecoderSettings() : mipmaps( true ) , filter( ImageFilter::Box )
+        { }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called by 'ImageDecoder::DispatchCompletions()' with a
+    /// decoded image, or null if it can't be decoded or was cancelled.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function < void( const Shared < Image >& ) > ImageDecodedCallback ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decodes images on the ThreadPool.
+    ///
+    /// Each image is a job of the decoder's LoadingQueue: the file is
+    /// loaded by the Manager < Image > instance (so by the Image subclass
+    /// registered for its MIME type), then its mip levels are generated,
+    /// and it is compressed if an ImageCompressor is instanced, all on a
+    /// worker. Callbacks are dispatched by the thread calling
+    /// 'DispatchCompletions()', generally the render thread, which only
+    /// has to upload complete mip chains.
+    ///
+    /// Images already loaded by the Manager are not decoded again.
+    /// As they may be used by other threads, images are processed in a
+    /// copy sharing their pixels (see 'Image( const Image& )'): callbacks
+    /// receive the processed copy, and the Manager's image is left
+    /// untouched. Processed images are stored again in the ResourceCache,
+    /// so next runs load them ready to upload.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ImageDecoder
+    {
+        ////////////////////////////////////////////////////////////
+        ImageDecoderSettings                        m_settings ; ///< What to do after decoding.
+        HashMap < LoadingJobId , Shared < Image > > m_images ;   ///< Decoded images, until their callback.
+        Mutex                                       m_mutex ;    ///< Access to 'm_images'.
+        LoadingQueue                                m_queue ;    ///< Decoding jobs. Last, so it is destroyed first.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        ImageDecoder( const ImageDecoderSettings& settings = ImageDecoderSettings() );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Cancels the images not decoded yet.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~ImageDecoder();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Pushes an image file to decode.
+        ///
+        /// \return The job decoding the file, in 'GetQueue()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual LoadingJobId Push( const String& file , const ImageDecodedCallback& callback , Priority priority = 0 );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Pushes an image already decoded, to generate its mip
+        /// levels and compress it on the ThreadPool. The image itself is
+        /// not modified: the callback receives a processed copy.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual LoadingJobId Push( const Shared < Image >& image , const ImageDecodedCallback& callback , Priority priority = 0 );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls the callbacks of the images decoded since the
+        /// last call. See 'LoadingQueue::DispatchCompletions()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t DispatchCompletions();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Waits for every image. Callbacks are not dispatched.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Wait();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the queue of the decoding jobs, to cancel them
+        /// or make other jobs depend on them.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual LoadingQueue& GetQueue();
+
+        ////////////////////////////////////////////////////////////
+        virtual const ImageDecoderSettings& GetSettings() const ;
+
+    protected:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Generates the mip levels of a copy of an image and
+        /// compresses it if needed, stores it in the ResourceCache for
+        /// 'file', and keeps it for its callback. Runs on a worker.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void DFinish( LoadingJobId job , const Shared < Image >& image , const String& file );
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the completion callback of a job, which calls
+        /// 'callback' with the job's image.
+        ///
+        ////////////////////////////////////////////////////////////
+        LoadingCallback pMakeCallback( const ImageDecodedCallback& callback );
+    };
+}
+
+#endif /* ImageDecoder_hpp */
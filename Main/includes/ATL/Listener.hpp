@@ -14,6 +14,7 @@
 #define Listener_hpp
 
 #include <ATL/StdIncludes.hpp>
+#include <ATL/PoolAllocator.hpp>
 
 namespace atl
 {
@@ -27,7 +28,7 @@ namespace atl
         template < class Derived , class... Args >
         static Shared < Event > Create( Args&&... args )
         {
-            auto event = std::make_shared < Derived >( std::forward < Args >( args )... );
+            auto event = MakePooled < Derived >( std::forward < Args >( args )... );
             assert( event && "Can't allocate event." );
             return std::static_pointer_cast < Event >( event );
         }
@@ -20,6 +20,13 @@ namespace atl
     class RenderWindow ;
     class Driver ;
     class Surfacer ;
+    class LoadingQueue ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifies a job in a LoadingQueue. 0 is never used.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef unsigned long long LoadingJobId ;
     
     ////////////////////////////////////////////////////////////
     /// \brief A simple context that is given to the loading queue
@@ -33,6 +40,8 @@ namespace atl
         Weak < Driver >       driver ;       ///< Current Driver registered in Root.
         Weak < Surfacer >     surfacer ;     ///< Current Surfacer registered in Root.
         void*                 data ;         ///< Arbitrary structure given to the function.
+        LoadingQueue*         queue ;        ///< Queue running the function.
+        LoadingJobId          job ;          ///< Job running the function, to check 'LoadingQueue::IsCancelled()'.
     };
 }
 
@@ -17,6 +17,10 @@
 #include <ATL/Performer.hpp>
 #include <ATL/LoadingContext.hpp>
 
+#include <condition_variable>
+#include <mutex>
+#include <functional>
+
 namespace atl
 {
     ////////////////////////////////////////////////////////////
@@ -28,25 +32,126 @@ namespace atl
     ////////////////////////////////////////////////////////////
     typedef unsigned long long LoadingQueueId ;
     
+    ////////////////////////////////////////////////////////////
+    /// \brief States of a job pushed in a LoadingQueue.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum class LoadingJobState : unsigned int
+    {
+        Waiting ,   ///< Waits for its dependencies.
+        Ready ,     ///< Waits for a worker.
+        Running ,   ///< Being executed.
+        Finished ,  ///< Executed.
+        Cancelled   ///< Cancelled before its end, or one of its dependencies was.
+    };
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Function executed by a job.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function < void( LoadingContext& ) > LoadingTask ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Called when a job is finished or cancelled, with its
+    /// final state.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::function < void( LoadingJobId , LoadingJobState ) > LoadingCallback ;
+    
     ////////////////////////////////////////////////////////////
     /// \brief Defines an object to load things with a defined
     /// context.
     ///
+    /// A LoadingQueue holds jobs, executed by the workers of the
+    /// ThreadPool. Only 'GetConcurrency()' jobs of a queue run at the
+    /// same time (by default, the number of workers), so loading never
+    /// creates threads and never oversubscribes the cores. Between
+    /// ready jobs, the one with the highest priority runs first, then
+    /// the oldest one.
+    ///
+    /// A job may depend on other jobs of the same queue: it is ready
+    /// only when all of them are finished (a material waits for its
+    /// textures). When a job is cancelled, or throws an exception, every
+    /// job depending on it is cancelled too.
+    ///
+    /// Completion callbacks are not called by the workers but stored
+    /// until 'DispatchCompletions()' is called, so they can use the render
+    /// context. 'RenderWindow::Display()' dispatches the completions of
+    /// every queue once per frame ('DispatchAllCompletions()').
+    ///
+    /// When no ThreadPool is instanced, jobs are executed by the thread
+    /// pushing them, before 'Push()' returns: 'StartAsync()' is then
+    /// synchroneous.
+    ///
     ////////////////////////////////////////////////////////////
     class LoadingQueue
     {
         ////////////////////////////////////////////////////////////
         typedef void (*LoadingFunc) ( LoadingContext& );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief A job not completed yet.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Job
+        {
+            LoadingTask             task ;       ///< Function to execute.
+            LoadingCallback         callback ;   ///< Called by 'DispatchCompletions()'.
+            Priority                priority ;   ///< Priority of the job.
+            LoadingJobState         state ;      ///< Current state.
+            std::size_t             waiting ;    ///< Number of dependencies not finished.
+            Vector < LoadingJobId > dependents ; ///< Jobs depending on this job.
+            bool                    cancelled ;  ///< True if 'Cancel()' was called while running.
+        };
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief A job in the ready heap.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct ReadyJob
+        {
+            Priority     priority ; ///< Priority of the job.
+            LoadingJobId id ;       ///< Job, ids are increasing so lower is older.
+            
+            ////////////////////////////////////////////////////////////
+            bool operator < ( const ReadyJob& rhs ) const
+            {
+                return priority < rhs.priority || ( priority == rhs.priority && id > rhs.id );
+            }
+        };
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief A completed job whose callback is not dispatched yet.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Completion
+        {
+            LoadingJobId    id ;       ///< Completed job.
+            LoadingJobState state ;    ///< 'Finished' or 'Cancelled'.
+            LoadingCallback callback ; ///< Callback of the job.
+        };
+        
         ////////////////////////////////////////////////////////////
         static IDGenerator < LoadingQueueId > s_generator ;
         
         ////////////////////////////////////////////////////////////
-        Atomic < LoadingQueueId > m_id ;        ///< Local id.
-        LoadingFunc               m_func ;      ///< Function to call with the context.
-        Performer                 m_performer ; ///< Performer to perform the function.
-        mutable Mutex             m_mutex ;     ///< Mutex to access data.
-        LoadingContext            m_context ;   ///< Context created at initialization.
+        static Vector < LoadingQueue* > s_queues ;      ///< Every queue alive, for 'DispatchAllCompletions()'.
+        static std::recursive_mutex     s_queuesmutex ; ///< Access 's_queues'. Recursive, as callbacks may create or destroy queues.
+        
+        ////////////////////////////////////////////////////////////
+        Atomic < LoadingQueueId >       m_id ;          ///< Local id.
+        LoadingFunc                     m_func ;        ///< Function pushed by 'Start()' and 'StartAsync()'.
+        Performer                       m_performer ;   ///< Times the queue, from its first job to its last one.
+        mutable Mutex                   m_mutex ;       ///< Mutex to access data.
+        std::condition_variable         m_cond ;        ///< Notified when a job is completed or becomes ready.
+        LoadingContext                  m_context ;     ///< Context created at initialization.
+        LoadingJobId                    m_lastjob ;     ///< Last job identifier used.
+        HashMap < LoadingJobId , Job >  m_jobs ;        ///< Jobs not completed yet.
+        Vector < ReadyJob >             m_ready ;       ///< Heap of ready jobs.
+        Vector < Completion >           m_completions ; ///< Completions to dispatch, only for jobs with a callback.
+        std::size_t                     m_concurrency ; ///< Maximum jobs running on the ThreadPool, 0 for its workers count.
+        std::size_t                     m_runners ;     ///< Runners pushed to the ThreadPool and not returned yet.
+        bool                            m_inline ;      ///< True while a thread executes the ready jobs, when no ThreadPool is instanced.
         
     public:
         
@@ -55,7 +160,7 @@ namespace atl
         /// without any renderwindow.
         ///
         ////////////////////////////////////////////////////////////
-        LoadingQueue( LoadingFunc func , void* data = nullptr );
+        LoadingQueue( LoadingFunc func = nullptr , void* data = nullptr );
         
         ////////////////////////////////////////////////////////////
         /// \brief Creates a loading queue where the context has the
@@ -64,14 +169,107 @@ namespace atl
         ////////////////////////////////////////////////////////////
         LoadingQueue( const Weak < RenderWindow >& renderwindow , LoadingFunc func , void* data = nullptr );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Cancels the jobs not running yet and waits for the
+        /// running ones. Completions not dispatched are lost.
+        ///
         ////////////////////////////////////////////////////////////
         virtual ~LoadingQueue();
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Pushes a job in the queue.
+        ///
+        /// \param task         Function to execute. It receives a copy of
+        ///                     the queue's context, with 'job' set.
+        /// \param priority     Jobs with an higher priority run first.
+        /// \param dependencies Jobs of this queue to finish before this
+        ///                     one. Jobs already completed are ignored.
+        /// \param callback     Called by 'DispatchCompletions()' once the
+        ///                     job is finished or cancelled.
+        ///
+        /// \return The identifier of the new job.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual LoadingJobId Push( const LoadingTask& task ,
+                                   Priority priority = 0 ,
+                                   const Vector < LoadingJobId >& dependencies = Vector < LoadingJobId >() ,
+                                   const LoadingCallback& callback = LoadingCallback() );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Cancels a job and every job depending on it.
+        ///
+        /// A job not running yet is never executed. A running job can't be
+        /// interrupted: it should check 'IsCancelled()' regularly. Its
+        /// dependents are cancelled when it returns.
+        ///
+        /// \return False if the job is already completed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Cancel( LoadingJobId job );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Cancels every job not completed yet.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void CancelAll();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if 'Cancel()' was called for the given
+        /// running job.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsCancelled( LoadingJobId job ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the state of a job. A job not in the queue
+        /// anymore is considered 'Finished'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual LoadingJobState GetState( LoadingJobId job ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls the callbacks of the jobs completed since the
+        /// last call, in their completion order.
+        ///
+        /// Should be called by the render thread, generally once per
+        /// frame. Callbacks may push new jobs.
+        ///
+        /// \return The number of completions dispatched.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t DispatchCompletions();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls 'DispatchCompletions()' on every queue alive.
+        ///
+        /// Called by 'RenderWindow::Display()', once per frame, so the
+        /// callbacks run on the render thread without the application
+        /// pumping each queue.
+        ///
+        /// \return The number of completions dispatched.
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t DispatchAllCompletions();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Sets the maximum number of jobs of this queue running
+        /// at the same time on the ThreadPool. 0 uses every worker.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void SetConcurrency( std::size_t concurrency );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the maximum number of jobs of this queue
+        /// running at the same time on the ThreadPool.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetConcurrency() const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Starts the loading queue synchroneously.
         ///
-        /// The function is blocking and will return only when the loading
-        /// queue has finished its task.
+        /// Pushes the function given at construction, and waits for every
+        /// jobs of the queue.
         ///
         ////////////////////////////////////////////////////////////
         virtual void Start();
@@ -79,29 +277,77 @@ namespace atl
         ////////////////////////////////////////////////////////////
         /// \brief Starts the loading queue asynchroneously.
         ///
-        /// The function is non-blocking and 'Wait', 'IsFinished' and
-        /// 'IsActive' are not available.
+        /// Pushes the function given at construction and returns.
         ///
         ////////////////////////////////////////////////////////////
         virtual void StartAsync();
         
         ////////////////////////////////////////////////////////////
-        /// \brief Return the performer used to perform the task.
+        /// \brief Return the performer timing the queue, from the push
+        /// of a job in an empty queue to the completion of its last job.
         ///
         ////////////////////////////////////////////////////////////
         virtual const Performer& GetPerformer() const ;
         
         ////////////////////////////////////////////////////////////
-        /// \brief Wait for the loading queue to finish.
+        /// \brief Wait for every jobs of the loading queue.
+        ///
+        /// The calling thread executes ready jobs while waiting, so it
+        /// is safe to call this function from a worker of the ThreadPool.
+        /// Completion callbacks are not dispatched.
         ///
         ////////////////////////////////////////////////////////////
         virtual void Wait();
         
         ////////////////////////////////////////////////////////////
-        /// \brief See Performer::IsFinished.
+        /// \brief Returns true if the queue has no job left.
         ///
         ////////////////////////////////////////////////////////////
         virtual bool IsFinished() const ;
+        
+    protected:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Pushes runners to the ThreadPool for the ready jobs,
+        /// within the concurrency limit. 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void pSchedule();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Executes the ready jobs on the calling thread when no
+        /// ThreadPool is instanced. 'm_mutex' must not be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void pRunInline();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Executes ready jobs until there is none. Executed by
+        /// the ThreadPool.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void pRunner();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Pops the next ready job and marks it running, or
+        /// returns 0. 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual LoadingJobId pPopReady( LoadingTask& task );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Executes a job popped by 'pPopReady()' and completes it.
+        /// 'm_mutex' must not be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void pExecute( LoadingJobId id , const LoadingTask& task );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Removes a job from the queue, updates its dependents and
+        /// stores its completion. 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void pComplete( LoadingJobId id , LoadingJobState state );
     };
 }
 
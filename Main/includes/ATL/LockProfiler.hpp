@@ -0,0 +1,198 @@
+//  ========================================================================  //
+//
+//  File    : ATL/LockProfiler.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef LockProfiler_hpp
+#define LockProfiler_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief Defined (by the ATL_LOCK_PROFILING CMake option) to record
+/// wait and hold times of every Mutex and Spinlock, per call site.
+///
+/// When not defined, locks don't record anything and the report
+/// functions return no site.
+///
+////////////////////////////////////////////////////////////
+#ifdef ATL_LOCK_PROFILING
+#   define ATL_LOCK_SITE_FILE __builtin_FILE()
+#   define ATL_LOCK_SITE_LINE __builtin_LINE()
+#endif
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Times recorded for a lock's call site, as returned by
+    /// 'GetLockSitesStats()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LockSiteStats
+    {
+        std::string              file ;         ///< File where the lock is taken.
+        int                      line ;         ///< Line where the lock is taken.
+        uint64_t                 acquisitions ; ///< Number of times the lock was taken at this site.
+        std::chrono::nanoseconds wait ;         ///< Total time spent waiting for the lock.
+        std::chrono::nanoseconds maxwait ;      ///< Longest wait for the lock.
+        std::chrono::nanoseconds hold ;         ///< Total time the lock was held.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns the 'count' call sites with the longest total
+    /// wait time, longest first.
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector < LockSiteStats > GetLockSitesStats( std::size_t count );
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Writes 'GetLockSitesStats( count )' to the given stream,
+    /// one site per line.
+    ///
+    ////////////////////////////////////////////////////////////
+    void PrintLockSitesStats( std::ostream& stream , std::size_t count );
+
+#ifdef ATL_LOCK_PROFILING
+
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        struct LockSite ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the counters of given call site, created on
+        /// first use.
+        ///
+        ////////////////////////////////////////////////////////////
+        LockSite* LockSiteFind( const char* file , int line );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Records one acquisition at 'site'.
+        ///
+        ////////////////////////////////////////////////////////////
+        void LockSiteAcquired( LockSite* site , uint64_t wait );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Records the time the lock taken at 'site' was held.
+        ///
+        ////////////////////////////////////////////////////////////
+        void LockSiteReleased( LockSite* site , uint64_t hold );
+
+        ////////////////////////////////////////////////////////////
+        inline uint64_t LockProfilerNow()
+        {
+            return static_cast < uint64_t >( std::chrono::duration_cast < std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Profiling state embedded in a profiled lock. Only the
+        /// owner of the lock writes it.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct LockProfile
+        {
+            LockSite* site = nullptr ; ///< Site of the current owner.
+            uint64_t  since = 0 ;      ///< Time the lock was acquired.
+
+            ////////////////////////////////////////////////////////////
+            void Acquired( const char* file , int line , uint64_t start )
+            {
+                since = LockProfilerNow();
+                site  = LockSiteFind( file , line );
+                LockSiteAcquired( site , since - start );
+            }
+
+            ////////////////////////////////////////////////////////////
+            void Released()
+            {
+                LockSiteReleased( site , LockProfilerNow() - since );
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief A std::mutex recording its call sites.
+        ///
+        /// \note std::condition_variable needs a 'std::unique_lock <
+        /// std::mutex >': such locks are not profiled.
+        ///
+        ////////////////////////////////////////////////////////////
+        class ProfiledMutex : public std::mutex
+        {
+            LockProfile m_profile ; ///< Current owner's site.
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            void lock( const char* file = ATL_LOCK_SITE_FILE , int line = ATL_LOCK_SITE_LINE )
+            {
+                uint64_t start = LockProfilerNow();
+                std::mutex::lock();
+                m_profile.Acquired( file , line , start );
+            }
+
+            ////////////////////////////////////////////////////////////
+            bool try_lock( const char* file = ATL_LOCK_SITE_FILE , int line = ATL_LOCK_SITE_LINE )
+            {
+                uint64_t start = LockProfilerNow();
+                if ( !std::mutex::try_lock() ) return false ;
+                m_profile.Acquired( file , line , start );
+                return true ;
+            }
+
+            ////////////////////////////////////////////////////////////
+            void unlock()
+            {
+                m_profile.Released();
+                std::mutex::unlock();
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Replaces std::lock_guard to give its call site to the
+        /// profiled lock.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Lockable >
+        class ProfiledLock
+        {
+            Lockable& m_lockable ; ///< Locked object.
+
+        public:
+
+            ////////////////////////////////////////////////////////////
+            explicit ProfiledLock( Lockable& lockable , const char* file = ATL_LOCK_SITE_FILE , int line = ATL_LOCK_SITE_LINE )
+            : m_lockable( lockable )
+            {
+                m_lockable.lock( file , line );
+            }
+
+            ////////////////////////////////////////////////////////////
+            ~ProfiledLock()
+            {
+                m_lockable.unlock();
+            }
+
+            ////////////////////////////////////////////////////////////
+            ProfiledLock( const ProfiledLock& ) = delete ;
+
+            ////////////////////////////////////////////////////////////
+            ProfiledLock& operator = ( const ProfiledLock& ) = delete ;
+        };
+    }
+
+#endif
+}
+
+#endif /* LockProfiler_hpp */
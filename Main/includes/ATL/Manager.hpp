@@ -18,6 +18,12 @@
 
 #include <ATL/MimeDatabase.hpp>
 #include <ATL/Metaclasser.hpp>
+#include <ATL/ResourceCache.hpp>
+#include <ATL/ThreadPool.hpp>
+#include <ATL/FileWatcher.hpp>
+
+#include <future>
+#include <functional>
 
 namespace atl
 {
@@ -36,6 +42,37 @@ namespace atl
     /// or released from it, by using ManagerCreateEvent and
     /// ManagerReleaseEvent.
     ///
+    /// Resources are indexed by ResourceId and by the canonical path of
+    /// their file, so finding an already loaded file does not depend on
+    /// the number of resources loaded. A file being loaded is reserved
+    /// before its loader runs: threads creating the same file meanwhile
+    /// wait for it and get the same object.
+    ///
+    /// The manager accounts the memory used by its resources (see
+    /// 'Resource::GetCPUSize()' and 'Resource::GetGPUSize()'). When a
+    /// budget is set and the resources use more, the least recently used
+    /// resources which are not in use are released, emitting
+    /// ManagerReleaseEvent, until the budget is met again. A resource is
+    /// in use while it has ResourceHolders or is shared outside the
+    /// manager: Weak pointers alone don't keep it. Sizes are
+    /// taken when a resource is added: call 'UpdateSize()' or 'Trim()'
+    /// when resources grow after their creation (as a Mesh generating
+    /// its VertexCommands).
+    ///
+    /// When a ResourceCache is instanced, files are first looked up in
+    /// the cache, and resources loaded from their file are stored in it.
+    /// Resources processed after their loading are stored again with
+    /// 'UpdateCache()'.
+    ///
+    /// 'CreateBatch()' loads several files at once: the resources are
+    /// constructed in parallel on the ThreadPool, then added under a
+    /// single lock with a single ManagerCreateEvent.
+    ///
+    /// With hot reload enabled ('SetHotReload()') and a FileWatcher
+    /// instanced, the files of the resources are watched. A modified file
+    /// is loaded again on the watcher's thread, then the new resource
+    /// replaces the old one in one step (see 'Reload()').
+    ///
     /// \see Metaclass , Resource
     ///
     ////////////////////////////////////////////////////////////
@@ -43,16 +80,50 @@ namespace atl
     class Manager : public Instanced < Manager < Class > > , public Emitter
     {
         ////////////////////////////////////////////////////////////
-        SharedVector < Class > m_objs ; ///< Objects loaded by this manager.
-        mutable Mutex          m_mutex ; ///< Mutex to access data.
+        /// \brief Constructs an object from a file with the arguments
+        /// given to 'Create()', copied (see 'pMakeConstructor()').
+        ///
+        ////////////////////////////////////////////////////////////
+        typedef std::function < Shared < Class >( const String& , const MimeType& , Detail::IMetaclass* ) > Constructor ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief An object loaded by this manager.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Entry
+        {
+            Shared < Class >                       object ;  ///< The object.
+            String                                 file ;    ///< Canonical path of its file, or empty.
+            std::size_t                            cpusize ; ///< CPU size accounted for the object.
+            std::size_t                            gpusize ; ///< GPU size accounted for the object.
+            typename List < ResourceId >::iterator lru ;     ///< Position of the object in 'm_lru'.
+            SharedVector < Class >                 stubs ;   ///< Objects replaced by this one, kept alive for their holders (see 'Reload()').
+            Constructor                            construct ; ///< Constructs the object again with its arguments (see 'Reload()').
+        };
+        
+        ////////////////////////////////////////////////////////////
+        HashMap < ResourceId , Entry >   m_objs ;      ///< Objects loaded by this manager, by identifier.
+        HashMap < String , ResourceId >  m_byfile ;    ///< Last object loaded for each canonical path.
+        HashMap < String , std::shared_future < Shared < Class > > > m_pending ; ///< Files being loaded, by canonical path. Set once added to the indexes.
+        mutable List < ResourceId >      m_lru ;       ///< Objects from the most recently used to the least one.
+        std::size_t                      m_budget ;    ///< Maximum CPU and GPU size of the objects, 0 for no limit.
+        std::size_t                      m_cpusize ;   ///< Total CPU size of the objects.
+        std::size_t                      m_gpusize ;   ///< Total GPU size of the objects.
+        bool                             m_hotreload ; ///< True if files are watched to be reloaded.
+        HashMap < String , FileWatchId > m_watches ;   ///< Watches of the files, by canonical path.
+        mutable Mutex                    m_mutex ;     ///< Mutex to access data.
         
     protected:
         
         ////////////////////////////////////////////////////////////
-        Manager() { }
+        Manager() : m_budget( 0 ) , m_cpusize( 0 ) , m_gpusize( 0 ) , m_hotreload( false ) { }
         
         ////////////////////////////////////////////////////////////
-        virtual ~Manager() { }
+        virtual ~Manager()
+        {
+            // Waits for a reload being done by the watcher.
+            SetHotReload( false );
+        }
         
         ////////////////////////////////////////////////////////////
         /// \brief Find the MIME type for given file, or return an
@@ -79,6 +150,330 @@ namespace atl
             return metaclasser->GetMetaclass( mime );
         }
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the object loaded for given canonical path,
+        /// or null.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        Shared < Class > pFindFile( const String& canonical ) const
+        {
+            auto it = m_byfile.find( canonical );
+            if ( it == m_byfile.end() )
+                return nullptr ;
+            
+            auto obj = m_objs.find( it->second );
+            if ( obj == m_objs.end() )
+                return nullptr ;
+            
+            pTouch( obj->second );
+            return obj->second.object ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Reserves a file to load it, or returns the future of
+        /// the thread already loading it.
+        ///
+        /// \return True if 'promise' reserved the file: the caller loads it,
+        /// then calls 'pUnreserve()'. False if 'loading' was set.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool pReserve( const String& canonical , std::promise < Shared < Class > >& promise , std::shared_future < Shared < Class > >& loading )
+        {
+            auto it = m_pending.find( canonical );
+            
+            if ( it != m_pending.end() )
+            {
+                loading = it->second ;
+                return false ;
+            }
+            
+            m_pending[canonical] = promise.get_future().share();
+            return true ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Removes the reservation of a file. Its promise must be
+        /// set after, waking the waiting threads.
+        ///
+        /// \note 'm_mutex' must be locked, and the object loaded, if any,
+        /// already added.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pUnreserve( const String& canonical )
+        {
+            m_pending.erase( canonical );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Marks an object as the most recently used.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pTouch( const Entry& entry ) const
+        {
+            m_lru.splice( m_lru.begin() , m_lru , entry.lru );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds an object to the indexes, then releases objects
+        /// if the budget is exceeded.
+        ///
+        /// \note 'm_mutex' must be locked. Sizes should be computed before
+        /// locking it, as resources lock their own data.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pAdd( const Shared < Class >& sptr , const String& canonical , std::size_t cpusize , std::size_t gpusize , Constructor construct = Constructor() )
+        {
+            Entry entry ;
+            entry.object    = sptr ;
+            entry.file      = canonical ;
+            entry.cpusize   = cpusize ;
+            entry.gpusize   = gpusize ;
+            entry.lru       = m_lru.insert( m_lru.begin() , sptr->GetId() );
+            entry.construct = std::move( construct );
+            
+            m_objs[sptr->GetId()] = entry ;
+            m_cpusize += cpusize ;
+            m_gpusize += gpusize ;
+            
+            if ( !canonical.empty() )
+            {
+                m_byfile[canonical] = sptr->GetId();
+                pWatch( canonical );
+            }
+            
+            pEvict();
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Watches a file if hot reload is enabled and it is not
+        /// watched yet.
+        ///
+        /// Files stay watched when their object is released: a modified
+        /// file which is not loaded anymore is simply ignored.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pWatch( const String& canonical )
+        {
+            if ( !m_hotreload || m_watches.count( canonical ) )
+                return ;
+            
+            auto watcher = FileWatcher::Get();
+            if ( !watcher )
+                return ;
+            
+            FileWatchId watch = watcher->Watch( canonical , [this]( const String& file )
+            {
+                Reload( file );
+                return true ;
+            });
+            
+            if ( watch )
+                m_watches[canonical] = watch ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Removes an object from the indexes and sends
+        /// ManagerReleaseEvent.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pRemove( typename HashMap < ResourceId , Entry >::iterator it )
+        {
+            // The file may have been reloaded since: its index then
+            // designates the newer object, which stays.
+            auto file = m_byfile.find( it->second.file );
+            
+            if ( file != m_byfile.end() && file->second == it->first )
+                m_byfile.erase( file );
+            
+            m_cpusize -= it->second.cpusize ;
+            m_gpusize -= it->second.gpusize ;
+            m_lru.erase( it->second.lru );
+            
+            ResourceId id = it->first ;
+            m_objs.erase( it );
+            
+            SendEvent < ManagerReleaseEvent >( id );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Releases the least recently used objects not in use
+        /// until the objects fit in the budget.
+        ///
+        /// An object is in use if it, or one of the stubs it replaced,
+        /// has ResourceHolders (holders of a stub move to the object when
+        /// they use it), or if it is shared outside the manager.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pEvict()
+        {
+            if ( !m_budget )
+                return ;
+            
+            auto lru = m_lru.end();
+            
+            while ( m_cpusize + m_gpusize > m_budget && lru != m_lru.begin() )
+            {
+                --lru ;
+                auto it = m_objs.find( *lru );
+                
+                // The object replaced last holds the object as its replacement.
+                long owners = it->second.stubs.empty() ? 1 : 2 ;
+                
+                if ( it->second.object.use_count() > owners || pIsHeld( it->second ) )
+                    continue ;
+                
+                // Erasing 'lru' invalidates it: the iterator after it stays valid.
+                ++lru ;
+                pRemove( it );
+            }
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if an object or one of its stubs has
+        /// ResourceHolders.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool pIsHeld( const Entry& entry ) const
+        {
+            if ( entry.object->GetHolders() )
+                return true ;
+            
+            for ( auto const& stub : entry.stubs )
+            {
+                if ( stub->GetHolders() )
+                    return true ;
+            }
+            
+            return false ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the key of a file in the ResourceCache, or 0
+        /// if it must not be cached.
+        ///
+        /// Extra arguments given to 'Create()' may change what the loader
+        /// does: objects created with arguments are never cached. Classes
+        /// not declaring 's_cacheversion' are never cached either, so their
+        /// files are not hashed.
+        ///
+        ////////////////////////////////////////////////////////////
+        ContentHash pCacheKey( const String& file , const MimeType& mime , Detail::IMetaclass* metaclass , std::size_t arguments )
+        {
+            auto cache = ResourceCache::Get();
+            if ( !cache || arguments || !metaclass->IsCached() )
+                return 0 ;
+            
+            return cache->GetKey( file , mime.GetCompleteSymbol().GetString() , metaclass->GetCacheVersion() );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Creates an object from the ResourceCache, or returns
+        /// null if it is not cached.
+        ///
+        ////////////////////////////////////////////////////////////
+        Shared < Class > pLoadCache( ContentHash key , const String& file , const MimeType& mime , Detail::IMetaclass* metaclass )
+        {
+            auto cache = ResourceCache::Get();
+            if ( !cache || !key )
+                return nullptr ;
+            
+            // The object must be of the class the loader creates.
+            auto sptr = std::static_pointer_cast < Class >( metaclass->Create() );
+            
+            if ( !sptr || !cache->Load( key , *sptr , file , mime ) )
+                return nullptr ;
+            
+            return sptr ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Stores an object freshly loaded to the ResourceCache.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pStoreCache( ContentHash key , const Class& object )
+        {
+            auto cache = ResourceCache::Get();
+            
+            if ( cache && key )
+                cache->Store( key , object );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Constructs an object from a file, through the
+        /// ResourceCache when possible.
+        ///
+        /// \note 'm_mutex' must not be locked: construction may be long.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename... Args >
+        Shared < Class > pConstruct( const String& file , const MimeType& mime , Detail::IMetaclass* metaclass , Args&&... args )
+        {
+            ContentHash key  = pCacheKey( file , mime , metaclass , sizeof...( Args ) );
+            auto        sptr = pLoadCache( key , file , mime , metaclass );
+            
+            if ( !sptr )
+            {
+                sptr = std::static_pointer_cast < Class >( metaclass->Create( file , std::forward < Args >( args )... ) );
+                
+                if ( sptr )
+                    pStoreCache( key , *sptr );
+            }
+            
+            return sptr ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a Constructor calling 'pConstruct()' with
+        /// copies of given arguments, so 'Reload()' gives the new object
+        /// the arguments the old one was created with.
+        ///
+        /// \note Arguments must be copy constructible.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename... Args >
+        Constructor pMakeConstructor( const Args&... args )
+        {
+            return [this , args...]( const String& file , const MimeType& mime , Detail::IMetaclass* metaclass )
+            {
+                return pConstruct( file , mime , metaclass , args... );
+            };
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Accounts again the size of an object.
+        ///
+        /// \note 'm_mutex' must not be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pUpdateSize( const Shared < Class >& sptr )
+        {
+            std::size_t cpusize = sptr->GetCPUSize();
+            std::size_t gpusize = sptr->GetGPUSize();
+            
+            MutexLocker lck( m_mutex );
+            auto it = m_objs.find( sptr->GetId() );
+            
+            if ( it == m_objs.end() || it->second.object != sptr )
+                return ;
+            
+            m_cpusize = m_cpusize - it->second.cpusize + cpusize ;
+            m_gpusize = m_gpusize - it->second.gpusize + gpusize ;
+            it->second.cpusize = cpusize ;
+            it->second.gpusize = gpusize ;
+        }
+        
     public:
         
         ////////////////////////////////////////////////////////////
@@ -88,8 +483,11 @@ namespace atl
             
             if ( sptr )
             {
+                std::size_t cpusize = sptr->GetCPUSize();
+                std::size_t gpusize = sptr->GetGPUSize();
+                
                 MutexLocker lck( m_mutex );
-                m_objs.push_back( sptr );
+                pAdd( sptr , String() , cpusize , gpusize );
                 
                 SendEvent < ManagerCreateEvent >( sptr->GetId() );
             }
@@ -97,55 +495,567 @@ namespace atl
             return sptr ;
         }
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Creates an object from a file, or returns the object
+        /// already loaded from it (unless 'reload' is true).
+        ///
+        /// A thread creating a file being loaded by another one waits for
+        /// it and returns the same object, even with 'reload'.
+        ///
         ////////////////////////////////////////////////////////////
         template < typename... Args >
         Weak < Class > Create( bool reload , const String& file , Args&&... args )
         {
-            if ( !reload )
+            String canonical = Filename( file ).GetCanonicalPath();
+            std::promise < Shared < Class > > promise ;
+            std::shared_future < Shared < Class > > loading ;
+            
             {
                 MutexLocker lck( m_mutex );
-                auto it = std::find_if( m_objs.begin() , m_objs.end() , [file]( const Shared < Class >& obj ) -> bool {
-                    return obj ? obj->GetFile() == file : false ;
-                });
                 
-                if ( it != m_objs.end() )
-                    return (*it);
+                if ( !reload )
+                {
+                    auto found = pFindFile( canonical );
+                    
+                    if ( found )
+                        return found ;
+                }
+                
+                pReserve( canonical , promise , loading );
             }
             
-            auto mimetype = pFindFileMime( file );
-            if ( mimetype.IsEmpty() )
+            if ( loading.valid() )
+                return loading.get();
+            
+            Shared < Class > sptr ;
+            Constructor      construct ;
+            
+            try
+            {
+                auto mimetype  = pFindFileMime( file );
+                auto metaclass = mimetype.IsEmpty() ? nullptr : pFindMetaclass( mimetype );
+                
+                if ( metaclass )
+                {
+                    // Copied before the construction, which may move them.
+                    construct = pMakeConstructor( args... );
+                    sptr      = pConstruct( file , mimetype , metaclass , std::forward < Args >( args )... );
+                }
+            }
+            
+            catch ( ... )
+            {
+                {
+                    MutexLocker lck( m_mutex );
+                    pUnreserve( canonical );
+                }
+                
+                promise.set_exception( std::current_exception() );
+                throw ;
+            }
+            
+            std::size_t cpusize = sptr ? sptr->GetCPUSize() : 0 ;
+            std::size_t gpusize = sptr ? sptr->GetGPUSize() : 0 ;
+            
+            {
+                MutexLocker lck( m_mutex );
+                
+                if ( sptr )
+                {
+                    pAdd( sptr , canonical , cpusize , gpusize , std::move( construct ) );
+                    
+                    SendEvent < ManagerCreateEvent >( sptr->GetId() ,
+                                                      sptr->GetFile() );
+                }
+                
+                pUnreserve( canonical );
+            }
+            
+            promise.set_value( sptr );
+            return sptr ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Creates an object for each given file.
+        ///
+        /// MIME types and metaclasses are resolved for the whole batch
+        /// first, then the objects are constructed in parallel on the
+        /// ThreadPool (sequentially if none is instanced). They are added
+        /// under a single lock, and one ManagerCreateEvent lists them all.
+        /// A file given twice is loaded once, and a file being loaded by
+        /// another thread is waited for instead of being loaded again.
+        ///
+        /// \param files  Files to load.
+        /// \param reload True to load again files already loaded.
+        ///
+        /// \return The objects, in the order of 'files'. An object is null
+        /// if its file can't be loaded.
+        ///
+        ////////////////////////////////////////////////////////////
+        Vector < Weak < Class > > CreateBatch( const StringVector& files , bool reload = false )
+        {
+            struct Item
+            {
+                String               canonical ; ///< Canonical path of the file.
+                std::size_t          first ;     ///< Index of the first item with the same file.
+                MimeType             mime ;      ///< MIME type of the file.
+                Detail::IMetaclass*  metaclass ; ///< Metaclass of the MIME type.
+                Shared < Class >     object ;    ///< Object found or created.
+                bool                 created ;   ///< True if 'object' was created by this batch.
+                std::size_t          cpusize ;   ///< CPU size of 'object'.
+                std::size_t          gpusize ;   ///< GPU size of 'object'.
+                bool                 owner ;     ///< True if this batch reserved the file.
+                std::promise < Shared < Class > >       promise ; ///< Reservation of the file, if 'owner'.
+                std::shared_future < Shared < Class > > loading ; ///< Load of another thread to wait for.
+                std::exception_ptr   error ;     ///< Exception thrown by the construction.
+            };
+            
+            Vector < Item > items( files.size() );
+            HashMap < String , std::size_t > byfile ;
+            
+            for ( std::size_t i = 0 ; i < files.size() ; ++i )
+            {
+                items[i].canonical = Filename( files[i] ).GetCanonicalPath();
+                items[i].first     = byfile.insert( std::make_pair( items[i].canonical , i ) ).first->second ;
+                items[i].metaclass = nullptr ;
+                items[i].created   = false ;
+                items[i].cpusize   = 0 ;
+                items[i].gpusize   = 0 ;
+                items[i].owner     = false ;
+            }
+            
+            {
+                MutexLocker lck( m_mutex );
+                
+                for ( std::size_t i = 0 ; i < items.size() ; ++i )
+                {
+                    Item& item = items[i];
+                    
+                    if ( item.first != i )
+                        continue ;
+                    
+                    if ( !reload )
+                        item.object = pFindFile( item.canonical );
+                    
+                    if ( !item.object )
+                        item.owner = pReserve( item.canonical , item.promise , item.loading );
+                }
+            }
+            
+            // MIME types are resolved in one pass, and metaclasses looked
+            // up once per MIME type.
+            Map < MimeType , Detail::IMetaclass* > metaclasses ;
+            
+            for ( std::size_t i = 0 ; i < items.size() ; ++i )
+            {
+                Item& item = items[i];
+                
+                if ( !item.owner )
+                    continue ;
+                
+                item.mime = pFindFileMime( files[i] );
+                if ( item.mime.IsEmpty() )
+                    continue ;
+                
+                auto it = metaclasses.find( item.mime );
+                if ( it == metaclasses.end() )
+                    it = metaclasses.insert( std::make_pair( item.mime , pFindMetaclass( item.mime ) ) ).first ;
+                
+                item.metaclass = it->second ;
+            }
+            
+            auto construct = [&]( std::size_t i )
+            {
+                Item& item = items[i];
+                
+                if ( !item.metaclass )
+                    return ;
+                
+                try
+                {
+                    item.object = pConstruct( files[i] , item.mime , item.metaclass );
+                }
+                
+                catch ( ... )
+                {
+                    item.error = std::current_exception();
+                    return ;
+                }
+                
+                if ( item.object )
+                {
+                    item.created = true ;
+                    item.cpusize = item.object->GetCPUSize();
+                    item.gpusize = item.object->GetGPUSize();
+                }
+            };
+            
+            auto pool = ThreadPool::Get();
+            
+            if ( pool && items.size() > 1 )
+            {
+                pool->ParallelFor( items.size() , construct );
+            }
+            
+            else
+            {
+                for ( std::size_t i = 0 ; i < items.size() ; ++i )
+                    construct( i );
+            }
+            
+            Vector < ResourceId > ids ;
+            StringVector          created ;
+            
+            {
+                MutexLocker lck( m_mutex );
+                
+                for ( auto& item : items )
+                {
+                    // 'items' holds every object until the end: none of them
+                    // can be evicted by the following ones.
+                    if ( item.created )
+                    {
+                        pAdd( item.object , item.canonical , item.cpusize , item.gpusize , pMakeConstructor() );
+                        ids.push_back( item.object->GetId() );
+                        created.push_back( item.object->GetFile() );
+                    }
+                    
+                    if ( item.owner )
+                        pUnreserve( item.canonical );
+                }
+                
+                if ( !ids.empty() )
+                    SendEvent < ManagerCreateEvent >( std::move( ids ) , std::move( created ) );
+            }
+            
+            // Threads waiting for our files are woken up before we wait for
+            // theirs, so two batches can't wait for each other.
+            std::exception_ptr error ;
+            
+            for ( auto& item : items )
+            {
+                if ( !item.owner )
+                    continue ;
+                
+                if ( item.error )
+                {
+                    item.promise.set_exception( item.error );
+                    
+                    if ( !error )
+                        error = item.error ;
+                }
+                
+                else
+                {
+                    item.promise.set_value( item.object );
+                }
+            }
+            
+            if ( error )
+                std::rethrow_exception( error );
+            
+            Vector < Weak < Class > > result ;
+            result.reserve( items.size() );
+            
+            for ( auto& item : items )
+            {
+                if ( item.loading.valid() )
+                    item.object = item.loading.get();
+                
+                result.push_back( items[item.first].object );
+            }
+            
+            return result ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Loads again the object of given file, and replaces
+        /// it by the new one.
+        ///
+        /// The new object is constructed without lock, with copies of the
+        /// arguments given to 'Create()' for the old one. Then, under the
+        /// lock, it takes the place of the old one in the indexes, and the
+        /// old one is released from this manager and given the new one as
+        /// replacement (see 'Resource::SetReplacement()'). A
+        /// ManagerReloadEvent is sent.
+        ///
+        /// Holders generally keep a Weak pointer: the old object stays alive
+        /// as a forwarding stub, kept with the new object, so they switch to
+        /// the new one with 'GetLatest()' whenever they use it. Stubs are
+        /// released with the object replacing them.
+        ///
+        /// \return The new object, or null if the file is not loaded by
+        /// this manager or can't be loaded again. The old object stays in
+        /// place in the latter case.
+        ///
+        ////////////////////////////////////////////////////////////
+        Weak < Class > Reload( const String& file )
+        {
+            String canonical = Filename( file ).GetCanonicalPath();
+            Shared < Class > old ;
+            Constructor      construct ;
+            
+            {
+                MutexLocker lck( m_mutex );
+                old = pFindFile( canonical );
+                
+                if ( old )
+                    construct = m_objs[old->GetId()].construct ;
+            }
+            
+            if ( !old )
                 return Weak < Class >();
             
+            auto mimetype = old->GetMimeType();
             auto metaclass = pFindMetaclass( mimetype );
             if ( !metaclass )
                 return Weak < Class >();
             
-            auto sptr = std::static_pointer_cast < Class >( metaclass->Create( reload , file , std::forward < Args >( args )... ) );
+            if ( !construct )
+                construct = pMakeConstructor();
+            
+            auto sptr = construct( canonical , mimetype , metaclass );
+            if ( !sptr )
+                return Weak < Class >();
+            
+            std::size_t cpusize = sptr->GetCPUSize();
+            std::size_t gpusize = sptr->GetGPUSize();
+            
+            MutexLocker lck( m_mutex );
+            pAdd( sptr , canonical , cpusize , gpusize , std::move( construct ) );
+            
+            // The old object is now not indexed by its file anymore, but the new
+            // one keeps it (and the objects it replaced) for their holders.
+            auto& stubs = m_objs[sptr->GetId()].stubs ;
+            auto it = m_objs.find( old->GetId() );
+            
+            if ( it != m_objs.end() )
+            {
+                stubs.swap( it->second.stubs );
+                pRemove( it );
+            }
+            
+            stubs.push_back( old );
+            old->SetReplacement( sptr );
+            
+            SendEvent < ManagerReloadEvent >( old->GetId() ,
+                                              sptr->GetId() ,
+                                              canonical );
+            
+            return sptr ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Enables or disables hot reload.
+        ///
+        /// When enabled and a FileWatcher is instanced, the files of the
+        /// objects loaded by this manager are watched, and 'Reload()' is
+        /// called on the watcher's thread when one of them is modified.
+        ///
+        ////////////////////////////////////////////////////////////
+        void SetHotReload( bool enabled )
+        {
+            Vector < FileWatchId > watches ;
             
-            if ( sptr )
             {
                 MutexLocker lck( m_mutex );
-                m_objs.push_back( sptr );
+                m_hotreload = enabled ;
+                
+                if ( enabled )
+                {
+                    for ( auto const& it : m_byfile )
+                        pWatch( it.first );
+                }
                 
-                SendEvent < ManagerCreateEvent >( sptr->GetId() ,
-                                                  sptr->GetFile() );
+                else
+                {
+                    for ( auto const& it : m_watches )
+                        watches.push_back( it.second );
+                    
+                    m_watches.clear();
+                }
             }
             
-            return sptr ;
+            // Unwatching waits for the watcher's callbacks, which lock our
+            // mutex: it must be done without it.
+            auto watcher = FileWatcher::Get();
+            
+            if ( watcher )
+            {
+                for ( FileWatchId watch : watches )
+                    watcher->Unwatch( watch );
+            }
+        }
+        
+        ////////////////////////////////////////////////////////////
+        bool IsHotReload() const
+        {
+            MutexLocker lck( m_mutex );
+            return m_hotreload ;
         }
         
         ////////////////////////////////////////////////////////////
         void Release( const Weak < Class >& object )
         {
+            auto sptr = object.lock();
+            if ( !sptr )
+                return ;
+            
             MutexLocker lck( m_mutex );
+            auto it = m_objs.find( sptr->GetId() );
+            
+            if ( it != m_objs.end() && it->second.object == sptr )
+                pRemove( it );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the object with given identifier, or null if
+        /// this manager doesn't have it.
+        ///
+        ////////////////////////////////////////////////////////////
+        Weak < Class > Find( ResourceId id ) const
+        {
+            MutexLocker lck( m_mutex );
+            auto it = m_objs.find( id );
+            
+            if ( it == m_objs.end() )
+                return Weak < Class >();
+            
+            pTouch( it->second );
+            return it->second.object ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the last object loaded from given file, or
+        /// null if this manager doesn't have one.
+        ///
+        ////////////////////////////////////////////////////////////
+        Weak < Class > FindFile( const String& file ) const
+        {
+            String canonical = Filename( file ).GetCanonicalPath();
+            MutexLocker lck( m_mutex );
+            return pFindFile( canonical );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Sets the maximum CPU and GPU size of the objects of
+        /// this manager, in bytes, and releases objects to meet it.
+        /// 0 (the default) disables the budget.
+        ///
+        /// \note Objects in use are never released: those with
+        /// ResourceHolders (as held by MeshNode and MaterialNode) or shared
+        /// outside the manager. The budget may then be exceeded. Objects
+        /// only referenced by Weak pointers are not in use.
+        ///
+        ////////////////////////////////////////////////////////////
+        void SetBudget( std::size_t budget )
+        {
+            MutexLocker lck( m_mutex );
+            m_budget = budget ;
+            pEvict();
+        }
+        
+        ////////////////////////////////////////////////////////////
+        std::size_t GetBudget() const
+        {
+            MutexLocker lck( m_mutex );
+            return m_budget ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the total CPU size of the objects, in bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t GetCPUSize() const
+        {
+            MutexLocker lck( m_mutex );
+            return m_cpusize ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the total GPU size of the objects, in bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t GetGPUSize() const
+        {
+            MutexLocker lck( m_mutex );
+            return m_gpusize ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Accounts again the size of an object, then releases
+        /// objects if the budget is exceeded.
+        ///
+        ////////////////////////////////////////////////////////////
+        void UpdateSize( const Weak < Class >& object )
+        {
             auto sptr = object.lock();
-            auto it   = std::find( m_objs.begin() , m_objs.end() , sptr );
+            if ( !sptr )
+                return ;
+            
+            pUpdateSize( sptr );
+            sptr.reset();
+            
+            MutexLocker lck( m_mutex );
+            pEvict();
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Stores an object loaded from a file to the ResourceCache
+        /// again, then accounts again its size.
+        ///
+        /// Used when an object is processed after being loaded (mip levels,
+        /// compression...): next loads of the file read the processed data
+        /// from the cache instead of processing it again.
+        ///
+        /// \return False if the object can't be cached.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool UpdateCache( const Weak < Class >& object , const String& file )
+        {
+            auto sptr = object.lock();
+            if ( !sptr || file.empty() )
+                return false ;
+        
+            auto mimetype = pFindFileMime( file );
+            if ( mimetype.IsEmpty() )
+                return false ;
+        
+            auto metaclass = pFindMetaclass( mimetype );
+            if ( !metaclass )
+                return false ;
+        
+            ContentHash key = pCacheKey( file , mimetype , metaclass , 0 );
+            bool stored = key && ResourceCache::Get()->Store( key , *sptr );
+        
+            UpdateSize( sptr );
+            return stored ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Accounts again the size of every object, then releases
+        /// objects if the budget is exceeded.
+        ///
+        ////////////////////////////////////////////////////////////
+        void Trim()
+        {
+            SharedVector < Class > objects ;
             
-            if ( it != m_objs.end() )
             {
-                SendEvent < ManagerReleaseEvent >( sptr->GetId() );
-                m_objs.erase( it );
+                MutexLocker lck( m_mutex );
+                objects.reserve( m_objs.size() );
+                
+                for ( auto const& it : m_objs )
+                    objects.push_back( it.second.object );
             }
+            
+            for ( auto const& object : objects )
+                pUpdateSize( object );
+            
+            objects.clear();
+            
+            MutexLocker lck( m_mutex );
+            pEvict();
         }
     };
 }
@@ -17,13 +17,19 @@
 
 namespace atl
 {
+    ////////////////////////////////////////////////////////////
+    /// \brief Sent when a Manager adds resources.
+    ///
+    /// 'Manager::CreateBatch()' sends one event for the whole batch:
+    /// listeners should iterate over 'GetCount()' resources rather
+    /// than only reading 'GetId()'.
+    ///
     ////////////////////////////////////////////////////////////
     class ManagerCreateEvent : public Event
     {
         ////////////////////////////////////////////////////////////
-        Atomic < ResourceId > m_id ;       ///< Resource's created ID.
-        String                m_file ;     ///< Resource's created file, if created from a file.
-        mutable Spinlock      m_spinlock ; ///< Access to file.
+        const Vector < ResourceId > m_ids ;   ///< Created resources' IDs.
+        const StringVector          m_files ; ///< Created resources' files, empty for those not created from a file.
         
     public:
         
@@ -31,10 +37,35 @@ namespace atl
         ManagerCreateEvent( const ResourceId& id , const String& m_file = String() );
         
         ////////////////////////////////////////////////////////////
-        ResourceId GetId() const ;
+        /// \brief Constructs the event for a batch of resources. Both
+        /// vectors must have the same size.
+        ///
+        ////////////////////////////////////////////////////////////
+        ManagerCreateEvent( Vector < ResourceId > ids , StringVector files );
         
         ////////////////////////////////////////////////////////////
-        const String GetFile() const ;
+        /// \brief Returns the number of resources created.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t GetCount() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the ID of the 'index'-th resource created.
+        ///
+        ////////////////////////////////////////////////////////////
+        ResourceId GetId( std::size_t index = 0 ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the file of the 'index'-th resource created.
+        ///
+        ////////////////////////////////////////////////////////////
+        const String GetFile( std::size_t index = 0 ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        const Vector < ResourceId >& GetIds() const ;
+        
+        ////////////////////////////////////////////////////////////
+        const StringVector& GetFiles() const ;
     };
     
     ////////////////////////////////////////////////////////////
@@ -51,6 +82,37 @@ namespace atl
         ////////////////////////////////////////////////////////////
         ResourceId GetId() const ;
     };
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Sent when a Manager replaces a resource by a new one
+    /// loaded from the same modified file.
+    ///
+    /// The old resource is released from the manager (and a
+    /// ManagerReleaseEvent is sent for it) but is kept alive with the new
+    /// one, so its holders can switch with 'GetLatest()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ManagerReloadEvent : public Event
+    {
+        ////////////////////////////////////////////////////////////
+        const ResourceId m_oldid ; ///< Replaced resource's ID.
+        const ResourceId m_newid ; ///< New resource's ID.
+        const String     m_file ;  ///< File reloaded.
+        
+    public:
+        
+        ////////////////////////////////////////////////////////////
+        ManagerReloadEvent( const ResourceId& oldid , const ResourceId& newid , const String& file );
+        
+        ////////////////////////////////////////////////////////////
+        ResourceId GetOldId() const ;
+        
+        ////////////////////////////////////////////////////////////
+        ResourceId GetNewId() const ;
+        
+        ////////////////////////////////////////////////////////////
+        const String GetFile() const ;
+    };
 }
 
 #endif /* ManagerEvent_hpp */
@@ -0,0 +1,106 @@
+//  ========================================================================  //
+//
+//  File    : ATL/MappedFile.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef MappedFile_hpp
+#define MappedFile_hpp
+
+#include <ATL/StdIncludes.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Maps a file read-only into memory.
+    ///
+    /// On POSIX platforms (Linux, Darwin), the file is mapped with
+    /// 'mmap' and pages are loaded by the kernel on first access. On
+    /// other platforms, the file is entirely read into a private buffer
+    /// so the interface stays the same.
+    ///
+    /// The mapping is released when the MappedFile is destroyed. Pointers
+    /// returned by 'GetData()' must not be used after this.
+    ///
+    ////////////////////////////////////////////////////////////
+    class MappedFile
+    {
+    public:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Hints about how the mapping will be accessed.
+        ///
+        ////////////////////////////////////////////////////////////
+        enum class Access
+        {
+            Normal     , ///< No particular hint.
+            Sequential , ///< Data is read once from start to end.
+            Random     , ///< Data is accessed randomly.
+            WillNeed     ///< Every pages will be needed soon, so the kernel may read them ahead.
+        };
+        
+    private:
+        
+        ////////////////////////////////////////////////////////////
+        String           m_file ;   ///< Path of the mapped file.
+        const char*      m_data ;   ///< Start of the mapped data, or null.
+        std::size_t      m_size ;   ///< Size of the mapped data in bytes.
+        Vector < char >  m_buffer ; ///< Fallback buffer when mapping is not available.
+        
+    public:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Maps the given file. 'IsValid()' returns false if
+        /// the file can't be opened, is empty or can't be mapped.
+        ///
+        ////////////////////////////////////////////////////////////
+        MappedFile( const String& file , Access access = Access::Normal );
+        
+        ////////////////////////////////////////////////////////////
+        virtual ~MappedFile();
+        
+        ////////////////////////////////////////////////////////////
+        MappedFile( const MappedFile& ) = delete ;
+        
+        ////////////////////////////////////////////////////////////
+        MappedFile& operator = ( const MappedFile& ) = delete ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the file is mapped.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsValid() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the mapped data.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const char* GetData() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of the mapped data.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetSize() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the path of the mapped file.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const String& GetFile() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Changes the access hint for the whole mapping.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Advise( Access access ) const ;
+    };
+}
+
+#endif /* MappedFile_hpp */
@@ -16,11 +16,22 @@
 #include <ATL/Resource.hpp>
 #include <ATL/ParameterValue.hpp>
 #include <ATL/Alias.hpp>
+#include <ATL/Handle.hpp>
+#include <ATL/Symbol.hpp>
 
 namespace atl
 {
     ////////////////////////////////////////////////////////////
     class Program ;
+    class Material ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Generational handle to a Material, resolved by
+    /// 'MaterialPool::GetDefault()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Handle < Material > MaterialHandle ;
+    typedef HandlePool < Material > MaterialPool ;
     
     ////////////////////////////////////////////////////////////
     /// \brief Defines a material object.
@@ -38,7 +49,7 @@ namespace atl
         Weak < Texture >          m_texspecular ; ///< Specular texture. (MaterialTextureSpecular)
         WeakVector < Texture >    m_textures ;    ///< Other textures. (MaterialTexture1 to 4)
         Vector < ParameterValue > m_customs ;     ///< Other parameters. (MaterialComponent1 to 5)
-        String                    m_name ;        ///< Name given to this materia.
+        Atomic < Symbol >         m_name ;        ///< Name given to this material (read without locking 'm_mutex').
         mutable Mutex             m_mutex ;       ///< Access to those data.
         
     public:
@@ -116,6 +127,12 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual const String GetName() const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned name of this material.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Symbol GetSymbol() const ;
+        
         ////////////////////////////////////////////////////////////
         virtual void SetName( const String& name );
         
@@ -124,6 +141,13 @@ namespace atl
         
         ////////////////////////////////////////////////////////////
         virtual WeakVector < Texture > GetTextures() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of the material's values. Textures
+        /// are resources of their own and are not counted.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetCPUSize() const ;
     };
 }
 
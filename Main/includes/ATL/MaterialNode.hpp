@@ -41,11 +41,14 @@ namespace atl
     /// object. AggregatedMaterial remember which parameter has already been set
     /// and only allow one setting by aggregation.
     ///
+    /// The node registers as a holder of its material (see ResourceHolder),
+    /// so the MaterialManager doesn't evict a material drawn by a scene.
+    ///
     ////////////////////////////////////////////////////////////
     class MaterialNode : public DerivedNode < MaterialNode >
     {
         ////////////////////////////////////////////////////////////
-        Weak < atl::Material > m_material ; ///< Managed Material.
+        ResourceHolder < atl::Material > m_material ; ///< Managed Material.
         
     public:
         
@@ -70,6 +73,12 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void Aggregate( AggregatedMaterial& , RenderCommand& ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief References the held material by its file.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const ;
     };
 }
 
@@ -18,6 +18,7 @@
 #include <ATL/CBuffer.hpp>
 #include <ATL/Material.hpp>
 #include <ATL/IndexType.hpp>
+#include <ATL/MeshOptimizer.hpp>
 
 namespace atl
 {
@@ -42,6 +43,10 @@ namespace atl
     /// It also own its generated VertexCommand, linked to the Context
     /// corresponding to the given RenderWindow.
     ///
+    /// Local data can be optimized for the GPU with 'Optimize()', and is
+    /// optimized before generating the VertexCommand when a MeshOptimizer
+    /// is instanced.
+    ///
     ////////////////////////////////////////////////////////////
     class Mesh : public Resource
     {
@@ -68,10 +73,18 @@ namespace atl
                                                ///  one of its submesh has been changed and thus, the VertexCommands are not
                                                ///  representative of the mesh's data.
         
+        Atomic < bool >          m_optimized ; ///< True if the local data was optimized and not changed since.
+        
         mutable Mutex            m_mutex ;     ///< Access all data.
         
     public:
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Version of the data written to the ResourceCache.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const uint32_t s_cacheversion = 1 ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Constructs an empty mesh.
         ///
@@ -199,6 +212,120 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual Shared < VertexCommand > GetVertexCommand() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the VertexComponents of this mesh.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Vector < VertexComponent > GetVertexComponents() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the local vertex buffers of this mesh.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual SharedVector < CBuffer > GetVertexCBuffers() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of local vertexes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetVertexCount() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the local index buffer, or null.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Shared < CBuffer > GetIndexCBuffer() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of local indexes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetIndexCount() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the type of the local indexes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual IndexType GetIndexType() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the local default material.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Weak < Material > GetMaterial() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of the local vertex and index
+        /// buffers, submeshes included.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetCPUSize() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of the buffers used by the generated
+        /// VertexCommands, submeshes included.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetGPUSize() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Optimizes the local data of this mesh and its
+        /// submeshes with given optimizer.
+        ///
+        /// Local buffers are replaced by the optimized ones, and the mesh
+        /// is marked dirty. Meshes already optimized are skipped.
+        ///
+        /// \return The sum of the reports of the optimized meshes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual MeshOptimizerReport Optimize( MeshOptimizer& optimizer );
+        
+    protected:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the local buffers, components and counts of
+        /// this mesh and its submeshes. The material is a resource of its
+        /// own and is not written.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DWriteCache( ResourceCacheWriter& writer ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Restores the data written by 'DWriteCache()'. Buffers
+        /// are views on the cache file, and submeshes are created as Mesh.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DReadCache( const ResourceCacheReader& reader );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Removes every local vertex buffers, components and
+        /// the index buffer.
+        ///
+        /// The generated VertexCommand is kept until the next call to
+        /// 'GenVertexCommands()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void ResetVertexData();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Marks the mesh as dirty, so 'GenVertexCommands()'
+        /// generates again its VertexCommand.
+        ///
+        /// Used when the content of a local CBuffer is changed in place.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void SetDirty();
+        
+    private:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Optimizes the local data, if not done yet.
+        ///
+        /// \note 'm_mutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        MeshOptimizerReport pOptimize( MeshOptimizer& optimizer );
     };
 }
 
@@ -23,28 +23,30 @@ namespace atl
     ////////////////////////////////////////////////////////////
     /// \brief Holds a Weak Mesh.
     ///
-    ///
+    /// The node registers as a holder of its mesh (see ResourceHolder),
+    /// so the MeshManager doesn't evict a mesh drawn by a scene.
     ///
     ////////////////////////////////////////////////////////////
     class MeshNode : public DerivedNode < MeshNode >
     {
         ////////////////////////////////////////////////////////////
-        Detail::WeakDirtable < atl::Mesh >      m_mesh ;    ///< Handled Mesh object.
-        mutable SharedVector < AggregatedNode > m_agnodes ; ///< AggregatedNodes created by the mesh node.
-        mutable Mutex                           m_mutex ;   ///< Access AggregatedNodes.
-        
-	protected:
-		
-		////////////////////////////////////////////////////////////
-		/// \brief Creates a new AggregatedNode and associate it with
-		/// the given AggregatedGroup.
-		/// 
-		/// \note An AggregatedNode must be created with a pair of lsnodes
-		/// and group. This permits to identify the correct AggregatedNode
-		/// when updating the mesh node. However, it is AggregatedGroup
-		/// wich set the AggregatedNode's parent when using 'AppendNode'.
-		///
-		////////////////////////////////////////////////////////////
+        mutable Detail::WeakDirtable < atl::Mesh > m_mesh ;    ///< Handled Mesh object. Follows its replacements when updated.
+        mutable ResourceHolder < atl::Mesh >       m_holder ;  ///< Registers this node as a holder of 'm_mesh'.
+        mutable SharedVector < AggregatedNode >    m_agnodes ; ///< AggregatedNodes created by the mesh node.
+        mutable Mutex                              m_mutex ;   ///< Access AggregatedNodes and 'm_holder'.
+        
+	protected:
+		
+		////////////////////////////////////////////////////////////
+		/// \brief Creates a new AggregatedNode and associate it with
+		/// the given AggregatedGroup.
+		/// 
+		/// \note An AggregatedNode must be created with a pair of lsnodes
+		/// and group. This permits to identify the correct AggregatedNode
+		/// when updating the mesh node. However, it is AggregatedGroup
+		/// wich set the AggregatedNode's parent when using 'AppendNode'.
+		///
+		////////////////////////////////////////////////////////////
 		virtual Shared < AggregatedNode > CreateAggregatedNode( const NodesBySubtype& lsnodes , const AggregatedGroup& group ) const ;
         
     public:
@@ -70,6 +72,12 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void Update( NodesBySubtype& lsnodes , AggregatedGroup& group ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief References the held mesh by its file.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const ;
     };
 }
 
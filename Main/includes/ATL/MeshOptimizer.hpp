@@ -0,0 +1,203 @@
+//  ========================================================================  //
+//
+//  File    : ATL/MeshOptimizer.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef MeshOptimizer_hpp
+#define MeshOptimizer_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Instanced.hpp>
+#include <ATL/CBuffer.hpp>
+#include <ATL/IndexType.hpp>
+#include <ATL/VertexComponent.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Steps done by a MeshOptimizer.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MeshOptimizerSettings
+    {
+        bool     weld ;              ///< Merges vertexes with the same data.
+        bool     reorderindexes ;    ///< Reorders triangles for the post-transform cache (Forsyth).
+        bool     reordervertexes ;   ///< Reorders vertexes in the order the indexes use them.
+        bool     shrinkindexes ;     ///< Uses the smallest index type able to address every vertex.
+        bool     allowui8 ;          ///< Allows 'IndexType::UI8', which some GPUs handle slowly.
+        bool     quantizenormals ;   ///< Packs normals, tangents and bitangents in 'R10G10B10A2Snorm'.
+        bool     quantizetexcoords ; ///< Stores 2 elements slots in 'R16G16Unorm', or 'R16G16Float'
+                                     ///  if out of [0, 1].
+        bool     quantizecolors ;    ///< Stores colors in 'R8G8B8A8Unorm'.
+        bool     quantizepositions ; ///< Stores positions in 'R16G16B16A16Float'. Only precise enough
+                                     ///  for small objects, whose vertexes are near the origin.
+        uint32_t cachesize ;         ///< Size of the LRU cache modeled when reordering triangles.
+        uint32_t fifosize ;          ///< Size of the FIFO cache modeled to compute the ACMR.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Every step enabled, except 'allowui8' and the
+        /// quantization steps.
+        ///
+        ////////////////////////////////////////////////////////////
+        MeshOptimizerSettings()
+        : weld( true ) , reorderindexes( true ) , reordervertexes( true ) , shrinkindexes( true )
+        , allowui8( false ) , quantizenormals( false ) , quantizetexcoords( false ) , quantizecolors( false )
+        , quantizepositions( false ) , cachesize( 32 ) , fifosize( 16 )
+        { }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Result of a MeshOptimizer on one or more meshes.
+    ///
+    /// The ACMR (average cache miss ratio) is the number of vertexes
+    /// transformed per triangle, with a FIFO post-transform cache: 3 is
+    /// the worst, 0.5 is about the best for a regular grid.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MeshOptimizerReport
+    {
+        uint32_t    meshes ;        ///< Number of optimized meshes.
+        uint64_t    triangles ;     ///< Number of triangles.
+        uint64_t    vcountbefore ;  ///< Number of vertexes before.
+        uint64_t    vcountafter ;   ///< Number of vertexes after.
+        std::size_t bytesbefore ;   ///< Size of the vertex and index buffers before.
+        std::size_t bytesafter ;    ///< Size of the vertex and index buffers after.
+        uint64_t    missesbefore ;  ///< Cache misses before.
+        uint64_t    missesafter ;   ///< Cache misses after.
+
+        ////////////////////////////////////////////////////////////
+        MeshOptimizerReport()
+        : meshes( 0 ) , triangles( 0 ) , vcountbefore( 0 ) , vcountafter( 0 )
+        , bytesbefore( 0 ) , bytesafter( 0 ) , missesbefore( 0 ) , missesafter( 0 )
+        { }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds the counts of another report.
+        ///
+        ////////////////////////////////////////////////////////////
+        MeshOptimizerReport& operator += ( const MeshOptimizerReport& rhs )
+        {
+            meshes       += rhs.meshes ;
+            triangles    += rhs.triangles ;
+            vcountbefore += rhs.vcountbefore ;
+            vcountafter  += rhs.vcountafter ;
+            bytesbefore  += rhs.bytesbefore ;
+            bytesafter   += rhs.bytesafter ;
+            missesbefore += rhs.missesbefore ;
+            missesafter  += rhs.missesafter ;
+            return *this ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        float GetACMRBefore() const { return triangles ? static_cast < float >( missesbefore ) / triangles : 0.0f ; }
+
+        ////////////////////////////////////////////////////////////
+        float GetACMRAfter() const { return triangles ? static_cast < float >( missesafter ) / triangles : 0.0f ; }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief The local vertex and index data of a Mesh, as given to
+    /// a MeshOptimizer.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MeshData
+    {
+        Vector < VertexComponent > components ; ///< Components, related to 'vbuffers'.
+        SharedVector < CBuffer >   vbuffers ;   ///< Vertex buffers.
+        uint32_t                   vcount ;     ///< Number of vertexes.
+        Shared < CBuffer >         ibuffer ;    ///< Index buffer, or null.
+        uint32_t                   icount ;     ///< Number of indexes.
+        IndexType                  itype ;      ///< Type of the indexes.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Optimizes the vertex and index data of meshes for the
+    /// GPU.
+    ///
+    /// Each step can be disabled in MeshOptimizerSettings:
+    /// - Vertexes with the same data in every component are welded.
+    /// - Triangles are reordered with Tom Forsyth's 'Linear-Speed Vertex
+    ///   Cache Optimisation', so vertexes are reused while they are in
+    ///   the post-transform cache.
+    /// - Vertexes are reordered in the order the triangles first use
+    ///   them, so fetches are sequential. Unused vertexes are removed.
+    /// - Indexes use the smallest type able to address every vertex.
+    /// - Float components are quantized to compact types (see
+    ///   VertexQuantizer), depending on their Attribute. A component is
+    ///   kept as is if a value is out of the compact type's range.
+    ///
+    /// New vertex buffers are written interleaved, one per original
+    /// buffer, with their components in the same order. The original
+    /// CBuffers are never modified, as they may be shared.
+    ///
+    /// Meshes are only optimized if they are triangle lists whose
+    /// components all have a known size and fit in their buffer.
+    /// Non-indexed meshes are indexed only if welding removes vertexes:
+    /// otherwise, they are only quantized.
+    ///
+    /// When a MeshOptimizer is instanced, 'Mesh::GenVertexCommands()'
+    /// optimizes the meshes before uploading them. Loaders can also call
+    /// 'Mesh::Optimize()' at import.
+    ///
+    ////////////////////////////////////////////////////////////
+    class MeshOptimizer : public Instanced < MeshOptimizer >
+    {
+        ////////////////////////////////////////////////////////////
+        MeshOptimizerSettings m_settings ; ///< Steps to do.
+        MeshOptimizerReport   m_total ;    ///< Sum of every report.
+        mutable Spinlock      m_spinlock ; ///< Access to 'm_total'.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        MeshOptimizer( const MeshOptimizerSettings& settings = MeshOptimizerSettings() );
+
+        ////////////////////////////////////////////////////////////
+        virtual ~MeshOptimizer();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Optimizes given data in place.
+        ///
+        /// \return The report for this data. If the data can't be
+        /// optimized, it is left untouched and the report's 'meshes' is 0.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual MeshOptimizerReport Optimize( MeshData& data );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the sum of every report returned by
+        /// 'Optimize()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual MeshOptimizerReport GetTotalReport() const ;
+
+        ////////////////////////////////////////////////////////////
+        virtual const MeshOptimizerSettings& GetSettings() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of vertexes transformed to draw a
+        /// triangle list, with a FIFO post-transform cache.
+        ///
+        ////////////////////////////////////////////////////////////
+        static uint64_t CountCacheMisses( const uint32_t* indexes , std::size_t count , uint32_t fifosize );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Reorders the triangles of a triangle list for a LRU
+        /// post-transform cache of given size.
+        ///
+        /// \param indexes  Indexes, 'count' is a multiple of 3.
+        /// \param vcount   Number of vertexes: every index is less.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ReorderTriangles( uint32_t* indexes , std::size_t count , uint32_t vcount , uint32_t cachesize );
+    };
+}
+
+#endif /* MeshOptimizer_hpp */
@@ -14,6 +14,7 @@
 
 #include <ATL/StdIncludes.hpp>
 #include <ATL/Resource.hpp>
+#include <ATL/ResourceArgs.hpp>
 #include <ATL/ErrorCenter.hpp>
 
 namespace atl
@@ -32,34 +33,58 @@ namespace atl
             ////////////////////////////////////////////////////////////
             virtual MimeType GetMimeType() const = 0 ;
             
+            ////////////////////////////////////////////////////////////
+            /// \brief Returns the version of the data written to the
+            /// ResourceCache by the class, used in its cache keys.
+            ///
+            ////////////////////////////////////////////////////////////
+            virtual uint32_t GetCacheVersion() const { return 0 ; }
+            
+            ////////////////////////////////////////////////////////////
+            /// \brief Returns true if the class stores its data in the
+            /// ResourceCache, i.e. declares 's_cacheversion'.
+            ///
+            ////////////////////////////////////////////////////////////
+            virtual bool IsCached() const { return false ; }
+            
             ////////////////////////////////////////////////////////////
             Shared < Resource > Create()
             {
                 return DCreate();
             }
             
+            ////////////////////////////////////////////////////////////
+            /// \brief Creates the resource from a file.
+            ///
+            /// Arguments are not copied: the resource's constructor sees
+            /// them through a ResourceArgs referencing them, with their
+            /// exact type, and may move those given as rvalues.
+            ///
+            /// The resource is always created: files already loaded are found
+            /// by the Manager, which also decides when to load them again.
+            ///
             ////////////////////////////////////////////////////////////
             template < typename... Args >
-            Shared < Resource > Create( bool reload , const String& file , Args&&... args )
+            Shared < Resource > Create( const String& file , Args&&... args )
             {
-                constexpr int num = sizeof...( Args );
-                return DCreate( reload , file , num , ( &args )... );
+                const ResourceArg list[] = { ResourceArg::Make( std::forward < Args >( args ) )... , ResourceArg() };
+                return DCreate( file , ResourceArgs( list , sizeof...( Args ) ) );
             }
             
             ////////////////////////////////////////////////////////////
             template < typename... Args >
             Shared < Resource > Create( const CBuffer& buf , Args&&... args )
             {
-                constexpr int num = sizeof...( Args );
-                return DCreate( buf , num , ( &args )... );
+                const ResourceArg list[] = { ResourceArg::Make( std::forward < Args >( args ) )... , ResourceArg() };
+                return DCreate( buf , ResourceArgs( list , sizeof...( Args ) ) );
             }
             
             ////////////////////////////////////////////////////////////
             template < typename... Args >
             Shared < Resource > Create( std::istream& is , Args&&... args )
             {
-                constexpr int num = sizeof...( Args );
-                return DCreate( is , num , ( &args )... );
+                const ResourceArg list[] = { ResourceArg::Make( std::forward < Args >( args ) )... , ResourceArg() };
+                return DCreate( is , ResourceArgs( list , sizeof...( Args ) ) );
             }
             
         protected:
@@ -68,13 +93,13 @@ namespace atl
             virtual Shared < Resource > DCreate() { return nullptr ; }
             
             ////////////////////////////////////////////////////////////
-            virtual Shared < Resource > DCreate( bool reload , const String& file , int num , ... ) { return nullptr ; }
+            virtual Shared < Resource > DCreate( const String& file , const ResourceArgs& args ) { return nullptr ; }
             
             ////////////////////////////////////////////////////////////
-            virtual Shared < Resource > DCreate( const CBuffer& buf , int num , ... ) { return nullptr ; }
+            virtual Shared < Resource > DCreate( const CBuffer& buf , const ResourceArgs& args ) { return nullptr ; }
             
             ////////////////////////////////////////////////////////////
-            virtual Shared < Resource > DCreate( std::istream& is , int num , ... ) { return nullptr ; }
+            virtual Shared < Resource > DCreate( std::istream& is , const ResourceArgs& args ) { return nullptr ; }
         };
         
         ////////////////////////////////////////////////////////////
@@ -94,45 +119,98 @@ namespace atl
         
         ////////////////////////////////////////////////////////////
         template < typename Class , typename Enable = void >
-        Shared < Class > HelperCreate2( const String& , va_list& , ... )
+        bool HelperIsCached( ... )
+        {
+            return false ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        template < typename Class ,
+                   typename std::enable_if< std::is_integral< decltype( Class::s_cacheversion ) >::value >::type* = nullptr >
+        bool HelperIsCached( int )
+        {
+            return true ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        template < typename Class , typename Enable = void >
+        uint32_t HelperCacheVersion( ... )
+        {
+            return 0 ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns 'Class::s_cacheversion' when the class
+        /// declares it.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Class ,
+                   typename std::enable_if< std::is_integral< decltype( Class::s_cacheversion ) >::value >::type* = nullptr >
+        uint32_t HelperCacheVersion( int )
+        {
+            return static_cast < uint32_t >( Class::s_cacheversion );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        template < typename Class , typename Enable = void >
+        Shared < Class > HelperCreate2( const String& , const ResourceArgs& , ... )
         {
             return nullptr ;
         }
         
         ////////////////////////////////////////////////////////////
         template < typename Class ,
-                   typename std::enable_if< std::is_constructible< Class , const String& , va_list& >::value >::type* = nullptr >
-        Shared < Class > HelperCreate2( const String& f , va_list& args , int dummy )
+                   typename std::enable_if< std::is_constructible< Class , const String& , const ResourceArgs& >::value >::type* = nullptr >
+        Shared < Class > HelperCreate2( const String& f , const ResourceArgs& args , int dummy )
         {
             return std::make_shared < Class >( f , args );
         }
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Creates a class only constructible from a CBuffer with
+        /// a file: the file is mapped into a read-only CBuffer, so the
+        /// class reads it straight from the page cache.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Class ,
+                   typename std::enable_if< !std::is_constructible< Class , const String& , const ResourceArgs& >::value &&
+                                             std::is_constructible< Class , const CBuffer& , const ResourceArgs& >::value >::type* = nullptr >
+        Shared < Class > HelperCreate2( const String& f , const ResourceArgs& args , int dummy )
+        {
+            CBuffer buffer = CBuffer::MapFile( f );
+            
+            if ( buffer.Empty() )
+                return nullptr ;
+            
+            return std::make_shared < Class >( buffer , args );
+        }
+        
         ////////////////////////////////////////////////////////////
         template < typename Class , typename Enable = void >
-        Shared < Class > HelperCreate3( const CBuffer& , va_list& , ... )
+        Shared < Class > HelperCreate3( const CBuffer& , const ResourceArgs& , ... )
         {
             return nullptr ;
         }
         
         ////////////////////////////////////////////////////////////
         template < typename Class ,
-        typename std::enable_if< std::is_constructible< Class , const CBuffer& , va_list& >::value >::type* = nullptr >
-        Shared < Class > HelperCreate3( const CBuffer& f , va_list& args , int dummy )
+        typename std::enable_if< std::is_constructible< Class , const CBuffer& , const ResourceArgs& >::value >::type* = nullptr >
+        Shared < Class > HelperCreate3( const CBuffer& f , const ResourceArgs& args , int dummy )
         {
             return std::make_shared < Class >( f , args );
         }
         
         ////////////////////////////////////////////////////////////
         template < typename Class , typename Enable = void >
-        Shared < Class > HelperCreate4( std::istream& , va_list& , ... )
+        Shared < Class > HelperCreate4( std::istream& , const ResourceArgs& , ... )
         {
             return nullptr ;
         }
         
         ////////////////////////////////////////////////////////////
         template < typename Class ,
-                   typename std::enable_if< std::is_constructible< Class , std::istream& , va_list& >::value >::type* = nullptr >
-        Shared < Class > HelperCreate4( std::istream& is , va_list& args , int dummy )
+                   typename std::enable_if< std::is_constructible< Class , std::istream& , const ResourceArgs& >::value >::type* = nullptr >
+        Shared < Class > HelperCreate4( std::istream& is , const ResourceArgs& args , int dummy )
         {
             return std::make_shared < Class >( is , args );
         }
@@ -161,9 +239,7 @@ namespace atl
     class Metaclass : public Detail::IMetaclass
     {
         ////////////////////////////////////////////////////////////
-        MimeType                           m_mime ;     ///< MIME type for this class.
-        mutable Spinlock                   m_spinlock ; ///< Spinlock to access the MIME type.
-        Map < String , Weak < Resource > > m_lastfile ; ///< Retain resource weak pointer for file loaded.
+        const MimeType m_mime ; ///< MIME type for this class, never modified once constructed.
         
     public:
         
@@ -188,10 +264,21 @@ namespace atl
         ////////////////////////////////////////////////////////////
         MimeType GetMimeType() const
         {
-            Spinlocker lck( m_spinlock );
             return m_mime ;
         }
         
+        ////////////////////////////////////////////////////////////
+        uint32_t GetCacheVersion() const
+        {
+            return Detail::HelperCacheVersion < Class >( int{} );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        bool IsCached() const
+        {
+            return Detail::HelperIsCached < Class >( int{} );
+        }
+        
     protected:
         
         ////////////////////////////////////////////////////////////
@@ -214,29 +301,12 @@ namespace atl
         }
         
         ////////////////////////////////////////////////////////////
-        Shared < Resource > DCreate( bool reload , const String& file , int num , ... )
+        Shared < Resource > DCreate( const String& file , const ResourceArgs& args )
         {
             try
             {
-                Spinlocker lck( m_spinlock );
-                auto it = m_lastfile.find( file );
-                
-                if ( it == m_lastfile.end() || it->second.expired() || reload )
-                {
-                    va_list args ;
-                    va_start( args , num );
-                    
-                    auto sptr = Detail::HelperCreate2 < Class >( file , args , int{} );
-                    
-                    va_end( args );
-                    m_lastfile[file] = std::static_pointer_cast< Resource >( sptr );
-                    return std::static_pointer_cast< Resource >( sptr );
-                }
-                
-                else
-                {
-                    return it->second.lock();
-                }
+                auto sptr = Detail::HelperCreate2 < Class >( file , args , int{} );
+                return std::static_pointer_cast< Resource >( sptr );
             }
             
             catch( const std::exception& exception )
@@ -251,17 +321,11 @@ namespace atl
         }
         
         ////////////////////////////////////////////////////////////
-        Shared < Resource > DCreate( const CBuffer& buf , int num , ... )
+        Shared < Resource > DCreate( const CBuffer& buf , const ResourceArgs& args )
         {
             try
             {
-                va_list args ;
-                va_start( args , num );
-                
                 auto sptr = Detail::HelperCreate3 < Class >( buf , args , int{} );
-                
-                va_end( args );
-                
                 return std::static_pointer_cast < Resource >( sptr );
             }
             
@@ -277,15 +341,11 @@ namespace atl
         }
         
         ////////////////////////////////////////////////////////////
-        Shared < Resource > DCreate( std::istream& is , int num , ... )
+        Shared < Resource > DCreate( std::istream& is , const ResourceArgs& args )
         {
             try
             {
-                va_list args ;
-                va_start( args , num );
                 auto sptr = Detail::HelperCreate4 < Class >( is , args , int{} );
-                va_end( args );
-                
                 return std::static_pointer_cast < Resource >( sptr );
             }
             
@@ -329,16 +389,4 @@ namespace atl
     }
 }
 
-////////////////////////////////////////////////////////////
-/// \brief Returns the next argument as given type, when called
-/// from a Metaclass'ed object.
-///
-/// Object created with Metaclass see their arguments given always
-/// as pointer to the base type, to ensure non-POD types are well
-/// transmitted. Those types can be converted implicitely into references
-/// if necessary.
-///
-////////////////////////////////////////////////////////////
-#define AtlMetaArg( type ) * ( va_arg( args , type * ) )
-
 #endif /* Metaclass_hpp */
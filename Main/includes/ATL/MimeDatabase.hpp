@@ -17,6 +17,19 @@
 
 namespace atl
 {
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief A node of the headers trie of MimeDatabase.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct MimeTrieNode
+        {
+            Map < unsigned char , uint32_t > children ; ///< Next nodes, by next byte of the header.
+            Vector < uint32_t >              mimes ;    ///< Ranks of the MIME types whose header ends here.
+        };
+    }
+    
     ////////////////////////////////////////////////////////////
     /// \brief A Database to collect and organize MIME types.
     ///
@@ -48,12 +61,27 @@ namespace atl
     /// 'mime-header' , 'mime-exts' and 'mime-priority' are optionals
     /// and are always reported to the last 'mime' command.
     ///
+    /// Lookups: MIME types are kept sorted by priority, and indexed by a
+    /// trie of their headers and a hash map of their extensions, rebuilt
+    /// when types are added or removed. A file is matched by reading its
+    /// first bytes once, outside of the lock, and walking the trie with
+    /// them: resolving a type costs the length of the longest header,
+    /// whatever the number of types.
+    ///
+    /// Results of 'FindHigherForFile()' can also be cached by path with
+    /// 'SetCacheEnabled()', for bulk loads of files which don't change.
+    ///
     ////////////////////////////////////////////////////////////
     class MimeDatabase : public Instanced < MimeDatabase >
     {
         ////////////////////////////////////////////////////////////
-        Vector < MimeType > iMimes ;    ///< MIME types collected.
-        mutable Spinlock    iSpinlock ; ///< Access MIME datas.
+        Vector < MimeType >                      iMimes ;      ///< MIME types collected, by decreasing priority.
+        Vector < Detail::MimeTrieNode >          iHeaders ;    ///< Trie of the headers. Node 0 is the root.
+        HashMap < String , Vector < uint32_t > > iExtensions ; ///< Ranks of the MIME types in 'iMimes', by extension.
+        std::size_t                              iMaxHeader ;  ///< Size of the longest header.
+        bool                                     iCached ;     ///< True if 'FindHigherForFile()' results are cached.
+        mutable HashMap < String , MimeType >    iCache ;      ///< Results of 'FindHigherForFile()', by path.
+        mutable Spinlock                         iSpinlock ;   ///< Access MIME datas.
         
     public:
         
@@ -130,6 +158,61 @@ namespace atl
         
         ////////////////////////////////////////////////////////////
         virtual uint32_t LoadSimpleMimeDatabase( const Filename & filename );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Enables or disables the cache of 'FindHigherForFile()'
+        /// results, by path. Disabled by default.
+        ///
+        /// A cached result is returned even if the file changed since:
+        /// call 'ClearCache()' when files may have changed type. The cache
+        /// is cleared when types are added or removed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void SetCacheEnabled( bool enabled );
+        
+        ////////////////////////////////////////////////////////////
+        virtual bool IsCacheEnabled() const ;
+        
+        ////////////////////////////////////////////////////////////
+        virtual void ClearCache();
+        
+    protected:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of the longest header registered, in
+        /// bytes: the number of bytes to read from a file to match it.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetMaxHeaderSize() const ;
+        
+    private:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Rebuilds the headers trie and the extensions map, and
+        /// clears the cache.
+        ///
+        /// \note 'iSpinlock' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pRebuild();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Finds the ranks of the MIME types matching a file's
+        /// first bytes and its extension, in increasing order.
+        ///
+        /// \note 'iSpinlock' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void pFindRanks( const String& prefix , const String& extension ,
+                         Vector < uint32_t >& byheader , Vector < uint32_t >& byext ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Reads the first bytes of a file, to match the headers.
+        /// Returns false if the file can't be opened, or if there are no
+        /// headers to match.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool pReadPrefix( const Filename& filename , String& prefix ) const ;
     };
 }
 
@@ -14,6 +14,7 @@
 
 #include <ATL/StdIncludes.hpp>
 #include <ATL/Filename.hpp>
+#include <ATL/Symbol.hpp>
 
 namespace atl
 {
@@ -39,13 +40,17 @@ namespace atl
     /// API to know if the resource is, for example, compatible with their
     /// underlying behaviour.
     ///
+    /// The category, the sub levels tree and the suffix are interned as
+    /// Symbols, so comparing two MIME types compares integers.
+    ///
     ////////////////////////////////////////////////////////////
     class MimeType
     {
         ////////////////////////////////////////////////////////////
-        String      iTopLevelCat ;  ///< Category.
-        String      iSublevelTree ; ///< Sub levels tree (after the Category and the '/').
-        String      iSuffix ;       ///< Suffix (after the '+').
+        Symbol      iTopLevelCat ;  ///< Category.
+        Symbol      iSublevelTree ; ///< Sub levels tree (after the Category and the '/').
+        Symbol      iSuffix ;       ///< Suffix (after the '+').
+        Symbol      iComplete ;     ///< Category and sub levels tree, as returned by 'GetCompleteTree()'.
         StringList  iExtensions ;   ///< Extensions (for now manually given).
         StringMap   iOptionals ;    ///< Options to the MIME type (manually given).
         String      iHeader ;       ///< Header normally encountered at the beginning of the file.
@@ -75,6 +80,12 @@ namespace atl
         String GetSuffix() const ;
         String GetSubType() const ;
         String GetCompleteTree() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns 'GetCompleteTree()' as an interned Symbol.
+        ///
+        ////////////////////////////////////////////////////////////
+        const Symbol& GetCompleteSymbol() const ;
         StringList GetExtensions() const ;
         
         String GetHeader() const ;
@@ -23,6 +23,8 @@ namespace atl
     class RenderCommand ;
     class AggregatedGroup ;
     class Node ;
+    struct BinarySceneNode ;
+    struct BinarySceneReference ;
     
     ////////////////////////////////////////////////////////////
     typedef Map < uint32_t , Weak < Node > > NodesBySubtype ;
@@ -152,6 +154,41 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void Update( NodesBySubtype& lsnodes , AggregatedGroup& group ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Updates the given AggregatedGroup by processing each
+        /// child subtree as an independent task.
+        ///
+        /// This node registers itself into 'lsnodes' as 'Update()' does,
+        /// then each child receives its own copy of 'lsnodes' and updates
+        /// into the slice 'group.GetSlice( index )', where index is the
+        /// position of the child. Tasks are run by the instanced ThreadPool
+        /// and this function returns when every subtree is updated. The
+        /// merged result is available with 'AggregatedGroup::GetNodes()'.
+        ///
+        /// It is generally called on the root PositionNode of a SceneGraph.
+        /// Children subtrees must be independent, i.e. a node must not be
+        /// shared by two subtrees of this node.
+        ///
+        /// \note If no ThreadPool is instanced, or if this node has less
+        /// than two children, it falls back to 'Update()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void UpdateParallel( NodesBySubtype& lsnodes , AggregatedGroup& group ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Fills the given record to write this node in a binary
+        /// scene file.
+        ///
+        /// Default implementation only writes the subtype. A node that
+        /// holds a resource must describe it in 'reference', and a node
+        /// with some data (like a position) must write it into 'record'.
+        /// The record's parent and reference indexes are set by the writer.
+        ///
+        /// \see SceneGraph::SaveBinary
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const ;
     };
 }
 
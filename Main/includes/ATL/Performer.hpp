@@ -14,6 +14,8 @@
 
 #include <ATL/StdIncludes.hpp>
 
+#include <condition_variable>
+
 namespace atl
 {
     ////////////////////////////////////////////////////////////
@@ -36,6 +38,16 @@ namespace atl
         mutable Spinlock iSpinlock ;
         std::future < void > iFuture ;
 
+        mutable Mutex                   iWaitMutex ; ///< Guards 'iWaitCond'.
+        mutable std::condition_variable iWaitCond ;  ///< Notified when the task ends.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Stops the timer, sets state to 'finished' and wakes
+        /// up the threads in 'Wait()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        void SetEnded();
+
     public:
 
         ////////////////////////////////////////////////////////////
@@ -56,11 +68,7 @@ namespace atl
             iFuture = std::async( std::launch::async , [this, callable, args...](){
                 
                 callable( args... );
-
-                Spinlocker lck( iSpinlock );
-                iEnd = Clock::now();
-                iStarted.store( false );
-                iEnded.store( true );
+                SetEnded();
             });
 
             iStarted.store( true );
@@ -75,6 +83,11 @@ namespace atl
 
         Duration GetDuration() const;
 
+        ////////////////////////////////////////////////////////////
+        /// \brief Blocks until the task is finished. The calling thread
+        /// sleeps while waiting.
+        ///
+        ////////////////////////////////////////////////////////////
         void Wait();
 
         Seconds GetSeconds() const ;
@@ -0,0 +1,190 @@
+//  ========================================================================  //
+//
+//  File    : ATL/PoolAllocator.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef PoolAllocator_hpp
+#define PoolAllocator_hpp
+
+#include <ATL/StdIncludes.hpp>
+
+#include <typeinfo>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of a pool, as returned by 'GetPoolsStats()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct PoolStats
+    {
+        String      name ;  ///< Name of the type allocated in the pool.
+        std::size_t live ;  ///< Number of allocations not yet freed.
+        std::size_t peak ;  ///< Highest value of 'live'.
+        std::size_t bytes ; ///< Bytes currently allocated (including shared pointers' control blocks).
+    };
+
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        static const std::size_t PoolAlignment   = 16 ;  ///< Alignment of every block.
+        static const std::size_t PoolMaxSize     = 512 ; ///< Bigger allocations use the global allocator.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Allocates a block of at least 'size' bytes.
+        ///
+        /// Blocks are taken from the calling thread's cache, which is
+        /// refilled by batches from a global free list. Sizes are rounded
+        /// up to 'PoolAlignment', and a size class never gives its memory
+        /// back to another one, so fragmentation stays bounded however
+        /// long the engine runs.
+        ///
+        ////////////////////////////////////////////////////////////
+        void* PoolAllocate( std::size_t size );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Frees a block allocated by 'PoolAllocate()' with the
+        /// same size.
+        ///
+        ////////////////////////////////////////////////////////////
+        void PoolDeallocate( void* block , std::size_t size );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Counters of one PoolAllocator tag.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct PoolCounters
+        {
+            const std::type_info&  type ;  ///< Tag's type.
+            Atomic < std::size_t > live ;  ///< Number of allocations not yet freed.
+            Atomic < std::size_t > peak ;  ///< Highest value of 'live'.
+            Atomic < std::size_t > bytes ; ///< Bytes currently allocated.
+
+            ////////////////////////////////////////////////////////////
+            PoolCounters( const std::type_info& info );
+
+            ////////////////////////////////////////////////////////////
+            void OnAllocate( std::size_t size )
+            {
+                std::size_t current = live.fetch_add( 1 , std::memory_order_relaxed ) + 1 ;
+                std::size_t highest = peak.load( std::memory_order_relaxed );
+                bytes.fetch_add( size , std::memory_order_relaxed );
+
+                while ( current > highest && !peak.compare_exchange_weak( highest , current , std::memory_order_relaxed ) );
+            }
+
+            ////////////////////////////////////////////////////////////
+            void OnDeallocate( std::size_t size )
+            {
+                live.fetch_sub( 1 , std::memory_order_relaxed );
+                bytes.fetch_sub( size , std::memory_order_relaxed );
+            }
+
+            ////////////////////////////////////////////////////////////
+            /// \brief Returns the counters of given tag, registered in
+            /// 'GetPoolsStats()' on first use.
+            ///
+            /// Counters are never destroyed, as pooled objects may be
+            /// released after static objects destruction.
+            ///
+            ////////////////////////////////////////////////////////////
+            template < typename Tag >
+            static PoolCounters& Get()
+            {
+                static PoolCounters* counters = new PoolCounters( typeid( Tag ) );
+                return *counters ;
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Standard allocator using the engine's block pools.
+    ///
+    /// Every allocation made with a PoolAllocator is accounted to 'Tag'.
+    /// When used with 'std::allocate_shared()', the allocator is rebound
+    /// to the type holding both the object and its control block, so both
+    /// are in the same pooled block and accounted to the object's type.
+    ///
+    /// Use 'MakePooled()' instead of 'std::make_shared()' for objects
+    /// created and destroyed often.
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class , typename Tag = Class >
+    class PoolAllocator
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        typedef Class value_type ;
+
+        ////////////////////////////////////////////////////////////
+        template < typename Other >
+        struct rebind { typedef PoolAllocator < Other , Tag > other ; };
+
+        ////////////////////////////////////////////////////////////
+        PoolAllocator() { }
+
+        ////////////////////////////////////////////////////////////
+        template < typename Other >
+        PoolAllocator( const PoolAllocator < Other , Tag >& ) { }
+
+        ////////////////////////////////////////////////////////////
+        Class* allocate( std::size_t count )
+        {
+            std::size_t size = count * sizeof( Class );
+            Detail::PoolCounters::Get < Tag >().OnAllocate( size );
+
+            if ( alignof( Class ) > Detail::PoolAlignment )
+                return static_cast < Class* >( ::operator new( size ) );
+
+            return static_cast < Class* >( Detail::PoolAllocate( size ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        void deallocate( Class* block , std::size_t count )
+        {
+            std::size_t size = count * sizeof( Class );
+            Detail::PoolCounters::Get < Tag >().OnDeallocate( size );
+
+            if ( alignof( Class ) > Detail::PoolAlignment )
+                ::operator delete( block );
+            else
+                Detail::PoolDeallocate( block , size );
+        }
+
+        ////////////////////////////////////////////////////////////
+        template < typename Other >
+        bool operator == ( const PoolAllocator < Other , Tag >& ) const { return true ; }
+
+        ////////////////////////////////////////////////////////////
+        template < typename Other >
+        bool operator != ( const PoolAllocator < Other , Tag >& ) const { return false ; }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Same as 'std::make_shared()' but allocates the object
+    /// and its control block with a PoolAllocator.
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class , typename... Args >
+    Shared < Class > MakePooled( Args&&... args )
+    {
+        return std::allocate_shared < Class >( PoolAllocator < Class >() , std::forward < Args >( args )... );
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns the statistics of every PoolAllocator tag used
+    /// so far, sorted by bytes allocated (biggest first).
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector < PoolStats > GetPoolsStats();
+}
+
+#endif /* PoolAllocator_hpp */
@@ -95,6 +95,12 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void Aggregate( AggregatedMaterial& material , RenderCommand& ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the position of this node.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const ;
     };
 }
 
@@ -14,6 +14,7 @@
 
 #include <ATL/StdIncludes.hpp>
 #include <ATL/IDGenerator.hpp>
+#include <ATL/Handle.hpp>
 #include <ATL/ConstantParameter.hpp>
 #include <ATL/Alias.hpp>
 #include <ATL/VertexLayout.hpp>
@@ -32,6 +33,17 @@ namespace atl
     ////////////////////////////////////////////////////////////
     typedef unsigned long long ProgramId ;
     
+    ////////////////////////////////////////////////////////////
+    class Program ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Generational handle to a Program, resolved by
+    /// 'ProgramPool::GetDefault()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Handle < Program > ProgramHandle ;
+    typedef HandlePool < Program > ProgramPool ;
+    
     ////////////////////////////////////////////////////////////
     /// \brief Defines an interface to manipulate program (a set
     /// of shaders in a particular order).
@@ -58,6 +70,7 @@ namespace atl
         Map < Alias , ConstantParameter* > m_aliases ;    ///< Aliases associated to given parameter.
         Vector < ConstantParameter >       m_parameters ; ///< Parameters for input for this program.
         Shared < VertexLayout >            m_layout ;     ///< Layout used in this program.
+        SharedVector < Shader >            m_shaders ;    ///< Shaders linked in this program.
         mutable Mutex                      m_mutex ;      ///< Acces to data.
         
     public:
@@ -68,10 +81,8 @@ namespace atl
         ////////////////////////////////////////////////////////////
         /// \brief Constructs a program from its shaders.
         ///
-        /// While Program object claim it own the passed shaders, it does
-        /// not guaranty you might be able to retrieve those objects.
-        /// Please keep trace of those shared pointers if you wish to use
-        /// them later.
+        /// The program keeps the given shaders, to link again when one
+        /// of them is outdated (see 'Relink()').
         ///
         ////////////////////////////////////////////////////////////
         Program( const SharedVector < Shader >& shaders );
@@ -94,6 +105,37 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void Prepare( const RenderTarget& target ) const = 0 ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the shaders linked in this program.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual SharedVector < Shader > GetShaders() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if one of the shaders is outdated (its
+        /// file was modified, see 'Shader::WatchFile()').
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsOutdated() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Links the program again with the latest version of its
+        /// shaders.
+        ///
+        /// Outdated shaders are replaced by their replacement if they have
+        /// one, or created again from their file. Then the derived program
+        /// links them with 'DRelink()', and the aliases are restored by
+        /// name. Whether linking succeeds or not, the program does not try
+        /// again before a shader is outdated again.
+        ///
+        /// It is called lazily by the RenderCommandGroup before the
+        /// program is used, thus on the rendering thread.
+        ///
+        /// \return True if the program was linked again.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Relink();
+        
         ////////////////////////////////////////////////////////////
         /// \brief Adds an alias for a given parameter.
         ///
@@ -189,6 +231,13 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual ConstantParameter* GetParameterByName( const String& name );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Finds the parameter with given interned name or
+        /// return null. Names are compared as integers.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ConstantParameter* GetParameterBySymbol( const Symbol& name );
+        
         ////////////////////////////////////////////////////////////
         /// \brief Finds the parameter with given index or return null.
         ///
@@ -207,6 +256,13 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual const ConstantParameter* GetParameterByName( const String& name ) const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Finds the parameter with given interned name or
+        /// return null. Names are compared as integers.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const ConstantParameter* GetParameterBySymbol( const Symbol& name ) const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Finds the parameter with given index or return null.
         ///
@@ -291,6 +347,16 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void BindParameter( const ConstantParameter* parameter , const ParameterValue& value ) const = 0 ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Links the program with given shaders, in place of the
+        /// current ones, and discovers its parameters again.
+        ///
+        /// On failure, the program must stay usable with its previous
+        /// shaders. The default implementation returns false.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DRelink( const SharedVector < Shader >& shaders );
+        
         ////////////////////////////////////////////////////////////
         /// \brief Called by derived class to modify the parameters
         /// in this program.
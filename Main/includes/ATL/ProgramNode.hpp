@@ -66,6 +66,13 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual void Aggregate( AggregatedMaterial& , RenderCommand& ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief References the held program. As a Program has no file,
+        /// it must be restored by 'BinarySceneResolver::program'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const ;
     };
 }
 
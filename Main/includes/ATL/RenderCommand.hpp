@@ -17,6 +17,8 @@
 #include <ATL/VertexCommand.hpp>
 #include <ATL/ParameterGroup.hpp>
 
+#include <functional>
+
 namespace atl
 {
     ////////////////////////////////////////////////////////////
@@ -30,6 +32,17 @@ namespace atl
     ////////////////////////////////////////////////////////////
     typedef unsigned long long RenderCommandId ;
     
+    ////////////////////////////////////////////////////////////
+    class RenderCommand ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Generational handle to a RenderCommand, resolved
+    /// by 'RenderCommandPool::GetDefault()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Handle < RenderCommand > RenderCommandHandle ;
+    typedef HandlePool < RenderCommand > RenderCommandPool ;
+    
     ////////////////////////////////////////////////////////////
     /// \brief Groups VertexCommands for specific user-defined
     /// parameters for the current bound program.
@@ -61,6 +74,7 @@ namespace atl
         Atomic < RenderCommandId >             m_id ;          ///< Local id.
         mutable Mutex                          m_mutex ;       ///< Acces all data.
         SharedVector < VertexCommand >         m_commands ;    ///< VertexCommand in this rendercommand.
+        Vector < VertexCommandHandle >         m_handles ;     ///< Handles to 'm_commands', in the same order.
         Weak < Material >                      m_material ;    ///< Material associated to this render command (optional).
         Weak < Program >                       m_program ;     ///< Program associated to this render command (optional).
         Weak < RenderCommandGroup >            m_parentgroup ; ///< RenderCommandGroup associated to this render command.
@@ -142,6 +156,16 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         virtual SharedVector < VertexCommand > GetVertexCommands() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls 'visitor' with the handle of every vertex
+        /// commands in this rendercommand.
+        ///
+        /// Unlike 'GetVertexCommands()', no Shared pointer is copied.
+        /// This is the function used by 'Context::DrawRenderCommand()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void VisitVertexCommands( const std::function < void( VertexCommandHandle ) >& visitor ) const ;
     };
 }
 
@@ -63,6 +63,7 @@ namespace atl
         SharedVector < RenderQueue > m_dynamicqueues ; ///< Dynamic renderqueues for the pass.
         RenderQueueMap               m_dynaqueuebyid ; ///< Dynamic renderqueues by MaterialId.
         Weak < Program >             m_program ;       ///< Program set to draw the pass.
+        ProgramHandle                m_programhandle ; ///< Handle to 'm_program'.
         mutable Mutex                m_mutex ;         ///< Mutex to access renderqueues arrays.
         
     public:
@@ -85,6 +86,13 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual const Weak < Program > GetProgram() const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the handle to the program, registered in
+        /// 'ProgramPool::GetDefault()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ProgramHandle GetProgramHandle() const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Draw its renderqueues.
         ///
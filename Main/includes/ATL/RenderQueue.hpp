@@ -43,11 +43,17 @@ namespace atl
     /// Weak directive implies that is could be. RenderQueues with an
     /// expired Weak material will be ignored.
     ///
+    /// RenderCommands and the material are registered in their default
+    /// HandlePool, and the queue only stores their handles: drawing
+    /// resolves them without locking any Weak pointer. The queue releases
+    /// its handles when destroyed, so the pools can collect them.
+    ///
     ////////////////////////////////////////////////////////////
     class RenderQueue
     {
         ////////////////////////////////////////////////////////////
-        Weak < Material > m_material ; ///< Material to use to execute the commands.
+        Weak < Material > m_material ;       ///< Material to use to execute the commands.
+        MaterialHandle    m_materialhandle ; ///< Handle to 'm_material'.
         
     public:
         
@@ -63,6 +69,13 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual const Weak < Material > GetMaterial() const ;
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the handle to the material, registered in
+        /// 'MaterialPool::GetDefault()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual MaterialHandle GetMaterialHandle() const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Adds a RenderCommand to this queue.
         ///
@@ -111,8 +124,8 @@ namespace atl
     class StaticRenderQueue : public RenderQueue
     {
         ////////////////////////////////////////////////////////////
-        WeakVector < RenderCommand > m_commands ; ///< Commands for this queue.
-        mutable Mutex                m_mutex ;    ///< Mutex to access the queue.
+        mutable Vector < RenderCommandHandle > m_commands ; ///< Commands for this queue. Dead handles are dropped by 'Draw()'.
+        mutable Mutex                          m_mutex ;    ///< Mutex to access the queue.
         
     public:
         using RenderQueue::RenderQueue ;
@@ -161,18 +174,17 @@ namespace atl
     /// frame. This is a good behaviour for objects that needs constant
     /// or very often updating of their RenderCommands.
     ///
-    /// A list is used for fast insertion, and a spinlock for fast
-    /// locking. However, iterating through the dynamic queue is slower
-    /// than over a static queue. Dynamic queues should be used for
-    /// a less number of RenderCommands but that are updated a lot more
-    /// frequently than a static queue.
+    /// Handles are appended without looking for duplicates, and a
+    /// spinlock is used for fast locking. Dynamic queues should be used
+    /// for a less number of RenderCommands but that are updated a lot
+    /// more frequently than a static queue.
     ///
     ////////////////////////////////////////////////////////////
     class DynamicRenderQueue : public RenderQueue
     {
         ////////////////////////////////////////////////////////////
-        WeakList < RenderCommand > m_commands ; ///< Commands for this queue.
-        mutable Spinlock           m_spinlock ; ///< Spinlock to access the list.
+        mutable Vector < RenderCommandHandle > m_commands ; ///< Commands for this queue. Dead handles are dropped by 'Draw()'.
+        mutable Spinlock                       m_spinlock ; ///< Spinlock to access the handles.
         
     public:
         using RenderQueue::RenderQueue ;
@@ -0,0 +1,196 @@
+//  ========================================================================  //
+//
+//  File    : ATL/RenderSnapshot.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef RenderSnapshot_hpp
+#define RenderSnapshot_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Resource.hpp>
+#include <ATL/RenderCommand.hpp>
+#include <ATL/Program.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    class AggregatedGroup ;
+    class Context ;
+    class RenderTarget ;
+    class Texture ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief One draw extracted from an AggregatedNode.
+    ///
+    /// Everything the render thread needs is copied here, so drawing
+    /// does not read any scene object. 'program', 'vfirst', 'tfirst' and
+    /// 'cfirst' are indexes in the owning RenderSnapshot's arrays.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct RenderSnapshotDraw
+    {
+        glm::mat4         model ;     ///< Model matrix aggregated by PositionNodes.
+        glm::mat4         mvp ;       ///< Model-View-Projection matrix aggregated by PositionNodes.
+        glm::vec4         ambient ;   ///< Ambient color.
+        glm::vec4         diffuse ;   ///< Diffuse color.
+        glm::vec4         specular ;  ///< Specular color.
+        float             shininess ; ///< Shininess.
+        uint32_t          program ;   ///< Index of the program in 'RenderSnapshot::GetPrograms()'.
+        uint32_t          vfirst ;    ///< First VertexCommand in 'RenderSnapshot::GetVertexCommands()'.
+        uint32_t          vcount ;    ///< Number of VertexCommands to draw.
+        uint32_t          tfirst ;    ///< First of the 'RenderSnapshot::TextureCount' textures in 'RenderSnapshot::GetTextures()'.
+        uint32_t          cfirst ;    ///< First of the 'RenderSnapshot::ComponentCount' values in 'RenderSnapshot::GetComponents()'.
+        ResourceId        material ;  ///< Identifier of the aggregated material.
+        RenderCommandId   command ;   ///< Identifier of the source RenderCommand.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Immutable list of draws extracted from the scene at
+    /// the end of an update tick.
+    ///
+    /// A RenderSnapshot is filled by the scene thread with 'Extract()'
+    /// and then only read by the render thread. Draws are sorted by
+    /// program and then by material, to reduce state changes.
+    ///
+    /// Programs, VertexCommands and textures used by the draws are held
+    /// by Shared pointers in the snapshot, so they stay alive while it is
+    /// read even if the scene releases them in the meantime.
+    ///
+    /// VertexCommands outside of the view volume of their draw's MVP
+    /// are culled while extracting, with their bounding sphere (see
+    /// 'VertexCommand::GetBoundingSphere()').
+    ///
+    ////////////////////////////////////////////////////////////
+    class RenderSnapshot
+    {
+        ////////////////////////////////////////////////////////////
+        Vector < RenderSnapshotDraw >  m_draws ;      ///< Draws, sorted by program and material.
+        SharedVector < Program >       m_programs ;   ///< Programs used by the draws.
+        SharedVector < VertexCommand > m_vcommands ;  ///< VertexCommands used by the draws.
+        SharedVector < Texture >       m_textures ;   ///< Textures of the draws' materials, or null.
+        Vector < ParameterValue >      m_components ; ///< Components of the draws' materials.
+        uint64_t                       m_tick ;       ///< Update tick this snapshot was extracted from.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        static const uint32_t TextureCount   = 7 ; ///< Textures per draw: ambient, diffuse, specular and 'MaterialTexture1' to 4.
+        static const uint32_t ComponentCount = 5 ; ///< Components per draw: 'MaterialComponent1' to 5.
+
+        ////////////////////////////////////////////////////////////
+        RenderSnapshot();
+
+        ////////////////////////////////////////////////////////////
+        virtual ~RenderSnapshot();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Replaces the content of this snapshot by the draws
+        /// of the given group (and its slices).
+        ///
+        /// Nodes without a RenderCommand, a Program or a visible
+        /// VertexCommand are skipped. Arrays keep their capacity from
+        /// one extraction to another.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Extract( const AggregatedGroup& group , uint64_t tick );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Draws the snapshot with the given context (render
+        /// thread only).
+        ///
+        /// Each program is prepared once for its draws, then the values
+        /// of each draw are bound to the program before drawing its
+        /// VertexCommands. The context must be active.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Draw( const Context& context , const RenderTarget& target ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Empties the snapshot, keeping its capacity.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Clear();
+
+        ////////////////////////////////////////////////////////////
+        const Vector < RenderSnapshotDraw >& GetDraws() const { return m_draws ; }
+
+        ////////////////////////////////////////////////////////////
+        const SharedVector < Program >& GetPrograms() const { return m_programs ; }
+
+        ////////////////////////////////////////////////////////////
+        const SharedVector < VertexCommand >& GetVertexCommands() const { return m_vcommands ; }
+
+        ////////////////////////////////////////////////////////////
+        const SharedVector < Texture >& GetTextures() const { return m_textures ; }
+
+        ////////////////////////////////////////////////////////////
+        const Vector < ParameterValue >& GetComponents() const { return m_components ; }
+
+        ////////////////////////////////////////////////////////////
+        uint64_t GetTick() const { return m_tick ; }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Exchanges RenderSnapshots between the scene thread
+    /// and the render thread without lock.
+    ///
+    /// The buffer owns three snapshots. The scene thread fills the
+    /// back one with 'GetBack()' and publishes it with 'Publish()'. The
+    /// render thread calls 'Acquire()' at the beginning of a frame, and
+    /// reads the returned snapshot until its next call. Exchanges are
+    /// made with a single atomic index, so neither thread ever waits for
+    /// the other one, and no allocation happens once the snapshots have
+    /// grown to the scene's size.
+    ///
+    /// \note Only one thread may publish and only one thread may acquire.
+    ///
+    ////////////////////////////////////////////////////////////
+    class RenderSnapshotBuffer
+    {
+        ////////////////////////////////////////////////////////////
+        RenderSnapshot     m_snapshots[3] ; ///< Back, middle and front snapshots.
+        uint8_t            m_back ;         ///< Index of the snapshot written by the scene thread.
+        uint8_t            m_front ;        ///< Index of the snapshot read by the render thread.
+        Atomic < uint8_t > m_middle ;       ///< Index of the last published snapshot, with 'FreshBit' if not acquired yet.
+
+        ////////////////////////////////////////////////////////////
+        static const uint8_t FreshBit = 0x4 ;
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        RenderSnapshotBuffer();
+
+        ////////////////////////////////////////////////////////////
+        virtual ~RenderSnapshotBuffer();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the snapshot to fill (scene thread only).
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual RenderSnapshot& GetBack();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Publishes the back snapshot (scene thread only).
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Publish();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the last published snapshot (render thread
+        /// only). If nothing was published since the last call, the same
+        /// snapshot is returned again.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const RenderSnapshot& Acquire();
+    };
+}
+
+#endif /* RenderSnapshot_hpp */
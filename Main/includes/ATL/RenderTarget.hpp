@@ -21,6 +21,8 @@
 
 namespace atl
 {
+    class Scene ;
+    
     ////////////////////////////////////////////////////////////
     /// \brief Defines target locking behaviour when updating objects
     /// groups.
@@ -47,6 +49,10 @@ namespace atl
     /// are created when a VertexCommand is added with a Program that
     /// was not registered with its own Pass already.
     ///
+    /// Scenes added with 'AddScene()' are never read directly: the
+    /// rendertarget draws the last snapshot they published, so the
+    /// update thread can change them while they are drawn.
+    ///
     ////////////////////////////////////////////////////////////
     class RenderTarget : public std::enable_shared_from_this < RenderTarget >
     {
@@ -58,6 +64,7 @@ namespace atl
         SharedVector < RenderCommandGroup > m_rendergroups ; ///< RenderCommand groups.
         mutable Mutex                       m_mutex ;        ///< Used to access passes.
         SharedVector < ObjectGroup >        m_groups ;       ///< Holds every groups related to this rendertarget.
+        WeakVector < Scene >                m_scenes ;       ///< Scenes drawn from their last published snapshot.
         mutable Atomic < bool >             m_updated ;      ///< true when the rendertarget is updated, false when 'Draw()' is called.
         Viewport                            m_viewport ;     ///< Viewport for this RenderTarget. Default is ( 0 , 0 , 0 , 0 ).
         Atomic < TargetLocking >            m_lockupdate ;   ///< Flag to indicate wether 'Begin()' and 'End()' are called between updates,
@@ -148,6 +155,13 @@ namespace atl
         ////////////////////////////////////////////////////////////
         virtual void AddRenderCommandGroup( const Shared < RenderCommandGroup >& group );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds a scene drawn by this target, from the snapshot
+        /// it publishes at the end of each update.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void AddScene( const Weak < Scene >& scene );
+        
         ////////////////////////////////////////////////////////////
         Viewport GetViewport() const ;
         
@@ -113,7 +113,8 @@ namespace atl
         virtual void Flush() const ;
         
         ////////////////////////////////////////////////////////////
-        /// \brief Flush and ProcessEvent of this RenderWindow.
+        /// \brief Flush and ProcessEvent of this RenderWindow, then
+        /// dispatches the completions of every LoadingQueue.
         ///
         ////////////////////////////////////////////////////////////
         virtual void Display();
@@ -121,6 +122,10 @@ namespace atl
         ////////////////////////////////////////////////////////////
         /// \brief Creates a VertexCommand.
         ///
+        /// Vertex and index data are uploaded in ranges of the Context's
+        /// shared buffers ('Context::AllocateVertexRange()'), kept by the
+        /// command until it is destroyed.
+        ///
         /// \param components VertexComponents list used to elaborate
         ///                   Buffer's related VertexComponents for the
         ///                   resulting VertexCommand.
@@ -16,9 +16,14 @@
 #include <ATL/MimeType.hpp>
 #include <ATL/IDGenerator.hpp>
 #include <ATL/CBuffer.hpp>
+#include <ATL/ResourceArgs.hpp>
 
 namespace atl
 {
+    ////////////////////////////////////////////////////////////
+    class ResourceCacheWriter ;
+    class ResourceCacheReader ;
+    
     ////////////////////////////////////////////////////////////
     typedef unsigned long long ResourceId ;
 
@@ -37,28 +42,22 @@ namespace atl
     /// Metaclass creation process (and to simplify Metaclass implementation),
     /// it was decided Resource can implement four constructors:
     /// - Resource( void )
-    /// - Resource( const String& , va_list& )
-    /// - Resource( const CBuffer < char >& , va_list& )
-    /// - Resource( const std::istream& , va_list& )
+    /// - Resource( const String& , const ResourceArgs& )
+    /// - Resource( const CBuffer& , const ResourceArgs& )
+    /// - Resource( std::istream& , const ResourceArgs& )
     ///
     /// Each constructor is optional but at least one of those must be present
-    /// for the metaclass to be usable. 'va_list' holds always the same pattern
-    /// of arguments: a list of void* pointers. When creating the resource using
-    /// the Metaclass subsystem, 'IMetaclass::DCreate()' convert every variadic
-    /// arguments into pointers and that is what is passed to the resource
-    /// constructor. Imagine you use the following:
+    /// for the metaclass to be usable. 'ResourceArgs' holds the extra arguments
+    /// given to 'IMetaclass::Create()', by reference and with their exact type.
+    /// Imagine you use the following:
     ///
-    /// auto myresource = mymeta->Create( 5, "blah", my_shared_class );
+    /// auto myresource = mymeta->Create( file , 5 , String( "blah" ) , my_shared_class );
     ///
-    /// 'va_list' will hold the following objects: 'int*', 'const char**', and
-    /// 'Shared < Class >*'. Think about this when converting those parameters
-    /// by using 'va_arg'. This convertion is needed as C-style variadics needs
-    /// non-POD types (which pointers are all naturally) and C++11 variadic templates
-    /// captures the passed object natural type. Notes also that references are not
-    /// conserved and thus types as 'const String&*' are converted into 'const String*'.
+    /// The constructor gets them with 'args.Get < int >( 0 )', 'args.Take < String >( 1 )'
+    /// (the String is moved as it was given as an rvalue) and
+    /// 'args.Get < Shared < Class > >( 2 )'. Asking an argument with a wrong
+    /// type throws, and the Metaclass returns null.
     ///
-    /// Derived of Resource should use wisely the 'va_list&' argument as it
-    /// may not provide correct arguments or corrupted memories.
     /// Also, notes that default implementation does nothing, as argument
     /// order matter. It is the derived object that should implement those
     /// constructors to manage argument in the order they want to.
@@ -73,6 +72,9 @@ namespace atl
         Atomic < ResourceId > m_id ;       ///< Local resource ID.
         MimeType              m_mimetype ; ///< Mimetype associated to this resource.
         String                m_file ;     ///< File associated to this resource, or empty if it was loaded from a buffer.
+        Shared < Resource >   m_replacement ; ///< Resource reloaded from the same file, or null.
+        Atomic < bool >       m_outdated ; ///< True once the file of this resource was modified.
+        Atomic < uint32_t >   m_holders ;  ///< Number of ResourceHolders registered on this resource.
         mutable Spinlock      m_spinlock ; ///< Access to data. 
         
     public:
@@ -81,13 +83,13 @@ namespace atl
         Resource( void );
         
         ////////////////////////////////////////////////////////////
-        Resource( va_list& args );
+        Resource( const ResourceArgs& args );
         
         ////////////////////////////////////////////////////////////
-        Resource( const String& file , va_list& args );
+        Resource( const String& file , const ResourceArgs& args );
         
         ////////////////////////////////////////////////////////////
-        Resource( const CBuffer& buf , va_list& args );
+        Resource( const CBuffer& buf , const ResourceArgs& args );
         
     protected:
         
@@ -107,6 +109,240 @@ namespace atl
         
         ////////////////////////////////////////////////////////////
         virtual String GetFile() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the memory used by this resource in the main
+        /// memory, in bytes.
+        ///
+        /// Used by Manager to keep its resources within its budget. The
+        /// default implementation returns 0: derived resources holding
+        /// large data should return its size.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetCPUSize() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the memory used by this resource on the GPU,
+        /// in bytes. The default implementation returns 0.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetGPUSize() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Marks this resource as outdated: its file was modified
+        /// since it was loaded. A holder which failed to load the file
+        /// again may clear the mark, until the file is modified again.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void SetOutdated( bool outdated = true );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if this resource was marked outdated or
+        /// replaced.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsOutdated() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Sets the resource reloaded from the same file to
+        /// replace this one, and marks this one outdated.
+        ///
+        /// The replacement is set once the new resource is fully loaded:
+        /// a holder of this resource switches to the new one in one step,
+        /// with 'GetLatest()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void SetReplacement( const Shared < Resource >& replacement );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the resource replacing this one, or null.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Shared < Resource > GetReplacement() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Registers a holder of this resource. A Manager never
+        /// evicts a resource while it has holders.
+        ///
+        /// \see ResourceHolder
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void AddHolder();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Unregisters a holder added with 'AddHolder()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void RemoveHolder();
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of holders registered.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetHolders() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the preprocessed data of this resource, to be
+        /// stored by ResourceCache.
+        ///
+        /// \return False if this resource can't be cached.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool WriteCache( ResourceCacheWriter& writer ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Fills this resource, freshly default constructed, from
+        /// a cache file. On success, the resource takes the file and MIME
+        /// type of the reader.
+        ///
+        ////////////////////////////////////////////////////////////
+        bool ReadCache( const ResourceCacheReader& reader );
+        
+    protected:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds the sections needed to restore this resource.
+        ///
+        /// Data should be written as the resource uses it, so reading it
+        /// back only needs to view the sections. The default implementation
+        /// returns false: the resource is not cached.
+        ///
+        /// Classes implementing it must also declare a static integral
+        /// 's_cacheversion', changed whenever the data written changes:
+        /// Managers don't look for classes without it in the cache.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DWriteCache( ResourceCacheWriter& writer ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Restores the data written by 'DWriteCache()'. Returns
+        /// false if the sections are missing or invalid.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool DReadCache( const ResourceCacheReader& reader );
+    };
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns the last replacement of given resource (see
+    /// 'Resource::SetReplacement()'), or the resource itself if it was
+    /// never replaced.
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class >
+    Shared < Class > GetLatest( Shared < Class > resource )
+    {
+        while ( resource )
+        {
+            auto replacement = resource->GetReplacement();
+            
+            if ( !replacement )
+                break ;
+            
+            resource = std::static_pointer_cast < Class >( replacement );
+        }
+        
+        return resource ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns the last replacement of the resource held by
+    /// 'holder', and moves 'holder' to it.
+    ///
+    /// Holders of resources loaded by a Manager call it each time they
+    /// use the resource, so they follow reloads (see 'Manager::Reload()').
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class >
+    Shared < Class > MoveToLatest( Weak < Class >& holder )
+    {
+        auto resource = holder.lock();
+        auto latest   = GetLatest( resource );
+        
+        if ( latest != resource )
+            holder = latest ;
+        
+        return latest ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Holds a Weak resource and registers itself as one of its
+    /// holders, so a Manager with a budget doesn't evict the resource
+    /// while it is held.
+    ///
+    /// Objects using a resource loaded by a Manager without owning it,
+    /// like scene nodes, should keep it through a ResourceHolder: the
+    /// Manager can't see Weak pointers when it looks for unused
+    /// resources.
+    ///
+    /// \note A ResourceHolder is not thread safe: its owner must
+    /// synchronize 'Set()' with other accesses.
+    ///
+    ////////////////////////////////////////////////////////////
+    template < typename Class >
+    class ResourceHolder
+    {
+        ////////////////////////////////////////////////////////////
+        Weak < Class > m_resource ; ///< Held resource.
+        
+    public:
+        
+        ////////////////////////////////////////////////////////////
+        ResourceHolder( const Weak < Class >& resource = Weak < Class >() )
+        {
+            Set( resource );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        ResourceHolder( const ResourceHolder& rhs )
+        {
+            Set( rhs.m_resource );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        ~ResourceHolder()
+        {
+            Set( Weak < Class >() );
+        }
+        
+        ////////////////////////////////////////////////////////////
+        ResourceHolder& operator = ( const ResourceHolder& rhs )
+        {
+            Set( rhs.m_resource );
+            return *this ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Holds another resource, and unregisters from the
+        /// previous one.
+        ///
+        ////////////////////////////////////////////////////////////
+        void Set( const Weak < Class >& resource )
+        {
+            auto next = resource.lock();
+            auto prev = m_resource.lock();
+            
+            if ( next == prev )
+                return ;
+            
+            if ( next )
+                next->AddHolder();
+            if ( prev )
+                prev->RemoveHolder();
+            
+            m_resource = next ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        Weak < Class > Get() const
+        {
+            return m_resource ;
+        }
+        
+        ////////////////////////////////////////////////////////////
+        Shared < Class > Lock() const
+        {
+            return m_resource.lock();
+        }
     };
 }
 
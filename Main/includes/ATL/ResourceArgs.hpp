@@ -0,0 +1,178 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ResourceArgs.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef ResourceArgs_hpp
+#define ResourceArgs_hpp
+
+#include <ATL/StdIncludes.hpp>
+
+#include <stdexcept>
+#include <typeinfo>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief One argument in a ResourceArgs: the address of the
+    /// caller's object and its type.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ResourceArg
+    {
+        void*                 object ; ///< Address of the caller's object.
+        const std::type_info* type ;   ///< Type of the object, without reference nor cv-qualifier.
+        bool                  rvalue ; ///< True if the caller gave an rvalue: the object can be moved.
+        bool                  cst ;    ///< True if the caller gave a const object.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Makes the argument for given caller's object.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename T >
+        static ResourceArg Make( T&& object )
+        {
+            typedef typename std::remove_reference < T >::type Referenced ;
+            typedef typename std::remove_cv < Referenced >::type Type ;
+
+            return ResourceArg {
+                const_cast < void* >( static_cast < const volatile void* >( std::addressof( object ) ) ) ,
+                &typeid( Type ) ,
+                !std::is_lvalue_reference < T >::value ,
+                std::is_const < Referenced >::value
+            };
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Type-erased pack of the arguments given to
+    /// 'IMetaclass::Create()', passed to the resource's constructor.
+    ///
+    /// The pack only references the caller's objects, which live until
+    /// the constructor returns: nothing is copied to build it. The
+    /// constructor gets each argument by its index, with its exact type:
+    ///
+    /// auto myresource = mymeta->Create( "file" , 5 , String( "blah" ) );
+    ///
+    /// MyResource( const String& file , const ResourceArgs& args )
+    /// {
+    ///     int    count = args.Get < int >( 0 );
+    ///     String name  = args.Take < String >( 1 ); // Moved, the caller gave an rvalue.
+    /// }
+    ///
+    /// Asking an argument with another type than the one given by the
+    /// caller throws std::invalid_argument, which makes the Metaclass
+    /// report an 'Error::MetaclassCreate' and return null.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ResourceArgs
+    {
+        ////////////////////////////////////////////////////////////
+        const ResourceArg* m_args ;  ///< Arguments, owned by the caller.
+        std::size_t        m_count ; ///< Number of arguments.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Constructs an empty pack.
+        ///
+        ////////////////////////////////////////////////////////////
+        ResourceArgs() : m_args( nullptr ) , m_count( 0 ) { }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Constructs a pack over given arguments, which must
+        /// outlive it.
+        ///
+        ////////////////////////////////////////////////////////////
+        ResourceArgs( const ResourceArg* args , std::size_t count ) : m_args( args ) , m_count( count ) { }
+
+        ////////////////////////////////////////////////////////////
+        std::size_t GetCount() const { return m_count ; }
+
+        ////////////////////////////////////////////////////////////
+        bool Empty() const { return !m_count ; }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the argument at 'index' exists and
+        /// is a 'T'.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename T >
+        bool Is( std::size_t index ) const
+        {
+            return index < m_count && *m_args[index].type == typeid( typename std::remove_cv < T >::type );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the argument at 'index', or null if it
+        /// doesn't exist or is not a 'T'.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename T >
+        const T* Find( std::size_t index ) const
+        {
+            if ( !Is < T >( index ) )
+                return nullptr ;
+
+            return static_cast < const T* >( m_args[index].object );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the argument at 'index'.
+        ///
+        /// \throw std::invalid_argument if it doesn't exist or is not
+        /// a 'T'.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename T >
+        const T& Get( std::size_t index ) const
+        {
+            const T* object = Find < T >( index );
+
+            if ( !object )
+                throw std::invalid_argument( "ResourceArgs: argument missing or of wrong type." );
+
+            return *object ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the argument at 'index', moved if the caller
+        /// gave a non-const rvalue and copied otherwise.
+        ///
+        /// \throw std::invalid_argument if it doesn't exist or is not
+        /// a 'T'.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename T >
+        T Take( std::size_t index ) const
+        {
+            const T& object = Get < T >( index );
+
+            if ( m_args[index].rvalue && !m_args[index].cst )
+                return std::move( const_cast < T& >( object ) );
+
+            return object ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the argument at 'index', or 'fallback' if it
+        /// doesn't exist or is not a 'T'.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename T >
+        const T& GetOr( std::size_t index , const T& fallback ) const
+        {
+            const T* object = Find < T >( index );
+            return object ? *object : fallback ;
+        }
+    };
+}
+
+#endif /* ResourceArgs_hpp */
@@ -0,0 +1,298 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ResourceCache.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef ResourceCache_hpp
+#define ResourceCache_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Instanced.hpp>
+#include <ATL/Hash.hpp>
+#include <ATL/CBuffer.hpp>
+#include <ATL/MimeType.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    class Resource ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout of a resource cache file.
+    ///
+    /// A cache file is made of a ResourceCacheHeader followed by an
+    /// array of ResourceCacheSection, then by the sections' data. Each
+    /// section is a blob tagged by a four characters code, and is
+    /// aligned on 'CBufferAlignment' bytes so it can be used in place
+    /// from a memory mapping. Values are stored in the native byte order.
+    ///
+    /// What the sections hold is decided by the resource writing them,
+    /// in 'Resource::DWriteCache()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ResourceCacheHeader
+    {
+        char        magic[4] ;       ///< Always 'ATLC'.
+        uint32_t    version ;        ///< Version of the format, 'ResourceCacheVersion'.
+        ContentHash key ;            ///< Key of the cached resource.
+        uint32_t    sectionscount ;  ///< Number of ResourceCacheSection.
+        uint32_t    reserved ;       ///< Padding, always zero.
+        uint64_t    sectionsoffset ; ///< Offset of the sections array.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief One blob in a resource cache file.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ResourceCacheSection
+    {
+        uint32_t tag ;      ///< Four characters code, see 'ResourceCacheTag()'.
+        uint32_t reserved ; ///< Padding, always zero.
+        uint64_t offset ;   ///< Offset of the data from the start of the file.
+        uint64_t size ;     ///< Size of the data, in bytes.
+        uint64_t padding ;  ///< Padding, always zero.
+    };
+
+    ////////////////////////////////////////////////////////////
+    static_assert( sizeof( ResourceCacheHeader ) == 32 , "ResourceCacheHeader must be 32 bytes." );
+    static_assert( sizeof( ResourceCacheSection ) == 32 , "ResourceCacheSection must be 32 bytes." );
+
+    ////////////////////////////////////////////////////////////
+    static const uint32_t ResourceCacheVersion = 1 ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns the tag of a section from its four characters.
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr uint32_t ResourceCacheTag( char a , char b , char c , char d )
+    {
+        return static_cast < uint32_t >( static_cast < unsigned char >( a ) )
+             | static_cast < uint32_t >( static_cast < unsigned char >( b ) ) << 8
+             | static_cast < uint32_t >( static_cast < unsigned char >( c ) ) << 16
+             | static_cast < uint32_t >( static_cast < unsigned char >( d ) ) << 24 ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collects the sections of a resource and writes them to
+    /// a cache file.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ResourceCacheWriter
+    {
+        ////////////////////////////////////////////////////////////
+        Vector < Pair < uint32_t , CBuffer > > m_sections ; ///< Sections, in the order they were added.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds a section sharing the given buffer's storage.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Add( uint32_t tag , const CBuffer& buffer );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds a section with a copy of the given bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Add( uint32_t tag , const void* data , std::size_t size );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds a section with a copy of the given array.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Record >
+        void AddArray( uint32_t tag , const Vector < Record >& records )
+        {
+            static_assert( std::is_trivially_copyable < Record >::value , "Cached records must be trivially copyable." );
+            Add( tag , records.data() , records.size() * sizeof( Record ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the sections to given file.
+        ///
+        /// The file is written next to its destination, then renamed,
+        /// so a reader never sees a partially written file.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Write( const String& file , ContentHash key ) const ;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Gives access to the sections of a mapped cache file.
+    ///
+    /// Sections are returned as CBuffers viewing the mapping: they
+    /// share it and keep it alive, thus they can be stored directly in
+    /// the resource and no byte is copied.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ResourceCacheReader
+    {
+        ////////////////////////////////////////////////////////////
+        CBuffer                              m_mapping ;  ///< The whole mapped file.
+        const ResourceCacheSection*          m_sections ; ///< Sections array, in 'm_mapping'.
+        uint32_t                             m_count ;    ///< Number of sections.
+        String                               m_file ;     ///< Source file of the cached resource.
+        MimeType                             m_mime ;     ///< MIME type of the source file.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Maps given cache file. 'IsValid()' returns false if
+        /// it can't be mapped, or if its header or its key don't match.
+        ///
+        /// \param cachefile Cache file to read.
+        /// \param key       Key the file must have been written with.
+        /// \param file      Source file of the resource.
+        /// \param mime      MIME type of the source file.
+        ///
+        ////////////////////////////////////////////////////////////
+        ResourceCacheReader( const String& cachefile , ContentHash key , const String& file , const MimeType& mime );
+
+        ////////////////////////////////////////////////////////////
+        virtual ~ResourceCacheReader() { }
+
+        ////////////////////////////////////////////////////////////
+        virtual bool IsValid() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of sections with given tag.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint32_t GetCount( uint32_t tag ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the 'index'-th section with given tag, or an
+        /// empty buffer.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual CBuffer Find( uint32_t tag , uint32_t index = 0 ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the 'index'-th section with given tag as an
+        /// array of records, or null if the section is missing or its
+        /// size is not a multiple of the record's size.
+        ///
+        /// \note The array lives in the mapping: it is valid as long as
+        /// this reader, or a buffer returned by 'Find()', exists.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Record >
+        const Record* FindArray( uint32_t tag , std::size_t& count , uint32_t index = 0 ) const
+        {
+            // Const, so reading the data never copies the mapping.
+            const CBuffer section = Find( tag , index );
+            count = section.GetSize() / sizeof( Record );
+
+            if ( section.Empty() || section.GetSize() % sizeof( Record ) )
+                return nullptr ;
+
+            return reinterpret_cast < const Record* >( section.GetData() );
+        }
+
+        ////////////////////////////////////////////////////////////
+        virtual const String& GetFile() const ;
+
+        ////////////////////////////////////////////////////////////
+        virtual const MimeType& GetMimeType() const ;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A directory of preprocessed resources.
+    ///
+    /// Resources able to save their preprocessed data (see
+    /// 'Resource::DWriteCache()') are stored in one file per resource,
+    /// named after a key. The key hashes the content of the source file
+    /// with the identity and the version of its loader: modifying the
+    /// file or the loader gives a new key, so entries never need to be
+    /// invalidated.
+    ///
+    /// Cache files are read back through a memory mapping, and resources
+    /// keep views on it: a warm start only maps files and never decodes
+    /// them again.
+    ///
+    /// When a ResourceCache is instanced, Manager uses it in 'Create()'
+    /// for files created without extra arguments.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ResourceCache : public Instanced < ResourceCache >
+    {
+        ////////////////////////////////////////////////////////////
+        String              m_directory ; ///< Directory of the cache files.
+        Atomic < uint64_t > m_hits ;      ///< Resources loaded from the cache.
+        Atomic < uint64_t > m_misses ;    ///< Resources not found in the cache.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Uses given directory, created if it doesn't exist.
+        ///
+        ////////////////////////////////////////////////////////////
+        ResourceCache( const String& directory );
+
+        ////////////////////////////////////////////////////////////
+        virtual ~ResourceCache();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the key of a source file for given loader, or
+        /// 0 if the file can't be read.
+        ///
+        /// \param file    Source file, hashed through a memory mapping.
+        /// \param loader  Identifies the loader (its MIME type for example).
+        /// \param version Version of the loader's output. Bump it when the
+        ///                preprocessed data changes.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ContentHash GetKey( const String& file , const String& loader , uint32_t version ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the path of the cache file for given key.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual String GetPath( ContentHash key ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes a resource's preprocessed data.
+        ///
+        /// \return False if the resource can't be cached or the file
+        /// can't be written.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Store( ContentHash key , const Resource& resource );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Fills an empty resource from the cache.
+        ///
+        /// \param key      Key of the resource.
+        /// \param resource Resource to fill, as returned by its default
+        ///                 constructor.
+        /// \param file     Source file of the resource.
+        /// \param mime     MIME type of the source file.
+        ///
+        /// \return False if the key is not in the cache or the resource
+        /// can't read it. The resource must then be discarded.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Load( ContentHash key , Resource& resource , const String& file , const MimeType& mime );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of successful 'Load()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint64_t GetHits() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of failed 'Load()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual uint64_t GetMisses() const ;
+    };
+}
+
+#endif /* ResourceCache_hpp */
@@ -24,6 +24,7 @@
 #include <ATL/MimeDatabase.hpp>
 #include <ATL/MaterialManager.hpp>
 #include <ATL/MeshManager.hpp>
+#include <ATL/ThreadPool.hpp>
 
 namespace atl
 {
@@ -67,6 +68,7 @@ namespace atl
         Shared < Metaclasser >      iMetaclasser ;
         Shared < MaterialManager >  iMaterialManager ;
         Shared < MeshManager >      iMeshManager ;
+        Shared < ThreadPool >       iThreadPool ;   ///< Workers shared by the engine's parallel tasks.
         
     public:
 
@@ -219,6 +221,9 @@ namespace atl
         ////////////////////////////////////////////////////////////
         Weak < MeshManager > GetMeshManager() const ;
         
+        ////////////////////////////////////////////////////////////
+        Weak < ThreadPool > GetThreadPool() const ;
+        
     protected:
         
         ////////////////////////////////////////////////////////////
@@ -13,6 +13,7 @@
 #define Scene_hpp
 
 #include <ATL/StdIncludes.hpp>
+#include <ATL/RenderSnapshot.hpp>
 
 namespace atl
 {
@@ -57,9 +58,12 @@ namespace atl
         ////////////////////////////////////////////////////////////
         Shared < SceneGraph >        m_scenegraph ;    ///< SceneGraph attached to this scene.
         SharedVector < CameraGraph > m_camgraphs ;     ///< CameraGraph(s) attached to this scene.
+        Shared < AggregatedGroup >   m_group ;         ///< Group updated by the SceneGraph at each tick.
         mutable Spinlock             m_spinlock ;      ///< Access to vector.
         std::thread                  m_updthread ;     ///< Thread launched by 'StartAsync'.
         Atomic < bool >              m_stopupdthread ; ///< Flag to stop thread.
+        RenderSnapshotBuffer         m_snapshots ;     ///< Snapshots exchanged with the render thread.
+        uint64_t                     m_tick ;          ///< Number of snapshots published (scene thread only).
         
     public:
         
@@ -148,8 +152,35 @@ namespace atl
 		/// \brief Make a call to 'OnSceneUpdate()' on SceneGraph and 
 		/// auxiliaries CameraGraph.
 		///
+		/// The SceneGraph updates the Scene's AggregatedGroup, which is
+		/// kept from one tick to another.
+		/// The tick ends by publishing a snapshot of it, which is
+		/// what RenderTargets draw (see 'RenderTarget::AddScene()').
+		///
 		////////////////////////////////////////////////////////////
 		virtual void MakeOnSceneUpdate();
+		
+		////////////////////////////////////////////////////////////
+		/// \brief Extracts the draws of the given group into a new
+		/// snapshot and publishes it for the render thread.
+		///
+		/// It must be called by the scene thread, once the update tick
+		/// is finished (i.e. after SCENE-UPDATE and AGGREGATION phases).
+		/// This is the only moment where scene objects are read for the
+		/// render thread.
+		///
+		////////////////////////////////////////////////////////////
+		virtual void PublishSnapshot( const AggregatedGroup& group );
+		
+		////////////////////////////////////////////////////////////
+		/// \brief Returns the last published snapshot.
+		///
+		/// It must be called by the render thread only, once per frame.
+		/// The returned snapshot stays valid and unchanged until the next
+		/// call, and reading it does not take any scene lock.
+		///
+		////////////////////////////////////////////////////////////
+		virtual const RenderSnapshot& AcquireSnapshot();
     };
 }
 
@@ -14,6 +14,7 @@
 
 #include <ATL/StdIncludes.hpp>
 #include <ATL/Resource.hpp>
+#include <ATL/BinaryScene.hpp>
 
 namespace atl
 {
@@ -26,6 +27,7 @@ namespace atl
     class Mesh ;
     class MeshNode ;
     class RenderNode ;
+    class AggregatedGroup ;
     
     ////////////////////////////////////////////////////////////
     /// \brief Interface provided to create and organize different
@@ -46,8 +48,9 @@ namespace atl
     class SceneGraph : public Resource
     {
         ////////////////////////////////////////////////////////////
-        Shared < PositionNode > m_root ;  ///< Root position node in this graph.
-        mutable Mutex           m_mutex ; ///< Mutex to lock when performing some action.
+        Shared < PositionNode >        m_root ;     ///< Root position node in this graph.
+        Vector < BinarySceneResolved > m_resolved ; ///< Resources of the last binary scene loaded, kept alive for its nodes.
+        mutable Mutex                  m_mutex ;    ///< Mutex to lock when performing some action.
         
     public:
         
@@ -96,6 +99,53 @@ namespace atl
         
         ////////////////////////////////////////////////////////////
         virtual Weak < PositionNode > GetRootNode() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Launches the SCENE-UPDATE and AGGREGATION phases of
+        /// this graph into the given group.
+        ///
+        /// The root node is updated with 'Node::UpdateParallel()', so
+        /// each of its children subtrees is updated by a ThreadPool task,
+        /// and the group's slices are then aggregated in parallel with
+        /// 'AggregatedGroup::Aggregation()'.
+        ///
+        /// \param group Group kept by the caller from one update to
+        ///              another, so AggregatedNodes are found back.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void OnSceneUpdate( AggregatedGroup& group );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Replaces the content of this graph by the binary
+        /// scene in the given file.
+        ///
+        /// The file is mapped in memory and nodes are created in one
+        /// pass over its nodes array, by using 'CreatePositionNode()',
+        /// 'CreateProgramNode()', 'CreateMaterialNode()' and
+        /// 'CreateMeshNode()'. References are resolved once before any
+        /// node is created, and the resolved resources are kept by the
+        /// graph until the next load, as nodes only hold weak pointers.
+        ///
+        /// \param file     Binary scene file, as written by 'SaveBinary()'.
+        /// \param resolver Functions used to find back referenced resources.
+        ///
+        /// \return False if the file is invalid. In this case, the graph
+        /// is left untouched and an Error::SceneFile is sent to ErrorCenter.
+        ///
+        /// \see BinarySceneHeader
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool LoadBinary( const String& file , const BinarySceneResolver& resolver = BinarySceneResolver() );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes this graph to the given file in the binary
+        /// scene format.
+        ///
+        /// Each node is written with 'Node::WriteBinaryRecord()'. Resources
+        /// referenced by a file path are hashed from their file's content.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool SaveBinary( const String& file ) const ;
     };
 }
 
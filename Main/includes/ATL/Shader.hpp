@@ -56,21 +56,34 @@ namespace atl
         ///
         /// \param file File to load.
         /// \param args Other arguments following the pattern :
-        ///         - ( Weak < Context > ) the context where you wish the
+        ///         - ( Shared < Context > ) the context where you wish the
         ///           the shader will be loaded (generally given by RenderWindow).
         ///         - ( ShaderParams ) A structure holding some informations
         ///           that may or may not be used depending on implementation.
         ///
-        /// \notes For the implementator: All arguments are passed as pointers.
+        /// \notes For the implementator: use 'args.Find()' for optional
+        /// arguments, as callers may give less of them.
         ///
         ////////////////////////////////////////////////////////////
-        Shader( const String& file , va_list& args );
+        Shader( const String& file , const ResourceArgs& args );
         
         ////////////////////////////////////////////////////////////
         virtual ~Shader();
         
         ////////////////////////////////////////////////////////////
         virtual Stage GetStage() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Watches the file of given shader with the FileWatcher,
+        /// if one is instanced.
+        ///
+        /// When the file is modified, the shader is marked outdated and
+        /// Programs using it relink with a new shader the next time they
+        /// are drawn (see 'Program::Relink()'). The watch stops once the
+        /// shader is destroyed.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void WatchFile( const Shared < Shader >& shader );
     };
 }
 
@@ -0,0 +1,255 @@
+//  ========================================================================  //
+//
+//  File    : ATL/Spinlock.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef Spinlock_hpp
+#define Spinlock_hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ATL/LockProfiler.hpp>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   include <immintrin.h>
+#   define ATL_SPINLOCK_PAUSE() _mm_pause()
+#
+#elif defined(__aarch64__) || defined(__arm__)
+#   define ATL_SPINLOCK_PAUSE() __asm__ __volatile__( "yield" )
+#
+#else
+#   define ATL_SPINLOCK_PAUSE() do { } while ( 0 )
+#
+#endif
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Contention statistics of a Spinlock, as returned by
+    /// 'GetSpinlocksStats()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SpinlockStats
+    {
+        std::string              name ;         ///< Name given to 'Spinlock::EnableStats()'.
+        uint64_t                 acquisitions ; ///< Number of times the lock was taken.
+        uint64_t                 contentions ;  ///< Number of times the lock was already taken.
+        uint64_t                 spins ;        ///< Number of pauses while waiting.
+        uint64_t                 sleeps ;       ///< Number of times a thread slept (or yielded) while waiting.
+        std::chrono::nanoseconds maxwait ;      ///< Longest wait for the lock.
+    };
+
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Counters updated by the Spinlocks enabling statistics
+        /// under the same name.
+        ///
+        /// Counters are shared by name, so they are bounded by the number
+        /// of names and not of locks: they live for the whole process,
+        /// and stats of destroyed locks are kept.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct SpinlockCounters
+        {
+            std::string              name ;         ///< Name of the lock.
+            std::atomic < uint64_t > acquisitions ; ///< See 'SpinlockStats'.
+            std::atomic < uint64_t > contentions ;  ///< See 'SpinlockStats'.
+            std::atomic < uint64_t > spins ;        ///< See 'SpinlockStats'.
+            std::atomic < uint64_t > sleeps ;       ///< See 'SpinlockStats'.
+            std::atomic < uint64_t > maxwait ;      ///< Longest wait, in nanoseconds.
+
+            ////////////////////////////////////////////////////////////
+            SpinlockCounters( const char* n )
+            : name( n ) , acquisitions( 0 ) , contentions( 0 ) , spins( 0 ) , sleeps( 0 ) , maxwait( 0 )
+            {
+
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A test-and-test-and-set lock for short critical
+    /// sections.
+    ///
+    /// An uncontended 'lock()' is a single compare-exchange. When the
+    /// lock is taken, the thread spins on a plain load (so the cache line
+    /// stays shared) with a pause instruction and an exponential backoff.
+    /// After a few rounds the thread stops spinning and sleeps on a futex
+    /// (Linux), or yields (other platforms), so a long critical section
+    /// doesn't burn a whole core per waiting thread.
+    ///
+    /// Statistics can be enabled on a given lock with 'EnableStats()'.
+    /// They cost one relaxed increment per acquisition, and a clock read
+    /// only when the lock was contended. Locks constructed with a name
+    /// enable them when ATL_LOCK_PROFILING is defined.
+    ///
+    ////////////////////////////////////////////////////////////
+    class Spinlock
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief State of the lock: 0 if unlocked, 1 if locked and 2 if
+        /// locked with threads sleeping on it.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::atomic < uint32_t > m_state ;
+
+        ////////////////////////////////////////////////////////////
+        std::atomic < Detail::SpinlockCounters* > m_counters ; ///< Statistics, or null if not enabled.
+
+#   ifdef ATL_LOCK_PROFILING
+        Detail::LockProfile                       m_profile ;  ///< Current owner's site.
+#   endif
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        Spinlock() : m_state( 0 ) , m_counters( nullptr ) { }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Constructs a lock reporting statistics under the given
+        /// name when ATL_LOCK_PROFILING is defined.
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Spinlock( const char* name ) : m_state( 0 ) , m_counters( nullptr )
+        {
+#       ifdef ATL_LOCK_PROFILING
+            EnableStats( name );
+#       else
+            static_cast < void >( name );
+#       endif
+        }
+
+        ////////////////////////////////////////////////////////////
+        Spinlock( const Spinlock& ) = delete ;
+
+        ////////////////////////////////////////////////////////////
+        Spinlock& operator = ( const Spinlock& ) = delete ;
+
+#   ifdef ATL_LOCK_PROFILING
+
+        ////////////////////////////////////////////////////////////
+        void lock( const char* file = ATL_LOCK_SITE_FILE , int line = ATL_LOCK_SITE_LINE )
+        {
+            uint64_t start = Detail::LockProfilerNow();
+            Acquire();
+            m_profile.Acquired( file , line , start );
+        }
+
+        ////////////////////////////////////////////////////////////
+        bool try_lock( const char* file = ATL_LOCK_SITE_FILE , int line = ATL_LOCK_SITE_LINE )
+        {
+            uint64_t start = Detail::LockProfilerNow();
+            if ( !TryAcquire() ) return false ;
+            m_profile.Acquired( file , line , start );
+            return true ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        void unlock() { m_profile.Released(); Release(); }
+
+#   else
+
+        ////////////////////////////////////////////////////////////
+        void lock() { Acquire(); }
+
+        ////////////////////////////////////////////////////////////
+        bool try_lock() { return TryAcquire(); }
+
+        ////////////////////////////////////////////////////////////
+        void unlock() { Release(); }
+
+#   endif
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Starts counting contention statistics for this lock,
+        /// reported by 'GetSpinlocksStats()' under the given name.
+        ///
+        /// Locks enabling statistics under the same name share their
+        /// counters. Calling it again does nothing.
+        ///
+        ////////////////////////////////////////////////////////////
+        void EnableStats( const char* name );
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        void Acquire()
+        {
+            uint32_t expected = 0 ;
+
+            if ( !m_state.compare_exchange_strong( expected , 1 , std::memory_order_acquire , std::memory_order_relaxed ) )
+                LockContended();
+
+            Detail::SpinlockCounters* counters = m_counters.load( std::memory_order_acquire );
+
+            if ( counters )
+                counters->acquisitions.fetch_add( 1 , std::memory_order_relaxed );
+        }
+
+        ////////////////////////////////////////////////////////////
+        bool TryAcquire()
+        {
+            uint32_t expected = 0 ;
+
+            if ( m_state.load( std::memory_order_relaxed ) != 0 ||
+                !m_state.compare_exchange_strong( expected , 1 , std::memory_order_acquire , std::memory_order_relaxed ) )
+                return false ;
+
+            Detail::SpinlockCounters* counters = m_counters.load( std::memory_order_acquire );
+
+            if ( counters )
+                counters->acquisitions.fetch_add( 1 , std::memory_order_relaxed );
+
+            return true ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        void Release()
+        {
+            if ( m_state.exchange( 0 , std::memory_order_release ) == 2 )
+                Wake();
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Spins with backoff, then sleeps until the lock is
+        /// acquired.
+        ///
+        ////////////////////////////////////////////////////////////
+        void LockContended();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Wakes one thread sleeping on this lock.
+        ///
+        ////////////////////////////////////////////////////////////
+        void Wake();
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns the statistics of every Spinlock that enabled
+    /// them, sorted by contentions (most contended first).
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector < SpinlockStats > GetSpinlocksStats();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Writes 'GetSpinlocksStats()' to the given stream, one
+    /// lock per line.
+    ///
+    ////////////////////////////////////////////////////////////
+    void PrintSpinlocksStats( std::ostream& stream );
+}
+
+#endif /* Spinlock_hpp */
@@ -0,0 +1,161 @@
+//  ========================================================================  //
+//
+//  File    : ATL/StaticBatch.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef StaticBatch_hpp
+#define StaticBatch_hpp
+
+#include <ATL/Mesh.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    typedef uint32_t StaticBatchMemberId ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A Mesh made of several static meshes merged together.
+    ///
+    /// Static geometry rendered with the same Program and Material
+    /// generally results in one RenderCommand per MeshNode. A StaticBatch
+    /// merges the vertex and index CBuffers of those meshes, with their
+    /// transformation already applied to positions and normals, so only
+    /// one VertexCommand (thus one RenderCommand) is needed to draw them.
+    /// Use it as any Mesh, by creating one MeshNode for the batch under
+    /// the shared ProgramNode/MaterialNode.
+    ///
+    /// Members must have a compatible layout: same number of vertex
+    /// buffers and same VertexComponents (attribute, type, stride, offset
+    /// and buffer). The merged index buffer is always IndexType::UI32.
+    /// Submeshes of members are not merged.
+    ///
+    /// Rebuild is incremental: changing the transformation of a member
+    /// only rewrites the vertexes and indexes of this member. Adding or
+    /// removing a member, or changing its vertex or index count, merges
+    /// again every buffers.
+    ///
+    ////////////////////////////////////////////////////////////
+    class StaticBatch : public Mesh
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Describes one mesh merged in the batch.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct Member
+        {
+            StaticBatchMemberId id ;        ///< Identifier returned by 'AddMember()'.
+            Shared < Mesh >     mesh ;      ///< Source mesh.
+            glm::mat4           transform ; ///< Transformation applied to the source vertexes.
+            uint32_t            vfirst ;    ///< First vertex of this member in the merged buffers.
+            uint32_t            vcount ;    ///< Number of vertexes of this member.
+            uint32_t            ifirst ;    ///< First index of this member in the merged index buffer.
+            uint32_t            icount ;    ///< Number of indexes of this member.
+            bool                dirty ;     ///< True if the vertexes must be written again.
+        };
+
+        ////////////////////////////////////////////////////////////
+        Vector < Member >          m_members ;   ///< Meshes merged in this batch.
+        Vector < VertexComponent > m_layout ;    ///< Components shared by every members.
+        Vector < std::size_t >     m_layoutbuf ; ///< Index of the vertex buffer used by each component of 'm_layout'.
+        Vector < uintptr_t >       m_strides ;   ///< Size of one vertex in each vertex buffer.
+        SharedVector < CBuffer >   m_merged ;    ///< Merged vertex buffers, one per source buffer.
+        Shared < CBuffer >         m_indexes ;   ///< Merged index buffer.
+        StaticBatchMemberId        m_nextid ;    ///< Next member identifier.
+        bool                       m_relayout ;  ///< True if members were added or removed.
+        mutable Mutex              m_bmutex ;    ///< Access members.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        StaticBatch();
+
+        ////////////////////////////////////////////////////////////
+        virtual ~StaticBatch();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the given mesh can be merged into
+        /// this batch.
+        ///
+        /// An empty batch accepts every mesh with at least one vertex
+        /// buffer and one component.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsCompatible( const Mesh& mesh ) const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds a mesh to the batch.
+        ///
+        /// \return The member's identifier, or 0 if the mesh is not
+        /// compatible with the batch.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual StaticBatchMemberId AddMember( const Shared < Mesh >& mesh , const glm::mat4& transform );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Changes the transformation of a member.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void SetMemberTransform( StaticBatchMemberId id , const glm::mat4& transform );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Marks a member to be written again, when its source
+        /// CBuffers changed. Buffers are merged again if its vertex or
+        /// index count changed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void InvalidateMember( StaticBatchMemberId id );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Removes a member from the batch.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void RemoveMember( StaticBatchMemberId id );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of members.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetMembersCount() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Updates merged buffers.
+        ///
+        /// If members were added or removed, every buffers are merged
+        /// again. Otherwise, only dirty members are written. When
+        /// something changed, the mesh is marked dirty so the next call
+        /// to 'GenVertexCommands()' uploads the merged buffers.
+        ///
+        /// \return True if the merged buffers changed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool Rebuild();
+
+    protected:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Merges every members into new buffers.
+        ///
+        /// \note 'm_bmutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void MergeAll();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copies vertexes and indexes of given member into the
+        /// merged buffers and applies its transformation.
+        ///
+        /// \note 'm_bmutex' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WriteMember( const Member& member );
+    };
+}
+
+#endif /* StaticBatch_hpp */
@@ -23,6 +23,7 @@
 #include <chrono>
 #include <future>
 #include <map>
+#include <unordered_map>
 #include <fstream>
 #include <dirent.h>
 #include <queue>
@@ -35,6 +36,9 @@
 #include <glm/glm.hpp>
 #include <glm/ext.hpp>
 
+#include <ATL/LockProfiler.hpp>
+#include <ATL/Spinlock.hpp>
+
 #define ATL_PLATFORM_UNKNOWN 1
 #define ATL_PLATFORM_DARWIN  1 << 1
 #define ATL_PLATFORM_WINDOWS 1 << 2
@@ -51,6 +55,12 @@
 #
 #endif
 
+// SSE2 is part of every x86-64 processor. Code using it must keep a scalar
+// version for other processors.
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   define ATL_SIMD_SSE2
+#endif
+
 namespace atl
 {
     template < typename Class >
@@ -123,15 +133,30 @@ namespace atl
     template < class Class >
     using Atomic = std::atomic < Class > ;
 
+#ifdef ATL_LOCK_PROFILING
+    
+    template < class Class >
+    using Lock = Detail::ProfiledLock < Class > ;
+    
+#else
+    
     template < class Class >
     using Lock = std::lock_guard < Class > ;
+    
+#endif
 
     template < class Class >
     using Vector = std::vector < Class > ;
 
+    template < class Class >
+    using List = std::list < Class > ;
+
     template < class Key , class Value >
     using Map = std::map < Key , Value > ;
 
+    template < class Key , class Value >
+    using HashMap = std::unordered_map < Key , Value > ;
+
     template < class C1 , class C2 >
     using Pair = std::pair < C1 , C2 > ;
 
@@ -144,20 +169,13 @@ namespace atl
     template < class Class >
     using SharedQueue = Queue < Shared < Class > > ;
 
+#ifdef ATL_LOCK_PROFILING
+    typedef Detail::ProfiledMutex Mutex ;
+#else
     typedef std::mutex Mutex ;
+#endif
     typedef Lock < Mutex > MutexLocker ;
 
-    class Spinlock
-    {
-        std::atomic_flag flag = ATOMIC_FLAG_INIT ;
-
-    public:
-
-        void lock()     { while ( flag.test_and_set( std::memory_order_acquire ) ); }
-        bool try_lock() { return !flag.test_and_set( std::memory_order_acquire ); }
-        void unlock()   { flag.clear( std::memory_order_release ); }
-    };
-
     typedef Lock < Spinlock >               Spinlocker ;
     
     ////////////////////////////////////////////////////////////
@@ -265,21 +283,18 @@ namespace atl
         if ( !ifs ) return String();
         
         String result ;
-        int length = 0 ;
+        std::streamoff length = 0 ;
         
         ifs.seekg( 0 , ifs.end );
         length = ifs.tellg();
         ifs.seekg( 0 , ifs.beg );
         
-        if ( length )
+        // Reads directly into the string, without any temporary buffer.
+        if ( length > 0 )
         {
-            char* buffer = new char [length+1];
-            memset( buffer , 0 , length+1 );
-            ifs.read( buffer , length );
-            
-            result = String( buffer , length );
-            
-            delete[] buffer ;
+            result.resize( static_cast < std::size_t >( length ) );
+            ifs.read( &result[0] , length );
+            result.resize( static_cast < std::size_t >( ifs.gcount() ) );
         }
         
         ifs.close();
@@ -88,7 +88,7 @@ namespace atl
         
         ////////////////////////////////////////////////////////////
         Subtree( const SharedVector < Class >& children = SharedVector < Class >() )
-        : m_parent() , m_children( children )
+        : m_parent() , m_children( children.begin() , children.end() )
         {
             
         }
@@ -126,7 +126,10 @@ namespace atl
             assert( treeptr );
             
             m_children.push_back( treeptr );
-            child->NotifiateParentChanged( this->shared_from_this() );
+            
+            // Called on the Subtree < Class > base: a node may derive from other
+            // subtrees (like Node's one) which have their own notifications.
+            treeptr->NotifiateParentChanged( this->shared_from_this() );
         }
         
         ////////////////////////////////////////////////////////////
@@ -137,7 +140,7 @@ namespace atl
         virtual void RemoveChild( const Shared < Class >& child )
         {
             if ( child )
-                child->NotifiateParentChanged( nullptr );
+                std::static_pointer_cast < Subtree < Class > >( child )->NotifiateParentChanged( nullptr );
         }
         
         ////////////////////////////////////////////////////////////
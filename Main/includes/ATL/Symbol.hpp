@@ -0,0 +1,108 @@
+//  ========================================================================  //
+//
+//  File    : ATL/Symbol.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef Symbol_hpp
+#define Symbol_hpp
+
+#include <ATL/StdIncludes.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an interned string.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef uint32_t SymbolId ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief An interned string.
+    ///
+    /// Every distinct string is stored once in a global table, and a
+    /// Symbol only holds its 32 bits identifier. Comparing two Symbols
+    /// compares their identifiers, and copying a Symbol copies an
+    /// integer. Names used in lookups (parameters, attributes, MIME types,
+    /// materials) should be stored as Symbols.
+    ///
+    /// Looking up the table ('Find()', 'GetString()', or interning an
+    /// already interned string) never takes a lock. Only the first
+    /// interning of a string takes the table's mutex. Interned strings are
+    /// never released.
+    ///
+    /// \note The order of Symbols is the order of their identifiers,
+    /// not the alphabetical order of their strings.
+    ///
+    ////////////////////////////////////////////////////////////
+    class Symbol
+    {
+        ////////////////////////////////////////////////////////////
+        SymbolId m_id ; ///< Identifier of the string.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        static const SymbolId EmptyId   = 0 ;          ///< Identifier of the empty string.
+        static const SymbolId UnknownId = 0xFFFFFFFF ; ///< Identifier returned by 'Find()' for a string never interned.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Constructs the empty Symbol.
+        ///
+        ////////////////////////////////////////////////////////////
+        Symbol() : m_id( EmptyId ) { }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Interns the given string.
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Symbol( const String& string );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Interns the given string.
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Symbol( const char* string );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the Symbol of the given string without
+        /// interning it.
+        ///
+        /// If the string was never interned, the returned Symbol is
+        /// different from every other Symbol: this is the right function
+        /// to look for a name among Symbols.
+        ///
+        ////////////////////////////////////////////////////////////
+        static Symbol Find( const String& string );
+
+        ////////////////////////////////////////////////////////////
+        SymbolId GetId() const { return m_id ; }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned string. The reference is valid
+        /// until the program exits.
+        ///
+        ////////////////////////////////////////////////////////////
+        const String& GetString() const ;
+
+        ////////////////////////////////////////////////////////////
+        bool IsEmpty() const { return m_id == EmptyId ; }
+
+        ////////////////////////////////////////////////////////////
+        bool operator == ( const Symbol& rhs ) const { return m_id == rhs.m_id ; }
+
+        ////////////////////////////////////////////////////////////
+        bool operator != ( const Symbol& rhs ) const { return m_id != rhs.m_id ; }
+
+        ////////////////////////////////////////////////////////////
+        bool operator < ( const Symbol& rhs ) const { return m_id < rhs.m_id ; }
+    };
+}
+
+#endif /* Symbol_hpp */
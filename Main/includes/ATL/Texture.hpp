@@ -23,6 +23,18 @@ namespace atl
         Texture( const Weak < Image > image );
         virtual ~Texture();
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the image of the texture.
+        ///
+        /// Drivers upload every mip level of the image ('Image::GetLevel()').
+        /// Those are generated with the image, by an ImageDecoder for
+        /// example, so creating a texture never filters pixels. Levels of
+        /// compressed formats ('Image::IsCompressedFor()') are uploaded as
+        /// they are, in blocks, and keep their size on the GPU.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual const Weak < Image > GetImage() const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Binds the texture for use.
         ///
@@ -0,0 +1,124 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ThreadPool.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Instanced.hpp>
+
+#include <thread>
+#include <condition_variable>
+#include <functional>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief A fixed set of worker threads shared by the engine.
+    ///
+    /// The ThreadPool is created by Root and registered as the current
+    /// instance, so every subsystem that needs to split its work (scene
+    /// update, aggregation, ...) can retrieve it with 'ThreadPool::Get()'.
+    /// When no pool is instanced, those subsystems must fall back to their
+    /// sequential path.
+    ///
+    /// Tasks are simple callables without arguments. 'Push()' returns a
+    /// future to wait for the task, and 'ParallelFor()' splits a range of
+    /// indexes between the workers and the calling thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ThreadPool : public Instanced < ThreadPool >
+    {
+        ////////////////////////////////////////////////////////////
+        typedef std::function < void() > Task ;
+
+        ////////////////////////////////////////////////////////////
+        Vector < std::thread >    m_workers ;  ///< Worker threads.
+        Queue < Task >            m_tasks ;    ///< Tasks waiting for a worker.
+        mutable Mutex             m_mutex ;    ///< Protects the tasks queue.
+        std::condition_variable   m_cond ;     ///< Wakes up the workers.
+        Atomic < bool >           m_stop ;     ///< True when the pool is being destroyed.
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Creates the pool with the given number of workers.
+        ///
+        /// \param workers Number of threads to launch. If zero, uses
+        ///                'std::thread::hardware_concurrency()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        ThreadPool( std::size_t workers = 0 );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Stops every workers after they finished their current
+        /// task. Pending tasks are still executed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~ThreadPool();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of workers in this pool.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::size_t GetWorkersCount() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the calling thread is one of the
+        /// workers of this pool.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool IsWorkerThread() const ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Pushes a task in the queue and returns a future to
+        /// wait for its result.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Callable >
+        std::future < void > Push( Callable callable )
+        {
+            auto task = std::make_shared < std::packaged_task < void() > >( callable );
+            std::future < void > result = task->get_future();
+
+            Enqueue( [task]() { (*task)(); } );
+            return result ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls 'callable( index )' for every index in [0, count).
+        ///
+        /// The calling thread takes part to the work, so it is safe to
+        /// call this function from a worker thread (nested parallel loops
+        /// never wait for a task that cannot be scheduled). Returns when
+        /// every index has been processed.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void ParallelFor( std::size_t count , const std::function < void( std::size_t ) >& callable );
+
+    protected:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Adds a task to the queue and wakes up one worker.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void Enqueue( Task task );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Loop executed by each worker.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void WorkerLoop();
+    };
+}
+
+#endif /* ThreadPool_hpp */
@@ -15,6 +15,7 @@
 #include <ATL/StdIncludes.hpp>
 #include <ATL/Alias.hpp>
 #include <ATL/ParameterValue.hpp>
+#include <ATL/Symbol.hpp>
 
 namespace atl
 {
@@ -27,17 +28,16 @@ namespace atl
     ///
     /// As Program uses ConstantParameters to store its own parameters,
     /// when binding a parameter, the program looks for its own parameter
-    /// to bind it with this parameter's value. Getting alias and index
-    /// is a lock-free operation (using atomic's operations) and thus is
-    /// faster than getting the parameter's name, that require a spinlock
-    /// locking.
+    /// to bind it with this parameter's value. Getting alias, index and
+    /// name is a lock-free operation (using atomic's operations), as the
+    /// name is stored as an interned Symbol.
     ///
     ////////////////////////////////////////////////////////////
     class VaryingParameter
     {
         ////////////////////////////////////////////////////////////
         Atomic < Alias >   m_alias ;    ///< Alias for this parameter.
-        String             m_name ;     ///< Name of this parameter.
+        Atomic < Symbol >  m_name ;     ///< Name of this parameter.
         Atomic < int32_t > m_index ;    ///< Index of this parameter.
         ParameterValue     m_value ;    ///< Value of this parameter.
         mutable Spinlock   m_spinlock ; ///< Spinlock to access data.
@@ -60,7 +60,13 @@ namespace atl
         ParameterValue GetValue() const ;
         
         ////////////////////////////////////////////////////////////
-        String GetName() const ;
+        const String& GetName() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned name of this parameter.
+        ///
+        ////////////////////////////////////////////////////////////
+        Symbol GetSymbol() const ;
         
         ////////////////////////////////////////////////////////////
         int32_t GetIndex() const ;
@@ -13,6 +13,7 @@
 #define VertexAttrib_hpp
 
 #include <ATL/StdIncludes.hpp>
+#include <ATL/Symbol.hpp>
 
 namespace atl
 {
@@ -32,8 +33,7 @@ namespace atl
         Atomic < uint32_t > m_type ;     ///< [Optional] Represents the VertexComponent type expected for this slot. A Program
                                          ///  object can perform an optional type check when binding a VertexComponent to this
                                          ///  attribute by using this type.
-        String              m_name ;     ///< Name given for this attribute.
-        mutable Spinlock    m_spinlock ; ///< Spinlock used to access data.
+        Symbol              m_name ;     ///< Name given for this attribute.
         
     public:
         
@@ -53,7 +53,13 @@ namespace atl
         uint32_t GetType() const ;
         
         ////////////////////////////////////////////////////////////
-        String GetName() const ;
+        const String& GetName() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned name of this attribute.
+        ///
+        ////////////////////////////////////////////////////////////
+        const Symbol& GetSymbol() const ;
     };
 }
 
@@ -14,9 +14,12 @@
 
 #include <ATL/StdIncludes.hpp>
 #include <ATL/IDGenerator.hpp>
+#include <ATL/Handle.hpp>
 #include <ATL/Buffer.hpp>
+#include <ATL/BufferArena.hpp>
 #include <ATL/IndexType.hpp>
 #include <ATL/VertexComponent.hpp>
+#include <ATL/VertexFormat.hpp>
 
 namespace atl
 {
@@ -29,6 +32,17 @@ namespace atl
     ////////////////////////////////////////////////////////////
     typedef unsigned long long VertexCommandId ;
     
+    ////////////////////////////////////////////////////////////
+    class VertexCommand ;
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Generational handle to a VertexCommand, resolved
+    /// by 'VertexCommandPool::GetDefault()'.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Handle < VertexCommand > VertexCommandHandle ;
+    typedef HandlePool < VertexCommand > VertexCommandPool ;
+    
     ////////////////////////////////////////////////////////////
     /// \brief Simple structure to describe how a batch of vertexs
     /// should be drawed by a driver.
@@ -52,6 +66,18 @@ namespace atl
     /// be lock-free. Furthermore, as a VertexCommand might have more
     /// than one buffer, a spinlock is used to access the vector.
     ///
+    /// \note Components are described by an interned VertexFormat,
+    /// updated each time components change, and their buffers are
+    /// stored once per slot. Drivers should read 'GetVertexFormat()' and
+    /// 'GetVertexBuffers()' instead of copying the components.
+    ///
+    /// \note Buffers may be ranges of buffers shared with other commands
+    /// (see 'Context::AllocateVertexRange()'). The offset of each slot's
+    /// range is returned by 'GetVertexBuffers()', and the format's offsets
+    /// are relative to it: commands with the same layout still share the
+    /// same VertexFormat. The command holds its ranges ('AddBufferRange()'),
+    /// which are given back to their arena when it is destroyed.
+    ///
     /// \note VertexCommand owns its buffers. As VertexCommands are
     /// created with a RenderWindow but by, for example, a Mesh, the
     /// VertexCommand holds the created renderwindow's specific buffers
@@ -69,10 +95,16 @@ namespace atl
         ////////////////////////////////////////////////////////////
         Atomic < VertexCommandId > m_id ;       ///< Local identifier.
         Vector < VertexComponent > m_comps ;    ///< VertexComponents for this command.
+        Atomic < const VertexFormat* > m_format ; ///< Interned format of 'm_comps'.
+        SharedVector < Buffer >    m_buffers ;  ///< Buffers of 'm_comps', by slot of 'm_format'.
+        Vector < std::size_t >     m_offsets ;  ///< Offset of each slot's range in its buffer.
+        SharedVector < BufferRange > m_ranges ; ///< Ranges of shared buffers used by this command.
         Atomic < uint32_t >        m_count ;    ///< Number of Vertexes to draw. 
         Atomic < uint32_t >        m_icount ;   ///< Number of indexes (optional).
         Atomic < IndexType >       m_itype ;    ///< Type of indexes (optional).
         Shared < Buffer >          m_ibuffer ;  ///< Index buffer (optional).
+        Atomic < std::size_t >     m_ioffset ;  ///< Offset of the indexes in 'm_ibuffer', in bytes.
+        glm::vec4                  m_sphere ;   ///< Bounding sphere of the vertexes (center, radius), or a negative radius if unknown.
         mutable Spinlock           m_spinlock ; ///< Access to vector of vertex components.
         mutable void*              m_ctxtdata ; ///< External data allocated by the Context with a VertexCommandVisitor.
                                                 ///  VertexCommand's data are specific from the Context it is used with.
@@ -133,6 +165,36 @@ namespace atl
         ////////////////////////////////////////////////////////////
         void AddVertexComponent( const VertexComponent& component );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned format of the vertex components,
+        /// or null if there is no component.
+        ///
+        ////////////////////////////////////////////////////////////
+        const VertexFormat* GetVertexFormat() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the buffer of each format's slot in 'buffers'.
+        ///
+        /// No reference count is modified: pointers are valid while the
+        /// components of this command are not changed.
+        ///
+        /// \return The number of slots written (at most 'max').
+        ///
+        ////////////////////////////////////////////////////////////
+        uint32_t GetVertexBuffers( Buffer** buffers , uint32_t max ) const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes the buffer of each format's slot in 'buffers',
+        /// and the offset of its range in 'offsets'.
+        ///
+        /// The first element of an attribute is at the offset of its
+        /// slot plus the attribute's offset.
+        ///
+        /// \return The number of slots written (at most 'max').
+        ///
+        ////////////////////////////////////////////////////////////
+        uint32_t GetVertexBuffers( Buffer** buffers , std::size_t* offsets , uint32_t max ) const ;
+        
         ////////////////////////////////////////////////////////////
         /// \brief Return the number of indexes.
         ///
@@ -169,6 +231,49 @@ namespace atl
         ////////////////////////////////////////////////////////////
         void SetIndexType( IndexType type );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Return the offset of the first index in the index
+        /// buffer, in bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t GetIndexOffset() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Change the offset of the first index.
+        ///
+        ////////////////////////////////////////////////////////////
+        void SetIndexOffset( std::size_t offset );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Keeps a range of a shared buffer until this command
+        /// is destroyed.
+        ///
+        ////////////////////////////////////////////////////////////
+        void AddBufferRange( const Shared < BufferRange >& range );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Return the ranges kept by this command.
+        ///
+        ////////////////////////////////////////////////////////////
+        SharedVector < BufferRange > GetBufferRanges() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the bounding sphere of the vertexes in model
+        /// space: xyz is its center and w its radius.
+        ///
+        /// A negative radius means the bounds are unknown, and the
+        /// command is never culled.
+        ///
+        ////////////////////////////////////////////////////////////
+        glm::vec4 GetBoundingSphere() const ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Changes the bounding sphere. It is generally set by
+        /// the Mesh which generated this command.
+        ///
+        ////////////////////////////////////////////////////////////
+        void SetBoundingSphere( const glm::vec4& sphere );
+        
         ////////////////////////////////////////////////////////////
         /// \brief Accepts the Context's created visitor to read/write
         /// 'm_ctxtdata' field.
@@ -178,6 +283,17 @@ namespace atl
         ///
         ////////////////////////////////////////////////////////////
         void AcceptVisitor( VertexCommandVisitor& visitor ) const ;
+        
+    private:
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Interns the format of 'm_comps' and fills 'm_buffers'
+        /// and 'm_offsets'.
+        ///
+        /// \note 'm_spinlock' must be locked.
+        ///
+        ////////////////////////////////////////////////////////////
+        void UpdateFormat();
     };
 }
 
@@ -37,6 +37,11 @@ namespace atl
     /// This also implies the VertexComponent in the VertexCommand holds its
     /// own Buffers, but never own the CBuffers related to it.
     ///
+    /// A VertexComponent is a plain value: it is not meant to be shared
+    /// between threads while modified. VertexCommands describe their
+    /// components with an interned VertexFormat, which is what drivers
+    /// read when drawing.
+    ///
     ////////////////////////////////////////////////////////////
     class VertexComponent
     {
@@ -66,6 +71,17 @@ namespace atl
             R32G32B32Sint ,
             R32G32B32A32Sint ,
             
+            R16G16Float ,
+            R16G16B16A16Float ,
+            
+            R8G8B8A8Unorm ,
+            R16G16Unorm ,
+            R16G16Snorm ,
+            R16G16B16A16Snorm ,
+            
+            R10G10B10A2Unorm ,
+            R10G10B10A2Snorm ,
+            
             Position4           = R32G32B32A32Float ,
             Position3           = R32G32B32Float ,
             Normal4             = R32G32B32A32Float ,
@@ -74,7 +90,14 @@ namespace atl
             Bitangent3          = R32G32B32Float ,
             Bitangent4          = R32G32B32A32Float ,
             Color3              = R32G32B32Float ,
-            Color4              = R32G32B32A32Float 
+            Color4              = R32G32B32A32Float ,
+            
+            Position4Half       = R16G16B16A16Float ,
+            NormalPacked        = R10G10B10A2Snorm ,
+            Texture2Half        = R16G16Float ,
+            Texture2Unorm       = R16G16Unorm ,
+            BitangentPacked     = R10G10B10A2Snorm ,
+            Color4Unorm         = R8G8B8A8Unorm 
         };
         
         ////////////////////////////////////////////////////////////
@@ -84,16 +107,40 @@ namespace atl
         ////////////////////////////////////////////////////////////
         static size_t GetElementCountFor( uint32_t type );
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Return the size in bytes of one vertex's data for
+        /// the given component type, or 0 if the type is unknown.
+        ///
+        ////////////////////////////////////////////////////////////
+        static size_t GetSizeFor( uint32_t type );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Return true if the given component type holds
+        /// normalized integers, which the program reads as floats in
+        /// [0, 1] (Unorm) or [-1, 1] (Snorm).
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool IsNormalizedFor( uint32_t type );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Return true if the program reads the given component
+        /// type as floats: 32 or 16 bits floats, and normalized types.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool IsFloatFor( uint32_t type );
+        
     private:
         
         ////////////////////////////////////////////////////////////
-        Atomic < Attribute > m_attrib ;  ///< Attribute linked for this component.
-        Atomic < uint32_t >  m_type ;    ///< Type from above enumeration.
-        Atomic < size_t >    m_elcount ; ///< Number of elements in the component. This parameter is deduced from
+        Attribute            m_attrib ;  ///< Attribute linked for this component.
+        uint32_t             m_type ;    ///< Type from above enumeration.
+        size_t               m_elcount ; ///< Number of elements in the component. This parameter is deduced from
                                          ///  the static 'GetElementCountFor()' function.
-        Atomic < uintptr_t > m_stride ;  ///< Stride between two elements (size of the Vertex structure).
-        Atomic < uintptr_t > m_offset ;  ///< Offset pointing to the begining of the elements.
+        uintptr_t            m_stride ;  ///< Stride between two elements (size of the Vertex structure).
+        uintptr_t            m_offset ;  ///< Offset pointing to the begining of the elements.
         Shared < Buffer >    m_buffer ;  ///< Buffer associated to this component. (in VertexCommand)
+        uintptr_t            m_boffset ; ///< Offset of the component's data in 'm_buffer', when it is a range
+                                         ///  of a shared buffer. 'm_offset' stays relative to this offset.
         Weak < CBuffer >     m_cbuffer ; ///< CBuffer associated to this component. (in Mesh or any not used by VertexCommand)
         
     public:
@@ -136,7 +183,21 @@ namespace atl
         const Weak < Buffer > GetBuffer() const ;
         
         ////////////////////////////////////////////////////////////
-        void SetBuffer( const Shared < Buffer >& buffer );
+        /// \brief Changes the buffer of this component.
+        ///
+        /// \param buffer Buffer holding the component's data.
+        /// \param offset Offset of the component's range in 'buffer',
+        ///               when suballocated (see BufferArena).
+        ///
+        ////////////////////////////////////////////////////////////
+        void SetBuffer( const Shared < Buffer >& buffer , uintptr_t offset = 0 );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the offset of the component's range in its
+        /// buffer. The first element is at 'GetBufferOffset() + GetOffset()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        uintptr_t GetBufferOffset() const ;
         
         ////////////////////////////////////////////////////////////
         const Weak < CBuffer > GetCBuffer() const ;
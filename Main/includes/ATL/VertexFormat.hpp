@@ -0,0 +1,136 @@
+//  ========================================================================  //
+//
+//  File    : ATL/VertexFormat.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef VertexFormat_hpp
+#define VertexFormat_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/Attribute.hpp>
+#include <ATL/Hash.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    class VertexComponent ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an interned VertexFormat. 0 is never
+    /// used.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef uint32_t VertexFormatId ;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Describes one attribute of a VertexFormat.
+    ///
+    /// This is a POD with no padding, so an array of attributes can be
+    /// hashed and compared as raw bytes.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct VertexAttribFormat
+    {
+        Attribute attrib ; ///< Attribute linked to this component.
+        uint32_t  type ;   ///< Type from 'VertexComponent' enumeration.
+        uint32_t  stride ; ///< Stride between two elements.
+        uint32_t  offset ; ///< Offset of the first element in the buffer.
+        uint32_t  slot ;   ///< Index of the buffer in the VertexCommand's buffers.
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Immutable and interned layout of a VertexCommand.
+    ///
+    /// Two VertexCommands with the same components layout share the
+    /// same VertexFormat object, so formats can be compared by pointer or
+    /// by identifier. Formats are created by 'Intern()' and never
+    /// destroyed: a program only uses a few distinct formats.
+    ///
+    /// Reading a VertexFormat never needs any lock, as it is never
+    /// modified once interned.
+    ///
+    ////////////////////////////////////////////////////////////
+    class VertexFormat
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        static const uint32_t MaxSlots = 16 ; ///< Maximum number of buffers (and attributes) in a format.
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        VertexFormatId                m_id ;      ///< Identifier of this format.
+        ContentHash                   m_hash ;    ///< Hash of 'm_attribs'.
+        Vector < VertexAttribFormat > m_attribs ; ///< Attributes of this format.
+        uint32_t                      m_slots ;   ///< Number of buffers used by this format.
+
+        ////////////////////////////////////////////////////////////
+        VertexFormat( VertexFormatId id , ContentHash hash , const VertexAttribFormat* attribs , std::size_t count );
+
+    public:
+
+        ////////////////////////////////////////////////////////////
+        VertexFormat( const VertexFormat& ) = delete ;
+
+        ////////////////////////////////////////////////////////////
+        VertexFormat& operator = ( const VertexFormat& ) = delete ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the unique format with given attributes,
+        /// creating it if needed.
+        ///
+        /// \return Null if 'count' is 0, or if an attribute uses a slot
+        /// greater than or equal to 'MaxSlots'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const VertexFormat* Intern( const VertexAttribFormat* attribs , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the unique format for given components.
+        ///
+        /// \param components Components to describe.
+        /// \param slots      Buffer's slot of each component. Must have
+        ///                   the same size as 'components'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const VertexFormat* Intern( const Vector < VertexComponent >& components , const Vector < uint32_t >& slots );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the format with given identifier, or null.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const VertexFormat* Get( VertexFormatId id );
+
+        ////////////////////////////////////////////////////////////
+        VertexFormatId GetId() const { return m_id ; }
+
+        ////////////////////////////////////////////////////////////
+        ContentHash GetHash() const { return m_hash ; }
+
+        ////////////////////////////////////////////////////////////
+        std::size_t GetAttribsCount() const { return m_attribs.size(); }
+
+        ////////////////////////////////////////////////////////////
+        const VertexAttribFormat* GetAttribs() const { return m_attribs.data(); }
+
+        ////////////////////////////////////////////////////////////
+        const VertexAttribFormat& operator [] ( std::size_t index ) const { return m_attribs[index] ; }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of buffers used by this format
+        /// (greatest slot plus one).
+        ///
+        ////////////////////////////////////////////////////////////
+        uint32_t GetSlotsCount() const { return m_slots ; }
+    };
+}
+
+#endif /* VertexFormat_hpp */
@@ -0,0 +1,120 @@
+//  ========================================================================  //
+//
+//  File    : ATL/VertexQuantizer.hpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#ifndef VertexQuantizer_hpp
+#define VertexQuantizer_hpp
+
+#include <ATL/StdIncludes.hpp>
+#include <ATL/VertexComponent.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Converts vertex data between 32 bits floats and the
+    /// compact VertexComponent types.
+    ///
+    /// Half floats, normalized 8/16 bits integers and 10-10-10-2 packed
+    /// integers are read as floats by programs: converting a mesh's
+    /// streams at import divides their size by 2 to 4, without changing
+    /// its shaders.
+    ///
+    /// Stream converters use SSE2 when available (see 'ATL_SIMD_SSE2'),
+    /// and give the same results as their scalar version: values are
+    /// clamped to the type's range (NaN gives its lowest value), and
+    /// rounding is to the nearest even.
+    ///
+    ////////////////////////////////////////////////////////////
+    class VertexQuantizer
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts a float to a half float.
+        ///
+        ////////////////////////////////////////////////////////////
+        static uint16_t FloatToHalf( float value );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts a half float to a float.
+        ///
+        ////////////////////////////////////////////////////////////
+        static float HalfToFloat( uint16_t value );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts 'count' floats to half floats.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ToHalf( const float* src , uint16_t* dst , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts 'count' floats to 8 bits unsigned normalized
+        /// integers: [0, 1] to [0, 255].
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ToUnorm8( const float* src , uint8_t* dst , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts 'count' floats to 16 bits unsigned normalized
+        /// integers: [0, 1] to [0, 65535].
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ToUnorm16( const float* src , uint16_t* dst , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts 'count' floats to 16 bits signed normalized
+        /// integers: [-1, 1] to [-32767, 32767].
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ToSnorm16( const float* src , int16_t* dst , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Packs 'count' vectors of 4 floats in 10-10-10-2
+        /// unsigned normalized integers, x in the lowest bits.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ToUnorm1010102( const float* src , uint32_t* dst , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Packs 'count' vectors of 4 floats in 10-10-10-2
+        /// signed normalized integers, x in the lowest bits.
+        ///
+        /// This is the usual format for normals and tangents: x, y and
+        /// z get a 1/511 precision, and w is -1, 0 or 1.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ToSnorm1010102( const float* src , uint32_t* dst , std::size_t count );
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts 'count' vertexes of a component to another
+        /// type.
+        ///
+        /// Both types must be read as floats (see 'VertexComponent::IsFloatFor()').
+        /// Elements missing in 'srctype' take their default value, as
+        /// in programs: (0, 0, 0, 1). Only the bytes of the component
+        /// are written: other components of an interleaved stream are
+        /// kept.
+        ///
+        /// \param srcstride Bytes between two source vertexes, or 0 if
+        ///                  they are tightly packed.
+        /// \param dststride Bytes between two destination vertexes, or
+        ///                  0 if they are tightly packed.
+        ///
+        /// \return False if a type can't be converted.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool Convert( const void* src , std::size_t srcstride , uint32_t srctype ,
+                             void* dst , std::size_t dststride , uint32_t dsttype ,
+                             std::size_t count );
+    };
+}
+
+#endif /* VertexQuantizer_hpp */
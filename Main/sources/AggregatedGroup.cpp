@@ -10,6 +10,7 @@
 //
 //  ========================================================================  //
 #include <ATL/AggregatedGroup.hpp>
+#include <ATL/ThreadPool.hpp>
 
 namespace atl
 {
@@ -59,6 +60,117 @@ namespace atl
         return Weak < AggregatedNode >();
     }
 
+    ////////////////////////////////////////////////////////////
+    Shared < AggregatedGroup > AggregatedGroup::GetSlice( std::size_t index )
+    {
+        MutexLocker lck( m_mutex );
+        
+        while ( m_slices.size() <= index )
+        {
+            auto slice = std::make_shared < AggregatedGroup >();
+            assert( slice && "Can't allocate AggregatedGroup slice." );
+            m_slices.push_back( slice );
+        }
+        
+        return m_slices[index] ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void AggregatedGroup::ResizeSlices( std::size_t count )
+    {
+        SharedVector < AggregatedGroup > removed ;
+        
+        {
+            MutexLocker lck( m_mutex );
+            
+            if ( m_slices.size() > count )
+            {
+                removed.assign( m_slices.begin() + count , m_slices.end() );
+                m_slices.resize( count );
+            }
+        }
+        
+        // 'removed' is destroyed here, outside of our mutex: AggregatedNodes held
+        // by those slices may notifiate them while they are destroyed.
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t AggregatedGroup::GetSlicesCount() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_slices.size();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    SharedVector < AggregatedNode > AggregatedGroup::GetNodes() const
+    {
+        SharedVector < AggregatedNode > result ;
+        SharedVector < AggregatedGroup > slices ;
+        
+        {
+            MutexLocker lck( m_mutex );
+            result.reserve( m_nodes.size() );
+            
+            for ( auto const& wnode : m_nodes )
+            {
+                auto node = wnode.lock();
+                if ( node ) result.push_back( node );
+            }
+            
+            slices = m_slices ;
+        }
+        
+        for ( auto const& slice : slices )
+        {
+            assert( slice );
+            auto nodes = slice->GetNodes();
+            result.insert( result.end() , nodes.begin() , nodes.end() );
+        }
+        
+        return result ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void AggregatedGroup::Aggregation() const
+    {
+        SharedVector < AggregatedNode > nodes ;
+        SharedVector < AggregatedGroup > slices ;
+        
+        {
+            MutexLocker lck( m_mutex );
+            
+            for ( auto const& wnode : m_nodes )
+            {
+                auto node = wnode.lock();
+                if ( node ) nodes.push_back( node );
+            }
+            
+            slices = m_slices ;
+        }
+        
+        for ( auto const& node : nodes )
+            node->Aggregation();
+        
+        auto pool = ThreadPool::Get();
+        
+        if ( pool && slices.size() > 1 )
+        {
+            pool->ParallelFor( slices.size() , [&slices]( std::size_t i ) {
+                assert( slices[i] );
+                slices[i]->Aggregation();
+            });
+        }
+        
+        else
+        {
+            for ( auto const& slice : slices )
+            {
+                assert( slice );
+                slice->Aggregation();
+            }
+        }
+    }
+    
     ////////////////////////////////////////////////////////////
     void AggregatedGroup::NotifiateNodeDestroyed( const Shared < AggregatedNode >& node )
     {
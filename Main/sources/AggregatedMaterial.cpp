@@ -13,6 +13,39 @@
 
 namespace atl
 {
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if the alias is a matrix, and sets
+        /// 'identity' to its identity.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool AggregatedMaterialIdentity( Alias alias , ParameterValue& identity )
+        {
+            switch ( alias )
+            {
+                case Alias::MatrixView:
+                case Alias::MatrixProjection:
+                case Alias::MatrixModel:
+                case Alias::MatrixViewProjection:
+                case Alias::MatrixMVP:
+                    identity = ParameterValue( glm::mat4( 1.0f ) );
+                    return true ;
+                    
+                case Alias::Matrix3View:
+                case Alias::Matrix3Projection:
+                case Alias::Matrix3Model:
+                case Alias::Matrix3ViewProjection:
+                case Alias::Matrix3MVP:
+                    identity = ParameterValue( glm::mat3( 1.0f ) );
+                    return true ;
+                    
+                default:
+                    return false ;
+            }
+        }
+    }
+    
     ////////////////////////////////////////////////////////////
     AggregatedMaterial::AggregatedMaterial()
     {
@@ -133,6 +166,15 @@ namespace atl
     void AggregatedMaterial::SetCustom( Alias alias , const ParameterValue& texture )
     {
         MutexLocker lck( m_mutex );
+        ParameterValue identity ;
+        
+        // Matrices are composed by every PositionNode, so they are always written.
+        if ( Detail::AggregatedMaterialIdentity( alias , identity ) )
+        {
+            m_matrices[ alias ] = texture ;
+            return ;
+        }
+        
         auto state = m_states.find( alias );
         
         if ( state == m_states.end() || !(state->second) )
@@ -171,6 +213,19 @@ namespace atl
         }
     }
     
+    ////////////////////////////////////////////////////////////
+    const ParameterValue AggregatedMaterial::GetCustom( Alias alias ) const
+    {
+        ParameterValue identity ;
+        
+        if ( !Detail::AggregatedMaterialIdentity( alias , identity ) )
+            return Material::GetCustom( alias );
+        
+        MutexLocker lck( m_mutex );
+        auto it = m_matrices.find( alias );
+        return it != m_matrices.end() ? it->second : identity ;
+    }
+    
     ////////////////////////////////////////////////////////////
     void AggregatedMaterial::ResetAllStates() const
     {
@@ -182,5 +237,8 @@ namespace atl
         
         for ( auto& it : m_states )
         it.second = false ;
+        
+        for ( auto& it : m_matrices )
+        Detail::AggregatedMaterialIdentity( it.first , it.second );
     }
 }
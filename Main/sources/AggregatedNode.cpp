@@ -22,6 +22,7 @@ namespace atl
     , m_material( material.lock() )
     , m_command( command )
     , m_lsnodes( lsnodes )
+    , m_spinlock( "AggregatedNode" )
     {
         
     }
@@ -85,6 +86,9 @@ namespace atl
         AggregatedMaterial& material = const_cast < AggregatedMaterial& >( *(m_material.get()) );
         RenderCommand& command       = const_cast < RenderCommand& >( *(m_command.get()) );
         
+        // Nodes set what they hold again, from the nearest to the farthest.
+        material.ResetAllStates();
+        
         for ( auto it = m_lsnodes.begin() ; it != m_lsnodes.end() ; it++ )
         {
             auto node = it->second ;
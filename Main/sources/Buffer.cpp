@@ -17,7 +17,7 @@ namespace atl
     IDGenerator < BufferId > Buffer::s_generator ;
     
     ////////////////////////////////////////////////////////////
-    Buffer::Buffer() : m_id( s_generator.New() )
+    Buffer::Buffer( std::size_t size ) : m_id( s_generator.New() ) , m_size( size )
     {
         
     }
@@ -27,4 +27,10 @@ namespace atl
     {
         
     }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t Buffer::GetSize() const
+    {
+        return m_size.load();
+    }
 }
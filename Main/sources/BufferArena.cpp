@@ -0,0 +1,203 @@
+//  ========================================================================  //
+//
+//  File    : ATL/BufferArena.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/BufferArena.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    BufferRange::BufferRange( const Shared < Buffer >& buffer , std::size_t offset , std::size_t size , const Weak < BufferArena >& arena )
+    : m_buffer( buffer ) , m_offset( offset ) , m_size( size ) , m_arena( arena )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    BufferRange::~BufferRange()
+    {
+        auto arena = m_arena.lock();
+
+        if ( arena )
+            arena->Release( m_buffer.get() , m_offset , m_size );
+    }
+
+    ////////////////////////////////////////////////////////////
+    const Shared < Buffer >& BufferRange::GetBuffer() const
+    {
+        return m_buffer ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t BufferRange::GetOffset() const
+    {
+        return m_offset ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t BufferRange::GetSize() const
+    {
+        return m_size ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    BufferArena::BufferArena( const BufferArenaFactory& factory , std::size_t pagesize , std::size_t alignment )
+    : m_factory( factory ) , m_pagesize( pagesize ) , m_alignment( alignment )
+    {
+        assert( m_factory && "'factory' is null." );
+        assert( alignment && !( alignment & ( alignment - 1 ) ) && "'alignment' must be a power of two." );
+    }
+
+    ////////////////////////////////////////////////////////////
+    BufferArena::~BufferArena()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    Shared < BufferRange > BufferArena::Allocate( const void* data , std::size_t size )
+    {
+        if ( !size )
+            return nullptr ;
+
+        // Ranges are rounded up too, so free ranges always start aligned.
+        std::size_t aligned = ( size + m_alignment - 1 ) & ~( m_alignment - 1 );
+        Shared < Buffer > buffer ;
+        std::size_t offset = 0 ;
+
+        {
+            MutexLocker lck( m_mutex );
+
+            for ( auto& page : m_pages )
+            {
+                if ( pTake( page , aligned , offset ) )
+                {
+                    buffer = page.buffer ;
+                    break ;
+                }
+            }
+
+            if ( !buffer )
+            {
+                Page page ;
+                page.size   = std::max( m_pagesize , aligned );
+                page.used   = 0 ;
+                page.buffer = m_factory( page.size );
+
+                if ( !page.buffer )
+                    return nullptr ;
+
+                page.free[0] = page.size ;
+                pTake( page , aligned , offset );
+
+                buffer = page.buffer ;
+                m_pages.push_back( std::move( page ) );
+            }
+        }
+
+        auto range = std::make_shared < BufferRange >( buffer , offset , aligned , shared_from_this() );
+
+        // Written out of the lock: uploading may be slow, and ranges never overlap.
+        if ( data && !buffer->Write( offset , data , size ) )
+            return nullptr ;
+
+        return range ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t BufferArena::GetPagesCount() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_pages.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t BufferArena::GetUsedSize() const
+    {
+        MutexLocker lck( m_mutex );
+        std::size_t size = 0 ;
+
+        for ( auto const& page : m_pages )
+            size += page.used ;
+
+        return size ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t BufferArena::GetReservedSize() const
+    {
+        MutexLocker lck( m_mutex );
+        std::size_t size = 0 ;
+
+        for ( auto const& page : m_pages )
+            size += page.size ;
+
+        return size ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void BufferArena::Release( const Buffer* buffer , std::size_t offset , std::size_t size )
+    {
+        MutexLocker lck( m_mutex );
+
+        auto page = std::find_if( m_pages.begin() , m_pages.end() , [buffer]( const Page& page ){ return page.buffer.get() == buffer ; } );
+        if ( page == m_pages.end() )
+            return ;
+
+        page->used -= size ;
+
+        auto& free = page->free ;
+        auto next = free.lower_bound( offset );
+
+        // Merges with the following free range.
+        if ( next != free.end() && offset + size == next->first )
+        {
+            size += next->second ;
+            next = free.erase( next );
+        }
+
+        // Merges with the preceding free range.
+        if ( next != free.begin() )
+        {
+            auto previous = std::prev( next );
+
+            if ( previous->first + previous->second == offset )
+            {
+                previous->second += size ;
+                return ;
+            }
+        }
+
+        free.insert( next , std::make_pair( offset , size ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool BufferArena::pTake( Page& page , std::size_t size , std::size_t& offset )
+    {
+        for ( auto it = page.free.begin() ; it != page.free.end() ; ++it )
+        {
+            if ( it->second < size )
+                continue ;
+
+            offset = it->first ;
+            std::size_t remaining = it->second - size ;
+            auto next = page.free.erase( it );
+
+            if ( remaining )
+                page.free.insert( next , std::make_pair( offset + size , remaining ) );
+
+            page.used += size ;
+            return true ;
+        }
+
+        return false ;
+    }
+}
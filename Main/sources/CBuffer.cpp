@@ -10,139 +10,269 @@
 
 namespace atl
 {
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Allocates 'size' bytes aligned on 'alignment' bytes
+        /// (a power of two). The original pointer is stored just before
+        /// the returned one, for 'CBufferAlignedFree()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void* CBufferAlignedAlloc( size_t size , size_t alignment )
+        {
+            assert( alignment && !( alignment & ( alignment - 1 ) ) && "'alignment' must be a power of two." );
+            alignment = std::max( alignment , sizeof( void* ) );
+
+            void* raw = malloc( size + alignment + sizeof( void* ) );
+            assert( raw && "Can't allocate data." );
+
+            uintptr_t aligned = ( reinterpret_cast < uintptr_t >( raw ) + sizeof( void* ) + alignment - 1 ) & ~( alignment - 1 );
+            reinterpret_cast < void** >( aligned )[-1] = raw ;
+            return reinterpret_cast < void* >( aligned );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static void CBufferAlignedFree( void* data )
+        {
+            if ( data )
+                free( static_cast < void** >( data )[-1] );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static Shared < CBufferStorage > CBufferNewStorage( void* data , size_t size , const CBufferDeleter& deleter , bool readonly )
+        {
+            auto storage = std::make_shared < CBufferStorage >();
+            assert( storage && "Can't allocate storage." );
+
+            storage->data     = data ;
+            storage->size     = size ;
+            storage->deleter  = deleter ;
+            storage->readonly = readonly ;
+            return storage ;
+        }
+    }
+
     ////////////////////////////////////////////////////////////
     CBuffer::CBuffer()
     {
         iBufSize = 0 ;
         iBufData = nullptr ;
     }
-    
+
     ////////////////////////////////////////////////////////////
     CBuffer::CBuffer( const CBuffer & rhs )
     {
+        iStorage = rhs.iStorage ;
         iBufSize = rhs.iBufSize ;
-        iBufData = nullptr ;
-        
-        if ( iBufSize )
-        {
-            iBufData = malloc( iBufSize );
-            assert( iBufData && "Can't allocate data." );
-            
-            memcpy( iBufData , rhs.iBufData , iBufSize );
-        }
+        iBufData = rhs.iBufData ;
     }
-    
+
     ////////////////////////////////////////////////////////////
     CBuffer::CBuffer( CBuffer&& rhs )
     {
+        iStorage = std::move( rhs.iStorage );
         iBufSize = rhs.iBufSize ;
         iBufData = rhs.iBufData ;
-        
+
         rhs.iBufSize = 0 ;
         rhs.iBufData = nullptr ;
     }
-    
+
     ////////////////////////////////////////////////////////////
-    CBuffer::CBuffer( const void* rd , size_t rs )
+    CBuffer::CBuffer( const void* rd , size_t rs , size_t alignment )
     {
-        iBufSize = rs ;
+        iBufSize = 0 ;
         iBufData = nullptr ;
-        
-        if ( iBufSize )
+
+        if ( rs )
         {
-            iBufData = malloc( iBufSize );
-            assert( iBufData && "Can't allocate data." );
-            
+            *this = Allocate( rs , alignment );
             memcpy( iBufData , rd , iBufSize );
         }
     }
-    
+
     ////////////////////////////////////////////////////////////
     CBuffer::~CBuffer()
     {
-        if ( iBufSize )
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    CBuffer CBuffer::Allocate( size_t size , size_t alignment )
+    {
+        if ( !size )
+            return CBuffer();
+
+        void* data = Detail::CBufferAlignedAlloc( size , alignment );
+        return Adopt( data , size , &Detail::CBufferAlignedFree );
+    }
+
+    ////////////////////////////////////////////////////////////
+    CBuffer CBuffer::Adopt( void* data , size_t size , const CBufferDeleter& deleter , bool readonly )
+    {
+        CBuffer result ;
+
+        if ( !size )
         {
-            assert( iBufData && "Invalid buffer." );
-            free( iBufData );
+            if ( deleter && data )
+                deleter( data );
+            return result ;
         }
+
+        assert( data && "Invalid buffer." );
+        result.iStorage = Detail::CBufferNewStorage( data , size , deleter , readonly );
+        result.iBufSize = size ;
+        result.iBufData = data ;
+        return result ;
     }
-    
+
+    ////////////////////////////////////////////////////////////
+    CBuffer CBuffer::MapFile( const String& file , MappedFile::Access access )
+    {
+        auto mapped = std::make_shared < MappedFile >( file , access );
+
+        if ( !mapped->IsValid() )
+            return CBuffer();
+
+        // The deleter holds the mapping, which is released with the last view.
+        void* data = const_cast < char* >( mapped->GetData() );
+        return Adopt( data , mapped->GetSize() , [mapped]( void* ) { } , true );
+    }
+
     ////////////////////////////////////////////////////////////
     void CBuffer::Swap( CBuffer& rhs )
     {
+        std::swap( iStorage , rhs.iStorage );
         std::swap( iBufSize , rhs.iBufSize );
         std::swap( iBufData , rhs.iBufData );
     }
-    
+
     ////////////////////////////////////////////////////////////
     void CBuffer::Set( const CBuffer& rhs )
     {
-        Clear();
-        
+        if ( this == &rhs )
+            return ;
+
+        iStorage = rhs.iStorage ;
         iBufSize = rhs.iBufSize ;
-        iBufData = nullptr ;
-        
-        if ( iBufSize )
-        {
-            iBufData = malloc( iBufSize );
-            assert( iBufData && "Can't allocate data." );
-            
-            memcpy( iBufData , rhs.iBufData , iBufSize );
-        }
+        iBufData = rhs.iBufData ;
     }
-    
+
     ////////////////////////////////////////////////////////////
     void CBuffer::Clear()
     {
-        if ( iBufSize )
-        {
-            assert( iBufData && "Invalid buffer." );
-            free( iBufData );
-        }
-        
+        iStorage.reset();
         iBufSize = 0 ;
         iBufData = nullptr ;
     }
-    
+
     ////////////////////////////////////////////////////////////
     void CBuffer::Assign( void* data , size_t sz )
     {
-        Clear();
-        iBufSize = sz ;
-        iBufData = data ;
+        *this = Adopt( data , sz , &free );
     }
-    
+
     ////////////////////////////////////////////////////////////
-    void* CBuffer::GetData() { return iBufData ; }
-    
+    CBuffer CBuffer::View( size_t offset , size_t size ) const
+    {
+        assert( offset + size <= iBufSize && "View out of the buffer's range." );
+
+        CBuffer result ;
+
+        if ( size )
+        {
+            result.iStorage = iStorage ;
+            result.iBufSize = size ;
+            result.iBufData = static_cast < char* >( iBufData ) + offset ;
+        }
+
+        return result ;
+    }
+
     ////////////////////////////////////////////////////////////
-    const void* CBuffer::GetData() const { return iBufData ; }
-    
+    CBuffer CBuffer::Copy( size_t alignment ) const
+    {
+        return CBuffer( iBufData , iBufSize , alignment );
+    }
+
     ////////////////////////////////////////////////////////////
-    char* CBuffer::begin() { return static_cast < char* >( iBufData ); }
-    
+    bool CBuffer::IsShared() const
+    {
+        return iStorage && iStorage.use_count() > 1 ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void CBuffer::MakeUnique()
+    {
+        if ( !iStorage )
+            return ;
+
+        if ( iStorage.use_count() > 1 || iStorage->readonly )
+        {
+            *this = Copy();
+            return ;
+        }
+
+        // We are the only owner: no other buffer can share the storage again
+        // without going through this one. The count is read relaxed, so order
+        // our writes after the reads done by the last buffer that released it
+        // on another thread.
+        std::atomic_thread_fence( std::memory_order_acquire );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void* CBuffer::GetMutableData() { MakeUnique(); return iBufData ; }
+
+    ////////////////////////////////////////////////////////////
+    const void* CBuffer::GetData() const { return iBufData ; }
+
     ////////////////////////////////////////////////////////////
     const char* CBuffer::begin() const { return static_cast < const char* >( iBufData ); }
-    
+
     ////////////////////////////////////////////////////////////
     const char* CBuffer::end() const { return static_cast < const char* >( iBufData ) + iBufSize ; }
-    
+
     ////////////////////////////////////////////////////////////
     size_t CBuffer::GetSize() const { return iBufSize ; }
-    
+
     ////////////////////////////////////////////////////////////
     bool CBuffer::Empty() const { return iBufSize == 0 ; }
-    
+
     ////////////////////////////////////////////////////////////
     CBuffer& CBuffer::operator = ( const CBuffer& rhs )
     {
         Set( rhs );
         return *this ;
     }
-    
+
     ////////////////////////////////////////////////////////////
-    bool CBuffer::operator == ( const CBuffer& rhs ) const { return iBufData == rhs.iBufData ; }
-    
+    CBuffer& CBuffer::operator = ( CBuffer&& rhs )
+    {
+        if ( this != &rhs )
+        {
+            iStorage = std::move( rhs.iStorage );
+            iBufSize = rhs.iBufSize ;
+            iBufData = rhs.iBufData ;
+
+            rhs.iBufSize = 0 ;
+            rhs.iBufData = nullptr ;
+        }
+
+        return *this ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool CBuffer::operator == ( const CBuffer& rhs ) const
+    {
+        if ( iBufSize != rhs.iBufSize )
+            return false ;
+
+        if ( iBufData == rhs.iBufData || !iBufSize )
+            return true ;
+
+        return memcmp( iBufData , rhs.iBufData , iBufSize ) == 0 ;
+    }
+
     ////////////////////////////////////////////////////////////
-    bool CBuffer::operator != ( const CBuffer& rhs ) const { return iBufData != rhs.iBufData ; }
+    bool CBuffer::operator != ( const CBuffer& rhs ) const { return !( *this == rhs ); }
 }
@@ -54,6 +54,12 @@ namespace atl
     
     ////////////////////////////////////////////////////////////
     const String& ConstantParameter::GetName() const
+    {
+        return m_name.GetString();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const Symbol& ConstantParameter::GetSymbol() const
     {
         return m_name ;
     }
@@ -85,7 +91,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void ConstantParameter::SetName( const String& name )
     {
-        m_name = name ;
+        m_name = Symbol( name );
     }
     
     ////////////////////////////////////////////////////////////
@@ -12,30 +12,91 @@
 #include <ATL/Context.hpp>
 #include <ATL/RenderCommand.hpp>
 #include <ATL/Program.hpp>
+#include <ATL/Material.hpp>
 
 namespace atl
 {
+    ////////////////////////////////////////////////////////////
+    Atomic < uint32_t > Context::s_contexts( 0 );
+    
     ////////////////////////////////////////////////////////////
     Context::Context()
     {
-
+        s_contexts++ ;
+        
+        // Pages are only created when allocating, once the derived
+        // context is fully constructed.
+        m_varena = std::make_shared < BufferArena >( [this]( std::size_t size ) {
+            return CreateVertexBuffer( nullptr , size ).lock();
+        });
+        
+        m_iarena = std::make_shared < BufferArena >( [this]( std::size_t size ) {
+            return CreateIndexBuffer( nullptr , size ).lock();
+        });
     }
 
     ////////////////////////////////////////////////////////////
     Context::~Context()
     {
-        
+        s_contexts-- ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Shared < BufferRange > Context::AllocateVertexRange( const void* data , const size_t sz )
+    {
+        return m_varena->Allocate( data , sz );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Shared < BufferRange > Context::AllocateIndexRange( const void* data , const size_t sz )
+    {
+        return m_iarena->Allocate( data , sz );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const Shared < BufferArena >& Context::GetVertexArena() const
+    {
+        return m_varena ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const Shared < BufferArena >& Context::GetIndexArena() const
+    {
+        return m_iarena ;
     }
     
     ////////////////////////////////////////////////////////////
     void Context::DrawRenderCommand( const Weak < RenderCommand >& command , const Program& program ) const
     {
         assert( !command.expired() && "'command' expired." );
-        auto vertexcommands = command.lock()->GetVertexCommands();
+        DrawRenderCommand( *command.lock() , program );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Context::DrawRenderCommand( const RenderCommand& command , const Program& program ) const
+    {
+        const VertexCommandPool& pool = VertexCommandPool::GetDefault();
         
-        for ( auto const& vcommand : vertexcommands )
+        command.VisitVertexCommands( [this , &pool , &program]( VertexCommandHandle handle )
         {
-            DrawVertexCommand( vcommand , program );
-        }
+            auto vcommand = pool.Resolve( handle );
+            
+            if ( vcommand )
+                DrawVertexCommand( vcommand , program );
+        });
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Context::ClearHandlePools()
+    {
+        if ( s_contexts.load() > 1 )
+            return ;
+        
+        // RenderCommands release their VertexCommands when destroyed, so they
+        // are cleared first.
+        RenderCommandPool::GetDefault().Clear();
+        VertexCommandPool::GetDefault().Clear();
+        MaterialPool::GetDefault().Clear();
+        ProgramPool::GetDefault().Clear();
     }
 }
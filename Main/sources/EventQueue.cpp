@@ -22,7 +22,7 @@ namespace atl
         return *iMainQueue ;
     }
 
-    EventQueue::EventQueue() : iRunning( false )
+    EventQueue::EventQueue() : iSpinlock( "EventQueue" ) , iRunning( false )
     {
 
     }
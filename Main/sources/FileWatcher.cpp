@@ -0,0 +1,382 @@
+//  ========================================================================  //
+//
+//  File    : ATL/FileWatcher.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/FileWatcher.hpp>
+#include <ATL/Filename.hpp>
+
+#include <algorithm>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if ATL_PLATFORM == ATL_PLATFORM_LINUX
+#   include <sys/inotify.h>
+#   include <poll.h>
+#   include <unistd.h>
+#endif
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the directory of a canonical path, or an
+        /// empty string.
+        ///
+        ////////////////////////////////////////////////////////////
+        static String FileWatcherDirectory( const String& canonical )
+        {
+            std::size_t separator = canonical.find_last_of( "/\\" );
+
+            if ( separator == String::npos )
+                return String();
+
+            return separator ? canonical.substr( 0 , separator ) : canonical.substr( 0 , 1 );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the modification time of a file, or -1.
+        ///
+        ////////////////////////////////////////////////////////////
+        static long long FileWatcherModificationTime( const String& file )
+        {
+            struct stat st ;
+
+            if ( stat( file.c_str() , &st ) != 0 )
+                return -1 ;
+
+            return static_cast < long long >( st.st_mtime );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    FileWatcher::FileWatcher( std::chrono::milliseconds delay )
+    : m_next( 1 ) , m_delay( delay ) , m_stop( false ) , m_fd( -1 )
+    {
+#   if ATL_PLATFORM == ATL_PLATFORM_LINUX
+        m_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+#   endif
+
+        m_thread = std::thread( &FileWatcher::Run , this );
+    }
+
+    ////////////////////////////////////////////////////////////
+    FileWatcher::~FileWatcher()
+    {
+        m_stop.store( true );
+
+        if ( m_thread.joinable() )
+            m_thread.join();
+
+#   if ATL_PLATFORM == ATL_PLATFORM_LINUX
+        if ( m_fd >= 0 )
+            close( m_fd );
+#   endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    FileWatchId FileWatcher::Watch( const String& file , FileWatchCallback callback )
+    {
+        String canonical = Filename( file ).GetCanonicalPath();
+        String directory = Detail::FileWatcherDirectory( canonical );
+
+        if ( directory.empty() || !callback )
+            return 0 ;
+
+        long long mtime = Detail::FileWatcherModificationTime( canonical );
+        MutexLocker lck( m_mutex );
+
+        auto dir = m_dirs.find( directory );
+
+        if ( dir == m_dirs.end() )
+        {
+            if ( !pAddDirectory( directory ) )
+                return 0 ;
+
+            dir = m_dirs.insert( std::make_pair( directory , std::size_t( 0 ) ) ).first ;
+        }
+
+        FileWatchId id = m_next++ ;
+        if ( !m_next ) m_next = 1 ;
+
+        Entry entry ;
+        entry.file     = canonical ;
+        entry.callback = std::move( callback );
+
+        m_watches[id] = std::move( entry );
+        m_byfile[canonical].push_back( id );
+        m_mtimes.insert( std::make_pair( canonical , mtime ) );
+        dir->second++ ;
+
+        return id ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void FileWatcher::Unwatch( FileWatchId watch )
+    {
+        {
+            MutexLocker lck( m_mutex );
+            pRemove( watch );
+        }
+
+        // Waits for the callbacks being called, which may have copied
+        // this watch's callback before it was removed.
+        if ( std::this_thread::get_id() != m_thread.get_id() )
+        {
+            MutexLocker lck( m_dispatch );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t FileWatcher::GetCount() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_watches.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::chrono::milliseconds FileWatcher::GetDelay() const
+    {
+        return m_delay ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void FileWatcher::Run()
+    {
+        typedef std::chrono::steady_clock Clock ;
+
+        Map < String , Clock::time_point > pending ;
+        std::chrono::milliseconds timeout = std::max( std::chrono::milliseconds( 10 ) , m_delay / 2 );
+
+        while ( !m_stop.load() )
+        {
+            Vector < String > modified = Poll( timeout );
+            Clock::time_point now = Clock::now();
+
+            // A file modified again restarts its delay.
+            for ( auto const& file : modified )
+                pending[file] = now ;
+
+            Vector < String > ready ;
+
+            for ( auto it = pending.begin() ; it != pending.end() ; )
+            {
+                if ( now - it->second >= m_delay )
+                {
+                    ready.push_back( it->first );
+                    it = pending.erase( it );
+                }
+
+                else
+                {
+                    ++it ;
+                }
+            }
+
+            if ( !ready.empty() )
+                Dispatch( ready );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void FileWatcher::Dispatch( const Vector < String >& files )
+    {
+        MutexLocker dispatch( m_dispatch );
+
+        for ( auto const& file : files )
+        {
+            Vector < FileWatchId > ids ;
+
+            {
+                MutexLocker lck( m_mutex );
+                auto it = m_byfile.find( file );
+
+                if ( it != m_byfile.end() )
+                    ids = it->second ;
+            }
+
+            for ( FileWatchId id : ids )
+            {
+                FileWatchCallback callback ;
+
+                {
+                    // A previous callback may have removed this watch.
+                    MutexLocker lck( m_mutex );
+                    auto it = m_watches.find( id );
+
+                    if ( it == m_watches.end() )
+                        continue ;
+
+                    callback = it->second.callback ;
+                }
+
+                if ( !callback( file ) )
+                {
+                    MutexLocker lck( m_mutex );
+                    pRemove( id );
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    Vector < String > FileWatcher::Poll( std::chrono::milliseconds timeout )
+    {
+        Vector < String > modified ;
+
+#   if ATL_PLATFORM == ATL_PLATFORM_LINUX
+
+        if ( m_fd < 0 )
+        {
+            std::this_thread::sleep_for( timeout );
+            return modified ;
+        }
+
+        struct pollfd pfd ;
+        pfd.fd      = m_fd ;
+        pfd.events  = POLLIN ;
+        pfd.revents = 0 ;
+
+        if ( poll( &pfd , 1 , static_cast < int >( timeout.count() ) ) <= 0 )
+            return modified ;
+
+        alignas( struct inotify_event ) char buffer[4096] ;
+
+        while ( true )
+        {
+            ssize_t length = read( m_fd , buffer , sizeof( buffer ) );
+
+            if ( length <= 0 )
+                break ;
+
+            MutexLocker lck( m_mutex );
+
+            for ( char* ptr = buffer ; ptr < buffer + length ; )
+            {
+                const struct inotify_event* event = reinterpret_cast < const struct inotify_event* >( ptr );
+                ptr += sizeof( struct inotify_event ) + event->len ;
+
+                if ( !event->len )
+                    continue ;
+
+                auto dir = m_wdtodir.find( event->wd );
+                if ( dir == m_wdtodir.end() )
+                    continue ;
+
+                String file = dir->second == "/" ? "/" + String( event->name ) : dir->second + "/" + String( event->name );
+
+                if ( m_byfile.count( file ) )
+                    modified.push_back( file );
+            }
+        }
+
+#   else
+
+        std::this_thread::sleep_for( timeout );
+
+        Vector < String > files ;
+
+        {
+            MutexLocker lck( m_mutex );
+            files.reserve( m_mtimes.size() );
+
+            for ( auto const& it : m_mtimes )
+                files.push_back( it.first );
+        }
+
+        for ( auto const& file : files )
+        {
+            long long mtime = Detail::FileWatcherModificationTime( file );
+            MutexLocker lck( m_mutex );
+
+            auto it = m_mtimes.find( file );
+            if ( it == m_mtimes.end() || it->second == mtime )
+                continue ;
+
+            it->second = mtime ;
+            modified.push_back( file );
+        }
+
+#   endif
+
+        return modified ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool FileWatcher::pAddDirectory( const String& directory )
+    {
+#   if ATL_PLATFORM == ATL_PLATFORM_LINUX
+
+        if ( m_fd < 0 )
+            return false ;
+
+        int wd = inotify_add_watch( m_fd , directory.c_str() , IN_CLOSE_WRITE | IN_MOVED_TO );
+        if ( wd < 0 )
+            return false ;
+
+        m_wdtodir[wd]        = directory ;
+        m_dirtowd[directory] = wd ;
+
+#   endif
+
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void FileWatcher::pRemoveDirectory( const String& directory )
+    {
+        m_dirs.erase( directory );
+
+#   if ATL_PLATFORM == ATL_PLATFORM_LINUX
+
+        auto it = m_dirtowd.find( directory );
+        if ( it == m_dirtowd.end() )
+            return ;
+
+        inotify_rm_watch( m_fd , it->second );
+        m_wdtodir.erase( it->second );
+        m_dirtowd.erase( it );
+
+#   endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    void FileWatcher::pRemove( FileWatchId watch )
+    {
+        auto it = m_watches.find( watch );
+        if ( it == m_watches.end() )
+            return ;
+
+        const String& file = it->second.file ;
+        auto byfile = m_byfile.find( file );
+
+        if ( byfile != m_byfile.end() )
+        {
+            auto& ids = byfile->second ;
+            ids.erase( std::remove( ids.begin() , ids.end() , watch ) , ids.end() );
+
+            if ( ids.empty() )
+            {
+                m_byfile.erase( byfile );
+                m_mtimes.erase( file );
+            }
+        }
+
+        String directory = Detail::FileWatcherDirectory( file );
+        auto dir = m_dirs.find( directory );
+
+        if ( dir != m_dirs.end() && --dir->second == 0 )
+            pRemoveDirectory( directory );
+
+        m_watches.erase( it );
+    }
+}
@@ -8,6 +8,9 @@
 
 #include <ATL/Filename.hpp>
 
+#include <climits>
+#include <cstdlib>
+
 namespace atl
 {
     Filename::Filename( const String& filepath ) : iFilepath( filepath )
@@ -58,6 +61,22 @@ namespace atl
         return iFilepath ;
     }
     
+    String Filename::GetCanonicalPath() const
+    {
+#       if ATL_PLATFORM == ATL_PLATFORM_WINDOWS
+        char* resolved = _fullpath( nullptr , iFilepath.c_str() , 0 );
+#       else
+        char* resolved = realpath( iFilepath.c_str() , nullptr );
+#       endif
+        
+        if ( !resolved )
+            return iFilepath ;
+        
+        String result( resolved );
+        free( resolved );
+        return result ;
+    }
+    
     void Filename::SetPath( const String& path )
     {
         iFilepath = path ;
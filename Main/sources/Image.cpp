@@ -7,10 +7,417 @@
 //
 
 #include <ATL/Image.hpp>
+#include <ATL/ResourceCache.hpp>
+#include <ATL/ThreadPool.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef ATL_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
 
 namespace atl
 {
-    Image::Image( const Filename& filename ) : iFilename( filename )
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Number of taps of the Kaiser filter, on each axis.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const int ImageKaiserTaps = 6 ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Minimum number of destination pixels to split a
+        /// level between the workers of the ThreadPool.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const std::size_t ImageParallelPixels = 64 * 1024 ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the number of channels of a format, and if
+        /// they are floats.
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t ImageChannelsFor( ImageFormat format , bool& isfloat )
+        {
+            isfloat = format == ImageFormat::R32Float || format == ImageFormat::R32G32B32A32Float ;
+
+            switch( format )
+            {
+                case ImageFormat::R8Unorm:           return 1 ;
+                case ImageFormat::R8G8Unorm:         return 2 ;
+                case ImageFormat::R8G8B8Unorm:       return 3 ;
+                case ImageFormat::R8G8B8A8Unorm:     return 4 ;
+                case ImageFormat::B8G8R8A8Unorm:     return 4 ;
+                case ImageFormat::R32Float:          return 1 ;
+                case ImageFormat::R32G32B32A32Float: return 4 ;
+                default:                             return 0 ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Calls 'func( first , last )' on bands of rows, on the
+        /// ThreadPool if one is instanced and there are enough pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageForRows( uint32_t rows , std::size_t pixels , const std::function < void( uint32_t , uint32_t ) >& func )
+        {
+            auto pool = ThreadPool::Get();
+
+            if ( !pool || pixels < ImageParallelPixels || rows < 2 )
+            {
+                func( 0 , rows );
+                return ;
+            }
+
+            uint32_t bands = static_cast < uint32_t >( std::min < std::size_t >( rows , pool->GetWorkersCount() * 4 ) );
+            uint32_t size  = ( rows + bands - 1 ) / bands ;
+
+            pool->ParallelFor( bands , [&func , size , rows]( std::size_t band ) {
+                uint32_t first = static_cast < uint32_t >( band ) * size ;
+                if ( first < rows ) func( first , std::min( rows , first + size ) );
+            });
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Box filter of 8 bits channels, for destination rows
+        /// [first, last).
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageBoxUnorm8( const unsigned char* src , uint32_t width , uint32_t height , std::size_t channels ,
+                                    unsigned char* dst , uint32_t dstwidth , uint32_t first , uint32_t last )
+        {
+            std::size_t pitch = width * channels ;
+
+            for ( uint32_t y = first ; y < last ; ++y )
+            {
+                const unsigned char* r0 = src + std::min( 2 * y , height - 1 ) * pitch ;
+                const unsigned char* r1 = src + std::min( 2 * y + 1 , height - 1 ) * pitch ;
+                unsigned char* out = dst + y * dstwidth * channels ;
+                uint32_t x = 0 ;
+
+#ifdef ATL_SIMD_SSE2
+                // Two destination pixels from four source pixels of each row.
+                if ( channels == 4 )
+                {
+                    __m128i zero  = _mm_setzero_si128();
+                    __m128i round = _mm_set1_epi16( 2 );
+
+                    for ( ; 2 * x + 3 < width ; x += 2 )
+                    {
+                        __m128i a = _mm_loadu_si128( reinterpret_cast < const __m128i* >( r0 + 2 * x * 4 ) );
+                        __m128i b = _mm_loadu_si128( reinterpret_cast < const __m128i* >( r1 + 2 * x * 4 ) );
+                        __m128i lo = _mm_add_epi16( _mm_unpacklo_epi8( a , zero ) , _mm_unpacklo_epi8( b , zero ) );
+                        __m128i hi = _mm_add_epi16( _mm_unpackhi_epi8( a , zero ) , _mm_unpackhi_epi8( b , zero ) );
+                        __m128i sum = _mm_add_epi16( _mm_unpacklo_epi64( lo , hi ) , _mm_unpackhi_epi64( lo , hi ) );
+                        sum = _mm_srli_epi16( _mm_add_epi16( sum , round ) , 2 );
+                        _mm_storel_epi64( reinterpret_cast < __m128i* >( out + x * 4 ) , _mm_packus_epi16( sum , sum ) );
+                    }
+                }
+#endif
+
+                for ( ; x < dstwidth ; ++x )
+                {
+                    std::size_t x0 = std::min( 2 * x , width - 1 ) * channels ;
+                    std::size_t x1 = std::min( 2 * x + 1 , width - 1 ) * channels ;
+
+                    for ( std::size_t c = 0 ; c < channels ; ++c )
+                        out[x * channels + c] = static_cast < unsigned char >( ( r0[x0 + c] + r0[x1 + c] + r1[x0 + c] + r1[x1 + c] + 2 ) >> 2 );
+                }
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Box filter of float channels, for destination rows
+        /// [first, last).
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageBoxFloat( const float* src , uint32_t width , uint32_t height , std::size_t channels ,
+                                   float* dst , uint32_t dstwidth , uint32_t first , uint32_t last )
+        {
+            std::size_t pitch = width * channels ;
+
+            for ( uint32_t y = first ; y < last ; ++y )
+            {
+                const float* r0 = src + std::min( 2 * y , height - 1 ) * pitch ;
+                const float* r1 = src + std::min( 2 * y + 1 , height - 1 ) * pitch ;
+                float* out = dst + y * dstwidth * channels ;
+
+                for ( uint32_t x = 0 ; x < dstwidth ; ++x )
+                {
+                    std::size_t x0 = std::min( 2 * x , width - 1 ) * channels ;
+                    std::size_t x1 = std::min( 2 * x + 1 , width - 1 ) * channels ;
+
+#ifdef ATL_SIMD_SSE2
+                    if ( channels == 4 )
+                    {
+                        __m128 sum = _mm_add_ps( _mm_add_ps( _mm_loadu_ps( r0 + x0 ) , _mm_loadu_ps( r0 + x1 ) ) ,
+                                                 _mm_add_ps( _mm_loadu_ps( r1 + x0 ) , _mm_loadu_ps( r1 + x1 ) ) );
+                        _mm_storeu_ps( out + x * 4 , _mm_mul_ps( sum , _mm_set1_ps( 0.25f ) ) );
+                        continue ;
+                    }
+#endif
+
+                    for ( std::size_t c = 0 ; c < channels ; ++c )
+                        out[x * channels + c] = ( ( r0[x0 + c] + r0[x1 + c] ) + ( r1[x0 + c] + r1[x1 + c] ) ) * 0.25f ;
+                }
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Zeroth order modified Bessel function of the first
+        /// kind, used by the Kaiser window.
+        ///
+        ////////////////////////////////////////////////////////////
+        static double ImageBesselI0( double x )
+        {
+            double sum  = 1.0 ;
+            double term = 1.0 ;
+
+            for ( int k = 1 ; k < 32 ; ++k )
+            {
+                term *= ( x / ( 2.0 * k ) ) * ( x / ( 2.0 * k ) );
+                sum  += term ;
+
+                if ( term < sum * 1e-12 )
+                    break ;
+            }
+
+            return sum ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the weights of the Kaiser filter for a 2x
+        /// reduction, for source pixels '2x - 2' to '2x + 3'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const float* ImageKaiserWeights()
+        {
+            static const struct Weights
+            {
+                float values[ImageKaiserTaps] ;
+
+                Weights()
+                {
+                    const double pi     = 3.14159265358979323846 ;
+                    const double alpha  = 4.0 ;
+                    const double radius = 1.5 ;
+                    double sum = 0.0 ;
+
+                    for ( int k = 0 ; k < ImageKaiserTaps ; ++k )
+                    {
+                        // Distance to the destination pixel's center, in destination pixels.
+                        double t    = ( k - 2.5 ) / 2.0 ;
+                        double sinc = std::sin( pi * t ) / ( pi * t );
+                        double r    = t / radius ;
+                        double w    = sinc * ImageBesselI0( alpha * std::sqrt( 1.0 - r * r ) ) / ImageBesselI0( alpha );
+
+                        values[k] = static_cast < float >( w );
+                        sum += w ;
+                    }
+
+                    for ( int k = 0 ; k < ImageKaiserTaps ; ++k )
+                        values[k] = static_cast < float >( values[k] / sum );
+                }
+            }
+            weights ;
+
+            return weights.values ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Kaiser filter, done in two passes: columns are reduced
+        /// in a float image, which is then reduced by rows.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageKaiser( const unsigned char* src , uint32_t width , uint32_t height , std::size_t channels , bool isfloat ,
+                                 unsigned char* dst , uint32_t dstwidth , uint32_t dstheight )
+        {
+            const float* weights = ImageKaiserWeights();
+            std::size_t  pitch   = dstwidth * channels ;
+            Vector < float > temp( pitch * height );
+
+            ImageForRows( height , static_cast < std::size_t >( dstwidth ) * height , [&]( uint32_t first , uint32_t last ) {
+                for ( uint32_t y = first ; y < last ; ++y )
+                {
+                    for ( uint32_t x = 0 ; x < dstwidth ; ++x )
+                    {
+                        for ( std::size_t c = 0 ; c < channels ; ++c )
+                        {
+                            float sum = 0.0f ;
+
+                            for ( int k = 0 ; k < ImageKaiserTaps ; ++k )
+                            {
+                                int sx = std::min( std::max( static_cast < int >( 2 * x ) - 2 + k , 0 ) , static_cast < int >( width ) - 1 );
+                                std::size_t index = ( static_cast < std::size_t >( y ) * width + sx ) * channels + c ;
+                                float value = isfloat ? reinterpret_cast < const float* >( src )[index] : src[index] / 255.0f ;
+                                sum += weights[k] * value ;
+                            }
+
+                            temp[y * pitch + x * channels + c] = sum ;
+                        }
+                    }
+                }
+            });
+
+            ImageForRows( dstheight , static_cast < std::size_t >( dstwidth ) * dstheight , [&]( uint32_t first , uint32_t last ) {
+                for ( uint32_t y = first ; y < last ; ++y )
+                {
+                    for ( std::size_t i = 0 ; i < pitch ; ++i )
+                    {
+                        float sum = 0.0f ;
+
+                        for ( int k = 0 ; k < ImageKaiserTaps ; ++k )
+                        {
+                            int sy = std::min( std::max( static_cast < int >( 2 * y ) - 2 + k , 0 ) , static_cast < int >( height ) - 1 );
+                            sum += weights[k] * temp[sy * pitch + i] ;
+                        }
+
+                        // Negative lobes may overshoot: unorm values are clamped.
+                        if ( isfloat )
+                        {
+                            reinterpret_cast < float* >( dst )[y * pitch + i] = sum ;
+                        }
+
+                        else
+                        {
+                            float value = std::min( std::max( sum , 0.0f ) , 1.0f );
+                            dst[y * pitch + i] = static_cast < unsigned char >( value * 255.0f + 0.5f );
+                        }
+                    }
+                }
+            });
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Level 0 of an Image, in a cache file.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct ImageCacheHeader
+        {
+            uint32_t width ;  ///< Width of level 0.
+            uint32_t height ; ///< Height of level 0.
+            uint32_t format ; ///< ImageFormat of the levels.
+            uint32_t levels ; ///< Number of levels.
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Sections of a cached Image. The digit is the version
+        /// of the records.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const uint32_t ImageCachePixels = ResourceCacheTag( 'I' , 'M' , 'G' , '1' );
+        static const uint32_t ImageCacheHeaders = ResourceCacheTag( 'I' , 'M' , 'H' , '1' );
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t Image::GetPixelSizeFor( ImageFormat format )
+    {
+        bool isfloat ;
+        std::size_t channels = Detail::ImageChannelsFor( format , isfloat );
+        return channels * ( isfloat ? 4 : 1 );
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Image::IsCompressedFor( ImageFormat format )
+    {
+        return format == ImageFormat::BC1Unorm || format == ImageFormat::BC3Unorm || format == ImageFormat::BC5Unorm ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t Image::GetLevelSizeFor( ImageFormat format , uint32_t width , uint32_t height )
+    {
+        if ( IsCompressedFor( format ) )
+        {
+            std::size_t blocks = static_cast < std::size_t >( ( width + 3 ) / 4 ) * ( ( height + 3 ) / 4 );
+            return blocks * ( format == ImageFormat::BC1Unorm ? 8 : 16 );
+        }
+
+        return static_cast < std::size_t >( width ) * height * GetPixelSizeFor( format );
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint32_t Image::GetLevelsCountFor( uint32_t width , uint32_t height )
+    {
+        uint32_t levels = 1 ;
+
+        while ( width > 1 || height > 1 )
+        {
+            width  = std::max( 1u , width / 2 );
+            height = std::max( 1u , height / 2 );
+            levels++ ;
+        }
+
+        return levels ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t Image::GetLayoutFor( uint32_t width , uint32_t height , ImageFormat format ,
+                                     uint32_t count , Vector < ImageLevel >& levels )
+    {
+        std::size_t total = 0 ;
+        levels.resize( count );
+
+        for ( uint32_t l = 0 ; l < count ; ++l )
+        {
+            levels[l].width  = l ? std::max( 1u , levels[l - 1].width / 2 ) : width ;
+            levels[l].height = l ? std::max( 1u , levels[l - 1].height / 2 ) : height ;
+            levels[l].offset = total ;
+            levels[l].size   = GetLevelSizeFor( format , levels[l].width , levels[l].height );
+            total += ( levels[l].size + 15 ) & ~static_cast < std::size_t >( 15 );
+        }
+
+        return total ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Image::Downsample( const unsigned char* src , uint32_t width , uint32_t height ,
+                            ImageFormat format , ImageFilter filter , unsigned char* dst )
+    {
+        bool isfloat ;
+        std::size_t channels = Detail::ImageChannelsFor( format , isfloat );
+
+        if ( !channels || !width || !height )
+            return false ;
+
+        uint32_t dstwidth  = std::max( 1u , width / 2 );
+        uint32_t dstheight = std::max( 1u , height / 2 );
+
+        if ( filter == ImageFilter::Kaiser )
+        {
+            Detail::ImageKaiser( src , width , height , channels , isfloat , dst , dstwidth , dstheight );
+            return true ;
+        }
+
+        std::size_t pixels = static_cast < std::size_t >( dstwidth ) * dstheight ;
+
+        Detail::ImageForRows( dstheight , pixels , [&]( uint32_t first , uint32_t last ) {
+            if ( isfloat )
+            {
+                Detail::ImageBoxFloat( reinterpret_cast < const float* >( src ) , width , height , channels ,
+                                       reinterpret_cast < float* >( dst ) , dstwidth , first , last );
+            }
+
+            else
+            {
+                Detail::ImageBoxUnorm8( src , width , height , channels , dst , dstwidth , first , last );
+            }
+        });
+
+        return true ;
+    }
+
+    Image::Image( const Filename& filename )
+    : iFilename( filename ) , iWidth( 0 ) , iHeight( 0 ) , iFormat( ImageFormat::Unknown )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    Image::Image( const Image& image )
+    : Resource( image.GetFile() , image.GetMimeType() ) , iFilename( image.iFilename ) , iBuffer( image.iBuffer ) ,
+      iWidth( image.iWidth ) , iHeight( image.iHeight ) , iFormat( image.iFormat ) , iLevels( image.iLevels )
     {
 
     }
@@ -23,6 +430,10 @@ namespace atl
     void Image::SetBuffer(const CBuffer&buf)
     {
         iBuffer.Set( buf );
+        iWidth  = 0 ;
+        iHeight = 0 ;
+        iFormat = ImageFormat::Unknown ;
+        iLevels.clear();
     }
 
     CBuffer& Image::GetBuffer()
@@ -35,6 +446,99 @@ namespace atl
         return iBuffer ;
     }
 
+    ////////////////////////////////////////////////////////////
+    bool Image::SetPixels( const CBuffer& pixels , uint32_t width , uint32_t height , ImageFormat format , uint32_t levels )
+    {
+        if ( !levels || levels > GetLevelsCountFor( width , height ) )
+            return false ;
+
+        Vector < ImageLevel > layout ;
+        GetLayoutFor( width , height , format , levels , layout );
+
+        // The last level needs no padding.
+        if ( !layout[0].size || pixels.GetSize() < layout.back().offset + layout.back().size )
+            return false ;
+
+        iBuffer.Set( pixels );
+        iWidth  = width ;
+        iHeight = height ;
+        iFormat = format ;
+        iLevels = std::move( layout );
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Image::GenerateMipmaps( ImageFilter filter )
+    {
+        if ( iLevels.empty() || iFormat == ImageFormat::Unknown )
+            return false ;
+
+        uint32_t count = GetLevelsCountFor( iWidth , iHeight );
+
+        if ( iLevels.size() == count )
+            return true ;
+
+        // Blocks can't be filtered: compressed images get their levels
+        // before being compressed.
+        if ( IsCompressedFor( iFormat ) )
+            return false ;
+
+        Vector < ImageLevel > levels ;
+        std::size_t total = GetLayoutFor( iWidth , iHeight , iFormat , count , levels );
+
+        CBuffer buffer = CBuffer::Allocate( total );
+        unsigned char* data = reinterpret_cast < unsigned char* >( buffer.GetMutableData() );
+        memcpy( data , GetLevelData( 0 ) , levels[0].size );
+
+        for ( uint32_t l = 1 ; l < count ; ++l )
+        {
+            const ImageLevel& previous = levels[l - 1] ;
+            Downsample( data + previous.offset , previous.width , previous.height , iFormat , filter , data + levels[l].offset );
+        }
+
+        iBuffer.Set( buffer );
+        iLevels = std::move( levels );
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint32_t Image::GetWidth() const
+    {
+        return iWidth ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint32_t Image::GetHeight() const
+    {
+        return iHeight ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ImageFormat Image::GetFormat() const
+    {
+        return iFormat ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint32_t Image::GetLevelsCount() const
+    {
+        return static_cast < uint32_t >( iLevels.size() );
+    }
+
+    ////////////////////////////////////////////////////////////
+    const ImageLevel& Image::GetLevel( uint32_t level ) const
+    {
+        assert( level < iLevels.size() && "'level' is out of range." );
+        return iLevels[level] ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const unsigned char* Image::GetLevelData( uint32_t level ) const
+    {
+        assert( level < iLevels.size() && "'level' is out of range." );
+        return GetData() + iLevels[level].offset ;
+    }
+
     unsigned char* Image::GetData()
     {
         return (unsigned char*) iBuffer.GetData();
@@ -49,4 +553,55 @@ namespace atl
     {
         return iBuffer.GetSize();
     }
+
+    size_t Image::GetCPUSize() const
+    {
+        return sizeof( Image ) + iBuffer.GetSize() + iLevels.size() * sizeof( ImageLevel );
+    }
+
+    bool Image::DWriteCache( ResourceCacheWriter& writer ) const
+    {
+        if ( iBuffer.Empty() )
+            return false ;
+
+        writer.Add( Detail::ImageCachePixels , iBuffer );
+
+        // Raw pixels set with 'SetBuffer()' have no header.
+        if ( !iLevels.empty() )
+        {
+            Detail::ImageCacheHeader header ;
+            header.width  = iWidth ;
+            header.height = iHeight ;
+            header.format = static_cast < uint32_t >( iFormat );
+            header.levels = static_cast < uint32_t >( iLevels.size() );
+
+            writer.Add( Detail::ImageCacheHeaders , &header , sizeof( Detail::ImageCacheHeader ) );
+        }
+
+        return true ;
+    }
+
+    bool Image::DReadCache( const ResourceCacheReader& reader )
+    {
+        CBuffer pixels = reader.Find( Detail::ImageCachePixels );
+
+        if ( pixels.Empty() )
+            return false ;
+
+        std::size_t count = 0 ;
+        auto header = reader.FindArray < Detail::ImageCacheHeader >( Detail::ImageCacheHeaders , count );
+
+        if ( !header )
+        {
+            SetBuffer( pixels );
+            return true ;
+        }
+
+        ImageFormat format = static_cast < ImageFormat >( header->format );
+
+        if ( count != 1 )
+            return false ;
+
+        return SetPixels( pixels , header->width , header->height , format , header->levels );
+    }
 }
@@ -0,0 +1,734 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ImageCompressor.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/ImageCompressor.hpp>
+#include <ATL/ThreadPool.hpp>
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#ifdef ATL_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Minimum number of blocks to split a level between
+        /// the workers of the ThreadPool.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const std::size_t ImageCompressorParallelBlocks = 1024 ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Weight of the first endpoint for each index of a BC1
+        /// block, in the 4 colors mode.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const float ImageBC1Weights[4] = { 1.0f , 0.0f , 2.0f / 3.0f , 1.0f / 3.0f };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Weight of the first endpoint for each index of a BC4
+        /// channel (in BC3 and BC5 blocks), in the 8 values mode.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const float ImageBC4Weights[8] = { 1.0f , 0.0f , 6.0f / 7.0f , 5.0f / 7.0f , 4.0f / 7.0f , 3.0f / 7.0f , 2.0f / 7.0f , 1.0f / 7.0f };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Pixels of a block, by channel.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct ImageBlock
+        {
+            float values[4][16] ; ///< Red, green, blue and alpha of the 16 pixels, in [0, 255].
+        };
+
+        ////////////////////////////////////////////////////////////
+        static void ImageBlockLoad( const unsigned char* rgba , ImageBlock& block )
+        {
+            for ( int i = 0 ; i < 16 ; ++i )
+            {
+                for ( int c = 0 ; c < 4 ; ++c )
+                    block.values[c][i] = rgba[i * 4 + c] ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Finds the nearest palette entry of each pixel, on the
+        /// first 'channels' channels of 'values', and returns the total
+        /// squared error.
+        ///
+        /// Ties keep the lowest index, with or without SSE2.
+        ///
+        ////////////////////////////////////////////////////////////
+        static float ImageBlockSelect( const float ( *values )[16] , int channels , const float ( *palette )[4] ,
+                                       int count , unsigned char* indexes )
+        {
+            float error = 0.0f ;
+
+#ifdef ATL_SIMD_SSE2
+            // Four pixels against each palette entry.
+            for ( int p = 0 ; p < 16 ; p += 4 )
+            {
+                __m128  best      = _mm_set1_ps( FLT_MAX );
+                __m128i bestindex = _mm_setzero_si128();
+
+                for ( int i = 0 ; i < count ; ++i )
+                {
+                    __m128 dist = _mm_setzero_ps();
+
+                    for ( int c = 0 ; c < channels ; ++c )
+                    {
+                        __m128 d = _mm_sub_ps( _mm_loadu_ps( values[c] + p ) , _mm_set1_ps( palette[i][c] ) );
+                        dist = _mm_add_ps( dist , _mm_mul_ps( d , d ) );
+                    }
+
+                    __m128i closer = _mm_castps_si128( _mm_cmplt_ps( dist , best ) );
+                    bestindex = _mm_or_si128( _mm_and_si128( closer , _mm_set1_epi32( i ) ) , _mm_andnot_si128( closer , bestindex ) );
+                    best      = _mm_min_ps( dist , best );
+                }
+
+                int32_t bests[4] ;
+                float   dists[4] ;
+                _mm_storeu_si128( reinterpret_cast < __m128i* >( bests ) , bestindex );
+                _mm_storeu_ps( dists , best );
+
+                for ( int k = 0 ; k < 4 ; ++k )
+                {
+                    indexes[p + k] = static_cast < unsigned char >( bests[k] );
+                    error += dists[k] ;
+                }
+            }
+#else
+            for ( int p = 0 ; p < 16 ; ++p )
+            {
+                float best = FLT_MAX ;
+                int   bestindex = 0 ;
+
+                for ( int i = 0 ; i < count ; ++i )
+                {
+                    float dist = 0.0f ;
+
+                    for ( int c = 0 ; c < channels ; ++c )
+                    {
+                        float d = values[c][p] - palette[i][c] ;
+                        dist += d * d ;
+                    }
+
+                    if ( dist < best )
+                    {
+                        best      = dist ;
+                        bestindex = i ;
+                    }
+                }
+
+                indexes[p] = static_cast < unsigned char >( bestindex );
+                error += best ;
+            }
+#endif
+
+            return error ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Finds the endpoints minimizing the squared error of a
+        /// block by least squares, with its current indexes.
+        ///
+        /// \return False if every pixel has the same weight: endpoints
+        /// can't be solved.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool ImageBlockFit( const float ( *values )[16] , int channels , const unsigned char* indexes ,
+                                   const float* weights , float* e0 , float* e1 )
+        {
+            float aa = 0.0f , bb = 0.0f , ab = 0.0f ;
+            float x0[4] = { 0.0f } , x1[4] = { 0.0f };
+
+            for ( int p = 0 ; p < 16 ; ++p )
+            {
+                float a = weights[indexes[p]] ;
+                float b = 1.0f - a ;
+                aa += a * a ;
+                bb += b * b ;
+                ab += a * b ;
+
+                for ( int c = 0 ; c < channels ; ++c )
+                {
+                    x0[c] += a * values[c][p] ;
+                    x1[c] += b * values[c][p] ;
+                }
+            }
+
+            float det = aa * bb - ab * ab ;
+
+            if ( std::fabs( det ) < 1e-6f )
+                return false ;
+
+            for ( int c = 0 ; c < channels ; ++c )
+            {
+                e0[c] = std::min( std::max( ( x0[c] * bb - x1[c] * ab ) / det , 0.0f ) , 255.0f );
+                e1[c] = std::min( std::max( ( x1[c] * aa - x0[c] * ab ) / det , 0.0f ) , 255.0f );
+            }
+
+            return true ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the colors of a block at the extremes of its
+        /// principal axis, found by power iterations on the covariance
+        /// of the pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageBlockEndpoints( const ImageBlock& block , float* e0 , float* e1 )
+        {
+            float mean[3] = { 0.0f } , lo[3] , hi[3] ;
+
+            for ( int c = 0 ; c < 3 ; ++c )
+            {
+                lo[c] = hi[c] = block.values[c][0] ;
+
+                for ( int p = 0 ; p < 16 ; ++p )
+                {
+                    mean[c] += block.values[c][p] ;
+                    lo[c] = std::min( lo[c] , block.values[c][p] );
+                    hi[c] = std::max( hi[c] , block.values[c][p] );
+                }
+
+                mean[c] /= 16.0f ;
+            }
+
+            float cov[6] = { 0.0f };
+
+            for ( int p = 0 ; p < 16 ; ++p )
+            {
+                float r = block.values[0][p] - mean[0] ;
+                float g = block.values[1][p] - mean[1] ;
+                float b = block.values[2][p] - mean[2] ;
+
+                cov[0] += r * r ; cov[1] += r * g ; cov[2] += r * b ;
+                cov[3] += g * g ; cov[4] += g * b ; cov[5] += b * b ;
+            }
+
+            // The bounding box diagonal is a good start: iterations find
+            // the sign of the correlations.
+            float axis[3] = { hi[0] - lo[0] , hi[1] - lo[1] , hi[2] - lo[2] };
+
+            for ( int it = 0 ; it < 8 ; ++it )
+            {
+                float v[3] = {
+                    cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2] ,
+                    cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2] ,
+                    cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]
+                };
+
+                float norm = std::max( std::fabs( v[0] ) , std::max( std::fabs( v[1] ) , std::fabs( v[2] ) ) );
+
+                if ( norm < 1e-6f )
+                    break ;
+
+                for ( int c = 0 ; c < 3 ; ++c )
+                    axis[c] = v[c] / norm ;
+            }
+
+            int   pmin = 0 , pmax = 0 ;
+            float tmin = FLT_MAX , tmax = -FLT_MAX ;
+
+            for ( int p = 0 ; p < 16 ; ++p )
+            {
+                float t = ( block.values[0][p] - mean[0] ) * axis[0]
+                        + ( block.values[1][p] - mean[1] ) * axis[1]
+                        + ( block.values[2][p] - mean[2] ) * axis[2] ;
+
+                if ( t < tmin ) { tmin = t ; pmin = p ; }
+                if ( t > tmax ) { tmax = t ; pmax = p ; }
+            }
+
+            for ( int c = 0 ; c < 3 ; ++c )
+            {
+                e0[c] = block.values[c][pmax] ;
+                e1[c] = block.values[c][pmin] ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        static uint16_t ImageTo565( const float* color )
+        {
+            int r = static_cast < int >( std::min( std::max( color[0] , 0.0f ) , 255.0f ) * 31.0f / 255.0f + 0.5f );
+            int g = static_cast < int >( std::min( std::max( color[1] , 0.0f ) , 255.0f ) * 63.0f / 255.0f + 0.5f );
+            int b = static_cast < int >( std::min( std::max( color[2] , 0.0f ) , 255.0f ) * 31.0f / 255.0f + 0.5f );
+            return static_cast < uint16_t >( ( r << 11 ) | ( g << 5 ) | b );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static void ImageFrom565( uint16_t color , int* rgb )
+        {
+            int r = ( color >> 11 ) & 31 ;
+            int g = ( color >> 5 ) & 63 ;
+            int b = color & 31 ;
+
+            rgb[0] = ( r << 3 ) | ( r >> 2 );
+            rgb[1] = ( g << 2 ) | ( g >> 4 );
+            rgb[2] = ( b << 3 ) | ( b >> 2 );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the palette of a BC1 block, as decoders compute
+        /// it, and the number of its entries used by the encoder.
+        ///
+        /// Colors of BC3 blocks are 'opaque': always in the 4 colors mode.
+        ///
+        ////////////////////////////////////////////////////////////
+        static int ImageBC1Palette( uint16_t c0 , uint16_t c1 , bool opaque , int ( *palette )[3] )
+        {
+            ImageFrom565( c0 , palette[0] );
+            ImageFrom565( c1 , palette[1] );
+
+            for ( int c = 0 ; c < 3 ; ++c )
+            {
+                if ( c0 > c1 || opaque )
+                {
+                    palette[2][c] = ( 2 * palette[0][c] + palette[1][c] ) / 3 ;
+                    palette[3][c] = ( palette[0][c] + 2 * palette[1][c] ) / 3 ;
+                }
+
+                else
+                {
+                    palette[2][c] = ( palette[0][c] + palette[1][c] ) / 2 ;
+                    palette[3][c] = 0 ;
+                }
+            }
+
+            return c0 > c1 ? 4 : 1 ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes a BC1 block with given endpoints, always in the
+        /// 4 colors mode, and returns its squared error.
+        ///
+        ////////////////////////////////////////////////////////////
+        static float ImageBC1Encode( const ImageBlock& block , const float* e0 , const float* e1 ,
+                                     unsigned char* out , unsigned char* indexes )
+        {
+            uint16_t c0 = ImageTo565( e0 );
+            uint16_t c1 = ImageTo565( e1 );
+
+            if ( c0 < c1 )
+                std::swap( c0 , c1 );
+
+            int   colors[4][3] ;
+            float palette[4][4] ;
+            int   count = ImageBC1Palette( c0 , c1 , false , colors );
+
+            for ( int i = 0 ; i < 4 ; ++i )
+            {
+                for ( int c = 0 ; c < 3 ; ++c )
+                    palette[i][c] = static_cast < float >( colors[i][c] );
+            }
+
+            // Equal endpoints use the first color only.
+            float    error = ImageBlockSelect( block.values , 3 , palette , count , indexes );
+            uint32_t bits  = 0 ;
+
+            for ( int p = 0 ; p < 16 ; ++p )
+                bits |= static_cast < uint32_t >( indexes[p] ) << ( 2 * p );
+
+            out[0] = static_cast < unsigned char >( c0 & 0xFF );
+            out[1] = static_cast < unsigned char >( c0 >> 8 );
+            out[2] = static_cast < unsigned char >( c1 & 0xFF );
+            out[3] = static_cast < unsigned char >( c1 >> 8 );
+
+            for ( int b = 0 ; b < 4 ; ++b )
+                out[4 + b] = static_cast < unsigned char >( bits >> ( 8 * b ) );
+
+            return error ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        static void ImageBC1Block( const ImageBlock& block , unsigned char* out , bool refine )
+        {
+            float e0[4] , e1[4] ;
+            unsigned char indexes[16] ;
+
+            ImageBlockEndpoints( block , e0 , e1 );
+            float error = ImageBC1Encode( block , e0 , e1 , out , indexes );
+
+            for ( int it = 0 ; refine && it < 2 && error > 0.0f ; ++it )
+            {
+                unsigned char candidate[8] , cindexes[16] ;
+
+                if ( !ImageBlockFit( block.values , 3 , indexes , ImageBC1Weights , e0 , e1 ) )
+                    break ;
+
+                float cerror = ImageBC1Encode( block , e0 , e1 , candidate , cindexes );
+
+                if ( cerror >= error )
+                    break ;
+
+                error = cerror ;
+                memcpy( out , candidate , sizeof( candidate ) );
+                memcpy( indexes , cindexes , sizeof( cindexes ) );
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decodes BC1 colors in 4x4 RGBA pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageBC1Decode( const unsigned char* block , bool opaque , unsigned char* rgba )
+        {
+            uint16_t c0   = static_cast < uint16_t >( block[0] | ( block[1] << 8 ) );
+            uint16_t c1   = static_cast < uint16_t >( block[2] | ( block[3] << 8 ) );
+            uint32_t bits = block[4] | ( block[5] << 8 ) | ( block[6] << 16 ) | ( static_cast < uint32_t >( block[7] ) << 24 );
+
+            int palette[4][3] ;
+            ImageBC1Palette( c0 , c1 , opaque , palette );
+
+            for ( int p = 0 ; p < 16 ; ++p )
+            {
+                uint32_t index = ( bits >> ( 2 * p ) ) & 3 ;
+
+                for ( int c = 0 ; c < 3 ; ++c )
+                    rgba[p * 4 + c] = static_cast < unsigned char >( palette[index][c] );
+
+                // The 3 colors mode has a transparent black.
+                rgba[p * 4 + 3] = ( !opaque && c0 <= c1 && index == 3 ) ? 0 : 255 ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the palette of a BC4 channel, as decoders
+        /// compute it, and the number of its entries used by the encoder.
+        ///
+        ////////////////////////////////////////////////////////////
+        static int ImageBC4Palette( int a0 , int a1 , int* palette )
+        {
+            palette[0] = a0 ;
+            palette[1] = a1 ;
+
+            if ( a0 > a1 )
+            {
+                for ( int i = 2 ; i < 8 ; ++i )
+                    palette[i] = ( ( 8 - i ) * a0 + ( i - 1 ) * a1 ) / 7 ;
+            }
+
+            else
+            {
+                for ( int i = 2 ; i < 6 ; ++i )
+                    palette[i] = ( ( 6 - i ) * a0 + ( i - 1 ) * a1 ) / 5 ;
+
+                palette[6] = 0 ;
+                palette[7] = 255 ;
+            }
+
+            return a0 > a1 ? 8 : 1 ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes a BC4 channel of 8 bytes with given endpoints,
+        /// always in the 8 values mode, and returns its squared error.
+        ///
+        ////////////////////////////////////////////////////////////
+        static float ImageBC4Encode( const float ( *values )[16] , float e0 , float e1 ,
+                                     unsigned char* out , unsigned char* indexes )
+        {
+            int a0 = static_cast < int >( std::min( std::max( e0 , 0.0f ) , 255.0f ) + 0.5f );
+            int a1 = static_cast < int >( std::min( std::max( e1 , 0.0f ) , 255.0f ) + 0.5f );
+
+            if ( a0 < a1 )
+                std::swap( a0 , a1 );
+
+            int   levels[8] ;
+            float palette[8][4] ;
+            int   count = ImageBC4Palette( a0 , a1 , levels );
+
+            for ( int i = 0 ; i < 8 ; ++i )
+                palette[i][0] = static_cast < float >( levels[i] );
+
+            float    error = ImageBlockSelect( values , 1 , palette , count , indexes );
+            uint64_t bits  = 0 ;
+
+            for ( int p = 0 ; p < 16 ; ++p )
+                bits |= static_cast < uint64_t >( indexes[p] ) << ( 3 * p );
+
+            out[0] = static_cast < unsigned char >( a0 );
+            out[1] = static_cast < unsigned char >( a1 );
+
+            for ( int b = 0 ; b < 6 ; ++b )
+                out[2 + b] = static_cast < unsigned char >( bits >> ( 8 * b ) );
+
+            return error ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        static void ImageBC4Block( const float ( *values )[16] , unsigned char* out , bool refine )
+        {
+            float e0 = values[0][0] , e1 = values[0][0] ;
+            unsigned char indexes[16] ;
+
+            for ( int p = 1 ; p < 16 ; ++p )
+            {
+                e0 = std::max( e0 , values[0][p] );
+                e1 = std::min( e1 , values[0][p] );
+            }
+
+            float error = ImageBC4Encode( values , e0 , e1 , out , indexes );
+
+            for ( int it = 0 ; refine && it < 2 && error > 0.0f ; ++it )
+            {
+                unsigned char candidate[8] , cindexes[16] ;
+
+                if ( !ImageBlockFit( values , 1 , indexes , ImageBC4Weights , &e0 , &e1 ) )
+                    break ;
+
+                float cerror = ImageBC4Encode( values , e0 , e1 , candidate , cindexes );
+
+                if ( cerror >= error )
+                    break ;
+
+                error = cerror ;
+                memcpy( out , candidate , sizeof( candidate ) );
+                memcpy( indexes , cindexes , sizeof( cindexes ) );
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decodes a BC4 channel in one channel of 4x4 RGBA
+        /// pixels.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ImageBC4Decode( const unsigned char* block , unsigned char* rgba , int channel )
+        {
+            int      palette[8] ;
+            uint64_t bits = 0 ;
+
+            ImageBC4Palette( block[0] , block[1] , palette );
+
+            for ( int b = 0 ; b < 6 ; ++b )
+                bits |= static_cast < uint64_t >( block[2 + b] ) << ( 8 * b );
+
+            for ( int p = 0 ; p < 16 ; ++p )
+                rgba[p * 4 + channel] = static_cast < unsigned char >( palette[( bits >> ( 3 * p ) ) & 7] );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    ImageCompressor::ImageCompressor( const ImageCompressorSettings& settings ) : m_settings( settings )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    ImageCompressor::~ImageCompressor()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ImageCompressor::Compress( Image& image ) const
+    {
+        ImageFormat format = GetFormatFor( image );
+
+        if ( format == ImageFormat::Unknown )
+            return false ;
+
+        uint32_t count = image.GetLevelsCount();
+        Vector < ImageLevel > levels ;
+        std::size_t total = Image::GetLayoutFor( image.GetWidth() , image.GetHeight() , format , count , levels );
+
+        CBuffer buffer = CBuffer::Allocate( total );
+        unsigned char* data = reinterpret_cast < unsigned char* >( buffer.GetMutableData() );
+
+        for ( uint32_t l = 0 ; l < count ; ++l )
+        {
+            const ImageLevel& level = image.GetLevel( l );
+            CompressLevel( image.GetLevelData( l ) , level.width , level.height , image.GetFormat() ,
+                           format , data + levels[l].offset , m_settings.refine );
+        }
+
+        return image.SetPixels( buffer , image.GetWidth() , image.GetHeight() , format , count );
+    }
+
+    ////////////////////////////////////////////////////////////
+    ImageFormat ImageCompressor::GetFormatFor( const Image& image ) const
+    {
+        if ( !image.GetLevelsCount() )
+            return ImageFormat::Unknown ;
+
+        switch( image.GetFormat() )
+        {
+            case ImageFormat::R8G8B8A8Unorm:
+            case ImageFormat::B8G8R8A8Unorm:
+            {
+                const ImageLevel&    level = image.GetLevel( 0 );
+                const unsigned char* data  = image.GetLevelData( 0 );
+                std::size_t pixels = static_cast < std::size_t >( level.width ) * level.height ;
+
+                for ( std::size_t p = 0 ; m_settings.alpha && p < pixels ; ++p )
+                {
+                    if ( data[p * 4 + 3] != 255 )
+                        return ImageFormat::BC3Unorm ;
+                }
+
+                return ImageFormat::BC1Unorm ;
+            }
+
+            case ImageFormat::R8G8B8Unorm: return ImageFormat::BC1Unorm ;
+            case ImageFormat::R8G8Unorm:   return ImageFormat::BC5Unorm ;
+            default:                       return ImageFormat::Unknown ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    const ImageCompressorSettings& ImageCompressor::GetSettings() const
+    {
+        return m_settings ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ImageCompressor::CompressLevel( const unsigned char* src , uint32_t width , uint32_t height , ImageFormat srcformat ,
+                                         ImageFormat dstformat , unsigned char* dst , bool refine )
+    {
+        std::size_t channels = 0 ;
+
+        switch( srcformat )
+        {
+            case ImageFormat::R8Unorm:       channels = 1 ; break ;
+            case ImageFormat::R8G8Unorm:     channels = 2 ; break ;
+            case ImageFormat::R8G8B8Unorm:   channels = 3 ; break ;
+            case ImageFormat::R8G8B8A8Unorm: channels = 4 ; break ;
+            case ImageFormat::B8G8R8A8Unorm: channels = 4 ; break ;
+            default:                         return false ;
+        }
+
+        if ( !Image::IsCompressedFor( dstformat ) || !width || !height )
+            return false ;
+
+        bool        bgra      = srcformat == ImageFormat::B8G8R8A8Unorm ;
+        std::size_t blocksize = dstformat == ImageFormat::BC1Unorm ? 8 : 16 ;
+        uint32_t    bwidth    = ( width + 3 ) / 4 ;
+        uint32_t    bheight   = ( height + 3 ) / 4 ;
+
+        auto row = [&]( std::size_t by ) {
+            unsigned char rgba[64] ;
+            Detail::ImageBlock block ;
+
+            for ( uint32_t bx = 0 ; bx < bwidth ; ++bx )
+            {
+                for ( uint32_t y = 0 ; y < 4 ; ++y )
+                {
+                    for ( uint32_t x = 0 ; x < 4 ; ++x )
+                    {
+                        std::size_t sx = std::min( bx * 4 + x , width - 1 );
+                        std::size_t sy = std::min( static_cast < uint32_t >( by ) * 4 + y , height - 1 );
+                        const unsigned char* p = src + ( sy * width + sx ) * channels ;
+                        unsigned char* q = rgba + ( y * 4 + x ) * 4 ;
+
+                        q[0] = p[bgra ? 2 : 0] ;
+                        q[1] = channels > 1 ? p[1] : 0 ;
+                        q[2] = channels > 2 ? p[bgra ? 0 : 2] : 0 ;
+                        q[3] = channels > 3 ? p[3] : 255 ;
+                    }
+                }
+
+                unsigned char* out = dst + ( by * bwidth + bx ) * blocksize ;
+                Detail::ImageBlockLoad( rgba , block );
+
+                if ( dstformat == ImageFormat::BC1Unorm )
+                {
+                    Detail::ImageBC1Block( block , out , refine );
+                }
+
+                else if ( dstformat == ImageFormat::BC3Unorm )
+                {
+                    Detail::ImageBC4Block( block.values + 3 , out , refine );
+                    Detail::ImageBC1Block( block , out + 8 , refine );
+                }
+
+                else
+                {
+                    Detail::ImageBC4Block( block.values , out , refine );
+                    Detail::ImageBC4Block( block.values + 1 , out + 8 , refine );
+                }
+            }
+        };
+
+        auto pool = ThreadPool::Get();
+
+        if ( pool && bheight > 1 && static_cast < std::size_t >( bwidth ) * bheight >= Detail::ImageCompressorParallelBlocks )
+        {
+            pool->ParallelFor( bheight , row );
+        }
+
+        else
+        {
+            for ( uint32_t by = 0 ; by < bheight ; ++by )
+                row( by );
+        }
+
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageCompressor::EncodeBC1Block( const unsigned char* rgba , unsigned char* block , bool refine )
+    {
+        Detail::ImageBlock pixels ;
+        Detail::ImageBlockLoad( rgba , pixels );
+        Detail::ImageBC1Block( pixels , block , refine );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageCompressor::EncodeBC3Block( const unsigned char* rgba , unsigned char* block , bool refine )
+    {
+        Detail::ImageBlock pixels ;
+        Detail::ImageBlockLoad( rgba , pixels );
+        Detail::ImageBC4Block( pixels.values + 3 , block , refine );
+        Detail::ImageBC1Block( pixels , block + 8 , refine );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageCompressor::EncodeBC5Block( const unsigned char* rgba , unsigned char* block , bool refine )
+    {
+        Detail::ImageBlock pixels ;
+        Detail::ImageBlockLoad( rgba , pixels );
+        Detail::ImageBC4Block( pixels.values , block , refine );
+        Detail::ImageBC4Block( pixels.values + 1 , block + 8 , refine );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageCompressor::DecodeBC1Block( const unsigned char* block , unsigned char* rgba )
+    {
+        Detail::ImageBC1Decode( block , false , rgba );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageCompressor::DecodeBC3Block( const unsigned char* block , unsigned char* rgba )
+    {
+        Detail::ImageBC1Decode( block + 8 , true , rgba );
+        Detail::ImageBC4Decode( block , rgba , 3 );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageCompressor::DecodeBC5Block( const unsigned char* block , unsigned char* rgba )
+    {
+        for ( int p = 0 ; p < 16 ; ++p )
+        {
+            rgba[p * 4 + 2] = 0 ;
+            rgba[p * 4 + 3] = 255 ;
+        }
+
+        Detail::ImageBC4Decode( block , rgba , 0 );
+        Detail::ImageBC4Decode( block + 8 , rgba , 1 );
+    }
+}
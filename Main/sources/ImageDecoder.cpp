@@ -0,0 +1,129 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ImageDecoder.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/ImageDecoder.hpp>
+#include <ATL/ImageCompressor.hpp>
+#include <ATL/Manager.hpp>
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    ImageDecoder::ImageDecoder( const ImageDecoderSettings& settings ) : m_settings( settings )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    ImageDecoder::~ImageDecoder()
+    {
+        m_queue.CancelAll();
+    }
+
+    ////////////////////////////////////////////////////////////
+    LoadingJobId ImageDecoder::Push( const String& file , const ImageDecodedCallback& callback , Priority priority )
+    {
+        auto task = [this , file]( LoadingContext& context ) {
+            auto manager = Manager < Image >::Get();
+            auto image   = manager ? manager->Create( false , file ).lock() : nullptr ;
+
+            if ( image && !context.queue->IsCancelled( context.job ) )
+                DFinish( context.job , image , file );
+        };
+
+        return m_queue.Push( task , priority , Vector < LoadingJobId >() , pMakeCallback( callback ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    LoadingJobId ImageDecoder::Push( const Shared < Image >& image , const ImageDecodedCallback& callback , Priority priority )
+    {
+        assert( image && "'image' is null." );
+
+        auto task = [this , image]( LoadingContext& context ) {
+            DFinish( context.job , image , image->GetFile() );
+        };
+
+        return m_queue.Push( task , priority , Vector < LoadingJobId >() , pMakeCallback( callback ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t ImageDecoder::DispatchCompletions()
+    {
+        return m_queue.DispatchCompletions();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageDecoder::Wait()
+    {
+        m_queue.Wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    LoadingQueue& ImageDecoder::GetQueue()
+    {
+        return m_queue ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const ImageDecoderSettings& ImageDecoder::GetSettings() const
+    {
+        return m_settings ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ImageDecoder::DFinish( LoadingJobId job , const Shared < Image >& image , const String& file )
+    {
+        // 'image' may be used by other threads (the Manager gives the same image to
+        // every loader of a file): a copy is processed, which shares its pixels until
+        // new levels replace them, then is published complete.
+        auto copy      = std::make_shared < Image >( *image );
+        bool processed = false ;
+
+        if ( m_settings.mipmaps && copy->GetLevelsCount() == 1 )
+            processed = copy->GenerateMipmaps( m_settings.filter );
+
+        auto compressor = ImageCompressor::Get();
+
+        if ( compressor && compressor->Compress( *copy ) )
+            processed = true ;
+
+        // Next loads of the file read the processed image from the cache.
+        auto manager = Manager < Image >::Get();
+
+        if ( processed && manager )
+            manager->UpdateCache( copy , file );
+
+        MutexLocker lck( m_mutex );
+        m_images[job] = processed ? copy : image ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    LoadingCallback ImageDecoder::pMakeCallback( const ImageDecodedCallback& callback )
+    {
+        return [this , callback]( LoadingJobId job , LoadingJobState state ) {
+            Shared < Image > image ;
+
+            {
+                MutexLocker lck( m_mutex );
+                auto it = m_images.find( job );
+
+                if ( it != m_images.end() )
+                {
+                    image = std::move( it->second );
+                    m_images.erase( it );
+                }
+            }
+
+            if ( callback )
+                callback( state == LoadingJobState::Finished ? image : nullptr );
+        };
+    }
+}
@@ -11,64 +11,243 @@
 //  ========================================================================  //
 #include <ATL/LoadingQueue.hpp>
 #include <ATL/Root.hpp>
+#include <ATL/ThreadPool.hpp>
+#include <ATL/ErrorCenter.hpp>
+
+#include <algorithm>
 
 namespace atl
 {
     ////////////////////////////////////////////////////////////
     IDGenerator < LoadingQueueId > LoadingQueue::s_generator ;
     
+    ////////////////////////////////////////////////////////////
+    Vector < LoadingQueue* > LoadingQueue::s_queues ;
+    
+    ////////////////////////////////////////////////////////////
+    std::recursive_mutex LoadingQueue::s_queuesmutex ;
+    
     ////////////////////////////////////////////////////////////
     LoadingQueue::LoadingQueue( LoadingQueue::LoadingFunc func , void* data )
-    : m_id( s_generator.New() ) , m_func( func )
+    : m_id( s_generator.New() ) , m_func( func ) , m_lastjob( 0 ) , m_concurrency( 0 ) , m_runners( 0 ) , m_inline( false )
     {
         m_context.renderwindow = Weak < RenderWindow >();
         m_context.driver       = Root::Get().GetDriver();
         m_context.surfacer     = Root::Get().GetSurfacer();
         m_context.data         = data ;
+        m_context.queue        = this ;
+        m_context.job          = 0 ;
+        
+        std::lock_guard < std::recursive_mutex > lck( s_queuesmutex );
+        s_queues.push_back( this );
     }
     
     ////////////////////////////////////////////////////////////
     LoadingQueue::LoadingQueue( const Weak < RenderWindow >& renderwindow , LoadingQueue::LoadingFunc func , void* data )
-    : m_id( s_generator.New() ) , m_func( func )
+    : m_id( s_generator.New() ) , m_func( func ) , m_lastjob( 0 ) , m_concurrency( 0 ) , m_runners( 0 ) , m_inline( false )
     {
         m_context.renderwindow = renderwindow ;
         m_context.driver       = Root::Get().GetDriver();
         m_context.surfacer     = Root::Get().GetSurfacer();
         m_context.data         = data ;
+        m_context.queue        = this ;
+        m_context.job          = 0 ;
+        
+        std::lock_guard < std::recursive_mutex > lck( s_queuesmutex );
+        s_queues.push_back( this );
     }
     
     ////////////////////////////////////////////////////////////
     LoadingQueue::~LoadingQueue()
     {
+        {
+            std::lock_guard < std::recursive_mutex > lck( s_queuesmutex );
+            s_queues.erase( std::remove( s_queues.begin() , s_queues.end() , this ) , s_queues.end() );
+        }
         
+        CancelAll();
+        
+        // Runners hold 'this': waits for them to return.
+        std::unique_lock < std::mutex > lck( m_mutex );
+        m_cond.wait( lck , [this]() { return m_runners == 0 && m_jobs.empty(); } );
     }
     
     ////////////////////////////////////////////////////////////
-    void LoadingQueue::Start()
+    LoadingJobId LoadingQueue::Push( const LoadingTask& task , Priority priority , const Vector < LoadingJobId >& dependencies , const LoadingCallback& callback )
     {
-        MutexLocker lck( m_mutex );
-        m_performer.StartSynced();
+        assert( task && "Invalid LoadingTask given." );
+        LoadingJobId id ;
         
-        if ( m_func )
         {
-            m_func( m_context );
+            MutexLocker lck( m_mutex );
+            id = ++m_lastjob ;
+            
+            if ( m_jobs.empty() )
+                m_performer.StartSynced();
+            
+            Job& job = m_jobs[id] ;
+            job.task      = task ;
+            job.callback  = callback ;
+            job.priority  = priority ;
+            job.state     = LoadingJobState::Waiting ;
+            job.waiting   = 0 ;
+            job.cancelled = false ;
+            
+            for ( LoadingJobId dependency : dependencies )
+            {
+                auto it = m_jobs.find( dependency );
+                
+                if ( it == m_jobs.end() || dependency == id )
+                    continue ;
+                
+                it->second.dependents.push_back( id );
+                job.waiting++ ;
+            }
+            
+            if ( !job.waiting )
+            {
+                job.state = LoadingJobState::Ready ;
+                m_ready.push_back( ReadyJob{ priority , id } );
+                std::push_heap( m_ready.begin() , m_ready.end() );
+                
+                pSchedule();
+            }
         }
         
-        m_performer.EndSynced();
+        pRunInline();
+        return id ;
     }
     
     ////////////////////////////////////////////////////////////
-    void LoadingQueue::StartAsync()
+    bool LoadingQueue::Cancel( LoadingJobId id )
+    {
+        MutexLocker lck( m_mutex );
+        auto it = m_jobs.find( id );
+        
+        if ( it == m_jobs.end() )
+            return false ;
+        
+        if ( it->second.state == LoadingJobState::Running )
+            it->second.cancelled = true ;
+        else
+            pComplete( id , LoadingJobState::Cancelled );
+        
+        return true ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::CancelAll()
     {
-        m_performer.Start( [this](){
+        MutexLocker lck( m_mutex );
+        Vector < LoadingJobId > ids ;
+        ids.reserve( m_jobs.size() );
+        
+        for ( auto const& it : m_jobs )
+            ids.push_back( it.first );
+        
+        for ( LoadingJobId id : ids )
+        {
+            auto it = m_jobs.find( id );
             
-            m_mutex.lock();
-            auto func = m_func ;
-            auto ctxt = m_context ;
-            m_mutex.unlock();
+            // May have been cancelled as a dependent of a previous one.
+            if ( it == m_jobs.end() )
+                continue ;
             
-            func( ctxt );
-        });
+            if ( it->second.state == LoadingJobState::Running )
+                it->second.cancelled = true ;
+            else
+                pComplete( id , LoadingJobState::Cancelled );
+        }
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool LoadingQueue::IsCancelled( LoadingJobId id ) const
+    {
+        MutexLocker lck( m_mutex );
+        auto it = m_jobs.find( id );
+        return it != m_jobs.end() && it->second.cancelled ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    LoadingJobState LoadingQueue::GetState( LoadingJobId id ) const
+    {
+        MutexLocker lck( m_mutex );
+        auto it = m_jobs.find( id );
+        return it == m_jobs.end() ? LoadingJobState::Finished : it->second.state ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t LoadingQueue::DispatchCompletions()
+    {
+        Vector < Completion > completions ;
+        
+        {
+            MutexLocker lck( m_mutex );
+            completions.swap( m_completions );
+        }
+        
+        for ( auto const& completion : completions )
+        {
+            if ( completion.callback )
+                completion.callback( completion.id , completion.state );
+        }
+        
+        return completions.size();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t LoadingQueue::DispatchAllCompletions()
+    {
+        std::lock_guard < std::recursive_mutex > lck( s_queuesmutex );
+        Vector < LoadingQueue* > queues = s_queues ;
+        std::size_t dispatched = 0 ;
+        
+        for ( LoadingQueue* queue : queues )
+        {
+            // A callback may have destroyed one of the next queues.
+            if ( std::find( s_queues.begin() , s_queues.end() , queue ) == s_queues.end() )
+                continue ;
+            
+            dispatched += queue->DispatchCompletions();
+        }
+        
+        return dispatched ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::SetConcurrency( std::size_t concurrency )
+    {
+        MutexLocker lck( m_mutex );
+        m_concurrency = concurrency ;
+        pSchedule();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t LoadingQueue::GetConcurrency() const
+    {
+        MutexLocker lck( m_mutex );
+        
+        if ( m_concurrency )
+            return m_concurrency ;
+        
+        auto pool = ThreadPool::Get();
+        return pool ? pool -> GetWorkersCount() : 0 ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::Start()
+    {
+        if ( m_func )
+            Push( m_func );
+        
+        Wait();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::StartAsync()
+    {
+        if ( m_func )
+            Push( m_func );
     }
     
     ////////////////////////////////////////////////////////////
@@ -81,14 +260,216 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void LoadingQueue::Wait()
     {
-        MutexLocker lck( m_mutex );
-        return m_performer.Wait();
+        std::unique_lock < std::mutex > lck( m_mutex );
+        
+        while ( !m_jobs.empty() )
+        {
+            LoadingTask  task ;
+            LoadingJobId id = pPopReady( task );
+            
+            if ( id )
+            {
+                lck.unlock();
+                pExecute( id , task );
+                lck.lock();
+            }
+            
+            else
+            {
+                // Remaining jobs are running or wait for running ones.
+                m_cond.wait( lck );
+            }
+        }
     }
     
     ////////////////////////////////////////////////////////////
     bool LoadingQueue::IsFinished() const
     {
         MutexLocker lck( m_mutex );
-        return m_performer.IsFinished();
+        return m_jobs.empty();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::pSchedule()
+    {
+        auto pool = ThreadPool::Get();
+        
+        if ( !pool )
+            return ;
+        
+        std::size_t concurrency = m_concurrency ? m_concurrency : pool -> GetWorkersCount();
+        
+        // A runner drains the ready jobs before returning: one more runner
+        // is only needed for a ready job no runner can take right now.
+        while ( m_runners < concurrency && m_runners < m_ready.size() )
+        {
+            m_runners++ ;
+            pool -> Push( [this]() { pRunner(); } );
+        }
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::pRunInline()
+    {
+        if ( ThreadPool::Get() )
+            return ;
+        
+        std::unique_lock < std::mutex > lck( m_mutex );
+        
+        // Jobs pushed by a running job, or by another thread meanwhile, are
+        // taken by the thread already executing them.
+        if ( m_inline )
+            return ;
+        
+        m_inline = true ;
+        
+        while ( true )
+        {
+            LoadingTask  task ;
+            LoadingJobId id = pPopReady( task );
+            
+            if ( !id )
+                break ;
+            
+            lck.unlock();
+            pExecute( id , task );
+            lck.lock();
+        }
+        
+        m_inline = false ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::pRunner()
+    {
+        std::unique_lock < std::mutex > lck( m_mutex );
+        
+        while ( true )
+        {
+            std::size_t concurrency = m_concurrency ? m_concurrency : m_runners ;
+            
+            // Exits when the concurrency has been lowered meanwhile.
+            if ( m_runners > concurrency )
+                break ;
+            
+            LoadingTask  task ;
+            LoadingJobId id = pPopReady( task );
+            
+            if ( !id )
+                break ;
+            
+            lck.unlock();
+            pExecute( id , task );
+            lck.lock();
+        }
+        
+        m_runners-- ;
+        m_cond.notify_all();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    LoadingJobId LoadingQueue::pPopReady( LoadingTask& task )
+    {
+        while ( !m_ready.empty() )
+        {
+            std::pop_heap( m_ready.begin() , m_ready.end() );
+            LoadingJobId id = m_ready.back().id ;
+            m_ready.pop_back();
+            
+            // Cancelled jobs are removed from 'm_jobs' but left in the heap.
+            auto it = m_jobs.find( id );
+            
+            if ( it == m_jobs.end() || it->second.state != LoadingJobState::Ready )
+                continue ;
+            
+            it->second.state = LoadingJobState::Running ;
+            task = it->second.task ;
+            return id ;
+        }
+        
+        return 0 ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::pExecute( LoadingJobId id , const LoadingTask& task )
+    {
+        LoadingContext context = m_context ;
+        context.job = id ;
+        bool failed = false ;
+        
+        try
+        {
+            task( context );
+        }
+        
+        catch ( const std::exception& e )
+        {
+            // Its dependents would miss what it loads: handled as cancelled.
+            ErrorCenter::CatchException( e , Error::LoadingJob , "LoadingQueue job %llu failed." , id );
+            failed = true ;
+        }
+        
+        MutexLocker lck( m_mutex );
+        auto it = m_jobs.find( id );
+        assert( it != m_jobs.end() && "Running job removed from LoadingQueue." );
+        
+        bool cancelled = failed || it->second.cancelled ;
+        pComplete( id , cancelled ? LoadingJobState::Cancelled : LoadingJobState::Finished );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void LoadingQueue::pComplete( LoadingJobId id , LoadingJobState state )
+    {
+        Vector < LoadingJobId > completed( 1 , id );
+        Vector < LoadingJobState > states( 1 , state );
+        bool ready = false ;
+        
+        for ( std::size_t i = 0 ; i < completed.size() ; ++i )
+        {
+            auto it = m_jobs.find( completed[i] );
+            
+            if ( it == m_jobs.end() )
+                continue ;
+            
+            Job job = std::move( it->second );
+            m_jobs.erase( it );
+            
+            // Jobs without callback have nothing to dispatch.
+            if ( job.callback )
+                m_completions.push_back( Completion{ completed[i] , states[i] , std::move( job.callback ) } );
+            
+            for ( LoadingJobId dependent : job.dependents )
+            {
+                auto other = m_jobs.find( dependent );
+                
+                if ( other == m_jobs.end() )
+                    continue ;
+                
+                if ( states[i] == LoadingJobState::Cancelled )
+                {
+                    completed.push_back( dependent );
+                    states.push_back( LoadingJobState::Cancelled );
+                }
+                
+                else if ( --other->second.waiting == 0 )
+                {
+                    other->second.state = LoadingJobState::Ready ;
+                    m_ready.push_back( ReadyJob{ other->second.priority , dependent } );
+                    std::push_heap( m_ready.begin() , m_ready.end() );
+                    ready = true ;
+                }
+            }
+        }
+        
+        if ( ready )
+            pSchedule();
+        
+        if ( m_jobs.empty() )
+        {
+            m_ready.clear();
+            m_performer.EndSynced();
+        }
+        
+        m_cond.notify_all();
     }
 }
@@ -0,0 +1,175 @@
+//  ========================================================================  //
+//
+//  File    : ATL/LockProfiler.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/LockProfiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+namespace atl
+{
+#ifdef ATL_LOCK_PROFILING
+
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Counters of a call site. Sites are never removed.
+        ///
+        /// \note Locks are used everywhere, so the sites table only
+        /// uses atomics and never takes a lock itself.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct LockSite
+        {
+            std::atomic < uint64_t >    key ;          ///< Identifies the site in the table, 0 if free.
+            std::atomic < const char* > file ;         ///< File of the site, set once the slot is claimed.
+            std::atomic < int >         line ;         ///< Line of the site.
+            std::atomic < uint64_t >    acquisitions ; ///< Number of acquisitions.
+            std::atomic < uint64_t >    wait ;         ///< Total wait, in nanoseconds.
+            std::atomic < uint64_t >    maxwait ;      ///< Longest wait, in nanoseconds.
+            std::atomic < uint64_t >    hold ;         ///< Total hold time, in nanoseconds.
+        };
+
+        ////////////////////////////////////////////////////////////
+        static const std::size_t LockSitesCount = 4096 ; ///< Size of the sites table (a power of two).
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the sites table. The last entry collects the
+        /// sites that don't fit in the table.
+        ///
+        ////////////////////////////////////////////////////////////
+        static LockSite* GetLockSites()
+        {
+            static LockSite* sites = new LockSite[ LockSitesCount + 1 ]();
+            return sites ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        LockSite* LockSiteFind( const char* file , int line )
+        {
+            LockSite* sites = GetLockSites();
+
+            // File names are string literals: their address identifies them.
+            uint64_t key = ( static_cast < uint64_t >( reinterpret_cast < uintptr_t >( file ) ) << 16 ) ^ static_cast < uint64_t >( line ) ;
+            key = key ? key : 1 ;
+
+            std::size_t index = static_cast < std::size_t >( ( key * 0x9E3779B97F4A7C15ull ) >> 52 ) & ( LockSitesCount - 1 );
+
+            for ( std::size_t probe = 0 ; probe < LockSitesCount ; ++probe )
+            {
+                LockSite& site = sites[ ( index + probe ) & ( LockSitesCount - 1 ) ];
+                uint64_t current = site.key.load( std::memory_order_acquire );
+
+                if ( current == key )
+                    return &site ;
+
+                if ( current == 0 && site.key.compare_exchange_strong( current , key , std::memory_order_acq_rel ) )
+                {
+                    site.line.store( line , std::memory_order_relaxed );
+                    site.file.store( file , std::memory_order_release );
+                    return &site ;
+                }
+
+                if ( current == key )
+                    return &site ;
+            }
+
+            LockSite& other = sites[ LockSitesCount ];
+            const char* expected = nullptr ;
+            other.file.compare_exchange_strong( expected , "<other sites>" );
+            return &other ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        void LockSiteAcquired( LockSite* site , uint64_t wait )
+        {
+            site->acquisitions.fetch_add( 1 , std::memory_order_relaxed );
+            site->wait.fetch_add( wait , std::memory_order_relaxed );
+
+            uint64_t max = site->maxwait.load( std::memory_order_relaxed );
+            while ( wait > max && !site->maxwait.compare_exchange_weak( max , wait , std::memory_order_relaxed ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        void LockSiteReleased( LockSite* site , uint64_t hold )
+        {
+            if ( site )
+                site->hold.fetch_add( hold , std::memory_order_relaxed );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::vector < LockSiteStats > GetLockSitesStats( std::size_t count )
+    {
+        // A site may appear more than once when its file name is not
+        // merged between translation units: merges them by name.
+        std::map < std::pair < std::string , int > , LockSiteStats > merged ;
+        Detail::LockSite* sites = Detail::GetLockSites();
+
+        for ( std::size_t i = 0 ; i <= Detail::LockSitesCount ; ++i )
+        {
+            const char* file = sites[i].file.load( std::memory_order_acquire );
+            if ( !file ) continue ;
+
+            int line = sites[i].line.load( std::memory_order_relaxed );
+            LockSiteStats& stats = merged[ std::make_pair( std::string( file ) , line ) ];
+
+            stats.file = file ;
+            stats.line = line ;
+            stats.acquisitions += sites[i].acquisitions.load( std::memory_order_relaxed );
+            stats.wait         += std::chrono::nanoseconds( sites[i].wait.load( std::memory_order_relaxed ) );
+            stats.hold         += std::chrono::nanoseconds( sites[i].hold.load( std::memory_order_relaxed ) );
+            stats.maxwait       = std::max( stats.maxwait , std::chrono::nanoseconds( sites[i].maxwait.load( std::memory_order_relaxed ) ) );
+        }
+
+        std::vector < LockSiteStats > result ;
+        result.reserve( merged.size() );
+
+        for ( auto const& entry : merged )
+            result.push_back( entry.second );
+
+        std::sort( result.begin() , result.end() , []( const LockSiteStats& lhs , const LockSiteStats& rhs )
+        {
+            return lhs.wait > rhs.wait ;
+        });
+
+        if ( result.size() > count )
+            result.resize( count );
+
+        return result ;
+    }
+
+#else
+
+    ////////////////////////////////////////////////////////////
+    std::vector < LockSiteStats > GetLockSitesStats( std::size_t )
+    {
+        return std::vector < LockSiteStats >();
+    }
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    void PrintLockSitesStats( std::ostream& stream , std::size_t count )
+    {
+        for ( auto const& stats : GetLockSitesStats( count ) )
+        {
+            stream << stats.file << ":" << stats.line
+                   << ": acquisitions=" << stats.acquisitions
+                   << " wait="          << stats.wait.count() << "ns"
+                   << " maxwait="       << stats.maxwait.count() << "ns"
+                   << " hold="          << stats.hold.count() << "ns"
+                   << std::endl ;
+        }
+    }
+}
@@ -15,22 +15,46 @@ namespace atl
 {
     ////////////////////////////////////////////////////////////
     ManagerCreateEvent::ManagerCreateEvent( const ResourceId& id , const String& file )
-    : m_id( id ) , m_file( file )
+    : m_ids( 1 , id ) , m_files( 1 , file )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
-    ResourceId ManagerCreateEvent::GetId() const
+    ManagerCreateEvent::ManagerCreateEvent( Vector < ResourceId > ids , StringVector files )
+    : m_ids( std::move( ids ) ) , m_files( std::move( files ) )
     {
-        return m_id.load();
+        assert( m_ids.size() == m_files.size() && "'ids' and 'files' sizes differ." );
     }
     
     ////////////////////////////////////////////////////////////
-    const String ManagerCreateEvent::GetFile() const
+    std::size_t ManagerCreateEvent::GetCount() const
     {
-        Spinlocker lck( m_spinlock );
-        return m_file ;
+        return m_ids.size();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    ResourceId ManagerCreateEvent::GetId( std::size_t index ) const
+    {
+        return index < m_ids.size() ? m_ids[index] : 0 ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const String ManagerCreateEvent::GetFile( std::size_t index ) const
+    {
+        return index < m_files.size() ? m_files[index] : String() ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const Vector < ResourceId >& ManagerCreateEvent::GetIds() const
+    {
+        return m_ids ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const StringVector& ManagerCreateEvent::GetFiles() const
+    {
+        return m_files ;
     }
     
     ////////////////////////////////////////////////////////////
@@ -45,4 +69,29 @@ namespace atl
     {
         return m_id.load();
     }
+    
+    ////////////////////////////////////////////////////////////
+    ManagerReloadEvent::ManagerReloadEvent( const ResourceId& oldid , const ResourceId& newid , const String& file )
+    : m_oldid( oldid ) , m_newid( newid ) , m_file( file )
+    {
+        
+    }
+    
+    ////////////////////////////////////////////////////////////
+    ResourceId ManagerReloadEvent::GetOldId() const
+    {
+        return m_oldid ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    ResourceId ManagerReloadEvent::GetNewId() const
+    {
+        return m_newid ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const String ManagerReloadEvent::GetFile() const
+    {
+        return m_file ;
+    }
 }
@@ -0,0 +1,125 @@
+//  ========================================================================  //
+//
+//  File    : ATL/MappedFile.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/MappedFile.hpp>
+
+#if ATL_PLATFORM == ATL_PLATFORM_LINUX || ATL_PLATFORM == ATL_PLATFORM_DARWIN
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   define ATL_HAS_MMAP 1
+#
+#endif
+
+namespace atl
+{
+    ////////////////////////////////////////////////////////////
+    MappedFile::MappedFile( const String& file , MappedFile::Access access )
+    : m_file( file ) , m_data( nullptr ) , m_size( 0 )
+    {
+#ifdef ATL_HAS_MMAP
+        int fd = ::open( file.c_str() , O_RDONLY );
+        if ( fd < 0 ) return ;
+        
+        struct stat st ;
+        if ( ::fstat( fd , &st ) == 0 && st.st_size > 0 )
+        {
+            void* data = ::mmap( nullptr , static_cast < std::size_t >( st.st_size ) , PROT_READ , MAP_PRIVATE , fd , 0 );
+            
+            if ( data != MAP_FAILED )
+            {
+                m_data = reinterpret_cast < const char* >( data );
+                m_size = static_cast < std::size_t >( st.st_size );
+            }
+        }
+        
+        // The mapping keeps its own reference to the file.
+        ::close( fd );
+        
+        if ( m_data )
+            Advise( access );
+        
+#else
+        std::ifstream ifs( file , std::ifstream::binary );
+        if ( !ifs ) return ;
+        
+        ifs.seekg( 0 , ifs.end );
+        std::streamoff length = ifs.tellg();
+        ifs.seekg( 0 , ifs.beg );
+        
+        if ( length > 0 )
+        {
+            m_buffer.resize( static_cast < std::size_t >( length ) );
+            ifs.read( m_buffer.data() , length );
+            
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+        
+#endif
+    }
+    
+    ////////////////////////////////////////////////////////////
+    MappedFile::~MappedFile()
+    {
+#ifdef ATL_HAS_MMAP
+        if ( m_data )
+            ::munmap( const_cast < char* >( m_data ) , m_size );
+#endif
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool MappedFile::IsValid() const
+    {
+        return m_data != nullptr ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const char* MappedFile::GetData() const
+    {
+        return m_data ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t MappedFile::GetSize() const
+    {
+        return m_size ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const String& MappedFile::GetFile() const
+    {
+        return m_file ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void MappedFile::Advise( MappedFile::Access access ) const
+    {
+#ifdef ATL_HAS_MMAP
+        if ( !m_data )
+            return ;
+        
+        int advice = MADV_NORMAL ;
+        
+        switch ( access )
+        {
+            case Access::Sequential: advice = MADV_SEQUENTIAL ; break ;
+            case Access::Random:     advice = MADV_RANDOM ;     break ;
+            case Access::WillNeed:   advice = MADV_WILLNEED ;   break ;
+            default: break ;
+        }
+        
+        ::madvise( const_cast < char* >( m_data ) , m_size , advice );
+#endif
+    }
+}
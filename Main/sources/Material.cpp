@@ -15,7 +15,7 @@
 namespace atl
 {
     ////////////////////////////////////////////////////////////
-    Material::Material() : Resource()
+    Material::Material() : Resource() , m_name( Symbol() )
     {
         m_textures.insert( m_textures.end() , 4 , Weak < Texture >() );
         m_customs.insert( m_customs.end() , 5 , ParameterValue() );
@@ -31,6 +31,15 @@ namespace atl
     void Material::Prepare( const Program& program )
     {
         MutexLocker lck( m_mutex );
+        
+        // Textures follow their reloads (see 'Manager::Reload()').
+        MoveToLatest( m_texambient );
+        MoveToLatest( m_texdiffuse );
+        MoveToLatest( m_texspecular );
+        
+        for ( auto& texture : m_textures )
+            MoveToLatest( texture );
+        
         program.BindAlias( Alias::MaterialAmbient , ParameterValue( m_ambient ) );
         program.BindAlias( Alias::MaterialDiffuse , ParameterValue( m_diffuse ) );
         program.BindAlias( Alias::MaterialSpecular , ParameterValue( m_specular ) );
@@ -109,7 +118,7 @@ namespace atl
     const Weak < Texture > Material::GetTextureAmbient() const
     {
         MutexLocker lck( m_mutex );
-        return m_texambient ;
+        return GetLatest( m_texambient.lock() );
     }
     
     ////////////////////////////////////////////////////////////
@@ -123,7 +132,7 @@ namespace atl
     const Weak < Texture > Material::GetTextureDiffuse() const
     {
         MutexLocker lck( m_mutex );
-        return m_texdiffuse ;
+        return GetLatest( m_texdiffuse.lock() );
     }
     
     ////////////////////////////////////////////////////////////
@@ -137,7 +146,7 @@ namespace atl
     const Weak < Texture > Material::GetTextureSpecular() const
     {
         MutexLocker lck( m_mutex );
-        return m_texspecular ;
+        return GetLatest( m_texspecular.lock() );
     }
     
     ////////////////////////////////////////////////////////////
@@ -154,10 +163,10 @@ namespace atl
         
         switch (alias)
         {
-            case Alias::MaterialTexture1: return m_textures.at( 0 );
-            case Alias::MaterialTexture2: return m_textures.at( 1 );
-            case Alias::MaterialTexture3: return m_textures.at( 2 );
-            case Alias::MaterialTexture4: return m_textures.at( 3 );
+            case Alias::MaterialTexture1: return GetLatest( m_textures.at( 0 ).lock() );
+            case Alias::MaterialTexture2: return GetLatest( m_textures.at( 1 ).lock() );
+            case Alias::MaterialTexture3: return GetLatest( m_textures.at( 2 ).lock() );
+            case Alias::MaterialTexture4: return GetLatest( m_textures.at( 3 ).lock() );
             default: return Weak < Texture >();
         }
     }
@@ -241,15 +250,19 @@ namespace atl
     ////////////////////////////////////////////////////////////
     const String Material::GetName() const
     {
-        MutexLocker lck( m_mutex );
-        return m_name ;
+        return m_name.load().GetString();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Symbol Material::GetSymbol() const
+    {
+        return m_name.load();
     }
     
     ////////////////////////////////////////////////////////////
     void Material::SetName( const String& name )
     {
-        MutexLocker lck( m_mutex );
-        m_name = name ;
+        m_name.store( Symbol( name ) );
     }
     
     ////////////////////////////////////////////////////////////
@@ -263,6 +276,19 @@ namespace atl
     WeakVector < Texture > Material::GetTextures() const
     {
         MutexLocker lck( m_mutex );
-        return m_textures ;
+        WeakVector < Texture > textures ;
+        textures.reserve( m_textures.size() );
+        
+        for ( auto const& texture : m_textures )
+            textures.push_back( GetLatest( texture.lock() ) );
+        
+        return textures ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t Material::GetCPUSize() const
+    {
+        MutexLocker lck( m_mutex );
+        return sizeof( Material ) + m_textures.capacity() * sizeof( Weak < Texture > ) + m_customs.capacity() * sizeof( ParameterValue );
     }
 }
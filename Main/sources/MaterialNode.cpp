@@ -11,6 +11,7 @@
 //  ========================================================================  //
 #include <ATL/MaterialNode.hpp>
 #include <ATL/AggregatedMaterial.hpp>
+#include <ATL/BinaryScene.hpp>
 
 namespace atl
 {
@@ -30,19 +31,20 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void MaterialNode::SetMaterial( const Weak < atl::Material >& material )
     {
-        m_material = material ;
+        m_material.Set( material );
     }
     
     ////////////////////////////////////////////////////////////
     Weak < Material > MaterialNode::GetMaterial() const
     {
-        return m_material ;
+        return GetLatest( m_material.Lock() );
     }
     
     ////////////////////////////////////////////////////////////
     void MaterialNode::Aggregate( AggregatedMaterial& material , RenderCommand& command ) const
     {
-        auto thismat = m_material.lock();
+        // Follows the material's reloads (see 'Manager::Reload()').
+        auto thismat = GetLatest( m_material.Lock() );
         
         material.SetAmbient( thismat->GetAmbient() );
         material.SetDiffuse( thismat->GetDiffuse() );
@@ -55,4 +57,18 @@ namespace atl
         
         DerivedNode < MaterialNode >::Aggregate( material , command );
     }
+    
+    ////////////////////////////////////////////////////////////
+    void MaterialNode::WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const
+    {
+        Node::WriteBinaryRecord( record , reference );
+        
+        auto material = GetLatest( m_material.Lock() );
+        
+        if ( material )
+        {
+            reference.object = material.get();
+            reference.path   = material->GetFile();
+        }
+    }
 }
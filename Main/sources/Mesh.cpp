@@ -11,11 +11,113 @@
 //  ========================================================================  //
 #include <ATL/Mesh.hpp>
 #include <ATL/RenderWindow.hpp>
+#include <ATL/ResourceCache.hpp>
+#include <ATL/VertexQuantizer.hpp>
 
 namespace atl
-{    
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief A mesh, or submesh, in a cache file.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct MeshCacheRecord
+        {
+            uint32_t parent ;      ///< Index of the parent record, or 'MeshCacheNone' for the mesh itself.
+            uint32_t vcount ;      ///< Number of vertexes.
+            uint32_t icount ;      ///< Number of indexes.
+            uint32_t itype ;       ///< IndexType of the indexes.
+            uint32_t ibuffer ;     ///< Index of the index buffer section, or 'MeshCacheNone'.
+            uint32_t firstbuffer ; ///< Index of the first vertex buffer section.
+            uint32_t buffers ;     ///< Number of vertex buffers.
+            uint32_t firstcomp ;   ///< Index of the first component.
+            uint32_t comps ;       ///< Number of components.
+            uint32_t reserved ;    ///< Padding, always zero.
+        };
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief A VertexComponent in a cache file.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct MeshCacheComponent
+        {
+            uint32_t attrib ;   ///< Attribute of the component.
+            uint32_t type ;     ///< Type of the component.
+            uint64_t stride ;   ///< Stride of the component.
+            uint64_t offset ;   ///< Offset of the component.
+            uint32_t buffer ;   ///< Index of its buffer among the record's buffers.
+            uint32_t reserved ; ///< Padding, always zero.
+        };
+        
+        ////////////////////////////////////////////////////////////
+        static const uint32_t MeshCacheNone = 0xFFFFFFFF ;
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Sections of a cached Mesh. The digit is the version of
+        /// the records: changing them gives new tags.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const uint32_t MeshCacheRecords    = ResourceCacheTag( 'M' , 'S' , 'H' , '1' );
+        static const uint32_t MeshCacheComponents = ResourceCacheTag( 'M' , 'C' , 'P' , '1' );
+        static const uint32_t MeshCacheVertexes   = ResourceCacheTag( 'M' , 'V' , 'B' , '1' );
+        static const uint32_t MeshCacheIndexes    = ResourceCacheTag( 'M' , 'I' , 'B' , '1' );
+        
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the bounding sphere of the positions of a
+        /// mesh, centered on their bounding box.
+        ///
+        /// Positions are read from the first 'Attribute::Position1'
+        /// component, whatever its float type is. If there is none, the
+        /// sphere has a negative radius.
+        ///
+        ////////////////////////////////////////////////////////////
+        static glm::vec4 MeshBoundingSphere( const Vector < VertexComponent >& comps , uint32_t vcount )
+        {
+            for ( auto const& component : comps )
+            {
+                auto cbuffer = component.GetCBuffer().lock();
+                
+                if ( component.GetAttribute() != Attribute::Position1 || !cbuffer || !vcount )
+                    continue ;
+                
+                const CBuffer& buffer = *cbuffer ;
+                std::size_t size   = VertexComponent::GetSizeFor( component.GetType() );
+                std::size_t stride = component.GetStride() ? component.GetStride() : size ;
+                
+                if ( !size || component.GetOffset() + ( vcount - 1 ) * stride + size > buffer.GetSize() )
+                    break ;
+                
+                Vector < glm::vec3 > positions( vcount );
+                const unsigned char* src = reinterpret_cast < const unsigned char* >( buffer.GetData() ) + component.GetOffset();
+                
+                if ( !VertexQuantizer::Convert( src , stride , component.GetType() , positions.data() , sizeof( glm::vec3 ) , VertexComponent::R32G32B32Float , vcount ) )
+                    break ;
+                
+                glm::vec3 lo = positions[0] ;
+                glm::vec3 hi = positions[0] ;
+                
+                for ( auto const& position : positions )
+                {
+                    lo = glm::min( lo , position );
+                    hi = glm::max( hi , position );
+                }
+                
+                glm::vec3 center = ( lo + hi ) * 0.5f ;
+                float     radius = 0.0f ;
+                
+                for ( auto const& position : positions )
+                    radius = std::max( radius , glm::dot( position - center , position - center ) );
+                
+                return glm::vec4( center , std::sqrt( radius ) );
+            }
+            
+            return glm::vec4( 0.0f , 0.0f , 0.0f , -1.0f );
+        }
+    }
+        
     ////////////////////////////////////////////////////////////
-    Mesh::Mesh() : m_dirty( false )
+    Mesh::Mesh() : m_dirty( false ) , m_optimized( false )
     {
         
     }
@@ -40,6 +142,7 @@ namespace atl
         
         m_comps.push_back( component );
         m_dirty.store( true );
+        m_optimized.store( false );
     }
     
     ////////////////////////////////////////////////////////////
@@ -53,6 +156,7 @@ namespace atl
         {
             m_vbufs.push_back( buffer );
             m_dirty.store( true );
+            m_optimized.store( false );
         }
     }
     
@@ -62,6 +166,7 @@ namespace atl
         MutexLocker lck( m_mutex );
         m_comps.push_back( component );
         m_dirty.store( true );
+        m_optimized.store( false );
     }
     
     ////////////////////////////////////////////////////////////
@@ -69,6 +174,7 @@ namespace atl
     {
         m_vcount.store( count );
         m_dirty.store( true );
+        m_optimized.store( false );
     }
     
     ////////////////////////////////////////////////////////////
@@ -83,6 +189,7 @@ namespace atl
         m_icount.store( count );
         m_itype = type ;
         m_dirty.store( true );
+        m_optimized.store( false );
     }
     
     ////////////////////////////////////////////////////////////
@@ -103,10 +210,16 @@ namespace atl
         auto rwindow = renderwindow.lock();
         MutexLocker lck( m_mutex );
         
+        auto optimizer = MeshOptimizer::Get();
+        
+        if ( optimizer )
+            pOptimize( *optimizer );
+        
         if ( !m_vbufs.empty() && !m_comps.empty() )
         {
             auto command = rwindow->CreateVertexCommand( m_comps , m_vbufs , m_vcount.load() , m_ibuf , m_icount.load() , m_itype );
             assert( command && "'RenderWindow::CreateVertexCommand()' failed." );
+            command->SetBoundingSphere( Detail::MeshBoundingSphere( m_comps , m_vcount.load() ) );
             m_command = command ;
             m_dirty.store( false );
         }
@@ -149,4 +262,313 @@ namespace atl
         MutexLocker lck( m_mutex );
         return m_command ;
     }
+    
+    ////////////////////////////////////////////////////////////
+    Vector < VertexComponent > Mesh::GetVertexComponents() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_comps ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    SharedVector < CBuffer > Mesh::GetVertexCBuffers() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_vbufs ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    uint32_t Mesh::GetVertexCount() const
+    {
+        return m_vcount.load();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Shared < CBuffer > Mesh::GetIndexCBuffer() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_ibuf ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    uint32_t Mesh::GetIndexCount() const
+    {
+        return m_icount.load();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    IndexType Mesh::GetIndexType() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_itype ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Weak < Material > Mesh::GetMaterial() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_material ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t Mesh::GetCPUSize() const
+    {
+        MutexLocker lck( m_mutex );
+        std::size_t size = m_ibuf ? m_ibuf->GetSize() : 0 ;
+        
+        for ( auto const& buffer : m_vbufs )
+            size += buffer->GetSize();
+        
+        for ( auto const& submesh : m_submeshes )
+            size += submesh->GetCPUSize();
+        
+        return size ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t Mesh::GetGPUSize() const
+    {
+        MutexLocker lck( m_mutex );
+        std::size_t size = 0 ;
+        
+        if ( m_command )
+        {
+            // Ranges of shared buffers only count for their own size.
+            auto ranges = m_command->GetBufferRanges();
+            
+            for ( auto const& range : ranges )
+                size += range->GetSize();
+            
+            if ( ranges.empty() )
+            {
+                Buffer*  buffers[VertexFormat::MaxSlots] ;
+                uint32_t count = m_command->GetVertexBuffers( buffers , VertexFormat::MaxSlots );
+                
+                for ( uint32_t i = 0 ; i < count ; ++i )
+                    size += buffers[i]->GetSize();
+                
+                auto ibuffer = m_command->GetIndexBuffer().lock();
+                if ( ibuffer )
+                    size += ibuffer->GetSize();
+            }
+        }
+        
+        for ( auto const& submesh : m_submeshes )
+            size += submesh->GetGPUSize();
+        
+        return size ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    MeshOptimizerReport Mesh::Optimize( MeshOptimizer& optimizer )
+    {
+        MeshOptimizerReport report ;
+        SharedVector < Mesh > submeshes ;
+        
+        {
+            MutexLocker lck( m_mutex );
+            report    = pOptimize( optimizer );
+            submeshes = m_submeshes ;
+        }
+        
+        for ( auto const& submesh : submeshes )
+            report += submesh->Optimize( optimizer );
+        
+        return report ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Mesh::DWriteCache( ResourceCacheWriter& writer ) const
+    {
+        Vector < Detail::MeshCacheRecord >    records ;
+        Vector < Detail::MeshCacheComponent > comps ;
+        Vector < Pair < const Mesh* , uint32_t > > stack ;
+        uint32_t vbuffers = 0 ;
+        uint32_t ibuffers = 0 ;
+        
+        // Preorder, so a parent is always before its submeshes.
+        stack.push_back( Pair < const Mesh* , uint32_t >( this , Detail::MeshCacheNone ) );
+        
+        while ( !stack.empty() )
+        {
+            const Mesh* mesh   = stack.back().first ;
+            uint32_t    parent = stack.back().second ;
+            stack.pop_back();
+            
+            MutexLocker lck( mesh->m_mutex );
+            
+            Detail::MeshCacheRecord record ;
+            memset( &record , 0 , sizeof( Detail::MeshCacheRecord ) );
+            record.parent      = parent ;
+            record.vcount      = mesh->m_vcount.load();
+            record.icount      = mesh->m_ibuf ? mesh->m_icount.load() : 0 ;
+            record.itype       = static_cast < uint32_t >( mesh->m_itype );
+            record.ibuffer     = mesh->m_ibuf ? ibuffers++ : Detail::MeshCacheNone ;
+            record.firstbuffer = vbuffers ;
+            record.buffers     = static_cast < uint32_t >( mesh->m_vbufs.size() );
+            record.firstcomp   = static_cast < uint32_t >( comps.size() );
+            record.comps       = static_cast < uint32_t >( mesh->m_comps.size() );
+            
+            for ( auto const& buffer : mesh->m_vbufs )
+                writer.Add( Detail::MeshCacheVertexes , *buffer );
+            
+            vbuffers += record.buffers ;
+            
+            if ( mesh->m_ibuf )
+                writer.Add( Detail::MeshCacheIndexes , *( mesh->m_ibuf ) );
+            
+            for ( auto const& component : mesh->m_comps )
+            {
+                auto cbuffer = component.GetCBuffer().lock();
+                auto it = std::find( mesh->m_vbufs.begin() , mesh->m_vbufs.end() , cbuffer );
+                
+                if ( it == mesh->m_vbufs.end() )
+                    return false ;
+                
+                Detail::MeshCacheComponent comp ;
+                memset( &comp , 0 , sizeof( Detail::MeshCacheComponent ) );
+                comp.attrib = static_cast < uint32_t >( component.GetAttribute() );
+                comp.type   = component.GetType();
+                comp.stride = component.GetStride();
+                comp.offset = component.GetOffset();
+                comp.buffer = static_cast < uint32_t >( it - mesh->m_vbufs.begin() );
+                comps.push_back( comp );
+            }
+            
+            uint32_t index = static_cast < uint32_t >( records.size() );
+            records.push_back( record );
+            
+            for ( auto it = mesh->m_submeshes.rbegin() ; it != mesh->m_submeshes.rend() ; ++it )
+                stack.push_back( Pair < const Mesh* , uint32_t >( it->get() , index ) );
+        }
+        
+        writer.AddArray( Detail::MeshCacheRecords , records );
+        writer.AddArray( Detail::MeshCacheComponents , comps );
+        return true ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Mesh::DReadCache( const ResourceCacheReader& reader )
+    {
+        std::size_t recordscount = 0 ;
+        std::size_t compscount   = 0 ;
+        
+        auto records = reader.FindArray < Detail::MeshCacheRecord >( Detail::MeshCacheRecords , recordscount );
+        auto comps   = reader.FindArray < Detail::MeshCacheComponent >( Detail::MeshCacheComponents , compscount );
+        
+        if ( !records || !recordscount || records[0].parent != Detail::MeshCacheNone || ( !comps && compscount ) )
+            return false ;
+        
+        uint32_t vbuffers = reader.GetCount( Detail::MeshCacheVertexes );
+        uint32_t ibuffers = reader.GetCount( Detail::MeshCacheIndexes );
+        
+        // Submeshes are added to their parent once they are filled.
+        SharedVector < Mesh > meshes( recordscount );
+        
+        for ( std::size_t i = 0 ; i < recordscount ; ++i )
+        {
+            const Detail::MeshCacheRecord& record = records[i] ;
+            
+            if ( ( i && record.parent >= i ) || record.firstbuffer > vbuffers || record.buffers > vbuffers - record.firstbuffer
+              || record.firstcomp > compscount || record.comps > compscount - record.firstcomp
+              || ( record.ibuffer != Detail::MeshCacheNone && ( record.ibuffer >= ibuffers || !record.icount ) ) )
+                return false ;
+            
+            Mesh* mesh = this ;
+            
+            if ( i )
+            {
+                meshes[i] = std::make_shared < Mesh >();
+                mesh = meshes[i].get();
+            }
+            
+            SharedVector < CBuffer > buffers ;
+            
+            for ( uint32_t b = 0 ; b < record.buffers ; ++b )
+            {
+                buffers.push_back( std::make_shared < CBuffer >( reader.Find( Detail::MeshCacheVertexes , record.firstbuffer + b ) ) );
+                mesh->AddVertexCBuffer( buffers.back() );
+            }
+            
+            for ( uint32_t c = record.firstcomp ; c < record.firstcomp + record.comps ; ++c )
+            {
+                if ( comps[c].buffer >= buffers.size() )
+                    return false ;
+                
+                mesh->AddVertexComponent( VertexComponent( static_cast < Attribute >( comps[c].attrib ) , comps[c].type ,
+                                                           static_cast < uintptr_t >( comps[c].stride ) ,
+                                                           static_cast < uintptr_t >( comps[c].offset ) ,
+                                                           Weak < CBuffer >( buffers[ comps[c].buffer ] ) ) );
+            }
+            
+            mesh->SetVertexCount( record.vcount );
+            
+            if ( record.ibuffer != Detail::MeshCacheNone )
+            {
+                auto ibuffer = std::make_shared < CBuffer >( reader.Find( Detail::MeshCacheIndexes , record.ibuffer ) );
+                mesh->SetIndexCBuffer( ibuffer , record.icount , static_cast < IndexType >( record.itype ) );
+            }
+        }
+        
+        for ( std::size_t i = 1 ; i < recordscount ; ++i )
+        {
+            Mesh* parent = records[i].parent ? meshes[ records[i].parent ].get() : this ;
+            parent->AddSubmesh( meshes[i] );
+        }
+        
+        return true ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Mesh::ResetVertexData()
+    {
+        MutexLocker lck( m_mutex );
+        m_comps.clear();
+        m_vbufs.clear();
+        m_ibuf.reset();
+        m_vcount.store( 0 );
+        m_icount.store( 0 );
+        m_itype = IndexType::Unknown ;
+        m_dirty.store( true );
+        m_optimized.store( false );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Mesh::SetDirty()
+    {
+        m_dirty.store( true );
+        m_optimized.store( false );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    MeshOptimizerReport Mesh::pOptimize( MeshOptimizer& optimizer )
+    {
+        if ( m_optimized.load() )
+            return MeshOptimizerReport();
+        
+        MeshData data ;
+        data.components = m_comps ;
+        data.vbuffers   = m_vbufs ;
+        data.vcount     = m_vcount.load();
+        data.ibuffer    = m_ibuf ;
+        data.icount     = m_icount.load();
+        data.itype      = m_itype ;
+        
+        MeshOptimizerReport report = optimizer.Optimize( data );
+        m_optimized.store( true );
+        
+        // Data which can't be optimized is left untouched.
+        if ( !report.meshes )
+            return report ;
+        
+        m_comps  = std::move( data.components );
+        m_vbufs  = std::move( data.vbuffers );
+        m_vcount.store( data.vcount );
+        m_ibuf   = data.ibuffer ;
+        m_icount.store( data.icount );
+        m_itype  = data.itype ;
+        m_dirty.store( true );
+        
+        return report ;
+    }
 }
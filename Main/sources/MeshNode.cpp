@@ -15,46 +15,75 @@
 #include <ATL/AggregatedMaterial.hpp>
 #include <ATL/AggregatedNode.hpp>
 #include <ATL/AggregatedGroup.hpp>
+#include <ATL/BinaryScene.hpp>
+#include <ATL/PoolAllocator.hpp>
 
 namespace atl
-{
-	////////////////////////////////////////////////////////////
-	Shared < AggregatedNode > MeshNode::CreateAggregatedNode( const NodesBySubtype& lsnodes , const AggregatedGroup& group ) const
-	{
-		auto mesh = m_mesh.Get().lock();
-		assert( mesh );
-		
-		auto vcommand = mesh->GetVertexCommand();
-		assert( vcommand );
-		
-		auto agmaterial = std::make_shared < AggregatedMaterial >();
-		assert( agmaterial );
-		
-		auto command = std::make_shared < RenderCommand >( vcommand , agmaterial );
-		assert( command );
-		
-		auto agnode = std::make_shared < AggregatedNode >( lsnodes , command , agmaterial );
-		assert( anode );
-		
-		return agnode ;
-	}
-	
-	////////////////////////////////////////////////////////////
-	MeshNode::MeshNode( const Weak < atl::Mesh >& mesh ) 
-	: DerivedNode < MeshNode >( Node::Subtype::Mesh ) , m_mesh( mesh )
-	{
-		
-	}
-	
-	////////////////////////////////////////////////////////////
-	MeshNode::~MeshNode()
-	{
-		
-	}
+{
+	////////////////////////////////////////////////////////////
+	Shared < AggregatedNode > MeshNode::CreateAggregatedNode( const NodesBySubtype& lsnodes , const AggregatedGroup& group ) const
+	{
+		auto mesh = m_mesh.Get().lock();
+		assert( mesh );
+		
+		auto vcommand = mesh->GetVertexCommand();
+		assert( vcommand );
+		
+		auto agmaterial = MakePooled < AggregatedMaterial >();
+		assert( agmaterial );
+		
+		auto command = MakePooled < RenderCommand >( vcommand , agmaterial );
+		assert( command );
+		
+		auto agnode = MakePooled < AggregatedNode >( lsnodes , command , agmaterial );
+		assert( agnode );
+		
+		return agnode ;
+	}
+	
+	////////////////////////////////////////////////////////////
+	MeshNode::MeshNode( const Weak < atl::Mesh >& mesh ) 
+	: DerivedNode < MeshNode >( Node::Subtype::Mesh ) , m_mesh( mesh ) , m_holder( mesh )
+	{
+		
+	}
+	
+	////////////////////////////////////////////////////////////
+	MeshNode::~MeshNode()
+	{
+		
+	}
+	
+    ////////////////////////////////////////////////////////////
+    void MeshNode::SetMesh( const Weak < atl::Mesh >& mesh )
+    {
+        MutexLocker lck( m_mutex );
+        m_mesh.Set( mesh );
+        m_holder.Set( mesh );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Weak < atl::Mesh > MeshNode::GetMesh() const
+    {
+        return GetLatest( m_mesh.Get().lock() );
+    }
 	
     ////////////////////////////////////////////////////////////
     void MeshNode::Update( NodesBySubtype& lsnodes , AggregatedGroup& group ) const
     {
+        // A mesh reloaded by its Manager is replaced by the new one, and its aggregated
+        // nodes are created again with the new vertex command.
+        auto mesh = m_mesh.Get().lock();
+        
+        if ( mesh && mesh->IsOutdated() )
+        {
+            auto latest = GetLatest( mesh );
+            
+            MutexLocker lck( m_mutex );
+            m_mesh.Set( latest );
+            m_holder.Set( latest );
+        }
+        
         if ( m_mesh.IsDirty() )
         {
             // When handled mesh is dirty, it means user have changed the mesh handled by this
@@ -70,11 +99,11 @@ namespace atl
         
         // Tries to find an AggregatedNode registered in the group for the given lsnodes map. If not found,
         // we must create a new aggregated node.
-        
+        
         MutexLocker lck( m_mutex );
-        lsnodes[GetSubtype()] = std::const_pointer_cast < Node >( Node::shared_from_this() );
+        lsnodes[GetSubtype()] = std::const_pointer_cast < Node >( std::static_pointer_cast < const Node >( Node::shared_from_this() ) );
         
-        auto agit = std::find_if( m_agnodes.begin() , m_agnodes.end() , [lsnodes,group](const Shared<AggregatedNode>& agnode) {
+        auto agit = std::find_if( m_agnodes.begin() , m_agnodes.end() , [&lsnodes,&group](const Shared<AggregatedNode>& agnode) {
             assert( agnode );
             return agnode->IsLsnodesEqual( lsnodes , group );
         });
@@ -93,10 +122,24 @@ namespace atl
             auto agnode = group.FindNode( *agit );
             if ( agnode.expired() )
             {
-                group.AppendNode( agnode );
+                group.AppendNode( *agit );
             }
         }
         
         return Node::Update( lsnodes , group );
     }
+    
+    ////////////////////////////////////////////////////////////
+    void MeshNode::WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const
+    {
+        Node::WriteBinaryRecord( record , reference );
+        
+        auto mesh = GetLatest( m_mesh.Get().lock() );
+        
+        if ( mesh )
+        {
+            reference.object = mesh.get();
+            reference.path   = mesh->GetFile();
+        }
+    }
 }
@@ -0,0 +1,737 @@
+//  ========================================================================  //
+//
+//  File    : ATL/MeshOptimizer.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/MeshOptimizer.hpp>
+#include <ATL/Hash.hpp>
+#include <ATL/VertexQuantizer.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        static const uint32_t MeshOptimizerNone = 0xFFFFFFFF ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Constants of the Forsyth's vertex score, from the
+        /// original article.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const float ForsythCacheDecayPower   = 1.5f ;
+        static const float ForsythLastTriScore      = 0.75f ;
+        static const float ForsythValenceBoostScale = 2.0f ;
+        static const float ForsythValenceBoostPower = 0.5f ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the score of a vertex from its position in
+        /// the LRU cache (or -1) and its number of triangles left.
+        ///
+        ////////////////////////////////////////////////////////////
+        static float ForsythVertexScore( int position , uint32_t valence , uint32_t cachesize )
+        {
+            if ( !valence )
+                return -1.0f ;
+
+            float score = 0.0f ;
+
+            if ( position >= 0 )
+            {
+                // The last triangle's vertexes have a fixed score, so a
+                // triangle sharing an edge is not always preferred.
+                if ( position < 3 )
+                {
+                    score = ForsythLastTriScore ;
+                }
+
+                else
+                {
+                    float scaler = 1.0f / static_cast < float >( cachesize - 3 );
+                    score = std::pow( 1.0f - static_cast < float >( position - 3 ) * scaler , ForsythCacheDecayPower );
+                }
+            }
+
+            // Vertexes with few triangles left are boosted, so they are
+            // finished instead of being left alone.
+            return score + ForsythValenceBoostScale * std::pow( static_cast < float >( valence ) , -ForsythValenceBoostPower );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of an index of given type, or 0.
+        ///
+        ////////////////////////////////////////////////////////////
+        static std::size_t MeshOptimizerIndexSize( IndexType type )
+        {
+            switch ( type )
+            {
+                case IndexType::UI8:  case IndexType::I8:  return 1 ;
+                case IndexType::UI16: case IndexType::I16: return 2 ;
+                case IndexType::UI32: case IndexType::I32: return 4 ;
+                default: return 0 ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Reads 'count' indexes of given type.
+        ///
+        /// \return False if the buffer is too small or the type unknown.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool MeshOptimizerReadIndexes( const CBuffer& buffer , uint32_t count , IndexType type , Vector < uint32_t >& indexes )
+        {
+            std::size_t size = MeshOptimizerIndexSize( type );
+
+            if ( !size || buffer.GetSize() < static_cast < std::size_t >( count ) * size )
+                return false ;
+
+            const unsigned char* data = reinterpret_cast < const unsigned char* >( buffer.GetData() );
+            indexes.resize( count );
+
+            for ( uint32_t i = 0 ; i < count ; ++i )
+            {
+                if ( size == 1 )
+                {
+                    indexes[i] = data[i] ;
+                }
+
+                else if ( size == 2 )
+                {
+                    uint16_t index ;
+                    memcpy( &index , data + i * 2 , 2 );
+                    indexes[i] = index ;
+                }
+
+                else
+                {
+                    memcpy( &indexes[i] , data + i * 4 , 4 );
+                }
+            }
+
+            return true ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes indexes with given type, which must be able to
+        /// hold every index.
+        ///
+        ////////////////////////////////////////////////////////////
+        static Shared < CBuffer > MeshOptimizerWriteIndexes( const Vector < uint32_t >& indexes , IndexType type )
+        {
+            std::size_t size   = MeshOptimizerIndexSize( type );
+            auto        buffer = std::make_shared < CBuffer >( CBuffer::Allocate( indexes.size() * size ) );
+            unsigned char* data = reinterpret_cast < unsigned char* >( buffer->GetMutableData() );
+
+            for ( std::size_t i = 0 ; i < indexes.size() ; ++i )
+            {
+                if ( size == 1 )
+                {
+                    data[i] = static_cast < uint8_t >( indexes[i] );
+                }
+
+                else if ( size == 2 )
+                {
+                    uint16_t index = static_cast < uint16_t >( indexes[i] );
+                    memcpy( data + i * 2 , &index , 2 );
+                }
+
+                else
+                {
+                    memcpy( data + i * 4 , &indexes[i] , 4 );
+                }
+            }
+
+            return buffer ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the smallest unsigned index type of at least
+        /// 'minsize' bytes able to address 'vcount' vertexes.
+        ///
+        ////////////////////////////////////////////////////////////
+        static IndexType MeshOptimizerIndexType( uint32_t vcount , std::size_t minsize )
+        {
+            if ( minsize <= 1 && vcount <= 0x100 )
+                return IndexType::UI8 ;
+
+            if ( minsize <= 2 && vcount <= 0x10000 )
+                return IndexType::UI16 ;
+
+            return IndexType::UI32 ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if every element of a 32 bits floats
+        /// component is in [lo, hi].
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool MeshOptimizerIsInRange( const unsigned char* src , std::size_t stride , std::size_t elements ,
+                                            uint32_t vcount , float lo , float hi )
+        {
+            for ( uint32_t v = 0 ; v < vcount ; ++v )
+            {
+                const float* values = reinterpret_cast < const float* >( src + v * stride );
+
+                for ( std::size_t e = 0 ; e < elements ; ++e )
+                {
+                    if ( !( values[e] >= lo && values[e] <= hi ) )
+                        return false ;
+                }
+            }
+
+            return true ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the compact type a component is quantized to,
+        /// or its own type if it can't be quantized without changing
+        /// its values more than the type's precision.
+        ///
+        ////////////////////////////////////////////////////////////
+        static uint32_t MeshOptimizerCompactType( const VertexComponent& component , const unsigned char* src , std::size_t stride ,
+                                                  uint32_t vcount , const MeshOptimizerSettings& settings )
+        {
+            uint32_t  type   = component.GetType();
+            Attribute attrib = component.GetAttribute();
+
+            if ( type != VertexComponent::R32G32Float && type != VertexComponent::R32G32B32Float && type != VertexComponent::R32G32B32A32Float )
+                return type ;
+
+            std::size_t elements = VertexComponent::GetElementCountFor( type );
+
+            bool position  = attrib == Attribute::Position1 || attrib == Attribute::Position2 ;
+            bool direction = attrib == Attribute::Normal1 || attrib == Attribute::Normal2
+                          || attrib == Attribute::Tangent1 || attrib == Attribute::Tangent2
+                          || attrib == Attribute::Bitangent1 || attrib == Attribute::Bitangent2 ;
+            bool color     = attrib == Attribute::Color1 || attrib == Attribute::Color2 ;
+            bool texcoord  = attrib <= Attribute::Slot14 && elements == 2 ;
+
+            if ( position && elements >= 3 && settings.quantizepositions )
+            {
+                if ( MeshOptimizerIsInRange( src , stride , elements , vcount , -65504.0f , 65504.0f ) )
+                    return VertexComponent::R16G16B16A16Float ;
+            }
+
+            else if ( direction && elements >= 3 && settings.quantizenormals )
+            {
+                if ( MeshOptimizerIsInRange( src , stride , elements , vcount , -1.0f , 1.0f ) )
+                    return VertexComponent::R10G10B10A2Snorm ;
+            }
+
+            else if ( color && elements >= 3 && settings.quantizecolors )
+            {
+                if ( MeshOptimizerIsInRange( src , stride , elements , vcount , 0.0f , 1.0f ) )
+                    return VertexComponent::R8G8B8A8Unorm ;
+            }
+
+            else if ( texcoord && settings.quantizetexcoords )
+            {
+                // Unorm16 is more precise than half floats in [0, 1].
+                if ( MeshOptimizerIsInRange( src , stride , elements , vcount , 0.0f , 1.0f ) )
+                    return VertexComponent::R16G16Unorm ;
+
+                if ( MeshOptimizerIsInRange( src , stride , elements , vcount , -65504.0f , 65504.0f ) )
+                    return VertexComponent::R16G16Float ;
+            }
+
+            return type ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    MeshOptimizer::MeshOptimizer( const MeshOptimizerSettings& settings ) : m_settings( settings )
+    {
+        assert( m_settings.cachesize > 3 && "'cachesize' must be greater than 3." );
+        assert( m_settings.fifosize && "'fifosize' is 0." );
+    }
+
+    ////////////////////////////////////////////////////////////
+    MeshOptimizer::~MeshOptimizer()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    MeshOptimizerReport MeshOptimizer::Optimize( MeshData& data )
+    {
+        MeshOptimizerReport report ;
+
+        if ( data.components.empty() || data.vbuffers.empty() || !data.vcount )
+            return report ;
+
+        // Checks every component can be read, and packs the components of
+        // a vertex in one record: records are compared to weld vertexes.
+
+        std::size_t ccount = data.components.size();
+        Vector < const CBuffer* > sources( ccount );
+        Vector < uint32_t >       buffers( ccount );
+        Vector < uint32_t >       types( ccount );
+        Vector < std::size_t >    sizes( ccount );
+        Vector < std::size_t >    strides( ccount );
+        Vector < std::size_t >    recoffsets( ccount );
+        std::size_t               record = 0 ;
+        bool                      quantized = false ;
+
+        for ( std::size_t c = 0 ; c < ccount ; ++c )
+        {
+            const VertexComponent& component = data.components[c] ;
+            auto cbuffer = component.GetCBuffer().lock();
+            auto it = std::find( data.vbuffers.begin() , data.vbuffers.end() , cbuffer );
+
+            if ( !cbuffer || it == data.vbuffers.end() )
+                return report ;
+
+            sizes[c]   = VertexComponent::GetSizeFor( component.GetType() );
+            strides[c] = component.GetStride() ? component.GetStride() : sizes[c] ;
+
+            if ( !sizes[c] || component.GetOffset() + ( data.vcount - 1 ) * strides[c] + sizes[c] > cbuffer->GetSize() )
+                return report ;
+
+            // Records hold the quantized data, so vertexes which only differ
+            // by less than the compact type's precision are welded too.
+            const unsigned char* src = reinterpret_cast < const unsigned char* >( cbuffer->GetData() ) + component.GetOffset();
+            types[c] = Detail::MeshOptimizerCompactType( component , src , strides[c] , data.vcount , m_settings );
+            sizes[c] = VertexComponent::GetSizeFor( types[c] );
+            quantized = quantized || types[c] != component.GetType();
+
+            sources[c]    = cbuffer.get();
+            buffers[c]    = static_cast < uint32_t >( it - data.vbuffers.begin() );
+            recoffsets[c] = record ;
+
+            // Components are kept 4 bytes aligned.
+            record += ( sizes[c] + 3 ) & ~static_cast < std::size_t >( 3 );
+        }
+
+        bool indexed = data.ibuffer && data.icount && data.itype != IndexType::Unknown ;
+        Vector < uint32_t > indexes ;
+
+        if ( indexed )
+        {
+            if ( !Detail::MeshOptimizerReadIndexes( *data.ibuffer , data.icount , data.itype , indexes ) )
+                return report ;
+        }
+
+        else
+        {
+            indexes.resize( data.vcount );
+
+            for ( uint32_t i = 0 ; i < data.vcount ; ++i )
+                indexes[i] = i ;
+        }
+
+        // Contexts only draw triangle lists.
+        if ( indexes.empty() || indexes.size() % 3 )
+            return report ;
+
+        for ( uint32_t index : indexes )
+        {
+            if ( index >= data.vcount )
+                return report ;
+        }
+
+        Vector < unsigned char > packed( static_cast < std::size_t >( data.vcount ) * record , 0 );
+
+        for ( std::size_t c = 0 ; c < ccount ; ++c )
+        {
+            const VertexComponent& component = data.components[c] ;
+            const unsigned char* src = reinterpret_cast < const unsigned char* >( sources[c]->GetData() ) + component.GetOffset();
+
+            if ( types[c] != component.GetType() )
+            {
+                VertexQuantizer::Convert( src , strides[c] , component.GetType() , &packed[recoffsets[c]] , record , types[c] , data.vcount );
+            }
+
+            else
+            {
+                for ( uint32_t v = 0 ; v < data.vcount ; ++v )
+                    memcpy( &packed[v * record + recoffsets[c]] , src + v * strides[c] , sizes[c] );
+            }
+        }
+
+        // Welds vertexes: 'remap' gives the unique vertex of each vertex,
+        // and 'uniques' the first vertex of each unique vertex.
+
+        Vector < uint32_t > remap( data.vcount );
+        Vector < uint32_t > uniques ;
+        uniques.reserve( data.vcount );
+
+        if ( m_settings.weld )
+        {
+            HashMap < ContentHash , uint32_t > heads ;
+            Vector < uint32_t > next ;
+            heads.reserve( data.vcount );
+            next.reserve( data.vcount );
+
+            for ( uint32_t v = 0 ; v < data.vcount ; ++v )
+            {
+                const unsigned char* bytes = &packed[v * record] ;
+                ContentHash hash = HashBytes( bytes , record );
+                auto head = heads.find( hash );
+                uint32_t unique = head == heads.end() ? Detail::MeshOptimizerNone : head->second ;
+
+                while ( unique != Detail::MeshOptimizerNone && memcmp( bytes , &packed[uniques[unique] * record] , record ) )
+                    unique = next[unique] ;
+
+                if ( unique == Detail::MeshOptimizerNone )
+                {
+                    unique = static_cast < uint32_t >( uniques.size() );
+                    next.push_back( head == heads.end() ? Detail::MeshOptimizerNone : head->second );
+                    heads[hash] = unique ;
+                    uniques.push_back( v );
+                }
+
+                remap[v] = unique ;
+            }
+        }
+
+        else
+        {
+            for ( uint32_t v = 0 ; v < data.vcount ; ++v )
+            {
+                remap[v] = v ;
+                uniques.push_back( v );
+            }
+        }
+
+        // Indexing a mesh only helps if vertexes were welded: otherwise
+        // only its vertexes are quantized, in their order.
+        bool unindexed = !indexed && uniques.size() == data.vcount ;
+
+        if ( unindexed && !quantized )
+            return report ;
+
+        report.meshes       = 1 ;
+        report.triangles    = indexes.size() / 3 ;
+        report.vcountbefore = data.vcount ;
+        report.missesbefore = CountCacheMisses( indexes.data() , indexes.size() , m_settings.fifosize );
+
+        for ( auto const& buffer : data.vbuffers )
+            report.bytesbefore += buffer->GetSize();
+
+        if ( indexed )
+            report.bytesbefore += data.ibuffer->GetSize();
+
+        for ( uint32_t& index : indexes )
+            index = remap[index] ;
+
+        uint32_t ucount = static_cast < uint32_t >( uniques.size() );
+
+        if ( m_settings.reorderindexes && !unindexed )
+            ReorderTriangles( indexes.data() , indexes.size() , ucount , m_settings.cachesize );
+
+        // 'order' gives the unique vertex of each new vertex.
+        Vector < uint32_t > order ;
+
+        if ( m_settings.reordervertexes && !unindexed )
+        {
+            Vector < uint32_t > newids( ucount , Detail::MeshOptimizerNone );
+            order.reserve( ucount );
+
+            for ( uint32_t& index : indexes )
+            {
+                if ( newids[index] == Detail::MeshOptimizerNone )
+                {
+                    newids[index] = static_cast < uint32_t >( order.size() );
+                    order.push_back( index );
+                }
+
+                index = newids[index] ;
+            }
+        }
+
+        else
+        {
+            order.resize( ucount );
+
+            for ( uint32_t u = 0 ; u < ucount ; ++u )
+                order[u] = u ;
+        }
+
+        uint32_t vcount = static_cast < uint32_t >( order.size() );
+
+        // Writes one interleaved buffer per original buffer used by a
+        // component, with the components in the same order.
+
+        Vector < VertexComponent > components ;
+        SharedVector < CBuffer >   vbuffers ;
+        Vector < std::size_t >     newoffsets( ccount );
+
+        for ( uint32_t b = 0 ; b < data.vbuffers.size() ; ++b )
+        {
+            std::size_t stride = 0 ;
+
+            for ( std::size_t c = 0 ; c < ccount ; ++c )
+            {
+                if ( buffers[c] != b )
+                    continue ;
+
+                newoffsets[c] = stride ;
+                stride += ( sizes[c] + 3 ) & ~static_cast < std::size_t >( 3 );
+            }
+
+            if ( !stride )
+                continue ;
+
+            auto buffer = std::make_shared < CBuffer >( CBuffer::Allocate( vcount * stride ) );
+            unsigned char* dst = reinterpret_cast < unsigned char* >( buffer->GetMutableData() );
+            memset( dst , 0 , vcount * stride );
+
+            for ( std::size_t c = 0 ; c < ccount ; ++c )
+            {
+                if ( buffers[c] != b )
+                    continue ;
+
+                for ( uint32_t v = 0 ; v < vcount ; ++v )
+                    memcpy( dst + v * stride + newoffsets[c] , &packed[uniques[order[v]] * record + recoffsets[c]] , sizes[c] );
+            }
+
+            for ( std::size_t c = 0 ; c < ccount ; ++c )
+            {
+                if ( buffers[c] != b )
+                    continue ;
+
+                const VertexComponent& component = data.components[c] ;
+                components.push_back( VertexComponent( component.GetAttribute() , types[c] ,
+                                                       stride , newoffsets[c] , Weak < CBuffer >( buffer ) ) );
+            }
+
+            vbuffers.push_back( buffer );
+        }
+
+        // Components are in the order of their buffers now: restores
+        // their original order, as the Mesh's components order matters
+        // for its VertexFormat.
+        Vector < VertexComponent > ordered ;
+        ordered.reserve( ccount );
+
+        for ( std::size_t c = 0 ; c < ccount ; ++c )
+        {
+            std::size_t rank = 0 ;
+
+            for ( std::size_t o = 0 ; o < ccount ; ++o )
+            {
+                if ( buffers[o] < buffers[c] || ( buffers[o] == buffers[c] && o < c ) )
+                    rank++ ;
+            }
+
+            ordered.push_back( components[rank] );
+        }
+
+        std::size_t minsize = m_settings.shrinkindexes ? ( m_settings.allowui8 ? 1 : 2 )
+                                                       : ( indexed ? Detail::MeshOptimizerIndexSize( data.itype ) : 4 );
+        IndexType itype = Detail::MeshOptimizerIndexType( vcount , minsize );
+
+        data.components = std::move( ordered );
+        data.vbuffers   = std::move( vbuffers );
+        data.vcount     = vcount ;
+        data.ibuffer    = unindexed ? nullptr : Detail::MeshOptimizerWriteIndexes( indexes , itype );
+        data.icount     = unindexed ? 0 : static_cast < uint32_t >( indexes.size() );
+        data.itype      = unindexed ? IndexType::Unknown : itype ;
+
+        report.vcountafter = vcount ;
+        report.missesafter = CountCacheMisses( indexes.data() , indexes.size() , m_settings.fifosize );
+        report.bytesafter  = data.ibuffer ? data.ibuffer->GetSize() : 0 ;
+
+        for ( auto const& buffer : data.vbuffers )
+            report.bytesafter += buffer->GetSize();
+
+        {
+            Spinlocker lck( m_spinlock );
+            m_total += report ;
+        }
+
+        return report ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    MeshOptimizerReport MeshOptimizer::GetTotalReport() const
+    {
+        Spinlocker lck( m_spinlock );
+        return m_total ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const MeshOptimizerSettings& MeshOptimizer::GetSettings() const
+    {
+        return m_settings ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint64_t MeshOptimizer::CountCacheMisses( const uint32_t* indexes , std::size_t count , uint32_t fifosize )
+    {
+        if ( !count )
+            return 0 ;
+
+        uint32_t maxindex = *std::max_element( indexes , indexes + count );
+
+        // A vertex is in the FIFO if it entered it less than 'fifosize'
+        // misses ago: hits don't move it.
+        Vector < uint64_t > entered( static_cast < std::size_t >( maxindex ) + 1 , 0 );
+        uint64_t misses = 0 ;
+
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            uint64_t& time = entered[indexes[i]] ;
+
+            if ( !time || misses - time >= fifosize )
+            {
+                time = ++misses ;
+            }
+        }
+
+        return misses ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void MeshOptimizer::ReorderTriangles( uint32_t* indexes , std::size_t count , uint32_t vcount , uint32_t cachesize )
+    {
+        assert( count % 3 == 0 && "'count' must be a multiple of 3." );
+        assert( cachesize > 3 && "'cachesize' must be greater than 3." );
+
+        std::size_t tcount = count / 3 ;
+
+        if ( tcount < 2 )
+            return ;
+
+        // Triangles of each vertex. The triangles left for vertex 'v' are
+        // 'triangles[firsts[v]]' to 'triangles[firsts[v] + valences[v]]'.
+
+        Vector < uint32_t > valences( vcount , 0 );
+        Vector < uint32_t > firsts( vcount + 1 , 0 );
+        Vector < uint32_t > triangles( count );
+
+        for ( std::size_t i = 0 ; i < count ; ++i )
+            valences[indexes[i]]++ ;
+
+        for ( uint32_t v = 0 ; v < vcount ; ++v )
+            firsts[v + 1] = firsts[v] + valences[v] ;
+
+        {
+            Vector < uint32_t > fill( firsts.begin() , firsts.end() - 1 );
+
+            for ( std::size_t i = 0 ; i < count ; ++i )
+                triangles[fill[indexes[i]]++] = static_cast < uint32_t >( i / 3 );
+        }
+
+        Vector < int >      positions( vcount , -1 );
+        Vector < float >    vscores( vcount );
+        Vector < float >    tscores( tcount );
+        Vector < bool >     emitted( tcount , false );
+        Vector < uint32_t > cache ;
+        Vector < uint32_t > newcache ;
+        Vector < uint32_t > output ;
+
+        cache.reserve( cachesize + 3 );
+        newcache.reserve( cachesize + 3 );
+        output.reserve( count );
+
+        for ( uint32_t v = 0 ; v < vcount ; ++v )
+            vscores[v] = Detail::ForsythVertexScore( -1 , valences[v] , cachesize );
+
+        std::size_t best = 0 ;
+
+        for ( std::size_t t = 0 ; t < tcount ; ++t )
+        {
+            tscores[t] = vscores[indexes[t * 3]] + vscores[indexes[t * 3 + 1]] + vscores[indexes[t * 3 + 2]] ;
+
+            if ( tscores[t] > tscores[best] )
+                best = t ;
+        }
+
+        std::size_t cursor = 0 ;
+
+        for ( std::size_t done = 0 ; done < tcount ; ++done )
+        {
+            // No triangle in the cache: takes the next triangle left.
+            if ( best == tcount )
+            {
+                while ( emitted[cursor] )
+                    cursor++ ;
+
+                best = cursor ;
+            }
+
+            const uint32_t* triangle = indexes + best * 3 ;
+            emitted[best] = true ;
+            output.insert( output.end() , triangle , triangle + 3 );
+
+            // Removes the triangle from its vertexes.
+            for ( int k = 0 ; k < 3 ; ++k )
+            {
+                uint32_t v = triangle[k] ;
+
+                if ( k && ( v == triangle[0] || ( k == 2 && v == triangle[1] ) ) )
+                    continue ;
+
+                uint32_t* first = triangles.data() + firsts[v] ;
+                uint32_t* last  = first + valences[v] ;
+                uint32_t* it    = std::find( first , last , static_cast < uint32_t >( best ) );
+
+                while ( it != last )
+                {
+                    *it = *--last ;
+                    valences[v]-- ;
+                    it = std::find( it , last , static_cast < uint32_t >( best ) );
+                }
+            }
+
+            // The triangle's vertexes go first in the cache.
+            newcache.clear();
+
+            for ( int k = 0 ; k < 3 ; ++k )
+            {
+                if ( std::find( newcache.begin() , newcache.end() , triangle[k] ) == newcache.end() )
+                    newcache.push_back( triangle[k] );
+            }
+
+            for ( uint32_t v : cache )
+            {
+                if ( v != triangle[0] && v != triangle[1] && v != triangle[2] )
+                    newcache.push_back( v );
+            }
+
+            for ( std::size_t i = 0 ; i < newcache.size() ; ++i )
+            {
+                uint32_t v = newcache[i] ;
+                positions[v] = i < cachesize ? static_cast < int >( i ) : -1 ;
+                vscores[v]   = Detail::ForsythVertexScore( positions[v] , valences[v] , cachesize );
+            }
+
+            // Only the triangles of the updated vertexes change their score.
+            best = tcount ;
+            float bestscore = -1.0f ;
+
+            for ( uint32_t v : newcache )
+            {
+                for ( uint32_t i = firsts[v] ; i < firsts[v] + valences[v] ; ++i )
+                {
+                    uint32_t t = triangles[i] ;
+                    tscores[t] = vscores[indexes[t * 3]] + vscores[indexes[t * 3 + 1]] + vscores[indexes[t * 3 + 2]] ;
+
+                    if ( tscores[t] > bestscore )
+                    {
+                        bestscore = tscores[t] ;
+                        best = t ;
+                    }
+                }
+            }
+
+            if ( newcache.size() > cachesize )
+                newcache.resize( cachesize );
+
+            cache.swap( newcache );
+        }
+
+        std::copy( output.begin() , output.end() , indexes );
+    }
+}
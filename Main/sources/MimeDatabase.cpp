@@ -13,10 +13,32 @@
 
 namespace atl
 {
-    ////////////////////////////////////////////////////////////
-    MimeDatabase::MimeDatabase()
+    namespace Detail
     {
+        ////////////////////////////////////////////////////////////
+        /// \brief Orders MIME types by decreasing priority.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool MimeHigherPriority( const MimeType& lhs , const MimeType& rhs )
+        {
+            return lhs.GetPriority() > rhs.GetPriority() ;
+        }
         
+        ////////////////////////////////////////////////////////////
+        /// \brief Appends the MIME types at given ranks to 'result'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void MimeAppendRanks( const Vector < MimeType >& mimes , const Vector < uint32_t >& ranks , Vector < MimeType >& result )
+        {
+            for ( auto rank : ranks )
+                result.push_back( mimes[rank] );
+        }
+    }
+    
+    ////////////////////////////////////////////////////////////
+    MimeDatabase::MimeDatabase() : iMaxHeader( 0 ) , iCached( false ) , iSpinlock( "MimeDatabase" )
+    {
+        pRebuild();
     }
     
     ////////////////////////////////////////////////////////////
@@ -29,7 +51,11 @@ namespace atl
     void MimeDatabase::AddType(const atl::MimeType &type)
     {
         Spinlocker lck( iSpinlock );
-        iMimes.push_back( type );
+        
+        // After the types of the same priority, so the first added wins.
+        auto it = std::upper_bound( iMimes.begin() , iMimes.end() , type , Detail::MimeHigherPriority );
+        iMimes.insert( it , type );
+        pRebuild();
     }
     
     ////////////////////////////////////////////////////////////
@@ -37,22 +63,36 @@ namespace atl
     {
         Spinlocker lck( iSpinlock );
         
-        for ( auto mime : type )
+        for ( auto const& mime : type )
         {
-            iMimes.push_back( mime );
+            auto it = std::upper_bound( iMimes.begin() , iMimes.end() , mime , Detail::MimeHigherPriority );
+            iMimes.insert( it , mime );
         }
+        
+        pRebuild();
     }
     
     ////////////////////////////////////////////////////////////
     Vector < MimeType > MimeDatabase::FindAllForFile( const Filename& filename ) const
     {
-        auto result = FindCompleteMatchForFile( filename );
+        String prefix ;
+        pReadPrefix( filename , prefix );
         
-        auto byhead = FindHeaderMatchForFile( filename );
-        result.insert( result.end() , byhead.begin() , byhead.end() );
+        auto extension = filename.GetExtension();
         
-        auto byexts = FindExtensionMatchForFile( filename );
-        result.insert( result.end() , byexts.begin() , byexts.end() );
+        Vector < uint32_t > byheader , byext , complete ;
+        Vector < MimeType > result ;
+        {
+            Spinlocker lck( iSpinlock );
+            pFindRanks( prefix , extension , byheader , byext );
+            
+            std::set_intersection( byheader.begin() , byheader.end() , byext.begin() , byext.end() , std::back_inserter( complete ) );
+            
+            result.reserve( complete.size() + byheader.size() + byext.size() );
+            Detail::MimeAppendRanks( iMimes , complete , result );
+            Detail::MimeAppendRanks( iMimes , byheader , result );
+            Detail::MimeAppendRanks( iMimes , byext , result );
+        }
         
         return result ;
     }
@@ -60,82 +100,83 @@ namespace atl
     ////////////////////////////////////////////////////////////
     MimeType MimeDatabase::FindHigherForFile( const Filename& filename ) const
     {
-        auto byall = FindAllForFile( filename );
-        return byall.size() > 0 ? byall.at(0) : MimeType() ;
+        const String& path = filename.GetPath();
+        
+        {
+            Spinlocker lck( iSpinlock );
+            
+            if ( iCached )
+            {
+                auto it = iCache.find( path );
+                if ( it != iCache.end() )
+                    return it->second ;
+            }
+        }
+        
+        String prefix ;
+        pReadPrefix( filename , prefix );
+        
+        auto extension = filename.GetExtension();
+        
+        Vector < uint32_t > byheader , byext ;
+        Spinlocker lck( iSpinlock );
+        pFindRanks( prefix , extension , byheader , byext );
+        
+        // First of 'FindAllForFile()': the best complete match, else the
+        // best header match, else the best extension match.
+        MimeType result ;
+        auto it = std::find_first_of( byheader.begin() , byheader.end() , byext.begin() , byext.end() );
+        
+        if ( it != byheader.end() )
+            result = iMimes[*it] ;
+        else if ( !byheader.empty() )
+            result = iMimes[byheader.front()] ;
+        else if ( !byext.empty() )
+            result = iMimes[byext.front()] ;
+        
+        if ( iCached )
+            iCache[path] = result ;
+        
+        return result ;
     }
     
     ////////////////////////////////////////////////////////////
     Vector < MimeType > MimeDatabase::FindCompleteMatchForFile( const Filename& filename ) const
     {
-        std::ifstream ifs( filename.GetPath() , std::ifstream::binary );
-        if ( !ifs ) return Vector < MimeType >();
+        String prefix ;
+        if ( !pReadPrefix( filename , prefix ) )
+            return Vector < MimeType >();
+        
         auto extension = filename.GetExtension();
         
+        Vector < uint32_t > byheader , byext , complete ;
         Vector < MimeType > result ;
         {
             Spinlocker lck( iSpinlock );
+            pFindRanks( prefix , extension , byheader , byext );
             
-            for ( auto const& mime : iMimes )
-            {
-                const String& header = mime.GetHeader();
-                if ( header.empty() )
-                    continue ;
-                
-                char headbuf [ header.size() ];
-                memset( headbuf , 0 , header.size() );
-                ifs.get( headbuf , header.size() );
-                ifs.seekg( 0 , ifs.beg );
-                
-                if ( header != headbuf )
-                    continue ;
-                
-                auto const& exts = mime.GetExtensions();
-                auto it = std::find( exts.begin() , exts.end() , extension );
-                
-                if ( it == exts.end() )
-                    continue ;
-                
-                result.push_back( mime );
-            }
+            std::set_intersection( byheader.begin() , byheader.end() , byext.begin() , byext.end() , std::back_inserter( complete ) );
+            Detail::MimeAppendRanks( iMimes , complete , result );
         }
         
-        ifs.close();
-        
-        Sort( result );
         return result ;
     }
     
     ////////////////////////////////////////////////////////////
     Vector < MimeType > MimeDatabase::FindHeaderMatchForFile( const Filename& filename ) const
     {
-        std::ifstream ifs( filename.GetPath() , std::ifstream::binary );
-        if ( !ifs ) return Vector < MimeType >();
+        String prefix ;
+        if ( !pReadPrefix( filename , prefix ) )
+            return Vector < MimeType >();
         
+        Vector < uint32_t > byheader , byext ;
         Vector < MimeType > result ;
         {
             Spinlocker lck( iSpinlock );
-            
-            for ( auto const& mime : iMimes )
-            {
-                const String& header = mime.GetHeader();
-                if ( header.empty() )
-                    continue ;
-                
-                char headbuf [ header.size()+1 ];
-                memset( headbuf , 0 , header.size()+1 );
-                ifs.get( headbuf , header.size() );
-                ifs.seekg( 0 , ifs.beg );
-                
-                if ( header != headbuf )
-                    continue ;
-                
-                result.push_back( mime );
-            }
+            pFindRanks( prefix , String() , byheader , byext );
+            Detail::MimeAppendRanks( iMimes , byheader , result );
         }
         
-        ifs.close();
-        
-        Sort( result );
         return result ;
     }
     
@@ -143,34 +184,27 @@ namespace atl
     Vector < MimeType > MimeDatabase::FindExtensionMatchForFile( const Filename& filename ) const
     {
         auto extension = filename.GetExtension();
+        
+        Vector < uint32_t > byheader , byext ;
         Vector < MimeType > result ;
         {
             Spinlocker lck( iSpinlock );
-            
-            for ( auto const& mime : iMimes )
-            {
-                auto const& exts = mime.GetExtensions();
-                auto it = std::find( exts.begin() , exts.end() , extension );
-                
-                if ( it == exts.end() )
-                    continue ;
-                
-                result.push_back( mime );
-            }
+            pFindRanks( String() , extension , byheader , byext );
+            Detail::MimeAppendRanks( iMimes , byext , result );
         }
         
-        Sort( result );
         return result ;
     }
     
     ////////////////////////////////////////////////////////////
     const MimeType MimeDatabase::Find(const String &complete) const
     {
+        Symbol symbol = Symbol::Find( complete );
         Spinlocker lck( iSpinlock );
         
-        for ( auto mime : iMimes )
+        for ( auto const& mime : iMimes )
         {
-            if ( mime.GetCompleteTree() == complete )
+            if ( mime.GetCompleteSymbol() == symbol )
                 return mime ;
         }
         
@@ -199,14 +233,26 @@ namespace atl
         auto it = std::find( iMimes.begin() , iMimes.end() , type );
         
         if ( it != iMimes.end() )
+        {
             iMimes.erase( it );
+            pRebuild();
+        }
     }
     
     ////////////////////////////////////////////////////////////
     void MimeDatabase::RemoveTypes(const Vector<atl::MimeType> &types)
     {
-        for ( auto mime : types )
-            RemoveType( mime );
+        Spinlocker lck( iSpinlock );
+        
+        for ( auto const& mime : types )
+        {
+            auto it = std::find( iMimes.begin() , iMimes.end() , mime );
+            
+            if ( it != iMimes.end() )
+                iMimes.erase( it );
+        }
+        
+        pRebuild();
     }
     
     ////////////////////////////////////////////////////////////
@@ -214,6 +260,7 @@ namespace atl
     {
         Spinlocker lck( iSpinlock );
         iMimes.clear();
+        pRebuild();
     }
     
     ////////////////////////////////////////////////////////////
@@ -299,4 +346,132 @@ namespace atl
         
         return retvalue ;
     }
+    
+    ////////////////////////////////////////////////////////////
+    void MimeDatabase::SetCacheEnabled( bool enabled )
+    {
+        Spinlocker lck( iSpinlock );
+        iCached = enabled ;
+        
+        if ( !enabled )
+            iCache.clear();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool MimeDatabase::IsCacheEnabled() const
+    {
+        Spinlocker lck( iSpinlock );
+        return iCached ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void MimeDatabase::ClearCache()
+    {
+        Spinlocker lck( iSpinlock );
+        iCache.clear();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t MimeDatabase::GetMaxHeaderSize() const
+    {
+        Spinlocker lck( iSpinlock );
+        return iMaxHeader ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void MimeDatabase::pRebuild()
+    {
+        iHeaders.assign( 1 , Detail::MimeTrieNode() );
+        iExtensions.clear();
+        iMaxHeader = 0 ;
+        iCache.clear();
+        
+        // Ranks are added in increasing order, so every list stays sorted
+        // by priority.
+        for ( uint32_t rank = 0 ; rank < iMimes.size() ; ++rank )
+        {
+            const MimeType& mime = iMimes[rank] ;
+            
+            for ( auto const& extension : mime.GetExtensions() )
+            {
+                auto& ranks = iExtensions[extension] ;
+                
+                // An extension listed twice by the same type.
+                if ( ranks.empty() || ranks.back() != rank )
+                    ranks.push_back( rank );
+            }
+            
+            String header = mime.GetHeader();
+            if ( header.empty() )
+                continue ;
+            
+            uint32_t node = 0 ;
+            
+            for ( auto byte : header )
+            {
+                unsigned char key = static_cast < unsigned char >( byte );
+                auto it = iHeaders[node].children.find( key );
+                
+                if ( it != iHeaders[node].children.end() )
+                {
+                    node = it->second ;
+                }
+                
+                else
+                {
+                    uint32_t child = static_cast < uint32_t >( iHeaders.size() );
+                    iHeaders[node].children[key] = child ;
+                    iHeaders.push_back( Detail::MimeTrieNode() );
+                    node = child ;
+                }
+            }
+            
+            iHeaders[node].mimes.push_back( rank );
+            iMaxHeader = std::max( iMaxHeader , header.size() );
+        }
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void MimeDatabase::pFindRanks( const String& prefix , const String& extension ,
+                                   Vector < uint32_t >& byheader , Vector < uint32_t >& byext ) const
+    {
+        // Every node on the path of the prefix is a header matching it.
+        uint32_t node = 0 ;
+        
+        for ( std::size_t i = 0 ; i < prefix.size() ; ++i )
+        {
+            auto const& children = iHeaders[node].children ;
+            auto it = children.find( static_cast < unsigned char >( prefix[i] ) );
+            
+            if ( it == children.end() )
+                break ;
+            
+            node = it->second ;
+            byheader.insert( byheader.end() , iHeaders[node].mimes.begin() , iHeaders[node].mimes.end() );
+        }
+        
+        // Headers of different lengths match: back to priority order.
+        std::sort( byheader.begin() , byheader.end() );
+        
+        auto it = iExtensions.find( extension );
+        
+        if ( it != iExtensions.end() )
+            byext = it->second ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool MimeDatabase::pReadPrefix( const Filename& filename , String& prefix ) const
+    {
+        // Without headers, there is nothing to read.
+        std::size_t size = GetMaxHeaderSize();
+        if ( !size ) return false ;
+        
+        std::ifstream ifs( filename.GetPath() , std::ifstream::binary );
+        if ( !ifs ) return false ;
+        
+        prefix.resize( size );
+        ifs.read( &prefix[0] , static_cast < std::streamsize >( size ) );
+        prefix.resize( static_cast < std::size_t >( ifs.gcount() ) );
+        return true ;
+    }
 }
@@ -13,6 +13,18 @@
 
 namespace atl
 {
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the interned complete tree of a MIME type.
+        ///
+        ////////////////////////////////////////////////////////////
+        static Symbol MimeCompleteTree( const Symbol& toplevel , const Symbol& sublevel )
+        {
+            return Symbol( toplevel.GetString() + "/" + sublevel.GetString() );
+        }
+    }
+    
     ////////////////////////////////////////////////////////////
     MimeType::MimeType()
     {
@@ -37,9 +49,10 @@ namespace atl
     ////////////////////////////////////////////////////////////
     MimeType::MimeType( const MimeType& parent , const String& subtype , const StringMap& options )
     {
-        iTopLevelCat    = parent.GetTopLevel();
-        iSublevelTree   = subtype.empty() ? parent.GetCompleteTree() : parent.GetCompleteTree() + "." + subtype ;
-        iSuffix         = parent.GetSuffix();
+        iTopLevelCat    = parent.iTopLevelCat ;
+        iSublevelTree   = subtype.empty() ? parent.iComplete : Symbol( parent.GetCompleteTree() + "." + subtype );
+        iSuffix         = parent.iSuffix ;
+        iComplete       = Detail::MimeCompleteTree( iTopLevelCat , iSublevelTree );
         iExtensions     = parent.GetExtensions();
         iOptionals      = options ;
         iHeader         = parent.iHeader ;
@@ -52,6 +65,7 @@ namespace atl
         iTopLevelCat    = rhs.iTopLevelCat ;
         iSublevelTree   = rhs.iSublevelTree ;
         iSuffix         = rhs.iSuffix ;
+        iComplete       = rhs.iComplete ;
         iExtensions     = rhs.iExtensions ;
         iOptionals      = rhs.iOptionals ;
         iHeader         = rhs.iHeader ;
@@ -70,6 +84,7 @@ namespace atl
         iTopLevelCat    = rhs.iTopLevelCat ;
         iSublevelTree   = rhs.iSublevelTree ;
         iSuffix         = rhs.iSuffix ;
+        iComplete       = rhs.iComplete ;
         iExtensions     = rhs.iExtensions ;
         iOptionals      = rhs.iOptionals ;
         iHeader         = rhs.iHeader ;
@@ -95,13 +110,13 @@ namespace atl
     ////////////////////////////////////////////////////////////
     bool MimeType::operator < ( const MimeType& rhs ) const
     {
-        return GetCompleteTree() < rhs.GetCompleteTree();
+        return iComplete < rhs.iComplete ;
     }
     
     ////////////////////////////////////////////////////////////
     bool MimeType::IsEmpty() const
     {
-        return iTopLevelCat.empty() || iSublevelTree.empty();
+        return iTopLevelCat.IsEmpty() || iSublevelTree.IsEmpty();
     }
     
     ////////////////////////////////////////////////////////////
@@ -119,22 +134,23 @@ namespace atl
     ////////////////////////////////////////////////////////////
     String MimeType::GetTopLevel() const
     {
-        return iTopLevelCat ;
+        return iTopLevelCat.GetString();
     }
     
     ////////////////////////////////////////////////////////////
     String MimeType::GetSubType() const
     {
-        return iSublevelTree ;
+        return iSublevelTree.GetString();
     }
     
     ////////////////////////////////////////////////////////////
     String MimeType::GetTreeName() const
     {
-        size_t i = iSublevelTree.find_first_of(".");
+        const String& tree = iSublevelTree.GetString();
+        size_t i = tree.find_first_of(".");
         
         if ( i != std::string::npos )
-        return iSublevelTree.substr( 0 , i );
+        return tree.substr( 0 , i );
         
         return String();
     }
@@ -142,13 +158,19 @@ namespace atl
     ////////////////////////////////////////////////////////////
     String MimeType::GetSuffix() const
     {
-        return iSuffix ;
+        return iSuffix.GetString();
     }
     
     ////////////////////////////////////////////////////////////
     String MimeType::GetCompleteTree() const
     {
-        return iTopLevelCat + "/" + iSublevelTree ;
+        return iComplete.GetString();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const Symbol& MimeType::GetCompleteSymbol() const
+    {
+        return iComplete ;
     }
     
     ////////////////////////////////////////////////////////////
@@ -189,11 +211,12 @@ namespace atl
         if ( endsubtype == std::string::npos ) endsubtype = mime.size();
         assert( endsubtype > endcat && "Invalid sub-type ending." );
         
-        iTopLevelCat = mime.substr( 0 , endcat );
-        iSublevelTree = mime.substr( endcat + 1 , endsubtype );
+        iTopLevelCat = Symbol( mime.substr( 0 , endcat ) );
+        iSublevelTree = Symbol( mime.substr( endcat + 1 , endsubtype ) );
+        iComplete = Detail::MimeCompleteTree( iTopLevelCat , iSublevelTree );
         
         if ( endsubtype < mime.size() )
-        iSuffix = mime.substr( endsubtype + 1 );
+        iSuffix = Symbol( mime.substr( endsubtype + 1 ) );
     }
     
     ////////////////////////////////////////////////////////////
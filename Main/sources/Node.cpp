@@ -10,6 +10,9 @@
 //
 //  ========================================================================  //
 #include <ATL/Node.hpp>
+#include <ATL/AggregatedGroup.hpp>
+#include <ATL/ThreadPool.hpp>
+#include <ATL/BinaryScene.hpp>
 
 namespace atl
 {
@@ -61,7 +64,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void Node::Update( NodesBySubtype& lsnodes , AggregatedGroup& group ) const
     {
-        lsnodes[GetSubtype()] = std::const_pointer_cast < Node >( Subtree < Node >::shared_from_this() );
+        lsnodes[GetSubtype()] = std::const_pointer_cast < Node >( std::static_pointer_cast < const Node >( Subtree < Node >::shared_from_this() ) );
         auto children = GetChildren();
         
         for ( auto const& child : children )
@@ -73,4 +76,49 @@ namespace atl
         if ( Detail::Dirtable::IsDirty() )
             Detail::Dirtable::SetDirty( false );
     }
+    
+    ////////////////////////////////////////////////////////////
+    void Node::UpdateParallel( NodesBySubtype& lsnodes , AggregatedGroup& group ) const
+    {
+        auto pool     = ThreadPool::Get();
+        auto children = GetChildren();
+        
+        if ( !pool || children.size() < 2 )
+        {
+            group.ResizeSlices( 0 );
+            return Update( lsnodes , group );
+        }
+        
+        lsnodes[GetSubtype()] = std::const_pointer_cast < Node >( std::static_pointer_cast < const Node >( Subtree < Node >::shared_from_this() ) );
+        
+        // Slices are retrieved before launching the tasks, so workers never touch the
+        // group's mutex. Each subtree always uses the slice with the same index, thus
+        // its AggregatedNodes are found back from one update to another.
+        SharedVector < AggregatedGroup > slices ;
+        slices.reserve( children.size() );
+        
+        for ( std::size_t i = 0 ; i < children.size() ; ++i )
+            slices.push_back( group.GetSlice( i ) );
+        
+        group.ResizeSlices( children.size() );
+        
+        const NodesBySubtype& base = lsnodes ;
+        
+        pool->ParallelFor( children.size() , [&children, &slices, &base]( std::size_t i ) {
+            assert( children[i] && "Null child was conserved in a node. (Illegal operation)" );
+            assert( slices[i] );
+            
+            NodesBySubtype sublsnodes( base );
+            children[i]->Update( sublsnodes , *slices[i] );
+        });
+        
+        if ( Detail::Dirtable::IsDirty() )
+            Detail::Dirtable::SetDirty( false );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Node::WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& ) const
+    {
+        record.subtype = GetSubtype();
+    }
 }
@@ -46,7 +46,8 @@ namespace atl
 
     void Performer::Wait()
     {
-        while ( !IsFinished() ) { }
+        std::unique_lock < std::mutex > lck( iWaitMutex );
+        iWaitCond.wait( lck , [this]() { return IsFinished(); } );
     }
 
     Seconds Performer::GetSeconds() const
@@ -84,9 +85,22 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void Performer::EndSynced()
     {
-        Spinlocker lck( iSpinlock );
-        iEnd = Clock::now();
-        iStarted.store( false );
-        iEnded.store( true );
+        SetEnded();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Performer::SetEnded()
+    {
+        {
+            Spinlocker lck( iSpinlock );
+            iEnd = Clock::now();
+            iStarted.store( false );
+            iEnded.store( true );
+        }
+        
+        // Takes the mutex so a thread between its check and its sleep in
+        // 'Wait()' can't miss the notification.
+        MutexLocker lck( iWaitMutex );
+        iWaitCond.notify_all();
     }
 }
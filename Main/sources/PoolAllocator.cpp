@@ -0,0 +1,336 @@
+//  ========================================================================  //
+//
+//  File    : ATL/PoolAllocator.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/PoolAllocator.hpp>
+
+#if defined( __GNUG__ )
+#   include <cxxabi.h>
+#   include <cstdlib>
+#endif
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        static const std::size_t PoolClasses    = PoolMaxSize / PoolAlignment ; ///< Number of size classes.
+        static const std::size_t PoolBatch      = 32 ;                          ///< Blocks moved at once between a cache and a class.
+        static const std::size_t PoolChunkBytes = 64 * 1024 ;                   ///< Bytes allocated at once by a class.
+
+        ////////////////////////////////////////////////////////////
+        struct PoolBlock
+        {
+            PoolBlock* next ;
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Global free list of one size class.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct PoolSizeClass
+        {
+            Spinlock    spinlock ;
+            PoolBlock*  free ;
+            std::size_t blocksize ;
+
+            ////////////////////////////////////////////////////////////
+            /// \brief Moves at most 'PoolBatch' blocks to 'head' and
+            /// returns their count. Allocates a new chunk if the class has
+            /// no free block.
+            ///
+            ////////////////////////////////////////////////////////////
+            std::size_t Pop( PoolBlock*& head )
+            {
+                Spinlocker lck( spinlock );
+
+                if ( !free )
+                {
+                    // Chunks are never freed: blocks of a class are always reused by
+                    // the same class, so memory use is bounded by the highest number
+                    // of live objects.
+                    std::size_t count = std::max( PoolChunkBytes / blocksize , PoolBatch );
+                    char* chunk = static_cast < char* >( ::operator new( count * blocksize ) );
+
+                    for ( std::size_t i = 0 ; i < count ; ++i )
+                    {
+                        PoolBlock* block = reinterpret_cast < PoolBlock* >( chunk + i * blocksize );
+                        block->next = free ;
+                        free = block ;
+                    }
+                }
+
+                std::size_t popped = 0 ;
+                head = nullptr ;
+
+                while ( free && popped < PoolBatch )
+                {
+                    PoolBlock* block = free ;
+                    free = block->next ;
+                    block->next = head ;
+                    head = block ;
+                    popped++ ;
+                }
+
+                return popped ;
+            }
+
+            ////////////////////////////////////////////////////////////
+            /// \brief Gives back a list of blocks from 'head' to 'tail'.
+            ///
+            ////////////////////////////////////////////////////////////
+            void Push( PoolBlock* head , PoolBlock* tail )
+            {
+                Spinlocker lck( spinlock );
+                tail->next = free ;
+                free = head ;
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the global size classes.
+        ///
+        /// They are never destroyed, as thread caches may give their
+        /// blocks back after static objects destruction.
+        ///
+        ////////////////////////////////////////////////////////////
+        static PoolSizeClass* GetSizeClasses()
+        {
+            static PoolSizeClass* classes = []()
+            {
+                PoolSizeClass* result = new PoolSizeClass [PoolClasses] ;
+
+                for ( std::size_t i = 0 ; i < PoolClasses ; ++i )
+                {
+                    result[i].free      = nullptr ;
+                    result[i].blocksize = ( i + 1 ) * PoolAlignment ;
+                }
+
+                return result ;
+            }();
+
+            return classes ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Free blocks cached by a thread, for every size class.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct PoolThreadCache
+        {
+            PoolBlock*  free[PoolClasses] ;
+            std::size_t count[PoolClasses] ;
+
+            ////////////////////////////////////////////////////////////
+            PoolThreadCache()
+            {
+                for ( std::size_t i = 0 ; i < PoolClasses ; ++i )
+                {
+                    free[i]  = nullptr ;
+                    count[i] = 0 ;
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            ~PoolThreadCache();
+
+            ////////////////////////////////////////////////////////////
+            /// \brief Gives 'number' blocks of class 'index' back to the
+            /// global size class.
+            ///
+            ////////////////////////////////////////////////////////////
+            void Release( std::size_t index , std::size_t number )
+            {
+                if ( !number || !free[index] )
+                    return ;
+
+                PoolBlock* head = free[index] ;
+                PoolBlock* tail = head ;
+
+                for ( std::size_t i = 1 ; i < number && tail->next ; ++i )
+                    tail = tail->next ;
+
+                free[index]  = tail->next ;
+                count[index] = count[index] > number ? count[index] - number : 0 ;
+                GetSizeClasses()[index].Push( head , tail );
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        static thread_local PoolThreadCache t_cache ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief True once 't_cache' is destroyed. Objects freed later by
+        /// this thread, like the ones held by function-static pools when
+        /// the main thread exits, use the global size classes directly.
+        ///
+        /// Constant initialized and trivially destructible: it can be read
+        /// at any time during the thread's exit.
+        ///
+        ////////////////////////////////////////////////////////////
+        static thread_local bool t_cachedestroyed = false ;
+
+        ////////////////////////////////////////////////////////////
+        PoolThreadCache::~PoolThreadCache()
+        {
+            for ( std::size_t i = 0 ; i < PoolClasses ; ++i )
+                Release( i , count[i] );
+
+            t_cachedestroyed = true ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        void* PoolAllocate( std::size_t size )
+        {
+            if ( size == 0 )
+                size = 1 ;
+
+            if ( size > PoolMaxSize )
+                return ::operator new( size );
+
+            std::size_t index = ( size - 1 ) / PoolAlignment ;
+
+            if ( t_cachedestroyed )
+            {
+                PoolBlock* head = nullptr ;
+                std::size_t popped = GetSizeClasses()[index].Pop( head );
+
+                if ( popped > 1 )
+                {
+                    PoolBlock* tail = head->next ;
+
+                    while ( tail->next )
+                        tail = tail->next ;
+
+                    GetSizeClasses()[index].Push( head->next , tail );
+                }
+
+                return head ;
+            }
+
+            if ( !t_cache.free[index] )
+                t_cache.count[index] = GetSizeClasses()[index].Pop( t_cache.free[index] );
+
+            PoolBlock* block = t_cache.free[index] ;
+            t_cache.free[index] = block->next ;
+            t_cache.count[index]-- ;
+
+            return block ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        void PoolDeallocate( void* block , std::size_t size )
+        {
+            if ( !block )
+                return ;
+
+            if ( size == 0 )
+                size = 1 ;
+
+            if ( size > PoolMaxSize )
+            {
+                ::operator delete( block );
+                return ;
+            }
+
+            std::size_t index = ( size - 1 ) / PoolAlignment ;
+
+            PoolBlock* pblock = static_cast < PoolBlock* >( block );
+
+            if ( t_cachedestroyed )
+            {
+                GetSizeClasses()[index].Push( pblock , pblock );
+                return ;
+            }
+
+            pblock->next = t_cache.free[index] ;
+            t_cache.free[index] = pblock ;
+            t_cache.count[index]++ ;
+
+            // A thread freeing what others allocate (like the render thread for events)
+            // would keep growing its cache: excess blocks go back to the global class.
+            if ( t_cache.count[index] > 2 * PoolBatch )
+                t_cache.Release( index , PoolBatch );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Every PoolCounters created so far.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct PoolRegistry
+        {
+            Mutex                    mutex ;
+            Vector < PoolCounters* > counters ;
+        };
+
+        ////////////////////////////////////////////////////////////
+        static PoolRegistry& GetPoolRegistry()
+        {
+            static PoolRegistry* registry = new PoolRegistry ;
+            return *registry ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        PoolCounters::PoolCounters( const std::type_info& info )
+        : type( info ) , live( 0 ) , peak( 0 ) , bytes( 0 )
+        {
+            PoolRegistry& registry = GetPoolRegistry();
+            MutexLocker lck( registry.mutex );
+            registry.counters.push_back( this );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static String Demangle( const char* name )
+        {
+#           if defined( __GNUG__ )
+            int status = 0 ;
+            char* demangled = abi::__cxa_demangle( name , nullptr , nullptr , &status );
+
+            if ( demangled && status == 0 )
+            {
+                String result( demangled );
+                std::free( demangled );
+                return result ;
+            }
+#           endif
+
+            return String( name );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    Vector < PoolStats > GetPoolsStats()
+    {
+        Vector < PoolStats > result ;
+
+        {
+            Detail::PoolRegistry& registry = Detail::GetPoolRegistry();
+            MutexLocker lck( registry.mutex );
+            result.reserve( registry.counters.size() );
+
+            for ( auto counters : registry.counters )
+            {
+                PoolStats stats ;
+                stats.name  = Detail::Demangle( counters->type.name() );
+                stats.live  = counters->live.load( std::memory_order_relaxed );
+                stats.peak  = counters->peak.load( std::memory_order_relaxed );
+                stats.bytes = counters->bytes.load( std::memory_order_relaxed );
+                result.push_back( stats );
+            }
+        }
+
+        std::sort( result.begin() , result.end() , []( const PoolStats& lhs , const PoolStats& rhs ) {
+            return lhs.bytes > rhs.bytes ;
+        });
+
+        return result ;
+    }
+}
@@ -12,6 +12,7 @@
 #include <ATL/PositionNode.hpp>
 #include <ATL/Material.hpp>
 #include <ATL/AggregatedMaterial.hpp>
+#include <ATL/BinaryScene.hpp>
 
 namespace atl
 {
@@ -57,10 +58,11 @@ namespace atl
         
         m_spinlock.unlock();
         
-        model  *= tmp ;
-        mvp    *= tmp ;
-        model3 *= tmp3 ;
-        mvp3   *= tmp3 ;
+        // Nearest nodes aggregate first: parent's matrices are applied after ours.
+        model  = tmp * model ;
+        mvp    = tmp * mvp ;
+        model3 = tmp3 * model3 ;
+        mvp3   = tmp3 * mvp3 ;
         
         material.SetCustom( Alias::MatrixModel , ParameterValue( model ) );
         material.SetCustom( Alias::Matrix3Model , ParameterValue( model3 ) );
@@ -69,4 +71,16 @@ namespace atl
         
         DerivedNode < PositionNode >::Aggregate( material , command );
     }
+    
+    ////////////////////////////////////////////////////////////
+    void PositionNode::WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const
+    {
+        Node::WriteBinaryRecord( record , reference );
+        
+        glm::vec3 position = GetPosition();
+        record.position[0] = position.x ;
+        record.position[1] = position.y ;
+        record.position[2] = position.z ;
+        record.position[3] = 0.0f ;
+    }
 }
@@ -12,6 +12,7 @@
 #include <ATL/Program.hpp>
 #include <ATL/ParameterValue.hpp>
 #include <ATL/VaryingParameter.hpp>
+#include <ATL/Metaclasser.hpp>
 
 namespace atl
 {
@@ -25,7 +26,7 @@ namespace atl
     }
     
     ////////////////////////////////////////////////////////////
-    Program::Program( const SharedVector < Shader >& shaders ) : m_id( s_generator.New() )
+    Program::Program( const SharedVector < Shader >& shaders ) : m_id( s_generator.New() ) , m_shaders( shaders )
     {
         
     }
@@ -42,6 +43,102 @@ namespace atl
         return m_id.load();
     }
     
+    ////////////////////////////////////////////////////////////
+    SharedVector < Shader > Program::GetShaders() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_shaders ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Program::IsOutdated() const
+    {
+        MutexLocker lck( m_mutex );
+        
+        for ( auto const& shader : m_shaders )
+        {
+            if ( shader && shader->IsOutdated() )
+                return true ;
+        }
+        
+        return false ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Program::Relink()
+    {
+        SharedVector < Shader > shaders = GetShaders();
+        bool changed = false ;
+        
+        for ( auto& shader : shaders )
+        {
+            if ( !shader || !shader->IsOutdated() )
+                continue ;
+            
+            auto latest = GetLatest( shader );
+            
+            if ( latest == shader )
+            {
+                auto metaclasser = Metaclasser::Get();
+                auto metaclass   = metaclasser ? metaclasser->GetMetaclass( shader->GetMimeType() ) : nullptr ;
+                
+                if ( metaclass )
+                    latest = std::static_pointer_cast < Shader >( metaclass->Create( shader->GetFile() ) );
+                
+                // Errors are reported by the Metaclass: keeps the shader until
+                // its file is modified again.
+                if ( !latest || latest == shader )
+                {
+                    shader->SetOutdated( false );
+                    continue ;
+                }
+                
+                shader->SetReplacement( latest );
+                Shader::WatchFile( latest );
+            }
+            
+            shader  = latest ;
+            changed = true ;
+        }
+        
+        if ( !changed )
+            return false ;
+        
+        // Parameters are discovered again: aliases are restored by name.
+        Vector < Pair < Alias , String > > aliases ;
+        
+        {
+            MutexLocker lck( m_mutex );
+            
+            for ( auto const& it : m_aliases )
+            {
+                if ( it.second )
+                    aliases.push_back( Pair < Alias , String >( it.first , it.second->GetName() ) );
+            }
+        }
+        
+        bool linked = DRelink( shaders );
+        
+        {
+            MutexLocker lck( m_mutex );
+            m_shaders = shaders ;
+        }
+        
+        if ( linked )
+        {
+            for ( auto const& alias : aliases )
+                AddAlias( alias.first , alias.second );
+        }
+        
+        return linked ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Program::DRelink( const SharedVector < Shader >& )
+    {
+        return false ;
+    }
+    
     ////////////////////////////////////////////////////////////
     bool Program::AddAlias( Alias alias , const String& name )
     {
@@ -127,7 +224,7 @@ namespace atl
         const ConstantParameter* inparam = GetParameterByAlias( parameter.GetAlias() );
         
         if ( !inparam )
-            inparam = GetParameterByName( parameter.GetName() );
+            inparam = GetParameterBySymbol( parameter.GetSymbol() );
         if ( !inparam )
             inparam = GetParameterByIndex( parameter.GetIndex() );
         
@@ -147,7 +244,7 @@ namespace atl
         const ConstantParameter* inparam = GetParameterByAlias( parameter->GetAlias() );
         
         if ( !inparam )
-            inparam = GetParameterByName( parameter->GetName() );
+            inparam = GetParameterBySymbol( parameter->GetSymbol() );
         if ( !inparam )
             inparam = GetParameterByIndex( parameter->GetIndex() );
         
@@ -193,12 +290,18 @@ namespace atl
     
     ////////////////////////////////////////////////////////////
     ConstantParameter* Program::GetParameterByName( const String& name )
+    {
+        return GetParameterBySymbol( Symbol::Find( name ) );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    ConstantParameter* Program::GetParameterBySymbol( const Symbol& name )
     {
         MutexLocker lck( m_mutex );
         
         for ( auto it = m_parameters.begin() ; it != m_parameters.end() ; it++ )
         {
-            if ( (*it).GetName() == name )
+            if ( (*it).GetSymbol() == name )
             {
                 return &(*it);
             }
@@ -239,12 +342,18 @@ namespace atl
     
     ////////////////////////////////////////////////////////////
     const ConstantParameter* Program::GetParameterByName( const String& name ) const
+    {
+        return GetParameterBySymbol( Symbol::Find( name ) );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const ConstantParameter* Program::GetParameterBySymbol( const Symbol& name ) const
     {
         MutexLocker lck( m_mutex );
         
         for ( auto it = m_parameters.begin() ; it != m_parameters.end() ; it++ )
         {
-            if ( (*it).GetName() == name )
+            if ( (*it).GetSymbol() == name )
             {
                 return &(*it);
             }
@@ -304,12 +413,13 @@ namespace atl
     ////////////////////////////////////////////////////////////
     const ConstantParameter* Program::GetParameterByStage( Stage stage , const String& name ) const
     {
+        Symbol symbol = Symbol::Find( name );
         MutexLocker lck( m_mutex );
         
         for ( auto const& param : m_parameters )
         {
-            if ( param.GetStage() == stage &&
-                 param.GetName()  == name )
+            if ( param.GetStage()  == stage &&
+                 param.GetSymbol() == symbol )
             {
                 return &param;
             }
@@ -11,6 +11,7 @@
 //  ========================================================================  //
 #include <ATL/ProgramNode.hpp>
 #include <ATL/RenderCommand.hpp>
+#include <ATL/BinaryScene.hpp>
 
 namespace atl
 {
@@ -50,4 +51,13 @@ namespace atl
         
         DerivedNode < ProgramNode >::Aggregate( material , command );
     }
+    
+    ////////////////////////////////////////////////////////////
+    void ProgramNode::WriteBinaryRecord( BinarySceneNode& record , BinarySceneReference& reference ) const
+    {
+        Node::WriteBinaryRecord( record , reference );
+        
+        auto program = m_program.lock();
+        reference.object = program.get();
+    }
 }
@@ -32,6 +32,7 @@ namespace atl
     : m_id( s_generator.New() ) , m_material( material ) , m_program( program )
     {
         m_commands.push_back( command );
+        m_handles.push_back( VertexCommandPool::GetDefault().Register( command ) );
     }
     
     ////////////////////////////////////////////////////////////
@@ -40,13 +41,17 @@ namespace atl
                                   const Weak < Program >& program )
     : m_id( s_generator.New() ) , m_commands( commands ) , m_material( material ) , m_program( program )
     {
-        
+        for ( auto const& command : m_commands )
+            m_handles.push_back( VertexCommandPool::GetDefault().Register( command ) );
     }
     
     ////////////////////////////////////////////////////////////
     RenderCommand::~RenderCommand()
     {
+        VertexCommandPool& pool = VertexCommandPool::GetDefault();
         
+        for ( auto handle : m_handles )
+            pool.Release( handle );
     }
     
     ////////////////////////////////////////////////////////////
@@ -60,6 +65,7 @@ namespace atl
     {
         MutexLocker lck( m_mutex );
         m_commands.push_back( command );
+        m_handles.push_back( VertexCommandPool::GetDefault().Register( command ) );
     }
     
     ////////////////////////////////////////////////////////////
@@ -67,13 +73,22 @@ namespace atl
     {
         MutexLocker lck( m_mutex );
         m_commands.insert( m_commands.end() , commands.begin() , commands.end() );
+        
+        for ( auto const& command : commands )
+            m_handles.push_back( VertexCommandPool::GetDefault().Register( command ) );
     }
     
     ////////////////////////////////////////////////////////////
     void RenderCommand::ResetVertexCommands()
     {
         MutexLocker lck( m_mutex );
+        VertexCommandPool& pool = VertexCommandPool::GetDefault();
+        
+        for ( auto handle : m_handles )
+            pool.Release( handle );
+        
         m_commands.clear();
+        m_handles.clear();
     }
     
     ////////////////////////////////////////////////////////////
@@ -106,4 +121,13 @@ namespace atl
         MutexLocker lck( m_mutex );
         return m_commands ;
     }
+    
+    ////////////////////////////////////////////////////////////
+    void RenderCommand::VisitVertexCommands( const std::function < void( VertexCommandHandle ) >& visitor ) const
+    {
+        MutexLocker lck( m_mutex );
+        
+        for ( auto handle : m_handles )
+            visitor( handle );
+    }
 }
@@ -97,11 +97,17 @@ namespace atl
         auto cstparams = GetConstParameters();
         auto varparams = GetVarParameters();
         
+        const ProgramPool& programs = ProgramPool::GetDefault();
+        
         for ( auto pass : tmppasses )
         {
-            auto wprogram = pass->GetProgram();
-            assert( !wprogram.expired() && "RenderPass program expired." );
-            auto program = wprogram.lock();
+            auto program = programs.Resolve( pass->GetProgramHandle() );
+            assert( program && "RenderPass program expired." );
+            
+            // Shaders modified since the last frame are linked now, as the
+            // context is current on this thread.
+            if ( program->IsOutdated() )
+                program->Relink();
             
             program->Prepare( target );
             program->BindConstantParameters( cstparams );
@@ -19,7 +19,7 @@ namespace atl
     
     ////////////////////////////////////////////////////////////
     RenderPass::RenderPass( const Weak < Program >& program )
-    : m_id( s_generator.New() ) , m_program( program )
+    : m_id( s_generator.New() ) , m_program( program ) , m_programhandle( ProgramPool::GetDefault().Register( program.lock() ) )
     {
         
     }
@@ -27,7 +27,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     RenderPass::~RenderPass()
     {
-        
+        ProgramPool::GetDefault().Release( m_programhandle );
     }
     
     ////////////////////////////////////////////////////////////
@@ -42,20 +42,28 @@ namespace atl
         return m_program ;
     }
     
+    ////////////////////////////////////////////////////////////
+    ProgramHandle RenderPass::GetProgramHandle() const
+    {
+        return m_programhandle ;
+    }
+    
     ////////////////////////////////////////////////////////////
     void RenderPass::Draw( const Context& context , const Program& program ) const
     {
+        const MaterialPool& materials = MaterialPool::GetDefault();
+        
         m_mutex.lock();
         auto staticqueues = m_staticqueues ;
         m_mutex.unlock();
         
         for ( auto queue : staticqueues )
         {
-            auto material = queue->GetMaterial();
-            if ( material.expired() )
+            auto material = materials.Resolve( queue->GetMaterialHandle() );
+            if ( !material )
                 continue ;
             
-            material.lock()->Prepare( program );
+            material->Prepare( program );
             queue->Draw( context , program );
         }
         
@@ -65,11 +73,11 @@ namespace atl
         
         for ( auto queue : dynamicqueues )
         {
-            auto material = queue->GetMaterial();
-            if ( material.expired() )
+            auto material = materials.Resolve( queue->GetMaterialHandle() );
+            if ( !material )
                 continue ;
             
-            material.lock()->Prepare( program );
+            material->Prepare( program );
             queue->Draw( context , program );
         }
     }
@@ -10,6 +10,9 @@
 //
 //  ========================================================================  //
 #include <ATL/RenderPath.hpp>
+#include <ATL/RenderCommand.hpp>
+#include <ATL/Material.hpp>
+#include <ATL/Program.hpp>
 
 namespace atl
 {
@@ -37,6 +40,13 @@ namespace atl
 
         _Init();
         _RecursiveDrawLook( m_first );
+        
+        // Every targets are drawn: objects only held by the handle pools can be
+        // destroyed now. RenderCommands go first as they hold VertexCommands.
+        RenderCommandPool::GetDefault().Collect();
+        VertexCommandPool::GetDefault().Collect();
+        MaterialPool::GetDefault().Collect();
+        ProgramPool::GetDefault().Collect();
     }
     
     ////////////////////////////////////////////////////////////
@@ -71,7 +81,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void RenderPath::_RecursiveDrawLook( Shared < Operation >& operation )
     {
-        std::unique_lock < Mutex > lck( operation->mutex );
+        std::unique_lock < std::mutex > lck( operation->mutex );
         
         if ( operation->done.load() )
         {
@@ -83,7 +93,7 @@ namespace atl
         {
             for ( auto& subop : operation->previouses )
             {
-                std::unique_lock < Mutex > lck( subop->mutex );
+                std::unique_lock < std::mutex > lck( subop->mutex );
                 _RecursiveDrawLook( subop );
                 subop->cv.wait( lck );
             }
@@ -12,12 +12,13 @@
 #include <ATL/RenderQueue.hpp>
 #include <ATL/Context.hpp>
 #include <ATL/Program.hpp>
+#include <ATL/PoolAllocator.hpp>
 
 namespace atl
 {
     ////////////////////////////////////////////////////////////
     RenderQueue::RenderQueue( const Weak < Material >& material )
-    : m_material( material )
+    : m_material( material ) , m_materialhandle( MaterialPool::GetDefault().Register( material.lock() ) )
     {
         
     }
@@ -25,7 +26,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     RenderQueue::~RenderQueue()
     {
-        
+        MaterialPool::GetDefault().Release( m_materialhandle );
     }
     
     ////////////////////////////////////////////////////////////
@@ -34,10 +35,19 @@ namespace atl
         return m_material ;
     }
     
+    ////////////////////////////////////////////////////////////
+    MaterialHandle RenderQueue::GetMaterialHandle() const
+    {
+        return m_materialhandle ;
+    }
+    
     ////////////////////////////////////////////////////////////
     StaticRenderQueue::~StaticRenderQueue()
     {
+        RenderCommandPool& pool = RenderCommandPool::GetDefault();
         
+        for ( auto handle : m_commands )
+            pool.Release( handle );
     }
     
     ////////////////////////////////////////////////////////////
@@ -50,22 +60,21 @@ namespace atl
     void StaticRenderQueue::AddRenderCommand( const Weak < RenderCommand >& command )
     {
         assert( !command.expired() && "RenderCommand given expired." );
+        
+        RenderCommandPool& pool = RenderCommandPool::GetDefault();
+        RenderCommandHandle handle = pool.Register( command.lock() );
         MutexLocker lck( m_mutex );
         
-        for ( auto it = m_commands.begin() ; it != m_commands.end() ; it++ )
-        {
-            if ( (*it).expired() ) {
-                continue ;
-            }
-            
-            else if ( (*it).lock() == command.lock() ) {
-                m_commands.erase( it );
-                break ;
-            }
-            
-        }
+        // Handles of collected commands are removed as we are iterating anyway. If the
+        // command is already present, our new registration is released.
+        m_commands.erase( std::remove_if( m_commands.begin() , m_commands.end() , [&pool]( RenderCommandHandle rhs ) {
+            return !pool.IsValid( rhs );
+        }) , m_commands.end() );
         
-        m_commands.push_back( command );
+        if ( std::find( m_commands.begin() , m_commands.end() , handle ) != m_commands.end() )
+            pool.Release( handle );
+        else
+            m_commands.push_back( handle );
     }
     
     ////////////////////////////////////////////////////////////
@@ -85,22 +94,41 @@ namespace atl
     {
         MutexLocker lck( m_mutex );
         
-        for ( auto const& command : m_commands )
+        const RenderCommandPool& pool = RenderCommandPool::GetDefault();
+        bool dead = false ;
+        
+        for ( auto handle : m_commands )
         {
-            if ( command.expired() )
+            auto command = pool.Resolve( handle );
+            
+            if ( !command )
+            {
+                dead = true ;
                 continue ;
+            }
             
-            auto scommand = command.lock();
-            program.BindConstantParameters( scommand->GetConstParameters() );
-            program.BindVaryingParameters( scommand->GetVarParameters() );
-            context.DrawRenderCommand( command , program );
+            program.BindConstantParameters( command->GetConstParameters() );
+            program.BindVaryingParameters( command->GetVarParameters() );
+            context.DrawRenderCommand( *command , program );
+        }
+        
+        // Handles of collected commands are dropped now, before their slot is reused
+        // enough times for their generation to match again.
+        if ( dead )
+        {
+            m_commands.erase( std::remove_if( m_commands.begin() , m_commands.end() , [&pool]( RenderCommandHandle rhs ) {
+                return !pool.IsValid( rhs );
+            }) , m_commands.end() );
         }
     }
     
     ////////////////////////////////////////////////////////////
     DynamicRenderQueue::~DynamicRenderQueue()
     {
+        RenderCommandPool& pool = RenderCommandPool::GetDefault();
         
+        for ( auto handle : m_commands )
+            pool.Release( handle );
     }
     
     ////////////////////////////////////////////////////////////
@@ -113,20 +141,27 @@ namespace atl
     void DynamicRenderQueue::AddRenderCommand( const Weak < RenderCommand >& command )
     {
         assert( !command.expired() && "RenderCommand given expired." );
+        RenderCommandHandle handle = RenderCommandPool::GetDefault().Register( command.lock() );
+        
         Spinlocker lck( m_spinlock );
-        m_commands.push_back( command );
+        m_commands.push_back( handle );
     }
     
     ////////////////////////////////////////////////////////////
     void DynamicRenderQueue::AddRenderCommands( const WeakVector < RenderCommand >& commands )
     {
-        Spinlocker lck( m_spinlock );
+        RenderCommandPool& pool = RenderCommandPool::GetDefault();
+        Vector < RenderCommandHandle > handles ;
+        handles.reserve( commands.size() );
         
         for ( auto const& command : commands )
         {
             assert( !command.expired() && "RenderCommand in vector expired." );
-            m_commands.push_back( command );
+            handles.push_back( pool.Register( command.lock() ) );
         }
+        
+        Spinlocker lck( m_spinlock );
+        m_commands.insert( m_commands.end() , handles.begin() , handles.end() );
     }
     
     ////////////////////////////////////////////////////////////
@@ -134,15 +169,31 @@ namespace atl
     {
         Spinlocker lck( m_spinlock );
         
-        for ( auto const& command : m_commands )
+        const RenderCommandPool& pool = RenderCommandPool::GetDefault();
+        bool dead = false ;
+        
+        for ( auto handle : m_commands )
         {
-            if ( command.expired() )
+            auto command = pool.Resolve( handle );
+            
+            if ( !command )
+            {
+                dead = true ;
                 continue ;
+            }
             
-            auto scommand = command.lock();
-            program.BindConstantParameters( scommand->GetConstParameters() );
-            program.BindVaryingParameters( scommand->GetVarParameters() );
-            context.DrawRenderCommand( command , program );
+            program.BindConstantParameters( command->GetConstParameters() );
+            program.BindVaryingParameters( command->GetVarParameters() );
+            context.DrawRenderCommand( *command , program );
+        }
+        
+        // Handles of collected commands are dropped now, before their slot is reused
+        // enough times for their generation to match again.
+        if ( dead )
+        {
+            m_commands.erase( std::remove_if( m_commands.begin() , m_commands.end() , [&pool]( RenderCommandHandle rhs ) {
+                return !pool.IsValid( rhs );
+            }) , m_commands.end() );
         }
     }
     
@@ -150,9 +201,9 @@ namespace atl
     Shared < RenderQueue > CreateRenderQueue( const Weak < Material >& material , const RenderQueueCache& mode )
     {
         if ( mode == RenderQueueCache::Static )
-            return std::make_shared < StaticRenderQueue >( material );
+            return MakePooled < StaticRenderQueue >( material );
         else if ( mode == RenderQueueCache::Dynamic )
-            return std::make_shared < DynamicRenderQueue >( material );
+            return MakePooled < DynamicRenderQueue >( material );
         
         return Shared < RenderQueue >();
     }
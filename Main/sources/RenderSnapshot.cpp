@@ -0,0 +1,241 @@
+//  ========================================================================  //
+//
+//  File    : ATL/RenderSnapshot.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/RenderSnapshot.hpp>
+#include <ATL/AggregatedGroup.hpp>
+#include <ATL/AggregatedMaterial.hpp>
+#include <ATL/Context.hpp>
+#include <ATL/RenderTarget.hpp>
+#include <ATL/Texture.hpp>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        static const Alias RenderSnapshotTextures[RenderSnapshot::TextureCount] =
+        {
+            Alias::MaterialTextureAmbient , Alias::MaterialTextureDiffuse , Alias::MaterialTextureSpecular ,
+            Alias::MaterialTexture1 , Alias::MaterialTexture2 , Alias::MaterialTexture3 , Alias::MaterialTexture4
+        };
+
+        ////////////////////////////////////////////////////////////
+        static const Alias RenderSnapshotComponents[RenderSnapshot::ComponentCount] =
+        {
+            Alias::MaterialComponent1 , Alias::MaterialComponent2 , Alias::MaterialComponent3 ,
+            Alias::MaterialComponent4 , Alias::MaterialComponent5
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns false if a bounding sphere, in model space,
+        /// is outside of the view volume of the given MVP.
+        ///
+        /// Planes of the clip volume are extracted from the MVP rows, so
+        /// they are in model space too. A sphere with a negative radius
+        /// is always visible.
+        ///
+        ////////////////////////////////////////////////////////////
+        static bool RenderSnapshotIsVisible( const glm::mat4& mvp , const glm::vec4& sphere )
+        {
+            if ( sphere.w < 0.0f )
+                return true ;
+
+            glm::mat4 rows = glm::transpose( mvp );
+            glm::vec4 center( glm::vec3( sphere ) , 1.0f );
+
+            const glm::vec4 planes[6] =
+            {
+                rows[3] + rows[0] , rows[3] - rows[0] ,
+                rows[3] + rows[1] , rows[3] - rows[1] ,
+                rows[3] + rows[2] , rows[3] - rows[2]
+            };
+
+            for ( auto const& plane : planes )
+            {
+                if ( glm::dot( plane , center ) < - sphere.w * glm::length( glm::vec3( plane ) ) )
+                    return false ;
+            }
+
+            return true ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    RenderSnapshot::RenderSnapshot() : m_tick( 0 )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    RenderSnapshot::~RenderSnapshot()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    void RenderSnapshot::Extract( const AggregatedGroup& group , uint64_t tick )
+    {
+        Clear();
+        m_tick = tick ;
+
+        auto nodes = group.GetNodes();
+        m_draws.reserve( nodes.size() );
+
+        Map < const Program* , uint32_t > programs ;
+
+        for ( auto const& node : nodes )
+        {
+            assert( node && "'AggregatedGroup::GetNodes()' returned a null node." );
+
+            auto command  = node->GetRenderCommand();
+            auto material = node->GetMaterial();
+
+            if ( !command || !material )
+                continue ;
+
+            auto program   = command->GetProgram().lock();
+            auto vcommands = command->GetVertexCommands();
+            glm::mat4 mvp  = material->GetCustom( Alias::MatrixMVP ).GetMat4();
+
+            vcommands.erase( std::remove_if( vcommands.begin() , vcommands.end() , [&mvp]( const Shared < VertexCommand >& vcommand ) {
+                return !vcommand || !Detail::RenderSnapshotIsVisible( mvp , vcommand->GetBoundingSphere() );
+            }) , vcommands.end() );
+
+            if ( !program || vcommands.empty() )
+                continue ;
+
+            auto it = programs.find( program.get() );
+
+            if ( it == programs.end() )
+            {
+                it = programs.insert( std::make_pair( program.get() , static_cast < uint32_t >( m_programs.size() ) ) ).first ;
+                m_programs.push_back( program );
+            }
+
+            RenderSnapshotDraw draw ;
+            draw.model     = material->GetCustom( Alias::MatrixModel ).GetMat4();
+            draw.mvp       = mvp ;
+            draw.ambient   = material->GetAmbient();
+            draw.diffuse   = material->GetDiffuse();
+            draw.specular  = material->GetSpecular();
+            draw.shininess = material->GetShininess();
+            draw.program   = it->second ;
+            draw.vfirst    = static_cast < uint32_t >( m_vcommands.size() );
+            draw.vcount    = static_cast < uint32_t >( vcommands.size() );
+            draw.tfirst    = static_cast < uint32_t >( m_textures.size() );
+            draw.cfirst    = static_cast < uint32_t >( m_components.size() );
+            draw.material  = material->GetId();
+            draw.command   = command->GetId();
+
+            for ( auto alias : Detail::RenderSnapshotTextures )
+                m_textures.push_back( material->GetTexture( alias ).lock() );
+
+            for ( auto alias : Detail::RenderSnapshotComponents )
+                m_components.push_back( material->GetCustom( alias ) );
+
+            m_vcommands.insert( m_vcommands.end() , vcommands.begin() , vcommands.end() );
+            m_draws.push_back( draw );
+        }
+
+        std::sort( m_draws.begin() , m_draws.end() , []( const RenderSnapshotDraw& lhs , const RenderSnapshotDraw& rhs ) {
+            return lhs.program != rhs.program ? lhs.program < rhs.program : lhs.material < rhs.material ;
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+    void RenderSnapshot::Clear()
+    {
+        m_draws.clear();
+        m_programs.clear();
+        m_vcommands.clear();
+        m_textures.clear();
+        m_components.clear();
+        m_tick = 0 ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void RenderSnapshot::Draw( const Context& context , const RenderTarget& target ) const
+    {
+        const Program* current = nullptr ;
+
+        for ( auto const& draw : m_draws )
+        {
+            Program& program = *m_programs[draw.program] ;
+
+            // Draws are sorted by program, so each program is prepared once.
+            if ( &program != current )
+            {
+                if ( program.IsOutdated() )
+                    program.Relink();
+
+                program.Prepare( target );
+                current = &program ;
+            }
+
+            program.BindAlias( Alias::MatrixModel , ParameterValue( draw.model ) );
+            program.BindAlias( Alias::MatrixMVP , ParameterValue( draw.mvp ) );
+            program.BindAlias( Alias::MaterialAmbient , ParameterValue( draw.ambient ) );
+            program.BindAlias( Alias::MaterialDiffuse , ParameterValue( draw.diffuse ) );
+            program.BindAlias( Alias::MaterialSpecular , ParameterValue( draw.specular ) );
+            program.BindAlias( Alias::MaterialShininess , ParameterValue( draw.shininess ) );
+
+            for ( uint32_t i = 0 ; i < TextureCount ; ++i )
+                program.BindAlias( Detail::RenderSnapshotTextures[i] , ParameterValue( Weak < Texture >( m_textures[draw.tfirst + i] ) ) );
+
+            for ( uint32_t i = 0 ; i < ComponentCount ; ++i )
+                program.BindAlias( Detail::RenderSnapshotComponents[i] , m_components[draw.cfirst + i] );
+
+            for ( uint32_t i = draw.vfirst ; i < draw.vfirst + draw.vcount ; ++i )
+                context.DrawVertexCommand( m_vcommands[i] , program );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    RenderSnapshotBuffer::RenderSnapshotBuffer() : m_back( 0 ) , m_front( 2 ) , m_middle( 1 )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    RenderSnapshotBuffer::~RenderSnapshotBuffer()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    RenderSnapshot& RenderSnapshotBuffer::GetBack()
+    {
+        return m_snapshots[m_back] ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void RenderSnapshotBuffer::Publish()
+    {
+        // The published snapshot becomes the middle one, and we get back the old
+        // middle one to write the next tick. If it was never acquired, it is simply
+        // overwritten: the render thread only wants the last snapshot.
+        uint8_t previous = m_middle.exchange( m_back | FreshBit , std::memory_order_acq_rel );
+        m_back = previous & ~FreshBit ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const RenderSnapshot& RenderSnapshotBuffer::Acquire()
+    {
+        if ( m_middle.load( std::memory_order_relaxed ) & FreshBit )
+        {
+            uint8_t previous = m_middle.exchange( m_front , std::memory_order_acq_rel );
+            m_front = previous & ~FreshBit ;
+        }
+
+        return m_snapshots[m_front] ;
+    }
+}
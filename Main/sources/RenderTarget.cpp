@@ -10,6 +10,7 @@
 //
 //  ========================================================================  //
 #include <ATL/RenderTarget.hpp>
+#include <ATL/Scene.hpp>
 
 namespace atl
 {
@@ -41,25 +42,44 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void RenderTarget::Draw() const
     {
-        if ( !m_updated.load() )
-            return ;
         if ( m_context.expired() )
             return ;
         
         m_mutex.lock();
         auto tmpgroups  = m_rendergroups ;
+        auto tmpscenes  = m_scenes ;
         auto context    = m_context.lock();
         auto clearcolor = m_clearcolor ;
         auto viewport   = m_viewport ;
         m_mutex.unlock();
         
-        for ( auto group : tmpgroups )
+        if ( m_updated.load() )
         {
+            for ( auto group : tmpgroups )
+            {
+                context->SetActive( true );
+                context->ClearColor( clearcolor );
+                context->BindViewport( viewport );
+                
+                group->Draw( *this );
+                
+                context->SetActive( false );
+            }
+        }
+        
+        // Scenes are only read through their snapshots: the update thread
+        // may be building the next one at the same time.
+        for ( auto const& weakscene : tmpscenes )
+        {
+            auto scene = weakscene.lock();
+            
+            if ( !scene )
+                continue ;
+            
             context->SetActive( true );
-            context->ClearColor( clearcolor );
             context->BindViewport( viewport );
             
-            group->Draw( *this );
+            scene->AcquireSnapshot().Draw( *context , *this );
             
             context->SetActive( false );
         }
@@ -184,6 +204,22 @@ namespace atl
         m_rendergroups.push_back( group );
     }
     
+    ////////////////////////////////////////////////////////////
+    void RenderTarget::AddScene( const Weak < Scene >& scene )
+    {
+        assert( !scene.expired() && "Scene expired." );
+        
+        MutexLocker lck( m_mutex );
+        
+        for ( auto const& existing : m_scenes )
+        {
+            if ( existing.lock() == scene.lock() )
+                return ;
+        }
+        
+        m_scenes.push_back( scene );
+    }
+    
     ////////////////////////////////////////////////////////////
     Viewport RenderTarget::GetViewport() const
     {
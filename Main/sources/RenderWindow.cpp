@@ -13,6 +13,8 @@
 #include <ATL/RenderWindow.hpp>
 #include <ATL/Root.hpp>
 #include <ATL/SurfaceEvent.hpp>
+#include <ATL/PoolAllocator.hpp>
+#include <ATL/LoadingQueue.hpp>
 
 namespace atl
 {
@@ -100,6 +102,9 @@ namespace atl
         Flush();
         ProcessEvents();
         
+        // Loading callbacks run on the render thread, once per frame.
+        LoadingQueue::DispatchAllCompletions();
+        
         if ( !m_slistened.load() )
         {
             using namespace std::placeholders ;
@@ -135,36 +140,46 @@ namespace atl
     {
         assert( m_context && "'m_context' is null." );
         
-        Map < Shared < CBuffer > , Shared < Buffer > > vbuffers ;
+        Map < Shared < CBuffer > , Shared < BufferRange > > vranges ;
         
         for ( const Shared < CBuffer >& cbuffer : vcbuffers )
         {
-            auto vbuffer = m_context->CreateVertexBuffer( cbuffer->GetData() , cbuffer->GetSize() ).lock();
-            assert( vbuffer && "'vbuffer' creation failed." );
-            vbuffers[cbuffer] = vbuffer ;
+            // Reads through a const reference, so a shared or read-only CBuffer
+            // is uploaded without being copied first.
+            const CBuffer& data = *cbuffer ;
+            auto vrange = m_context->AllocateVertexRange( data.GetData() , data.GetSize() );
+            assert( vrange && "'vrange' allocation failed." );
+            vranges[cbuffer] = vrange ;
         }
         
-        if ( vbuffers.empty() )
+        if ( vranges.empty() )
             return nullptr ;
         
-        Shared < VertexCommand > command = std::make_shared < VertexCommand >();
+        Shared < VertexCommand > command = MakePooled < VertexCommand >();
         assert( command && "'command' creation failed." );
         command->SetVertexCount( vcount );
         
+        for ( auto const& it : vranges )
+            command->AddBufferRange( it.second );
+        
         for ( const VertexComponent& component : components )
         {
             VertexComponent cpy = component ;
             auto cbuffer = cpy.GetCBuffer().lock();
             assert( cbuffer && "VertexComponent has invalid CBuffer." );
-            cpy.SetBuffer( vbuffers.at(cbuffer) );
+            const Shared < BufferRange >& vrange = vranges.at(cbuffer);
+            cpy.SetBuffer( vrange->GetBuffer() , vrange->GetOffset() );
             command->AddVertexComponent( cpy );
         }
         
         if ( icbuffer && icount && itype != IndexType::Unknown )
         {
-            Shared < Buffer > ibuffer = m_context->CreateIndexBuffer( icbuffer->GetData() , icbuffer->GetSize() ).lock();
-            assert( ibuffer && "'ibuffer' creation failed." );
-            command->SetIndexBuffer( ibuffer );
+            const CBuffer& data = *icbuffer ;
+            Shared < BufferRange > irange = m_context->AllocateIndexRange( data.GetData() , data.GetSize() );
+            assert( irange && "'irange' allocation failed." );
+            command->AddBufferRange( irange );
+            command->SetIndexBuffer( irange->GetBuffer() );
+            command->SetIndexOffset( irange->GetOffset() );
             command->SetIndexCount( icount );
             command->SetIndexType( itype );
         }
@@ -191,9 +206,12 @@ namespace atl
             auto metaclass = smetaclasser->GetMetaclass( mime );
             if ( !metaclass )
                 continue ;
-            auto shader = std::static_pointer_cast < Shader >( metaclass->Create( false , shadfile , m_context ) );
-            if ( shader )
-                shaders.push_back( shader );
+            auto shader = std::static_pointer_cast < Shader >( metaclass->Create( shadfile , m_context ) );
+            if ( !shader )
+                continue ;
+            
+            Shader::WatchFile( shader );
+            shaders.push_back( shader );
         }
         
         if ( shaders.empty() )
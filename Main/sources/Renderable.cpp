@@ -10,6 +10,7 @@
 //
 //  ========================================================================  //
 #include <ATL/Renderable.hpp>
+#include <ATL/PoolAllocator.hpp>
 
 namespace atl
 {
@@ -28,7 +29,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     Weak < VertexCommand > Renderable::CreateAndAddVertexCommand()
     {
-        auto command = std::make_shared < VertexCommand >();
+        auto command = MakePooled < VertexCommand >();
         AddVertexCommand( command );
         return command ;
     }
@@ -10,6 +10,7 @@
 //
 //  ========================================================================  //
 #include <ATL/Resource.hpp>
+#include <ATL/ResourceCache.hpp>
 
 namespace atl
 {
@@ -17,31 +18,31 @@ namespace atl
     IDGenerator < ResourceId > Resource::s_generator ;
     
     ////////////////////////////////////////////////////////////
-    Resource::Resource( void ) : m_id( s_generator.New() )
+    Resource::Resource( void ) : m_id( s_generator.New() ) , m_outdated( false ) , m_holders( 0 ) , m_spinlock( "Resource" )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
-    Resource::Resource( va_list& args ) : m_id( s_generator.New() )
+    Resource::Resource( const ResourceArgs& args ) : m_id( s_generator.New() ) , m_outdated( false ) , m_holders( 0 ) , m_spinlock( "Resource" )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
-    Resource::Resource( const String& file , va_list& args ) : m_id( s_generator.New() )
+    Resource::Resource( const String& file , const ResourceArgs& args ) : m_id( s_generator.New() ) , m_outdated( false ) , m_holders( 0 ) , m_spinlock( "Resource" )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
-    Resource::Resource( const CBuffer& buf , va_list& args ) : m_id( s_generator.New() )
+    Resource::Resource( const CBuffer& buf , const ResourceArgs& args ) : m_id( s_generator.New() ) , m_outdated( false ) , m_holders( 0 ) , m_spinlock( "Resource" )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
-    Resource::Resource( const String& file , const MimeType& mime ) : m_id( s_generator.New() ) , m_mimetype( mime ) , m_file( file )
+    Resource::Resource( const String& file , const MimeType& mime ) : m_id( s_generator.New() ) , m_mimetype( mime ) , m_file( file ) , m_outdated( false ) , m_holders( 0 ) , m_spinlock( "Resource" )
     {
         
     }
@@ -71,4 +72,95 @@ namespace atl
         Spinlocker lck( m_spinlock );
         return m_file ;
     }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t Resource::GetCPUSize() const
+    {
+        return 0 ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    std::size_t Resource::GetGPUSize() const
+    {
+        return 0 ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Resource::SetOutdated( bool outdated )
+    {
+        m_outdated.store( outdated );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Resource::IsOutdated() const
+    {
+        return m_outdated.load();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Resource::SetReplacement( const Shared < Resource >& replacement )
+    {
+        {
+            Spinlocker lck( m_spinlock );
+            m_replacement = replacement ;
+        }
+        
+        m_outdated.store( true );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Shared < Resource > Resource::GetReplacement() const
+    {
+        Spinlocker lck( m_spinlock );
+        return m_replacement ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Resource::AddHolder()
+    {
+        m_holders.fetch_add( 1 );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Resource::RemoveHolder()
+    {
+        assert( m_holders.load() && "Resource has no holder." );
+        m_holders.fetch_sub( 1 );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    uint32_t Resource::GetHolders() const
+    {
+        return m_holders.load();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Resource::WriteCache( ResourceCacheWriter& writer ) const
+    {
+        return DWriteCache( writer );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Resource::ReadCache( const ResourceCacheReader& reader )
+    {
+        if ( !DReadCache( reader ) )
+            return false ;
+        
+        Spinlocker lck( m_spinlock );
+        m_file     = reader.GetFile();
+        m_mimetype = reader.GetMimeType();
+        return true ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Resource::DWriteCache( ResourceCacheWriter& ) const
+    {
+        return false ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool Resource::DReadCache( const ResourceCacheReader& )
+    {
+        return false ;
+    }
 }
@@ -0,0 +1,283 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ResourceCache.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/ResourceCache.hpp>
+#include <ATL/Resource.hpp>
+#include <ATL/MappedFile.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if ATL_PLATFORM == ATL_PLATFORM_WINDOWS
+#   include <direct.h>
+#else
+#   include <sys/stat.h>
+#   include <sys/types.h>
+#endif
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns 'offset' aligned on 'CBufferAlignment'.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline uint64_t ResourceCacheAlign( uint64_t offset )
+        {
+            return ( offset + CBufferAlignment - 1 ) & ~( static_cast < uint64_t >( CBufferAlignment - 1 ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Creates a directory. Does nothing if it exists.
+        ///
+        ////////////////////////////////////////////////////////////
+        static void ResourceCacheMakeDirectory( const String& directory )
+        {
+#       if ATL_PLATFORM == ATL_PLATFORM_WINDOWS
+            _mkdir( directory.c_str() );
+#       else
+            mkdir( directory.c_str() , 0755 );
+#       endif
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ResourceCacheWriter::Add( uint32_t tag , const CBuffer& buffer )
+    {
+        m_sections.push_back( Pair < uint32_t , CBuffer >( tag , buffer ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ResourceCacheWriter::Add( uint32_t tag , const void* data , std::size_t size )
+    {
+        m_sections.push_back( Pair < uint32_t , CBuffer >( tag , CBuffer( data , size ) ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ResourceCacheWriter::Write( const String& file , ContentHash key ) const
+    {
+        ResourceCacheHeader header ;
+        memset( &header , 0 , sizeof( ResourceCacheHeader ) );
+        memcpy( header.magic , "ATLC" , 4 );
+
+        header.version        = ResourceCacheVersion ;
+        header.key            = key ;
+        header.sectionscount  = static_cast < uint32_t >( m_sections.size() );
+        header.sectionsoffset = sizeof( ResourceCacheHeader );
+
+        Vector < ResourceCacheSection > sections( m_sections.size() );
+        uint64_t offset = Detail::ResourceCacheAlign( header.sectionsoffset + sections.size() * sizeof( ResourceCacheSection ) );
+
+        for ( std::size_t i = 0 ; i < m_sections.size() ; ++i )
+        {
+            memset( &sections[i] , 0 , sizeof( ResourceCacheSection ) );
+            sections[i].tag    = m_sections[i].first ;
+            sections[i].offset = offset ;
+            sections[i].size   = m_sections[i].second.GetSize();
+
+            offset = Detail::ResourceCacheAlign( offset + sections[i].size );
+        }
+
+        // Several threads or processes may write the same key: each one
+        // writes its own file, and the last rename wins.
+        std::ostringstream tmpname ;
+        tmpname << file << ".tmp" << std::this_thread::get_id();
+        String tmp = tmpname.str();
+
+        {
+            std::ofstream ofs( tmp , std::ofstream::binary | std::ofstream::trunc );
+            if ( !ofs ) return false ;
+
+            const char padding[CBufferAlignment] = { 0 };
+            uint64_t   written = sizeof( ResourceCacheHeader ) + sections.size() * sizeof( ResourceCacheSection );
+
+            ofs.write( reinterpret_cast < const char* >( &header ) , sizeof( ResourceCacheHeader ) );
+            ofs.write( reinterpret_cast < const char* >( sections.data() ) , sections.size() * sizeof( ResourceCacheSection ) );
+
+            for ( std::size_t i = 0 ; i < m_sections.size() ; ++i )
+            {
+                ofs.write( padding , sections[i].offset - written );
+                ofs.write( reinterpret_cast < const char* >( m_sections[i].second.GetData() ) , sections[i].size );
+                written = sections[i].offset + sections[i].size ;
+            }
+
+            if ( !ofs )
+            {
+                ofs.close();
+                std::remove( tmp.c_str() );
+                return false ;
+            }
+        }
+
+        if ( std::rename( tmp.c_str() , file.c_str() ) != 0 )
+        {
+            std::remove( tmp.c_str() );
+            return false ;
+        }
+
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ResourceCacheReader::ResourceCacheReader( const String& cachefile , ContentHash key , const String& file , const MimeType& mime )
+    : m_sections( nullptr ) , m_count( 0 ) , m_file( file ) , m_mime( mime )
+    {
+        CBuffer mapping = CBuffer::MapFile( cachefile , MappedFile::Access::WillNeed );
+        uint64_t total = mapping.GetSize();
+
+        if ( total < sizeof( ResourceCacheHeader ) )
+            return ;
+
+        const char* data = reinterpret_cast < const char* >( static_cast < const CBuffer& >( mapping ).GetData() );
+        const ResourceCacheHeader& header = *reinterpret_cast < const ResourceCacheHeader* >( data );
+
+        if ( memcmp( header.magic , "ATLC" , 4 ) != 0 || header.version != ResourceCacheVersion || header.key != key
+          || header.sectionsoffset % 8 || header.sectionsoffset > total
+          || header.sectionscount > ( total - header.sectionsoffset ) / sizeof( ResourceCacheSection ) )
+            return ;
+
+        const ResourceCacheSection* sections = reinterpret_cast < const ResourceCacheSection* >( data + header.sectionsoffset );
+
+        for ( uint32_t i = 0 ; i < header.sectionscount ; ++i )
+        {
+            if ( sections[i].offset > total || sections[i].size > total - sections[i].offset )
+                return ;
+        }
+
+        m_mapping.Set( mapping );
+        m_sections = sections ;
+        m_count    = header.sectionscount ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ResourceCacheReader::IsValid() const
+    {
+        return m_sections != nullptr ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint32_t ResourceCacheReader::GetCount( uint32_t tag ) const
+    {
+        uint32_t count = 0 ;
+
+        for ( uint32_t i = 0 ; i < m_count ; ++i )
+        {
+            if ( m_sections[i].tag == tag )
+                count++ ;
+        }
+
+        return count ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    CBuffer ResourceCacheReader::Find( uint32_t tag , uint32_t index ) const
+    {
+        for ( uint32_t i = 0 ; i < m_count ; ++i )
+        {
+            if ( m_sections[i].tag != tag )
+                continue ;
+
+            if ( index-- == 0 )
+                return m_mapping.View( m_sections[i].offset , m_sections[i].size );
+        }
+
+        return CBuffer();
+    }
+
+    ////////////////////////////////////////////////////////////
+    const String& ResourceCacheReader::GetFile() const
+    {
+        return m_file ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const MimeType& ResourceCacheReader::GetMimeType() const
+    {
+        return m_mime ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    ResourceCache::ResourceCache( const String& directory ) : m_directory( directory ) , m_hits( 0 ) , m_misses( 0 )
+    {
+        Detail::ResourceCacheMakeDirectory( m_directory );
+    }
+
+    ////////////////////////////////////////////////////////////
+    ResourceCache::~ResourceCache()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    ContentHash ResourceCache::GetKey( const String& file , const String& loader , uint32_t version ) const
+    {
+        MappedFile mapping( file , MappedFile::Access::Sequential );
+
+        if ( !mapping.IsValid() )
+            return 0 ;
+
+        ContentHash key = HashString( loader );
+        key = HashBytes( &version , sizeof( uint32_t ) , key );
+        key = HashBytes( mapping.GetData() , mapping.GetSize() , key );
+
+        // 0 means 'no key'.
+        return key ? key : 1 ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    String ResourceCache::GetPath( ContentHash key ) const
+    {
+        char name[32] ;
+        snprintf( name , sizeof( name ) , "%016llx.atlc" , static_cast < unsigned long long >( key ) );
+        return m_directory + "/" + name ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ResourceCache::Store( ContentHash key , const Resource& resource )
+    {
+        ResourceCacheWriter writer ;
+
+        if ( !resource.WriteCache( writer ) )
+            return false ;
+
+        return writer.Write( GetPath( key ) , key );
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ResourceCache::Load( ContentHash key , Resource& resource , const String& file , const MimeType& mime )
+    {
+        ResourceCacheReader reader( GetPath( key ) , key , file , mime );
+
+        if ( !reader.IsValid() || !resource.ReadCache( reader ) )
+        {
+            m_misses.fetch_add( 1 );
+            return false ;
+        }
+
+        m_hits.fetch_add( 1 );
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint64_t ResourceCache::GetHits() const
+    {
+        return m_hits.load();
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint64_t ResourceCache::GetMisses() const
+    {
+        return m_misses.load();
+    }
+}
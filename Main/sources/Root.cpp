@@ -34,6 +34,9 @@ namespace atl
         iMeshManager = std::make_shared < MeshManager >();
         MeshManager::Set( iMeshManager );
         
+        iThreadPool = std::make_shared < ThreadPool >();
+        ThreadPool::Set( iThreadPool );
+        
         iDriver.reset();
         iDontSaveConfigFile = false ;
         iSurfacer.reset();
@@ -49,6 +52,7 @@ namespace atl
             SaveConfigFile();
         }
         
+        ThreadPool::Set( nullptr );
         MeshManager::Set( nullptr );
         MaterialManager::Set( nullptr );
         Metaclasser::Set( nullptr );
@@ -458,4 +462,10 @@ namespace atl
     {
         return iMeshManager ;
     }
+    
+    ////////////////////////////////////////////////////////////
+    Weak < ThreadPool > Root::GetThreadPool() const
+    {
+        return iThreadPool ;
+    }
 }
@@ -12,14 +12,18 @@
 #include <ATL/Scene.hpp>
 #include <ATL/Metaclass.hpp>
 #include <ATL/SceneGraph.hpp>
+#include <ATL/AggregatedGroup.hpp>
 
 #include <ATL/PositionNode.hpp>
 
 namespace atl
 {
     ////////////////////////////////////////////////////////////
-    Scene::Scene( const Shared < SceneGraph >& scenegraph ) : m_scenegraph( scenegraph ) , m_updthread() , m_stopupdthread( true )
+    Scene::Scene( const Shared < SceneGraph >& scenegraph ) : m_scenegraph( scenegraph ) , m_spinlock( "Scene" ) , m_updthread() , m_stopupdthread( true ) , m_tick( 0 )
     {
+        m_group = std::make_shared < AggregatedGroup >();
+        assert( m_group && "'m_group': allocation failure." );
+        
         if ( !m_scenegraph )
         {
             m_scenegraph = std::static_pointer_cast < SceneGraph >( Metaclass < SceneGraph >().Create() );
@@ -188,7 +192,7 @@ namespace atl
     	
     	if ( m_scenegraph )
 		{
-			m_scenegraph->OnSceneUpdate();
+			m_scenegraph->OnSceneUpdate( *m_group );
 		}
 		
 		for ( auto camgraph : m_camgraphs )
@@ -196,5 +200,21 @@ namespace atl
 			assert( camgraph );
 			camgraph->OnSceneUpdate();
 		}
+		
+		PublishSnapshot( *m_group );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void Scene::PublishSnapshot( const AggregatedGroup& group )
+    {
+        RenderSnapshot& snapshot = m_snapshots.GetBack();
+        snapshot.Extract( group , ++m_tick );
+        m_snapshots.Publish();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const RenderSnapshot& Scene::AcquireSnapshot()
+    {
+        return m_snapshots.Acquire();
     }
 }
@@ -0,0 +1,455 @@
+//  ========================================================================  //
+//
+//  File    : ATL/SceneGraph.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/SceneGraph.hpp>
+#include <ATL/AggregatedGroup.hpp>
+#include <ATL/PositionNode.hpp>
+#include <ATL/ProgramNode.hpp>
+#include <ATL/MaterialNode.hpp>
+#include <ATL/MeshNode.hpp>
+#include <ATL/MaterialManager.hpp>
+#include <ATL/MeshManager.hpp>
+#include <ATL/MappedFile.hpp>
+#include <ATL/ErrorCenter.hpp>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns a Shared pointer to the Node's base of a
+        /// derived node, sharing the ownership of the derived node.
+        ///
+        ////////////////////////////////////////////////////////////
+        template < typename Class >
+        Shared < Node > AsNode( const Shared < Class >& node )
+        {
+            return Shared < Node >( node , &( node->Base() ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns true if an array of 'count' elements of
+        /// 'size' bytes at 'offset' fits in 'total' bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline bool BinarySceneFits( uint64_t offset , uint64_t count , uint64_t size , uint64_t total )
+        {
+            return offset <= total && count <= ( total - offset ) / size ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns 'offset' aligned on 16 bytes.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline uint64_t BinarySceneAlign( uint64_t offset )
+        {
+            return ( offset + 15 ) & ~( static_cast < uint64_t >( 15 ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Sends an Error::SceneFile if the file at 'path' was
+        /// modified since the scene 'scene' was saved, i.e. if its content
+        /// doesn't match the reference's hash.
+        ///
+        /// \return False if the content doesn't match.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline bool BinarySceneCheckHash( const BinarySceneRef& ref , const String& path , const String& scene )
+        {
+            if ( !ref.hash )
+                return true ;
+
+            MappedFile content( path , MappedFile::Access::Sequential );
+
+            if ( !content.IsValid() || HashBytes( content.GetData() , content.GetSize() ) == ref.hash )
+                return true ;
+
+            ErrorCenter::CatchError( Error::SceneFile , "'%s' was modified since '%s' was saved." , path.c_str() , scene.c_str() );
+            return false ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    SceneGraph::SceneGraph() : m_root( std::make_shared < PositionNode >( glm::vec3( 0.0f ) ) )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    SceneGraph::~SceneGraph()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    Shared < PositionNode > SceneGraph::CreatePositionNode( const glm::vec3& position ) const
+    {
+        return std::make_shared < PositionNode >( position );
+    }
+
+    ////////////////////////////////////////////////////////////
+    Shared < ProgramNode > SceneGraph::CreateProgramNode( const Weak < Program >& program ) const
+    {
+        return std::make_shared < ProgramNode >( program );
+    }
+
+    ////////////////////////////////////////////////////////////
+    Shared < MaterialNode > SceneGraph::CreateMaterialNode( const Weak < Material >& material ) const
+    {
+        return std::make_shared < MaterialNode >( material );
+    }
+
+    ////////////////////////////////////////////////////////////
+    Shared < MeshNode > SceneGraph::CreateMeshNode( const Weak < Mesh >& mesh ) const
+    {
+        return std::make_shared < MeshNode >( mesh );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SceneGraph::AddPositionNode( const Shared < PositionNode >& posnode )
+    {
+        assert( posnode && "'posnode' is null." );
+        MutexLocker lck( m_mutex );
+        m_root -> AddChild( posnode );
+    }
+
+    ////////////////////////////////////////////////////////////
+    Weak < PositionNode > SceneGraph::GetRootNode() const
+    {
+        MutexLocker lck( m_mutex );
+        return m_root ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SceneGraph::OnSceneUpdate( AggregatedGroup& group )
+    {
+        Shared < PositionNode > root ;
+
+        {
+            MutexLocker lck( m_mutex );
+            root = m_root ;
+        }
+
+        assert( root && "'m_root' is null." );
+
+        // Each position subtree of the root is updated as one task, into its own
+        // slice of the group, and slices are then aggregated in parallel.
+        NodesBySubtype lsnodes ;
+        root->Base().UpdateParallel( lsnodes , group );
+        group.Aggregation();
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool SceneGraph::LoadBinary( const String& file , const BinarySceneResolver& resolver )
+    {
+        MappedFile mapping( file , MappedFile::Access::Sequential );
+
+        if ( !mapping.IsValid() || mapping.GetSize() < sizeof( BinarySceneHeader ) )
+        {
+            ErrorCenter::CatchError( Error::SceneFile , "Can't map binary scene '%s'." , file.c_str() );
+            return false ;
+        }
+
+        const char* data  = mapping.GetData();
+        uint64_t    total = mapping.GetSize();
+
+        const BinarySceneHeader& header = *reinterpret_cast < const BinarySceneHeader* >( data );
+
+        if ( memcmp( header.magic , "ATLS" , 4 ) != 0 || header.version != BinarySceneVersion
+          || !header.nodescount
+          || !Detail::BinarySceneFits( header.nodesoffset , header.nodescount , sizeof( BinarySceneNode ) , total )
+          || !Detail::BinarySceneFits( header.refsoffset , header.refscount , sizeof( BinarySceneRef ) , total )
+          || !Detail::BinarySceneFits( header.stringsoffset , header.stringssize , 1 , total )
+          || header.nodesoffset % 16 || header.refsoffset % 16 )
+        {
+            ErrorCenter::CatchError( Error::SceneFile , "Invalid binary scene header in '%s'." , file.c_str() );
+            return false ;
+        }
+
+        const BinarySceneNode* records = reinterpret_cast < const BinarySceneNode* >( data + header.nodesoffset );
+        const BinarySceneRef*  refs    = reinterpret_cast < const BinarySceneRef* >( data + header.refsoffset );
+        const char*            strings = data + header.stringsoffset ;
+
+        // Resolves references first: they are far less numerous than nodes and
+        // each one may load a resource.
+        Vector < BinarySceneResolved > resolved( header.refscount );
+
+        for ( uint32_t i = 0 ; i < header.refscount ; ++i )
+        {
+            const BinarySceneRef& ref = refs[i] ;
+
+            if ( !Detail::BinarySceneFits( ref.pathoffset , ref.pathlength , 1 , header.stringssize ) )
+            {
+                ErrorCenter::CatchError( Error::SceneFile , "Invalid reference %u in '%s'." , i , file.c_str() );
+                return false ;
+            }
+
+            String path( strings + ref.pathoffset , static_cast < std::size_t >( ref.pathlength ) );
+
+            switch ( ref.subtype )
+            {
+                case Node::Subtype::Program:
+                if ( resolver.program )
+                    resolved[i].program = resolver.program( ref , path );
+                break ;
+
+                case Node::Subtype::Material:
+                if ( resolver.material )
+                    resolved[i].material = resolver.material( ref , path );
+                else if ( !path.empty() && MaterialManager::IsInstanced() )
+                {
+                    Detail::BinarySceneCheckHash( ref , path , file );
+                    resolved[i].material = MaterialManager::Get() -> Create( false , path ).lock();
+                }
+                break ;
+
+                case Node::Subtype::Mesh:
+                if ( resolver.mesh )
+                    resolved[i].mesh = resolver.mesh( ref , path );
+                else if ( !path.empty() && MeshManager::IsInstanced() )
+                {
+                    Detail::BinarySceneCheckHash( ref , path , file );
+                    resolved[i].mesh = MeshManager::Get() -> Create( false , path ).lock();
+                }
+                break ;
+
+                default:
+                break ;
+            }
+        }
+
+        // Creates the nodes. Each node keeps its typed pointer, so a node can be
+        // added to the typed subtree of a parent with the same subtype.
+        Vector < Shared < void > > typed ;
+        SharedVector < Node >      nodes ;
+        Shared < PositionNode >    root ;
+
+        typed.reserve( header.nodescount );
+        nodes.reserve( header.nodescount );
+
+        for ( uint32_t i = 0 ; i < header.nodescount ; ++i )
+        {
+            const BinarySceneNode& record = records[i] ;
+
+            if ( i == 0 ? ( record.parent != BinarySceneNone || record.subtype != Node::Subtype::Position )
+                        : ( record.parent >= i ) )
+            {
+                ErrorCenter::CatchError( Error::SceneFile , "Invalid node %u in '%s'." , i , file.c_str() );
+                return false ;
+            }
+
+            const BinarySceneResolved* ref = record.ref < header.refscount ? &resolved[record.ref] : nullptr ;
+            const BinarySceneNode* parent = i ? &records[record.parent] : nullptr ;
+
+            Shared < void > typednode ;
+            Shared < Node > node ;
+
+            switch ( record.subtype )
+            {
+                case Node::Subtype::Position:
+                {
+                    auto posnode = CreatePositionNode( glm::vec3( record.position[0] , record.position[1] , record.position[2] ) );
+
+                    if ( parent && parent->subtype == Node::Subtype::Position )
+                        std::static_pointer_cast < PositionNode >( typed[record.parent] ) -> AddChild( posnode );
+                    else if ( parent )
+                        nodes[record.parent] -> AddChild( Detail::AsNode( posnode ) );
+
+                    if ( !root ) root = posnode ;
+                    typednode = posnode ;
+                    node = Detail::AsNode( posnode );
+                    break ;
+                }
+
+                case Node::Subtype::Program:
+                {
+                    auto prognode = CreateProgramNode( ref ? ref->program : Shared < Program >() );
+
+                    if ( parent->subtype == Node::Subtype::Program )
+                        std::static_pointer_cast < ProgramNode >( typed[record.parent] ) -> AddChild( prognode );
+                    else
+                        nodes[record.parent] -> AddChild( Detail::AsNode( prognode ) );
+
+                    typednode = prognode ;
+                    node = Detail::AsNode( prognode );
+                    break ;
+                }
+
+                case Node::Subtype::Material:
+                {
+                    auto matnode = CreateMaterialNode( ref ? ref->material : Shared < Material >() );
+
+                    if ( parent->subtype == Node::Subtype::Material )
+                        std::static_pointer_cast < MaterialNode >( typed[record.parent] ) -> AddChild( matnode );
+                    else
+                        nodes[record.parent] -> AddChild( Detail::AsNode( matnode ) );
+
+                    typednode = matnode ;
+                    node = Detail::AsNode( matnode );
+                    break ;
+                }
+
+                case Node::Subtype::Mesh:
+                {
+                    auto meshnode = CreateMeshNode( ref ? ref->mesh : Shared < Mesh >() );
+
+                    if ( parent->subtype == Node::Subtype::Mesh )
+                        std::static_pointer_cast < MeshNode >( typed[record.parent] ) -> AddChild( meshnode );
+                    else
+                        nodes[record.parent] -> AddChild( Detail::AsNode( meshnode ) );
+
+                    typednode = meshnode ;
+                    node = Detail::AsNode( meshnode );
+                    break ;
+                }
+
+                default:
+                {
+                    // Custom subtypes are restored as basic nodes, to keep the tree's shape.
+                    node = std::make_shared < Node >( static_cast < Node::Subtype >( record.subtype ) );
+                    nodes[record.parent] -> AddChild( node );
+                    typednode = node ;
+                    break ;
+                }
+            }
+
+            assert( node && "Node creation failed." );
+            typed.push_back( typednode );
+            nodes.push_back( node );
+        }
+
+        assert( root && "Root node was not created." );
+
+        // Nodes only hold weak pointers to their resources: the graph keeps
+        // them alive as long as it uses those nodes.
+        MutexLocker lck( m_mutex );
+        m_root = root ;
+        m_resolved.swap( resolved );
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool SceneGraph::SaveBinary( const String& file ) const
+    {
+        Shared < PositionNode > root ;
+
+        {
+            MutexLocker lck( m_mutex );
+            root = m_root ;
+        }
+
+        assert( root && "'m_root' is null." );
+
+        Vector < BinarySceneNode >  records ;
+        Vector < BinarySceneRef >   refs ;
+        String                      strings ;
+        Map < const void* , uint32_t > refindexes ;
+
+        // Pre-order traversal: a node is always written after its parent.
+        Vector < Pair < Shared < Node > , uint32_t > > stack ;
+        stack.push_back( Pair < Shared < Node > , uint32_t >( Detail::AsNode( root ) , BinarySceneNone ) );
+
+        while ( !stack.empty() )
+        {
+            auto current = stack.back();
+            stack.pop_back();
+
+            assert( current.first && "Null child was conserved in a node. (Illegal operation)" );
+
+            BinarySceneNode record ;
+            memset( &record , 0 , sizeof( BinarySceneNode ) );
+            BinarySceneReference reference ;
+
+            current.first -> WriteBinaryRecord( record , reference );
+            record.parent = current.second ;
+            record.ref    = BinarySceneNone ;
+
+            if ( reference.object )
+            {
+                auto it = refindexes.find( reference.object );
+
+                if ( it == refindexes.end() )
+                {
+                    BinarySceneRef ref ;
+                    memset( &ref , 0 , sizeof( BinarySceneRef ) );
+
+                    ref.hash       = reference.hash ;
+                    ref.subtype    = record.subtype ;
+                    ref.pathoffset = strings.size();
+                    ref.pathlength = reference.path.size();
+
+                    if ( !ref.hash && !reference.path.empty() )
+                    {
+                        MappedFile content( reference.path , MappedFile::Access::Sequential );
+
+                        if ( content.IsValid() )
+                            ref.hash = HashBytes( content.GetData() , content.GetSize() );
+                    }
+
+                    strings.append( reference.path );
+                    strings.push_back( '\0' );
+
+                    it = refindexes.insert( std::make_pair( reference.object , static_cast < uint32_t >( refs.size() ) ) ).first ;
+                    refs.push_back( ref );
+                }
+
+                record.ref = it->second ;
+            }
+
+            uint32_t index = static_cast < uint32_t >( records.size() );
+            records.push_back( record );
+
+            auto children = current.first -> GetChildren();
+
+            for ( auto it = children.rbegin() ; it != children.rend() ; ++it )
+                stack.push_back( Pair < Shared < Node > , uint32_t >( *it , index ) );
+        }
+
+        BinarySceneHeader header ;
+        memset( &header , 0 , sizeof( BinarySceneHeader ) );
+        memcpy( header.magic , "ATLS" , 4 );
+
+        header.version       = BinarySceneVersion ;
+        header.nodescount    = static_cast < uint32_t >( records.size() );
+        header.refscount     = static_cast < uint32_t >( refs.size() );
+        header.nodesoffset   = Detail::BinarySceneAlign( sizeof( BinarySceneHeader ) );
+        header.refsoffset    = Detail::BinarySceneAlign( header.nodesoffset + records.size() * sizeof( BinarySceneNode ) );
+        header.stringsoffset = Detail::BinarySceneAlign( header.refsoffset + refs.size() * sizeof( BinarySceneRef ) );
+        header.stringssize   = strings.size();
+
+        std::ofstream ofs( file , std::ofstream::binary | std::ofstream::trunc );
+
+        if ( !ofs )
+        {
+            ErrorCenter::CatchError( Error::SceneFile , "Can't open '%s' for writing." , file.c_str() );
+            return false ;
+        }
+
+        const char padding[16] = { 0 };
+
+        ofs.write( reinterpret_cast < const char* >( &header ) , sizeof( BinarySceneHeader ) );
+        ofs.write( padding , header.nodesoffset - sizeof( BinarySceneHeader ) );
+        ofs.write( reinterpret_cast < const char* >( records.data() ) , records.size() * sizeof( BinarySceneNode ) );
+        ofs.write( padding , header.refsoffset - header.nodesoffset - records.size() * sizeof( BinarySceneNode ) );
+        ofs.write( reinterpret_cast < const char* >( refs.data() ) , refs.size() * sizeof( BinarySceneRef ) );
+        ofs.write( padding , header.stringsoffset - header.refsoffset - refs.size() * sizeof( BinarySceneRef ) );
+        ofs.write( strings.data() , strings.size() );
+
+        if ( !ofs )
+        {
+            ErrorCenter::CatchError( Error::SceneFile , "Can't write binary scene '%s'." , file.c_str() );
+            return false ;
+        }
+
+        return true ;
+    }
+}
@@ -10,6 +10,7 @@
 //
 //  ========================================================================  //
 #include <ATL/Shader.hpp>
+#include <ATL/FileWatcher.hpp>
 
 namespace atl
 {
@@ -21,7 +22,7 @@ namespace atl
     }
     
     ////////////////////////////////////////////////////////////
-    Shader::Shader( const String& file , va_list& args )
+    Shader::Shader( const String& file , const ResourceArgs& args )
     {
         
     }
@@ -37,4 +38,26 @@ namespace atl
     {
         return m_stage.load();
     }
+    
+    ////////////////////////////////////////////////////////////
+    void Shader::WatchFile( const Shared < Shader >& shader )
+    {
+        auto watcher = FileWatcher::Get();
+        
+        if ( !watcher || !shader || shader->GetFile().empty() )
+            return ;
+        
+        Weak < Shader > weak = shader ;
+        
+        watcher->Watch( shader->GetFile() , [weak]( const String& )
+        {
+            auto sptr = weak.lock();
+            
+            if ( !sptr )
+                return false ;
+            
+            sptr->SetOutdated();
+            return true ;
+        });
+    }
 }
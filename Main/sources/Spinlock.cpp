@@ -0,0 +1,225 @@
+//  ========================================================================  //
+//
+//  File    : ATL/Spinlock.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/Spinlock.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   define ATL_SPINLOCK_FUTEX 1
+#endif
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        static const uint32_t SpinlockMaxBackoff = 64 ; ///< Maximum pauses between two tries.
+        static const uint32_t SpinlockRounds     = 12 ; ///< Tries before sleeping.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Every counters created by 'Spinlock::EnableStats()',
+        /// one per name.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct SpinlockRegistry
+        {
+            std::mutex                        mutex ;    ///< Access to 'counters'.
+            std::vector < SpinlockCounters* > counters ; ///< Registered counters.
+        };
+
+        ////////////////////////////////////////////////////////////
+        static SpinlockRegistry& GetSpinlockRegistry()
+        {
+            static SpinlockRegistry* registry = new SpinlockRegistry ;
+            return *registry ;
+        }
+
+#       ifdef ATL_SPINLOCK_FUTEX
+
+        ////////////////////////////////////////////////////////////
+        static void SpinlockFutexWait( std::atomic < uint32_t >* state , uint32_t value )
+        {
+            syscall( SYS_futex , reinterpret_cast < uint32_t* >( state ) , FUTEX_WAIT_PRIVATE , value , nullptr , nullptr , 0 );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static void SpinlockFutexWake( std::atomic < uint32_t >* state )
+        {
+            syscall( SYS_futex , reinterpret_cast < uint32_t* >( state ) , FUTEX_WAKE_PRIVATE , 1 , nullptr , nullptr , 0 );
+        }
+
+#       endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Spinlock::EnableStats( const char* name )
+    {
+        if ( m_counters.load( std::memory_order_acquire ) )
+            return ;
+
+        auto& registry = Detail::GetSpinlockRegistry();
+        std::lock_guard < std::mutex > lck( registry.mutex );
+
+        auto it = std::find_if( registry.counters.begin() , registry.counters.end() , [name]( const Detail::SpinlockCounters* counters )
+        {
+            return counters->name == name ;
+        });
+
+        Detail::SpinlockCounters* counters = nullptr ;
+
+        if ( it != registry.counters.end() )
+        {
+            counters = *it ;
+        }
+
+        else
+        {
+            counters = new Detail::SpinlockCounters( name );
+            registry.counters.push_back( counters );
+        }
+
+        // Another thread may enable them at the same time: the first one wins,
+        // both using registered counters.
+        Detail::SpinlockCounters* expected = nullptr ;
+        m_counters.compare_exchange_strong( expected , counters , std::memory_order_release , std::memory_order_relaxed );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Spinlock::LockContended()
+    {
+        typedef std::chrono::steady_clock SteadyClock ;
+
+        SteadyClock::time_point start ;
+        uint64_t spins  = 0 ;
+        uint64_t sleeps = 0 ;
+
+        Detail::SpinlockCounters* counters = m_counters.load( std::memory_order_acquire );
+
+        if ( counters )
+            start = SteadyClock::now();
+
+        bool     acquired = false ;
+        uint32_t backoff  = 1 ;
+
+        for ( uint32_t round = 0 ; round < Detail::SpinlockRounds && !acquired ; ++round )
+        {
+            for ( uint32_t i = 0 ; i < backoff ; ++i )
+                ATL_SPINLOCK_PAUSE();
+
+            spins   = spins + backoff ;
+            backoff = std::min( backoff * 2 , Detail::SpinlockMaxBackoff );
+
+            uint32_t expected = 0 ;
+            acquired = m_state.load( std::memory_order_relaxed ) == 0 &&
+                       m_state.compare_exchange_strong( expected , 1 , std::memory_order_acquire , std::memory_order_relaxed );
+        }
+
+        if ( !acquired )
+        {
+#       ifdef ATL_SPINLOCK_FUTEX
+
+            // Marks the lock as contended so 'unlock()' wakes us. The lock
+            // is then held with state 2, which only costs a spurious wake.
+            while ( m_state.exchange( 2 , std::memory_order_acquire ) != 0 )
+            {
+                Detail::SpinlockFutexWait( &m_state , 2 );
+                sleeps++ ;
+            }
+
+#       else
+
+            uint32_t expected = 0 ;
+
+            while ( m_state.load( std::memory_order_relaxed ) != 0 ||
+                   !m_state.compare_exchange_weak( expected , 1 , std::memory_order_acquire , std::memory_order_relaxed ) )
+            {
+                std::this_thread::yield();
+                expected = 0 ;
+                sleeps++ ;
+            }
+
+#       endif
+        }
+
+        if ( counters )
+        {
+            uint64_t wait = static_cast < uint64_t >( std::chrono::duration_cast < std::chrono::nanoseconds >( SteadyClock::now() - start ).count() );
+            uint64_t max  = counters->maxwait.load( std::memory_order_relaxed );
+
+            while ( wait > max && !counters->maxwait.compare_exchange_weak( max , wait , std::memory_order_relaxed ) );
+
+            counters->contentions.fetch_add( 1 , std::memory_order_relaxed );
+            counters->spins.fetch_add( spins , std::memory_order_relaxed );
+            counters->sleeps.fetch_add( sleeps , std::memory_order_relaxed );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Spinlock::Wake()
+    {
+#   ifdef ATL_SPINLOCK_FUTEX
+        Detail::SpinlockFutexWake( &m_state );
+#   endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::vector < SpinlockStats > GetSpinlocksStats()
+    {
+        std::vector < SpinlockStats > result ;
+
+        {
+            auto& registry = Detail::GetSpinlockRegistry();
+            std::lock_guard < std::mutex > lck( registry.mutex );
+            result.reserve( registry.counters.size() );
+
+            for ( auto counters : registry.counters )
+            {
+                SpinlockStats stats ;
+                stats.name         = counters->name ;
+                stats.acquisitions = counters->acquisitions.load( std::memory_order_relaxed );
+                stats.contentions  = counters->contentions.load( std::memory_order_relaxed );
+                stats.spins        = counters->spins.load( std::memory_order_relaxed );
+                stats.sleeps       = counters->sleeps.load( std::memory_order_relaxed );
+                stats.maxwait      = std::chrono::nanoseconds( counters->maxwait.load( std::memory_order_relaxed ) );
+                result.push_back( stats );
+            }
+        }
+
+        std::sort( result.begin() , result.end() , []( const SpinlockStats& lhs , const SpinlockStats& rhs )
+        {
+            return lhs.contentions > rhs.contentions ;
+        });
+
+        return result ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void PrintSpinlocksStats( std::ostream& stream )
+    {
+        for ( auto const& stats : GetSpinlocksStats() )
+        {
+            stream << stats.name
+                   << ": acquisitions=" << stats.acquisitions
+                   << " contentions="   << stats.contentions
+                   << " spins="         << stats.spins
+                   << " sleeps="        << stats.sleeps
+                   << " maxwait="       << stats.maxwait.count() << "ns"
+                   << std::endl ;
+        }
+    }
+}
@@ -0,0 +1,421 @@
+//  ========================================================================  //
+//
+//  File    : ATL/StaticBatch.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/StaticBatch.hpp>
+#include <ATL/VertexQuantizer.hpp>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the index of the CBuffer used by 'component'
+        /// in 'vbufs', or 'vbufs.size()' if not found.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline std::size_t StaticBatchBufferIndex( const VertexComponent& component , const SharedVector < CBuffer >& vbufs )
+        {
+            auto cbuffer = component.GetCBuffer().lock();
+            return std::find( vbufs.begin() , vbufs.end() , cbuffer ) - vbufs.begin();
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size in bytes of one vertex for given
+        /// component. Tightly packed components are as wide as their type.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline uintptr_t StaticBatchStride( const VertexComponent& component )
+        {
+            return component.GetStride() ? component.GetStride() : VertexComponent::GetSizeFor( component.GetType() );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Reads the index at 'i' in a buffer of given type.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline uint32_t StaticBatchReadIndex( const CBuffer& buffer , IndexType type , uint32_t i )
+        {
+            const char* data = buffer.begin();
+
+            switch ( type )
+            {
+                case IndexType::UI8:  return reinterpret_cast < const uint8_t* >( data )[i] ;
+                case IndexType::I8:   return static_cast < uint32_t >( reinterpret_cast < const int8_t* >( data )[i] );
+                case IndexType::UI16: return reinterpret_cast < const uint16_t* >( data )[i] ;
+                case IndexType::I16:  return static_cast < uint32_t >( reinterpret_cast < const int16_t* >( data )[i] );
+                case IndexType::UI32: return reinterpret_cast < const uint32_t* >( data )[i] ;
+                case IndexType::I32:  return static_cast < uint32_t >( reinterpret_cast < const int32_t* >( data )[i] );
+                default: return 0 ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the size of one index of given type.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline std::size_t StaticBatchIndexSize( IndexType type )
+        {
+            switch ( type )
+            {
+                case IndexType::UI8:  case IndexType::I8:  return 1 ;
+                case IndexType::UI16: case IndexType::I16: return 2 ;
+                case IndexType::UI32: case IndexType::I32: return 4 ;
+                default: return 0 ;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    StaticBatch::StaticBatch() : m_nextid( 1 ) , m_relayout( false )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    StaticBatch::~StaticBatch()
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool StaticBatch::IsCompatible( const Mesh& mesh ) const
+    {
+        auto comps = mesh.GetVertexComponents();
+        auto vbufs = mesh.GetVertexCBuffers();
+
+        if ( comps.empty() || vbufs.empty() )
+            return false ;
+
+        MutexLocker lck( m_bmutex );
+
+        if ( m_layout.empty() )
+        {
+            return std::all_of( comps.begin() , comps.end() , [&vbufs]( const VertexComponent& comp ) {
+                return Detail::StaticBatchBufferIndex( comp , vbufs ) < vbufs.size();
+            });
+        }
+
+        if ( comps.size() != m_layout.size() || vbufs.size() != m_strides.size() )
+            return false ;
+
+        for ( std::size_t i = 0 ; i < comps.size() ; ++i )
+        {
+            const VertexComponent& comp = comps[i] ;
+            const VertexComponent& ref  = m_layout[i] ;
+
+            if ( comp.GetAttribute() != ref.GetAttribute()
+              || comp.GetType()      != ref.GetType()
+              || comp.GetStride()    != ref.GetStride()
+              || comp.GetOffset()    != ref.GetOffset()
+              || Detail::StaticBatchBufferIndex( comp , vbufs ) != m_layoutbuf[i] )
+                return false ;
+        }
+
+        return true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    StaticBatchMemberId StaticBatch::AddMember( const Shared < Mesh >& mesh , const glm::mat4& transform )
+    {
+        assert( mesh && "'mesh' is null." );
+
+        if ( !IsCompatible( *mesh ) )
+            return 0 ;
+
+        MutexLocker lck( m_bmutex );
+
+        if ( m_layout.empty() )
+        {
+            auto vbufs = mesh->GetVertexCBuffers();
+            m_layout   = mesh->GetVertexComponents();
+            m_layoutbuf.clear();
+            m_strides.assign( vbufs.size() , 0 );
+
+            for ( auto const& comp : m_layout )
+            {
+                std::size_t index = Detail::StaticBatchBufferIndex( comp , vbufs );
+                m_layoutbuf.push_back( index );
+                m_strides[index] = std::max( m_strides[index] , Detail::StaticBatchStride( comp ) );
+            }
+        }
+
+        Member member ;
+        member.id        = m_nextid++ ;
+        member.mesh      = mesh ;
+        member.transform = transform ;
+        member.vfirst    = 0 ;
+        member.vcount    = 0 ;
+        member.ifirst    = 0 ;
+        member.icount    = 0 ;
+        member.dirty     = true ;
+
+        m_members.push_back( member );
+        m_relayout = true ;
+        return member.id ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StaticBatch::SetMemberTransform( StaticBatchMemberId id , const glm::mat4& transform )
+    {
+        MutexLocker lck( m_bmutex );
+
+        auto it = std::find_if( m_members.begin() , m_members.end() , [id]( const Member& member ) {
+            return member.id == id ;
+        });
+
+        if ( it != m_members.end() )
+        {
+            it->transform = transform ;
+            it->dirty     = true ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StaticBatch::InvalidateMember( StaticBatchMemberId id )
+    {
+        MutexLocker lck( m_bmutex );
+
+        auto it = std::find_if( m_members.begin() , m_members.end() , [id]( const Member& member ) {
+            return member.id == id ;
+        });
+
+        if ( it == m_members.end() )
+            return ;
+
+        // A member with a different size can't be rewritten in place. Indexes
+        // are counted as in 'MergeAll()'.
+        uint32_t icount = it->mesh->GetIndexCBuffer() ? it->mesh->GetIndexCount() : it->mesh->GetVertexCount();
+
+        if ( it->mesh->GetVertexCount() != it->vcount || icount != it->icount )
+            m_relayout = true ;
+
+        it->dirty = true ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StaticBatch::RemoveMember( StaticBatchMemberId id )
+    {
+        MutexLocker lck( m_bmutex );
+
+        auto it = std::find_if( m_members.begin() , m_members.end() , [id]( const Member& member ) {
+            return member.id == id ;
+        });
+
+        if ( it != m_members.end() )
+        {
+            m_members.erase( it );
+            m_relayout = true ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t StaticBatch::GetMembersCount() const
+    {
+        MutexLocker lck( m_bmutex );
+        return m_members.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool StaticBatch::Rebuild()
+    {
+        MutexLocker lck( m_bmutex );
+
+        if ( m_relayout )
+        {
+            MergeAll();
+            m_relayout = false ;
+            return true ;
+        }
+
+        bool changed = false ;
+
+        for ( auto& member : m_members )
+        {
+            if ( member.dirty )
+            {
+                WriteMember( member );
+                member.dirty = false ;
+                changed = true ;
+            }
+        }
+
+        if ( changed )
+            SetDirty();
+
+        return changed ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StaticBatch::MergeAll()
+    {
+        ResetVertexData();
+        m_merged.clear();
+        m_indexes.reset();
+
+        if ( m_members.empty() )
+        {
+            m_layout.clear();
+            m_layoutbuf.clear();
+            m_strides.clear();
+            return ;
+        }
+
+        // Computes each member's range in the merged buffers.
+        uint32_t vtotal = 0 ;
+        uint32_t itotal = 0 ;
+
+        for ( auto& member : m_members )
+        {
+            auto ibuf = member.mesh->GetIndexCBuffer();
+
+            member.vfirst = vtotal ;
+            member.vcount = member.mesh->GetVertexCount();
+            member.ifirst = itotal ;
+            member.icount = ibuf ? member.mesh->GetIndexCount() : member.vcount ;
+
+            vtotal += member.vcount ;
+            itotal += member.icount ;
+        }
+
+        if ( !vtotal || !itotal )
+            return ;
+
+        for ( auto stride : m_strides )
+        {
+            auto buffer = std::make_shared < CBuffer >();
+            assert( buffer && "Can't allocate CBuffer." );
+
+            std::size_t size = static_cast < std::size_t >( vtotal ) * stride ;
+            *buffer = CBuffer::Allocate( size );
+            memset( buffer->GetMutableData() , 0 , size );
+
+            m_merged.push_back( buffer );
+        }
+
+        m_indexes = std::make_shared < CBuffer >();
+        assert( m_indexes && "Can't allocate CBuffer." );
+
+        *m_indexes = CBuffer::Allocate( itotal * sizeof( uint32_t ) );
+
+        for ( auto& member : m_members )
+        {
+            WriteMember( member );
+            member.dirty = false ;
+        }
+
+        for ( auto const& buffer : m_merged )
+            AddVertexCBuffer( buffer );
+
+        for ( std::size_t i = 0 ; i < m_layout.size() ; ++i )
+        {
+            const VertexComponent& comp = m_layout[i] ;
+            AddVertexComponent( VertexComponent( comp.GetAttribute() , comp.GetType() ,
+                                                 comp.GetStride() , comp.GetOffset() ,
+                                                 Weak < CBuffer >( m_merged[m_layoutbuf[i]] ) ) );
+        }
+
+        SetVertexCount( vtotal );
+        SetIndexCBuffer( m_indexes , itotal , IndexType::UI32 );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StaticBatch::WriteMember( const StaticBatch::Member& member )
+    {
+        // Rebases the member's indexes on its first vertex. A member without
+        // index buffer is drawn in order.
+        if ( !m_indexes )
+            return ;
+
+        auto ibuf  = member.mesh->GetIndexCBuffer();
+        auto itype = member.mesh->GetIndexType();
+        uint32_t* dest = static_cast < uint32_t* >( m_indexes->GetMutableData() ) + member.ifirst ;
+
+        if ( ibuf && ibuf->GetSize() >= member.icount * Detail::StaticBatchIndexSize( itype ) )
+        {
+            for ( uint32_t i = 0 ; i < member.icount ; ++i )
+                dest[i] = member.vfirst + Detail::StaticBatchReadIndex( *ibuf , itype , i );
+        }
+
+        else
+        {
+            for ( uint32_t i = 0 ; i < member.icount ; ++i )
+                dest[i] = member.vfirst + ( member.vcount ? i % member.vcount : 0 );
+        }
+
+        auto vbufs = member.mesh->GetVertexCBuffers();
+
+        if ( vbufs.size() != m_merged.size() )
+            return ;
+
+        // Copies raw vertexes.
+        for ( std::size_t b = 0 ; b < m_merged.size() ; ++b )
+        {
+            assert( vbufs[b] && m_merged[b] );
+
+            const CBuffer& source = *vbufs[b] ;
+            std::size_t size = std::min( static_cast < std::size_t >( member.vcount ) * m_strides[b] , source.GetSize() );
+            memcpy( static_cast < char* >( m_merged[b]->GetMutableData() ) + member.vfirst * m_strides[b] , source.begin() , size );
+        }
+
+        if ( member.transform == glm::mat4( 1.0f ) )
+            return ;
+
+        // Transforms positions as points, and normals, tangents and bitangents as
+        // directions. Other components are left untouched. Compact types are
+        // converted to floats and back.
+        glm::mat3 normalmat = glm::transpose( glm::inverse( glm::mat3( member.transform ) ) );
+        Vector < glm::vec4 > values( member.vcount );
+
+        for ( std::size_t c = 0 ; c < m_layout.size() ; ++c )
+        {
+            const VertexComponent& comp = m_layout[c] ;
+            Attribute attrib = comp.GetAttribute();
+            uint32_t  type   = comp.GetType();
+
+            if ( !VertexComponent::IsFloatFor( type ) || VertexComponent::GetElementCountFor( type ) < 3 )
+                continue ;
+
+            bool position  = attrib == Attribute::Position1 || attrib == Attribute::Position2 ;
+            bool direction = attrib == Attribute::Normal1 || attrib == Attribute::Normal2
+                          || attrib == Attribute::Tangent1 || attrib == Attribute::Tangent2
+                          || attrib == Attribute::Bitangent1 || attrib == Attribute::Bitangent2 ;
+
+            if ( !position && !direction )
+                continue ;
+
+            std::size_t b      = m_layoutbuf[c] ;
+            uintptr_t   stride = m_strides[b] ;
+            char*       base   = static_cast < char* >( m_merged[b]->GetMutableData() ) + member.vfirst * stride + comp.GetOffset();
+
+            VertexQuantizer::Convert( base , stride , type , values.data() , sizeof( glm::vec4 ) , VertexComponent::R32G32B32A32Float , member.vcount );
+
+            for ( glm::vec4& value : values )
+            {
+                if ( position )
+                {
+                    glm::vec4 result = member.transform * glm::vec4( value.x , value.y , value.z , 1.0f );
+                    value.x = result.x ; value.y = result.y ; value.z = result.z ;
+                }
+
+                else
+                {
+                    glm::vec3 result = normalmat * glm::vec3( value );
+                    float length = glm::length( result );
+                    if ( length > 0.0f ) result /= length ;
+                    value.x = result.x ; value.y = result.y ; value.z = result.z ;
+                }
+            }
+
+            VertexQuantizer::Convert( values.data() , sizeof( glm::vec4 ) , VertexComponent::R32G32B32A32Float , base , stride , type , member.vcount );
+        }
+    }
+}
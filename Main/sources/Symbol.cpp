@@ -0,0 +1,225 @@
+//  ========================================================================  //
+//
+//  File    : ATL/Symbol.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/Symbol.hpp>
+#include <ATL/Hash.hpp>
+
+#include <cstring>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        static const uint32_t SymbolChunkBits  = 12 ;                    ///< Bits of an identifier giving its index in a chunk.
+        static const uint32_t SymbolChunkSize  = 1 << SymbolChunkBits ;  ///< Number of strings in a chunk.
+        static const uint32_t SymbolMaxChunks  = 4096 ;                  ///< Maximum number of chunks.
+        static const uint32_t SymbolIndexStart = 1024 ;                  ///< First capacity of the hash index.
+
+        ////////////////////////////////////////////////////////////
+        /// \brief An interned string.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct SymbolEntry
+        {
+            String      string ; ///< The string.
+            ContentHash hash ;   ///< Hash of 'string'.
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Open addressing hash index, from the hash of a string
+        /// to its identifier. A slot is 0 while free.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct SymbolIndex
+        {
+            uint32_t             capacity ; ///< Number of slots (a power of two).
+            Atomic < SymbolId >* slots ;    ///< Identifiers.
+
+            ////////////////////////////////////////////////////////////
+            SymbolIndex( uint32_t cap ) : capacity( cap ) , slots( new Atomic < SymbolId >[cap] )
+            {
+                for ( uint32_t i = 0 ; i < cap ; ++i )
+                    slots[i].store( 0 , std::memory_order_relaxed );
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief The global table of Symbols.
+        ///
+        /// Strings are stored in chunks that never move, so a string can
+        /// be read without lock once its identifier is known. The hash
+        /// index is replaced by a bigger one when half full: the old index
+        /// is kept alive as a reader may still use it.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct SymbolTable
+        {
+            Atomic < SymbolEntry* > chunks[SymbolMaxChunks] ; ///< Chunks of strings, by identifier.
+            Atomic < SymbolIndex* > index ;                   ///< Current hash index.
+            SymbolId                count ;                   ///< Greatest identifier used. Guarded by 'mutex'.
+            Mutex                   mutex ;                   ///< Serializes the interning of new strings.
+
+            ////////////////////////////////////////////////////////////
+            SymbolTable() : index( new SymbolIndex( SymbolIndexStart ) ) , count( 0 )
+            {
+                for ( uint32_t i = 0 ; i < SymbolMaxChunks ; ++i )
+                    chunks[i].store( nullptr , std::memory_order_relaxed );
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        static SymbolTable& GetSymbolTable()
+        {
+            static SymbolTable* table = new SymbolTable ;
+            return *table ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        static const SymbolEntry& SymbolGetEntry( const SymbolTable& table , SymbolId id )
+        {
+            return table.chunks[ id >> SymbolChunkBits ].load( std::memory_order_acquire )[ id & ( SymbolChunkSize - 1 ) ];
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Returns the identifier of given string in 'index', or
+        /// 'Symbol::UnknownId'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static SymbolId SymbolLookup( const SymbolTable& table , const SymbolIndex& index , const char* data , std::size_t size , ContentHash hash )
+        {
+            uint32_t mask = index.capacity - 1 ;
+
+            for ( uint32_t probe = 0 ; probe < index.capacity ; ++probe )
+            {
+                SymbolId id = index.slots[ ( hash + probe ) & mask ].load( std::memory_order_acquire );
+
+                if ( !id )
+                    return Symbol::UnknownId ;
+
+                const SymbolEntry& entry = SymbolGetEntry( table , id );
+
+                if ( entry.hash == hash && entry.string.size() == size && !memcmp( entry.string.data() , data , size ) )
+                    return id ;
+            }
+
+            return Symbol::UnknownId ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        static void SymbolInsert( SymbolIndex& index , SymbolId id , ContentHash hash )
+        {
+            uint32_t mask = index.capacity - 1 ;
+            uint32_t slot = static_cast < uint32_t >( hash ) & mask ;
+
+            while ( index.slots[slot].load( std::memory_order_relaxed ) )
+                slot = ( slot + 1 ) & mask ;
+
+            index.slots[slot].store( id , std::memory_order_release );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static SymbolId SymbolFind( const char* data , std::size_t size )
+        {
+            if ( !size )
+                return Symbol::EmptyId ;
+
+            SymbolTable& table = GetSymbolTable();
+            ContentHash  hash  = HashBytes( data , size );
+            return SymbolLookup( table , *table.index.load( std::memory_order_acquire ) , data , size , hash );
+        }
+
+        ////////////////////////////////////////////////////////////
+        static SymbolId SymbolIntern( const char* data , std::size_t size )
+        {
+            if ( !size )
+                return Symbol::EmptyId ;
+
+            SymbolTable& table = GetSymbolTable();
+            ContentHash  hash  = HashBytes( data , size );
+
+            SymbolId id = SymbolLookup( table , *table.index.load( std::memory_order_acquire ) , data , size , hash );
+            if ( id != Symbol::UnknownId )
+                return id ;
+
+            MutexLocker lck( table.mutex );
+            SymbolIndex* index = table.index.load( std::memory_order_relaxed );
+
+            // Another thread may have interned it meanwhile.
+            id = SymbolLookup( table , *index , data , size , hash );
+            if ( id != Symbol::UnknownId )
+                return id ;
+
+            id = ++table.count ;
+            assert( ( id >> SymbolChunkBits ) < SymbolMaxChunks && "Too many Symbols interned." );
+
+            auto& chunk = table.chunks[ id >> SymbolChunkBits ];
+            if ( !chunk.load( std::memory_order_relaxed ) )
+                chunk.store( new SymbolEntry[SymbolChunkSize] , std::memory_order_release );
+
+            SymbolEntry& entry = chunk.load( std::memory_order_relaxed )[ id & ( SymbolChunkSize - 1 ) ];
+            entry.string.assign( data , size );
+            entry.hash = hash ;
+
+            if ( ( table.count + 1 ) * 2 > index->capacity )
+            {
+                SymbolIndex* bigger = new SymbolIndex( index->capacity * 2 );
+
+                for ( SymbolId other = 1 ; other < id ; ++other )
+                    SymbolInsert( *bigger , other , SymbolGetEntry( table , other ).hash );
+
+                table.index.store( bigger , std::memory_order_release );
+                index = bigger ;
+            }
+
+            SymbolInsert( *index , id , hash );
+            return id ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    const SymbolId Symbol::EmptyId ;
+    const SymbolId Symbol::UnknownId ;
+
+    ////////////////////////////////////////////////////////////
+    Symbol::Symbol( const String& string )
+    : m_id( Detail::SymbolIntern( string.data() , string.size() ) )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    Symbol::Symbol( const char* string )
+    : m_id( string ? Detail::SymbolIntern( string , strlen( string ) ) : EmptyId )
+    {
+
+    }
+
+    ////////////////////////////////////////////////////////////
+    Symbol Symbol::Find( const String& string )
+    {
+        Symbol result ;
+        result.m_id = Detail::SymbolFind( string.data() , string.size() );
+        return result ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const String& Symbol::GetString() const
+    {
+        static const String empty ;
+
+        if ( m_id == EmptyId || m_id == UnknownId )
+            return empty ;
+
+        return Detail::SymbolGetEntry( Detail::GetSymbolTable() , m_id ).string ;
+    }
+}
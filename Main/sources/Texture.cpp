@@ -19,4 +19,10 @@ namespace atl
     {
         
     }
+    
+    ////////////////////////////////////////////////////////////
+    const Weak < Image > Texture::GetImage() const
+    {
+        return iImage ;
+    }
 }
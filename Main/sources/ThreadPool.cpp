@@ -0,0 +1,165 @@
+//  ========================================================================  //
+//
+//  File    : ATL/ThreadPool.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/ThreadPool.hpp>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief State shared by every participant of a 'ParallelFor()'.
+        ///
+        /// Helpers tasks may start after the loop is finished (if every
+        /// worker was busy), so they hold this state by shared pointer and
+        /// simply return when no index is left.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct ParallelForState
+        {
+            std::function < void( std::size_t ) > callable ;
+            std::size_t                           count ;
+            Atomic < std::size_t >                next ;
+            Atomic < std::size_t >                done ;
+            Mutex                                 mutex ;
+            std::condition_variable               cond ;
+
+            ////////////////////////////////////////////////////////////
+            void Run()
+            {
+                std::size_t processed = 0 ;
+                std::size_t index     = next.fetch_add( 1 );
+
+                while ( index < count )
+                {
+                    callable( index );
+                    processed++ ;
+                    index = next.fetch_add( 1 );
+                }
+
+                if ( processed && done.fetch_add( processed ) + processed == count )
+                {
+                    MutexLocker lck( mutex );
+                    cond.notify_all();
+                }
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    ThreadPool::ThreadPool( std::size_t workers ) : m_stop( false )
+    {
+        if ( !workers )
+            workers = std::max( 1u , std::thread::hardware_concurrency() );
+
+        for ( std::size_t i = 0 ; i < workers ; ++i )
+            m_workers.push_back( std::thread( &ThreadPool::WorkerLoop , this ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    ThreadPool::~ThreadPool()
+    {
+        {
+            MutexLocker lck( m_mutex );
+            m_stop.store( true );
+        }
+
+        m_cond.notify_all();
+
+        for ( auto& worker : m_workers )
+        {
+            if ( worker.joinable() )
+                worker.join();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t ThreadPool::GetWorkersCount() const
+    {
+        return m_workers.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool ThreadPool::IsWorkerThread() const
+    {
+        auto id = std::this_thread::get_id();
+
+        return std::find_if( m_workers.begin() , m_workers.end() , [id]( const std::thread& worker ) {
+            return worker.get_id() == id ;
+        }) != m_workers.end();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ThreadPool::ParallelFor( std::size_t count , const std::function < void( std::size_t ) >& callable )
+    {
+        if ( !count )
+            return ;
+
+        if ( count == 1 || m_workers.empty() )
+        {
+            for ( std::size_t i = 0 ; i < count ; ++i )
+                callable( i );
+            return ;
+        }
+
+        auto state = std::make_shared < Detail::ParallelForState >();
+        assert( state && "Can't allocate ParallelForState." );
+
+        state->callable = callable ;
+        state->count    = count ;
+        state->next.store( 0 );
+        state->done.store( 0 );
+
+        std::size_t helpers = std::min( count - 1 , m_workers.size() );
+
+        for ( std::size_t i = 0 ; i < helpers ; ++i )
+            Enqueue( [state]() { state->Run(); } );
+
+        state->Run();
+
+        std::unique_lock < std::mutex > lck( state->mutex );
+        state->cond.wait( lck , [state]() { return state->done.load() == state->count ; } );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ThreadPool::Enqueue( Task task )
+    {
+        {
+            MutexLocker lck( m_mutex );
+            m_tasks.push( std::move( task ) );
+        }
+
+        m_cond.notify_one();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ThreadPool::WorkerLoop()
+    {
+        while ( true )
+        {
+            Task task ;
+
+            {
+                std::unique_lock < std::mutex > lck( m_mutex );
+                m_cond.wait( lck , [this]() { return m_stop.load() || !m_tasks.empty(); } );
+
+                if ( m_tasks.empty() )
+                    return ;
+
+                task = std::move( m_tasks.front() );
+                m_tasks.pop();
+            }
+
+            task();
+        }
+    }
+}
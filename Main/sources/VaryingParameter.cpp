@@ -14,21 +14,21 @@
 namespace atl
 {
     ////////////////////////////////////////////////////////////
-    VaryingParameter::VaryingParameter() : m_alias( Alias::Unknown ) , m_index( -1 )
+    VaryingParameter::VaryingParameter() : m_alias( Alias::Unknown ) , m_name( Symbol() ) , m_index( -1 )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
     VaryingParameter::VaryingParameter( const ParameterValue& value , const String& name , int32_t index )
-    : m_alias( Alias::Unknown ) , m_name( name ) , m_index( index ) , m_value( value )
+    : m_alias( Alias::Unknown ) , m_name( Symbol( name ) ) , m_index( index ) , m_value( value )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
     VaryingParameter::VaryingParameter( const ParameterValue& value , Alias alias )
-    : m_alias( alias ) , m_index( -1 ) , m_value( value )
+    : m_alias( alias ) , m_name( Symbol() ) , m_index( -1 ) , m_value( value )
     {
         
     }
@@ -47,10 +47,15 @@ namespace atl
     }
     
     ////////////////////////////////////////////////////////////
-    String VaryingParameter::GetName() const
+    const String& VaryingParameter::GetName() const
     {
-        Spinlocker lck( m_spinlock );
-        return m_name ;
+        return m_name.load().GetString();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    Symbol VaryingParameter::GetSymbol() const
+    {
+        return m_name.load();
     }
     
     ////////////////////////////////////////////////////////////
@@ -75,8 +80,7 @@ namespace atl
     ////////////////////////////////////////////////////////////
     void VaryingParameter::SetName( const String& name )
     {
-        Spinlocker lck( m_spinlock );
-        m_name = name ;
+        m_name.store( Symbol( name ) );
     }
     
     ////////////////////////////////////////////////////////////
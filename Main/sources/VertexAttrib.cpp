@@ -46,9 +46,14 @@ namespace atl
     }
     
     ////////////////////////////////////////////////////////////
-    String VertexAttrib::GetName() const
+    const String& VertexAttrib::GetName() const
+    {
+        return m_name.GetString();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const Symbol& VertexAttrib::GetSymbol() const
     {
-        Spinlocker lck( m_spinlock );
         return m_name ;
     }
 }
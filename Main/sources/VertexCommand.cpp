@@ -20,9 +20,10 @@ namespace atl
     ////////////////////////////////////////////////////////////
     VertexCommand::VertexCommand()
     : m_id( s_generator.New() )
+    , m_format( nullptr )
     , m_count( 0 ) , m_icount( 0 )
-    , m_itype( IndexType::Unknown )
-    , m_ctxtdata( 0 )
+    , m_itype( IndexType::Unknown ) , m_ioffset( 0 )
+    , m_sphere( 0.0f , 0.0f , 0.0f , -1.0f ) , m_spinlock( "VertexCommand" ) , m_ctxtdata( 0 )
     {
         
     }
@@ -32,10 +33,12 @@ namespace atl
                                   uint32_t icount , const Shared < Buffer >& ibuffer ,
                                   IndexType itype )
     : m_id( s_generator.New() )
-    , m_count( count )
-    , m_icount( icount ) , m_ibuffer( ibuffer )
+    , m_format( nullptr ) , m_count( count )
+    , m_icount( icount ) , m_itype( itype ) , m_ibuffer( ibuffer ) , m_ioffset( 0 )
+    , m_sphere( 0.0f , 0.0f , 0.0f , -1.0f ) , m_spinlock( "VertexCommand" ) , m_ctxtdata( 0 )
     {
         m_comps.push_back( buffer );
+        UpdateFormat();
     }
     
     ////////////////////////////////////////////////////////////
@@ -43,10 +46,11 @@ namespace atl
                                   uint32_t icount , const Shared < Buffer >& ibuffer ,
                                   IndexType itype )
     : m_id( s_generator.New() )
-    , m_comps( buffers ) , m_count( count )
-    , m_icount( icount ) , m_ibuffer( ibuffer )
+    , m_comps( buffers ) , m_format( nullptr ) , m_count( count )
+    , m_icount( icount ) , m_itype( itype ) , m_ibuffer( ibuffer ) , m_ioffset( 0 )
+    , m_sphere( 0.0f , 0.0f , 0.0f , -1.0f ) , m_spinlock( "VertexCommand" ) , m_ctxtdata( 0 )
     {
-        
+        UpdateFormat();
     }
     
     ////////////////////////////////////////////////////////////
@@ -85,6 +89,7 @@ namespace atl
     {
         Spinlocker lck( m_spinlock );
         m_comps = buffers ;
+        UpdateFormat();
     }
     
     ////////////////////////////////////////////////////////////
@@ -92,6 +97,36 @@ namespace atl
     {
         Spinlocker lck( m_spinlock );
         m_comps.push_back( component );
+        UpdateFormat();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    const VertexFormat* VertexCommand::GetVertexFormat() const
+    {
+        return m_format.load( std::memory_order_acquire );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    uint32_t VertexCommand::GetVertexBuffers( Buffer** buffers , uint32_t max ) const
+    {
+        return GetVertexBuffers( buffers , nullptr , max );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    uint32_t VertexCommand::GetVertexBuffers( Buffer** buffers , std::size_t* offsets , uint32_t max ) const
+    {
+        Spinlocker lck( m_spinlock );
+        uint32_t count = std::min( static_cast < uint32_t >( m_buffers.size() ) , max );
+        
+        for ( uint32_t i = 0 ; i < count ; ++i )
+        {
+            buffers[i] = m_buffers[i].get();
+            
+            if ( offsets )
+                offsets[i] = m_offsets[i] ;
+        }
+        
+        return count ;
     }
     
     ////////////////////////////////////////////////////////////
@@ -130,9 +165,85 @@ namespace atl
         m_itype.store( type );
     }
     
+    ////////////////////////////////////////////////////////////
+    std::size_t VertexCommand::GetIndexOffset() const
+    {
+        return m_ioffset.load();
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void VertexCommand::SetIndexOffset( std::size_t offset )
+    {
+        m_ioffset.store( offset );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void VertexCommand::AddBufferRange( const Shared < BufferRange >& range )
+    {
+        assert( range && "'range' is null." );
+        Spinlocker lck( m_spinlock );
+        m_ranges.push_back( range );
+    }
+    
+    ////////////////////////////////////////////////////////////
+    SharedVector < BufferRange > VertexCommand::GetBufferRanges() const
+    {
+        Spinlocker lck( m_spinlock );
+        return m_ranges ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    glm::vec4 VertexCommand::GetBoundingSphere() const
+    {
+        Spinlocker lck( m_spinlock );
+        return m_sphere ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void VertexCommand::SetBoundingSphere( const glm::vec4& sphere )
+    {
+        Spinlocker lck( m_spinlock );
+        m_sphere = sphere ;
+    }
+    
     ////////////////////////////////////////////////////////////
     void VertexCommand::AcceptVisitor( VertexCommandVisitor& visitor ) const
     {
         visitor.Visit( *this );
     }
+    
+    ////////////////////////////////////////////////////////////
+    void VertexCommand::UpdateFormat()
+    {
+        Vector < uint32_t > slots ;
+        slots.reserve( m_comps.size() );
+        m_buffers.clear();
+        m_offsets.clear();
+        
+        // Components sharing a buffer's range (interleaved vertexes) share
+        // its slot. Ranges of a shared buffer get one slot each.
+        for ( auto const& component : m_comps )
+        {
+            auto        buffer = component.GetBuffer().lock();
+            std::size_t offset = static_cast < std::size_t >( component.GetBufferOffset() );
+            uint32_t    slot   = 0 ;
+            
+            while ( slot < m_buffers.size() && ( m_buffers[slot] != buffer || m_offsets[slot] != offset ) )
+                slot++ ;
+            
+            if ( slot == m_buffers.size() || !buffer )
+            {
+                slots.push_back( static_cast < uint32_t >( m_buffers.size() ) );
+                m_buffers.push_back( buffer );
+                m_offsets.push_back( offset );
+            }
+            
+            else
+            {
+                slots.push_back( slot );
+            }
+        }
+        
+        m_format.store( m_comps.empty() ? nullptr : VertexFormat::Intern( m_comps , slots ) , std::memory_order_release );
+    }
 }
@@ -27,6 +27,9 @@ namespace atl
             case R32G32Float: return 2 ;
             case R32G32Uint:  return 2 ;
             case R32G32Sint:  return 2 ;
+            case R16G16Float: return 2 ;
+            case R16G16Unorm: return 2 ;
+            case R16G16Snorm: return 2 ;
                 
             case R32G32B32Float: return 3 ;
             case R32G32B32Uint:  return 3 ;
@@ -35,18 +38,77 @@ namespace atl
             case R32G32B32A32Float: return 4 ;
             case R32G32B32A32Uint:  return 4 ;
             case R32G32B32A32Sint:  return 4 ;
+            case R16G16B16A16Float: return 4 ;
+            case R16G16B16A16Snorm: return 4 ;
+            case R8G8B8A8Unorm:     return 4 ;
+            case R10G10B10A2Unorm:  return 4 ;
+            case R10G10B10A2Snorm:  return 4 ;
                 
             default: return 0 ;
         }
     }
     
+    ////////////////////////////////////////////////////////////
+    size_t VertexComponent::GetSizeFor( uint32_t type )
+    {
+        switch( type )
+        {
+            case R8G8B8A8Unorm:    return 4 ;
+            case R10G10B10A2Unorm: return 4 ;
+            case R10G10B10A2Snorm: return 4 ;
+                
+            case R16G16Float:       return 4 ;
+            case R16G16Unorm:       return 4 ;
+            case R16G16Snorm:       return 4 ;
+            case R16G16B16A16Float: return 8 ;
+            case R16G16B16A16Snorm: return 8 ;
+                
+            // Other types have 32 bits elements.
+            default: return GetElementCountFor( type ) * 4 ;
+        }
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool VertexComponent::IsNormalizedFor( uint32_t type )
+    {
+        switch( type )
+        {
+            case R8G8B8A8Unorm:
+            case R16G16Unorm:
+            case R16G16Snorm:
+            case R16G16B16A16Snorm:
+            case R10G10B10A2Unorm:
+            case R10G10B10A2Snorm:
+                return true ;
+                
+            default: return false ;
+        }
+    }
+    
+    ////////////////////////////////////////////////////////////
+    bool VertexComponent::IsFloatFor( uint32_t type )
+    {
+        switch( type )
+        {
+            case R32Float:
+            case R32G32Float:
+            case R32G32B32Float:
+            case R32G32B32A32Float:
+            case R16G16Float:
+            case R16G16B16A16Float:
+                return true ;
+                
+            default: return IsNormalizedFor( type );
+        }
+    }
+    
     ////////////////////////////////////////////////////////////
     VertexComponent::VertexComponent( Attribute attrib , uint32_t type ,
                                       uintptr_t stride , uintptr_t offset ,
                                       const Shared < Buffer >& buffer )
     : m_attrib( attrib ) , m_type( type )
     , m_elcount( GetElementCountFor(type) ) , m_stride( stride ) , m_offset( offset )
-    , m_buffer( buffer )
+    , m_buffer( buffer ) , m_boffset( 0 )
     {
         
     }
@@ -57,16 +119,16 @@ namespace atl
                                       const Weak < CBuffer >& cbuffer )
     : m_attrib( attrib ) , m_type( type )
     , m_elcount( GetElementCountFor(type) ) , m_stride( stride ) , m_offset( offset )
-    , m_cbuffer( cbuffer )
+    , m_boffset( 0 ) , m_cbuffer( cbuffer )
     {
         
     }
     
     ////////////////////////////////////////////////////////////
     VertexComponent::VertexComponent( const VertexComponent& rhs )
-    : m_attrib( rhs.m_attrib.load() ) , m_type( rhs.m_type.load() )
-    , m_elcount( rhs.m_elcount.load() ) , m_stride( rhs.m_stride.load() ) , m_offset( rhs.m_offset.load() )
-    , m_buffer( rhs.m_buffer ) , m_cbuffer( rhs.m_cbuffer )
+    : m_attrib( rhs.m_attrib ) , m_type( rhs.m_type )
+    , m_elcount( rhs.m_elcount ) , m_stride( rhs.m_stride ) , m_offset( rhs.m_offset )
+    , m_buffer( rhs.m_buffer ) , m_boffset( rhs.m_boffset ) , m_cbuffer( rhs.m_cbuffer )
     {
         
     }
@@ -74,13 +136,14 @@ namespace atl
     ////////////////////////////////////////////////////////////
     VertexComponent& VertexComponent::operator = ( const VertexComponent& rhs )
     {
-        m_attrib.store( rhs.GetAttribute() );
-        m_type.store( rhs.GetType() );
-        m_elcount.store( rhs.GetElementCount() );
-        m_stride.store( rhs.GetStride() );
-        m_offset.store( rhs.GetOffset() );
-        std::atomic_store( &m_buffer , rhs.m_buffer );
-        m_cbuffer = rhs.GetCBuffer();
+        m_attrib  = rhs.m_attrib ;
+        m_type    = rhs.m_type ;
+        m_elcount = rhs.m_elcount ;
+        m_stride  = rhs.m_stride ;
+        m_offset  = rhs.m_offset ;
+        m_buffer  = rhs.m_buffer ;
+        m_boffset = rhs.m_boffset ;
+        m_cbuffer = rhs.m_cbuffer ;
         return *this ;
     }
     
@@ -93,43 +156,50 @@ namespace atl
     ////////////////////////////////////////////////////////////
     Attribute VertexComponent::GetAttribute() const
     {
-        return m_attrib.load();
+        return m_attrib ;
     }
     
     ////////////////////////////////////////////////////////////
     uint32_t VertexComponent::GetType() const
     {
-        return m_type.load();
+        return m_type ;
     }
     
     ////////////////////////////////////////////////////////////
     size_t VertexComponent::GetElementCount() const
     {
-        return m_elcount.load();
+        return m_elcount ;
     }
     
     ////////////////////////////////////////////////////////////
     uintptr_t VertexComponent::GetStride() const
     {
-        return m_stride.load();
+        return m_stride ;
     }
     
     ////////////////////////////////////////////////////////////
     uintptr_t VertexComponent::GetOffset() const
     {
-        return m_offset.load();
+        return m_offset ;
     }
     
     ////////////////////////////////////////////////////////////
     const Weak < Buffer > VertexComponent::GetBuffer() const
     {
-        return std::atomic_load( &m_buffer );
+        return m_buffer ;
+    }
+    
+    ////////////////////////////////////////////////////////////
+    void VertexComponent::SetBuffer( const Shared < Buffer >& buffer , uintptr_t offset )
+    {
+        m_buffer  = buffer ;
+        m_boffset = offset ;
     }
     
     ////////////////////////////////////////////////////////////
-    void VertexComponent::SetBuffer( const Shared < Buffer >& buffer )
+    uintptr_t VertexComponent::GetBufferOffset() const
     {
-        std::atomic_store( &m_buffer , buffer );
+        return m_boffset ;
     }
     
     ////////////////////////////////////////////////////////////
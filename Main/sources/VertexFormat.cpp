@@ -0,0 +1,115 @@
+//  ========================================================================  //
+//
+//  File    : ATL/VertexFormat.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/VertexFormat.hpp>
+#include <ATL/VertexComponent.hpp>
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Every interned VertexFormats.
+        ///
+        ////////////////////////////////////////////////////////////
+        struct VertexFormatTable
+        {
+            Map < ContentHash , Vector < const VertexFormat* > > byhash ; ///< Formats by hash.
+            Vector < const VertexFormat* >                       byid ;   ///< Formats by identifier minus one.
+            Mutex                                                mutex ;  ///< Access to the table.
+        };
+
+        ////////////////////////////////////////////////////////////
+        static VertexFormatTable& GetVertexFormatTable()
+        {
+            static VertexFormatTable* table = new VertexFormatTable ;
+            return *table ;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    VertexFormat::VertexFormat( VertexFormatId id , ContentHash hash , const VertexAttribFormat* attribs , std::size_t count )
+    : m_id( id ) , m_hash( hash ) , m_attribs( attribs , attribs + count ) , m_slots( 0 )
+    {
+        for ( auto const& attrib : m_attribs )
+            m_slots = std::max( m_slots , attrib.slot + 1 );
+    }
+
+    ////////////////////////////////////////////////////////////
+    const VertexFormat* VertexFormat::Intern( const VertexAttribFormat* attribs , std::size_t count )
+    {
+        if ( !count || count > MaxSlots )
+            return nullptr ;
+
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            if ( attribs[i].slot >= MaxSlots )
+                return nullptr ;
+        }
+
+        std::size_t bytes = count * sizeof( VertexAttribFormat );
+        ContentHash hash  = HashBytes( attribs , bytes );
+
+        Detail::VertexFormatTable& table = Detail::GetVertexFormatTable();
+        MutexLocker lck( table.mutex );
+
+        auto& candidates = table.byhash[hash] ;
+
+        for ( auto format : candidates )
+        {
+            if ( format->GetAttribsCount() == count && !memcmp( format->GetAttribs() , attribs , bytes ) )
+                return format ;
+        }
+
+        VertexFormatId id = static_cast < VertexFormatId >( table.byid.size() + 1 );
+        const VertexFormat* format = new VertexFormat( id , hash , attribs , count );
+
+        candidates.push_back( format );
+        table.byid.push_back( format );
+        return format ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const VertexFormat* VertexFormat::Intern( const Vector < VertexComponent >& components , const Vector < uint32_t >& slots )
+    {
+        assert( components.size() == slots.size() && "'slots' must have one slot per component." );
+
+        VertexAttribFormat attribs[MaxSlots] ;
+        std::size_t count = std::min( components.size() , static_cast < std::size_t >( MaxSlots ) );
+
+        // Zeroes the array so padding bytes, if any on this platform, don't change the hash.
+        memset( attribs , 0 , sizeof( attribs ) );
+
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            attribs[i].attrib = components[i].GetAttribute();
+            attribs[i].type   = components[i].GetType();
+            attribs[i].stride = static_cast < uint32_t >( components[i].GetStride() );
+            attribs[i].offset = static_cast < uint32_t >( components[i].GetOffset() );
+            attribs[i].slot   = slots[i] ;
+        }
+
+        return Intern( attribs , count );
+    }
+
+    ////////////////////////////////////////////////////////////
+    const VertexFormat* VertexFormat::Get( VertexFormatId id )
+    {
+        Detail::VertexFormatTable& table = Detail::GetVertexFormatTable();
+        MutexLocker lck( table.mutex );
+
+        if ( !id || id > table.byid.size() )
+            return nullptr ;
+
+        return table.byid[id - 1] ;
+    }
+}
@@ -53,10 +53,11 @@ namespace atl
     ////////////////////////////////////////////////////////////
     bool VertexLayout::SetAttribute( Attribute attribute , const String& name , uint32_t type )
     {
+        Symbol symbol = Symbol::Find( name );
         MutexLocker lck( m_mutex );
         
         auto it = std::find_if( m_attribs.begin() , m_attribs.end() ,
-                               [name](const VertexAttrib& attrib) -> bool { return attrib.GetName() == name ; });
+                               [symbol](const VertexAttrib& attrib) -> bool { return attrib.GetSymbol() == symbol ; });
         
         if ( it == m_attribs.end() )
             return false ;
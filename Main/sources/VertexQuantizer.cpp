@@ -0,0 +1,506 @@
+//  ========================================================================  //
+//
+//  File    : ATL/VertexQuantizer.cpp
+//  Project : atlresource
+//  Author  : Luk2010
+//  Date    : 19/10/2026
+//
+//  Copyright :
+//  Copyright © 2017 Atlanti's Corporation. All rights reserved.
+//
+//  ========================================================================  //
+
+#include <ATL/VertexQuantizer.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef ATL_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace atl
+{
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Number of vertexes converted at once by 'VertexQuantizer::Convert()'.
+        ///
+        ////////////////////////////////////////////////////////////
+        static const std::size_t VertexQuantizerChunk = 256 ;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Clamps a value, NaN giving 'lo' as '_mm_max_ps()' does.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline float VertexQuantizerClamp( float value , float lo , float hi )
+        {
+            return value > lo ? ( value < hi ? value : hi ) : lo ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Rounds to the nearest even integer, as '_mm_cvtps_epi32()'
+        /// does with the default rounding mode.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline int32_t VertexQuantizerRound( float value )
+        {
+            return static_cast < int32_t >( std::nearbyint( value ) );
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Packs a vector already scaled and rounded in 10-10-10-2.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline uint32_t VertexQuantizerPack1010102( const int32_t* values )
+        {
+            return ( static_cast < uint32_t >( values[0] ) & 0x3FF )
+                 | ( static_cast < uint32_t >( values[1] ) & 0x3FF ) << 10
+                 | ( static_cast < uint32_t >( values[2] ) & 0x3FF ) << 20
+                 | ( static_cast < uint32_t >( values[3] ) & 0x3 ) << 30 ;
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Clamps, scales and packs 'count' vectors in 10-10-10-2.
+        ///
+        ////////////////////////////////////////////////////////////
+        void VertexQuantizerTo1010102( const float* src , uint32_t* dst , std::size_t count , float lo , const float* scale )
+        {
+            std::size_t i = 0 ;
+
+#ifdef ATL_SIMD_SSE2
+            __m128 vlo    = _mm_set1_ps( lo );
+            __m128 vhi    = _mm_set1_ps( 1.0f );
+            __m128 vscale = _mm_loadu_ps( scale );
+            alignas( 16 ) int32_t values[4] ;
+
+            for ( ; i < count ; ++i )
+            {
+                __m128 v = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i * 4 ) , vlo ) , vhi );
+                _mm_store_si128( reinterpret_cast < __m128i* >( values ) , _mm_cvtps_epi32( _mm_mul_ps( v , vscale ) ) );
+                dst[i] = VertexQuantizerPack1010102( values );
+            }
+#endif
+
+            for ( ; i < count ; ++i )
+            {
+                int32_t values[4] ;
+
+                for ( std::size_t e = 0 ; e < 4 ; ++e )
+                    values[e] = VertexQuantizerRound( VertexQuantizerClamp( src[i * 4 + e] , lo , 1.0f ) * scale[e] );
+
+                dst[i] = VertexQuantizerPack1010102( values );
+            }
+        }
+
+#ifdef ATL_SIMD_SSE2
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Converts 4 floats to half floats, in the low 16 bits
+        /// of each lane, sign extended so '_mm_packs_epi32()' keeps them.
+        ///
+        /// Same steps as 'VertexQuantizer::FloatToHalf()', for each lane.
+        ///
+        ////////////////////////////////////////////////////////////
+        inline __m128i VertexQuantizerToHalf( __m128 value )
+        {
+            const __m128i maxhalf   = _mm_set1_epi32( ( 127 + 16 ) << 23 );
+            const __m128i minnormal = _mm_set1_epi32( ( 127 - 14 ) << 23 );
+            const __m128i magic     = _mm_set1_epi32( ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23 );
+            const __m128i bias      = _mm_set1_epi32( 0xFFF - ( ( 127 - 15 ) << 23 ) );
+
+            __m128  sign    = _mm_and_ps( value , _mm_castsi128_ps( _mm_set1_epi32( static_cast < int >( 0x80000000u ) ) ) );
+            __m128  absf    = _mm_xor_ps( value , sign );
+            __m128i absi    = _mm_castps_si128( absf );
+            __m128  isnan   = _mm_cmpunord_ps( absf , absf );
+            __m128i regular = _mm_cmpgt_epi32( maxhalf , absi );
+            __m128i special = _mm_or_si128( _mm_and_si128( _mm_castps_si128( isnan ) , _mm_set1_epi32( 0x200 ) ) , _mm_set1_epi32( 0x7C00 ) );
+            __m128i subnorm = _mm_cmpgt_epi32( minnormal , absi );
+
+            // Subnormal results: the FPU rounds the mantissa.
+            __m128i subvalue = _mm_sub_epi32( _mm_castps_si128( _mm_add_ps( absf , _mm_castsi128_ps( magic ) ) ) , magic );
+
+            // Normal results: rebias the exponent and round the mantissa.
+            __m128i odd    = _mm_srai_epi32( _mm_slli_epi32( absi , 31 - 13 ) , 31 );
+            __m128i normal = _mm_srli_epi32( _mm_sub_epi32( _mm_add_epi32( absi , bias ) , odd ) , 13 );
+
+            __m128i result = _mm_or_si128( _mm_and_si128( subnorm , subvalue ) , _mm_andnot_si128( subnorm , normal ) );
+            result = _mm_or_si128( _mm_and_si128( regular , result ) , _mm_andnot_si128( regular , special ) );
+
+            return _mm_or_si128( result , _mm_srai_epi32( _mm_castps_si128( sign ) , 16 ) );
+        }
+
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    uint16_t VertexQuantizer::FloatToHalf( float value )
+    {
+        uint32_t bits ;
+        memcpy( &bits , &value , 4 );
+
+        uint32_t sign = bits & 0x80000000u ;
+        uint32_t absi = bits ^ sign ;
+        uint32_t half ;
+
+        // Infinite, NaN (kept quiet) or too large for a half float.
+        if ( absi >= ( 127 + 16 ) << 23 )
+        {
+            half = absi > 0x7F800000u ? 0x7E00 : 0x7C00 ;
+        }
+
+        // Subnormal result: adding a magic value makes the FPU round the mantissa.
+        else if ( absi < ( 127 - 14 ) << 23 )
+        {
+            const uint32_t magicbits = ( ( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23 ;
+            float magic , absf ;
+            memcpy( &magic , &magicbits , 4 );
+            memcpy( &absf , &absi , 4 );
+
+            absf += magic ;
+            memcpy( &half , &absf , 4 );
+            half -= magicbits ;
+        }
+
+        // Normal result: rebias the exponent and round the mantissa to the nearest even.
+        else
+        {
+            uint32_t odd = ( absi >> 13 ) & 1 ;
+            half = ( absi + ( static_cast < uint32_t >( 15 - 127 ) << 23 ) + 0xFFF + odd ) >> 13 ;
+        }
+
+        return static_cast < uint16_t >( half | sign >> 16 );
+    }
+
+    ////////////////////////////////////////////////////////////
+    float VertexQuantizer::HalfToFloat( uint16_t value )
+    {
+        const uint32_t shiftedexp = 0x7C00u << 13 ;
+        const uint32_t magicbits  = 113u << 23 ;
+
+        uint32_t bits = ( value & 0x7FFFu ) << 13 ;
+        uint32_t exp  = bits & shiftedexp ;
+        bits += ( 127 - 15 ) << 23 ;
+
+        if ( exp == shiftedexp )
+        {
+            bits += ( 128 - 16 ) << 23 ;
+        }
+
+        else if ( !exp )
+        {
+            // Subnormal: let the FPU renormalize.
+            float result , magic ;
+            bits += 1 << 23 ;
+            memcpy( &result , &bits , 4 );
+            memcpy( &magic , &magicbits , 4 );
+            result -= magic ;
+            memcpy( &bits , &result , 4 );
+        }
+
+        bits |= static_cast < uint32_t >( value & 0x8000u ) << 16 ;
+
+        float result ;
+        memcpy( &result , &bits , 4 );
+        return result ;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void VertexQuantizer::ToHalf( const float* src , uint16_t* dst , std::size_t count )
+    {
+        std::size_t i = 0 ;
+
+#ifdef ATL_SIMD_SSE2
+        for ( ; i + 8 <= count ; i += 8 )
+        {
+            __m128i lo = Detail::VertexQuantizerToHalf( _mm_loadu_ps( src + i ) );
+            __m128i hi = Detail::VertexQuantizerToHalf( _mm_loadu_ps( src + i + 4 ) );
+            _mm_storeu_si128( reinterpret_cast < __m128i* >( dst + i ) , _mm_packs_epi32( lo , hi ) );
+        }
+#endif
+
+        for ( ; i < count ; ++i )
+            dst[i] = FloatToHalf( src[i] );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void VertexQuantizer::ToUnorm8( const float* src , uint8_t* dst , std::size_t count )
+    {
+        std::size_t i = 0 ;
+
+#ifdef ATL_SIMD_SSE2
+        __m128 zero  = _mm_setzero_ps();
+        __m128 one   = _mm_set1_ps( 1.0f );
+        __m128 scale = _mm_set1_ps( 255.0f );
+
+        for ( ; i + 16 <= count ; i += 16 )
+        {
+            __m128i values[4] ;
+
+            for ( std::size_t j = 0 ; j < 4 ; ++j )
+            {
+                __m128 v = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i + j * 4 ) , zero ) , one );
+                values[j] = _mm_cvtps_epi32( _mm_mul_ps( v , scale ) );
+            }
+
+            __m128i lo = _mm_packs_epi32( values[0] , values[1] );
+            __m128i hi = _mm_packs_epi32( values[2] , values[3] );
+            _mm_storeu_si128( reinterpret_cast < __m128i* >( dst + i ) , _mm_packus_epi16( lo , hi ) );
+        }
+#endif
+
+        for ( ; i < count ; ++i )
+            dst[i] = static_cast < uint8_t >( Detail::VertexQuantizerRound( Detail::VertexQuantizerClamp( src[i] , 0.0f , 1.0f ) * 255.0f ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void VertexQuantizer::ToUnorm16( const float* src , uint16_t* dst , std::size_t count )
+    {
+        std::size_t i = 0 ;
+
+#ifdef ATL_SIMD_SSE2
+        __m128  zero  = _mm_setzero_ps();
+        __m128  one   = _mm_set1_ps( 1.0f );
+        __m128  scale = _mm_set1_ps( 65535.0f );
+        __m128i half  = _mm_set1_epi32( 32768 );
+        __m128i flip  = _mm_set1_epi16( static_cast < short >( 0x8000 ) );
+
+        // SSE2 can only pack to signed 16 bits: values are biased by -32768
+        // to be packed, and the bias is removed by flipping the high bit.
+        for ( ; i + 8 <= count ; i += 8 )
+        {
+            __m128 v0 = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i ) , zero ) , one );
+            __m128 v1 = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i + 4 ) , zero ) , one );
+            __m128i lo = _mm_sub_epi32( _mm_cvtps_epi32( _mm_mul_ps( v0 , scale ) ) , half );
+            __m128i hi = _mm_sub_epi32( _mm_cvtps_epi32( _mm_mul_ps( v1 , scale ) ) , half );
+            _mm_storeu_si128( reinterpret_cast < __m128i* >( dst + i ) , _mm_xor_si128( _mm_packs_epi32( lo , hi ) , flip ) );
+        }
+#endif
+
+        for ( ; i < count ; ++i )
+            dst[i] = static_cast < uint16_t >( Detail::VertexQuantizerRound( Detail::VertexQuantizerClamp( src[i] , 0.0f , 1.0f ) * 65535.0f ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void VertexQuantizer::ToSnorm16( const float* src , int16_t* dst , std::size_t count )
+    {
+        std::size_t i = 0 ;
+
+#ifdef ATL_SIMD_SSE2
+        __m128 lo    = _mm_set1_ps( -1.0f );
+        __m128 hi    = _mm_set1_ps( 1.0f );
+        __m128 scale = _mm_set1_ps( 32767.0f );
+
+        for ( ; i + 8 <= count ; i += 8 )
+        {
+            __m128 v0 = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i ) , lo ) , hi );
+            __m128 v1 = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( src + i + 4 ) , lo ) , hi );
+            __m128i packed = _mm_packs_epi32( _mm_cvtps_epi32( _mm_mul_ps( v0 , scale ) ) , _mm_cvtps_epi32( _mm_mul_ps( v1 , scale ) ) );
+            _mm_storeu_si128( reinterpret_cast < __m128i* >( dst + i ) , packed );
+        }
+#endif
+
+        for ( ; i < count ; ++i )
+            dst[i] = static_cast < int16_t >( Detail::VertexQuantizerRound( Detail::VertexQuantizerClamp( src[i] , -1.0f , 1.0f ) * 32767.0f ) );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void VertexQuantizer::ToUnorm1010102( const float* src , uint32_t* dst , std::size_t count )
+    {
+        static const float scale[4] = { 1023.0f , 1023.0f , 1023.0f , 3.0f };
+        Detail::VertexQuantizerTo1010102( src , dst , count , 0.0f , scale );
+    }
+
+    ////////////////////////////////////////////////////////////
+    void VertexQuantizer::ToSnorm1010102( const float* src , uint32_t* dst , std::size_t count )
+    {
+        static const float scale[4] = { 511.0f , 511.0f , 511.0f , 1.0f };
+        Detail::VertexQuantizerTo1010102( src , dst , count , -1.0f , scale );
+    }
+
+    namespace Detail
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Reads one vertex of a component in 'values'. Missing
+        /// elements are left untouched.
+        ///
+        ////////////////////////////////////////////////////////////
+        void VertexQuantizerDecode( const unsigned char* src , uint32_t type , float* values )
+        {
+            switch( type )
+            {
+                case VertexComponent::R32Float:
+                case VertexComponent::R32G32Float:
+                case VertexComponent::R32G32B32Float:
+                case VertexComponent::R32G32B32A32Float:
+                    memcpy( values , src , VertexComponent::GetSizeFor( type ) );
+                    break ;
+
+                case VertexComponent::R16G16Float:
+                case VertexComponent::R16G16B16A16Float:
+                    for ( std::size_t e = 0 ; e < VertexComponent::GetElementCountFor( type ) ; ++e )
+                    {
+                        uint16_t half ;
+                        memcpy( &half , src + e * 2 , 2 );
+                        values[e] = VertexQuantizer::HalfToFloat( half );
+                    }
+                    break ;
+
+                case VertexComponent::R8G8B8A8Unorm:
+                    for ( std::size_t e = 0 ; e < 4 ; ++e )
+                        values[e] = src[e] / 255.0f ;
+                    break ;
+
+                case VertexComponent::R16G16Unorm:
+                    for ( std::size_t e = 0 ; e < 2 ; ++e )
+                    {
+                        uint16_t value ;
+                        memcpy( &value , src + e * 2 , 2 );
+                        values[e] = value / 65535.0f ;
+                    }
+                    break ;
+
+                case VertexComponent::R16G16Snorm:
+                case VertexComponent::R16G16B16A16Snorm:
+                    for ( std::size_t e = 0 ; e < VertexComponent::GetElementCountFor( type ) ; ++e )
+                    {
+                        int16_t value ;
+                        memcpy( &value , src + e * 2 , 2 );
+                        values[e] = std::max( value / 32767.0f , -1.0f );
+                    }
+                    break ;
+
+                case VertexComponent::R10G10B10A2Unorm:
+                {
+                    uint32_t packed ;
+                    memcpy( &packed , src , 4 );
+
+                    for ( std::size_t e = 0 ; e < 3 ; ++e )
+                        values[e] = ( ( packed >> ( e * 10 ) ) & 0x3FF ) / 1023.0f ;
+
+                    values[3] = ( packed >> 30 ) / 3.0f ;
+                    break ;
+                }
+
+                case VertexComponent::R10G10B10A2Snorm:
+                {
+                    uint32_t packed ;
+                    memcpy( &packed , src , 4 );
+
+                    // Shifts the field to the top bits, then back with sign extension.
+                    for ( std::size_t e = 0 ; e < 3 ; ++e )
+                        values[e] = std::max( ( static_cast < int32_t >( packed << ( 22 - e * 10 ) ) >> 22 ) / 511.0f , -1.0f );
+
+                    values[3] = std::max( static_cast < float >( static_cast < int32_t >( packed ) >> 30 ) , -1.0f );
+                    break ;
+                }
+
+                default:
+                    break ;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Writes 'count' vertexes of a component, whose elements
+        /// are tightly packed in 'values'.
+        ///
+        ////////////////////////////////////////////////////////////
+        void VertexQuantizerEncode( const float* values , std::size_t count , uint32_t type , void* dst )
+        {
+            std::size_t elements = count * VertexComponent::GetElementCountFor( type );
+
+            switch( type )
+            {
+                case VertexComponent::R32Float:
+                case VertexComponent::R32G32Float:
+                case VertexComponent::R32G32B32Float:
+                case VertexComponent::R32G32B32A32Float:
+                    memcpy( dst , values , elements * 4 );
+                    break ;
+
+                case VertexComponent::R16G16Float:
+                case VertexComponent::R16G16B16A16Float:
+                    VertexQuantizer::ToHalf( values , reinterpret_cast < uint16_t* >( dst ) , elements );
+                    break ;
+
+                case VertexComponent::R8G8B8A8Unorm:
+                    VertexQuantizer::ToUnorm8( values , reinterpret_cast < uint8_t* >( dst ) , elements );
+                    break ;
+
+                case VertexComponent::R16G16Unorm:
+                    VertexQuantizer::ToUnorm16( values , reinterpret_cast < uint16_t* >( dst ) , elements );
+                    break ;
+
+                case VertexComponent::R16G16Snorm:
+                case VertexComponent::R16G16B16A16Snorm:
+                    VertexQuantizer::ToSnorm16( values , reinterpret_cast < int16_t* >( dst ) , elements );
+                    break ;
+
+                case VertexComponent::R10G10B10A2Unorm:
+                    VertexQuantizer::ToUnorm1010102( values , reinterpret_cast < uint32_t* >( dst ) , count );
+                    break ;
+
+                case VertexComponent::R10G10B10A2Snorm:
+                    VertexQuantizer::ToSnorm1010102( values , reinterpret_cast < uint32_t* >( dst ) , count );
+                    break ;
+
+                default:
+                    break ;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool VertexQuantizer::Convert( const void* src , std::size_t srcstride , uint32_t srctype ,
+                                   void* dst , std::size_t dststride , uint32_t dsttype ,
+                                   std::size_t count )
+    {
+        if ( !VertexComponent::IsFloatFor( srctype ) || !VertexComponent::IsFloatFor( dsttype ) )
+            return false ;
+
+        std::size_t elements = VertexComponent::GetElementCountFor( dsttype );
+        std::size_t dstsize  = VertexComponent::GetSizeFor( dsttype );
+
+        if ( !srcstride ) srcstride = VertexComponent::GetSizeFor( srctype );
+        if ( !dststride ) dststride = dstsize ;
+
+        const unsigned char* source = reinterpret_cast < const unsigned char* >( src );
+        unsigned char*       dest   = reinterpret_cast < unsigned char* >( dst );
+
+        // Vertexes are read 4 elements each, packed to the destination's
+        // elements count, and converted by chunks so converters see long
+        // streams.
+        float    values[Detail::VertexQuantizerChunk * 4] ;
+        uint32_t bytes[Detail::VertexQuantizerChunk * 4] ;
+
+        for ( std::size_t first = 0 ; first < count ; first += Detail::VertexQuantizerChunk )
+        {
+            std::size_t chunk = std::min( Detail::VertexQuantizerChunk , count - first );
+
+            for ( std::size_t v = 0 ; v < chunk ; ++v )
+            {
+                float* value = values + v * 4 ;
+                value[0] = 0.0f ; value[1] = 0.0f ; value[2] = 0.0f ; value[3] = 1.0f ;
+                Detail::VertexQuantizerDecode( source + ( first + v ) * srcstride , srctype , value );
+            }
+
+            if ( elements != 4 )
+            {
+                for ( std::size_t v = 0 ; v < chunk ; ++v )
+                {
+                    for ( std::size_t e = 0 ; e < elements ; ++e )
+                        values[v * elements + e] = values[v * 4 + e] ;
+                }
+            }
+
+            Detail::VertexQuantizerEncode( values , chunk , dsttype , bytes );
+
+            const unsigned char* encoded = reinterpret_cast < const unsigned char* >( bytes );
+
+            for ( std::size_t v = 0 ; v < chunk ; ++v )
+                memcpy( dest + ( first + v ) * dststride , encoded + v * dstsize , dstsize );
+        }
+
+        return true ;
+    }
+}
@@ -28,10 +28,10 @@ public:
     static MimeType s_mime ;
     
     ////////////////////////////////////////////////////////////
-    Gl3FragmentShader( const String& file , va_list& args );
+    Gl3FragmentShader( const String& file , const ResourceArgs& args );
     
     ////////////////////////////////////////////////////////////
-    Gl3FragmentShader( std::istream& is , va_list& args );
+    Gl3FragmentShader( std::istream& is , const ResourceArgs& args );
 };
 
 #endif /* Gl3FragmentShader_h */
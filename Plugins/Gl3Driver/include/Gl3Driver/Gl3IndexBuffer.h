@@ -39,6 +39,14 @@ public:
     
     ////////////////////////////////////////////////////////////
     virtual void Unbind();
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Writes data with glBufferSubData(), through the
+    /// GL_COPY_WRITE_BUFFER target so the current vertex array is not
+    /// modified.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool Write( std::size_t offset , const void* data , std::size_t size );
 };
 
 #endif /* Gl3IndexBuffer_h */
@@ -86,6 +86,21 @@ protected:
     ////////////////////////////////////////////////////////////
     void BindParameter( const ConstantParameter* parameter , const ParameterValue& value ) const ;
     
+    ////////////////////////////////////////////////////////////
+    /// \brief Links a new OpenGL program with given shaders and
+    /// replaces the current one. The context must be current.
+    ///
+    ////////////////////////////////////////////////////////////
+    bool DRelink( const SharedVector < Shader >& shaders );
+    
+    ////////////////////////////////////////////////////////////
+    /// \brief Creates an OpenGL program and links given shaders.
+    ///
+    /// \throw Gl3Exception if the program can't be linked.
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint GlLink( const SharedVector < Shader >& shaders );
+    
     ////////////////////////////////////////////////////////////
     /// \brief Constructs the attribute's list (Vertex layout) for the
     /// given current program.
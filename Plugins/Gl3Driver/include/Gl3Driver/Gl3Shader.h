@@ -52,7 +52,7 @@ public:
     /// corresponding Gl3Error code.
     ///
     ////////////////////////////////////////////////////////////
-    Gl3Shader( const String& file , const MimeType& mime , Stage stage , GLenum glstage , va_list& args );
+    Gl3Shader( const String& file , const MimeType& mime , Stage stage , GLenum glstage , const ResourceArgs& args );
     
     ////////////////////////////////////////////////////////////
     /// \brief Creates a shader from the input stream given.
@@ -78,7 +78,7 @@ public:
     /// \note On failure, a Gl3Exception object is threw with the
     /// corresponding Gl3Error code.
     ////////////////////////////////////////////////////////////
-    Gl3Shader( std::istream& is , const MimeType& mime , Stage stage , GLenum glstage , va_list& args );
+    Gl3Shader( std::istream& is , const MimeType& mime , Stage stage , GLenum glstage , const ResourceArgs& args );
     
     ////////////////////////////////////////////////////////////
     virtual ~Gl3Shader();
@@ -92,6 +92,7 @@ private:
     /// \brief Internally load the shader from the given source.
     ///
     /// \param source  Source of the future shader to be compiled.
+    /// \param length  Length of the source, in bytes.
     /// \param glstage Given by the derived class, the corresponding
     ///                OpenGL stage it refers to. This stage will be
     ///                used to create the shader.
@@ -102,7 +103,7 @@ private:
     /// corresponding Gl3Error code.
     ///
     ////////////////////////////////////////////////////////////
-    void iGl3Shader( const String& source , GLenum glstage , va_list& args );
+    void iGl3Shader( const char* source , size_t length , GLenum glstage , const ResourceArgs& args );
 };
 
 #endif /* Gl3Shader_h */
@@ -28,10 +28,10 @@ public:
     static MimeType s_mime ;
     
     ////////////////////////////////////////////////////////////
-    Gl3VertexShader( const String& file , va_list& args );
+    Gl3VertexShader( const String& file , const ResourceArgs& args );
     
     ////////////////////////////////////////////////////////////
-    Gl3VertexShader( std::istream& is , va_list& args );
+    Gl3VertexShader( std::istream& is , const ResourceArgs& args );
 };
 
 #endif /* Gl3VertexShader_h */
@@ -52,8 +52,16 @@ void main()
 )glsl" ;
 
 ////////////////////////////////////////////////////////////
-GLenum GlEnumFromVertexComponent( uint32_t type )
+/// \brief Returns the GL type of a VertexComponent type, and if its
+/// integers are normalized when read as floats.
+///
+/// \note Packed 10-10-10-2 types need GL 3.3 (or 'ARB_vertex_type_2_10_10_10_rev').
+///
+////////////////////////////////////////////////////////////
+GLenum GlEnumFromVertexComponent( uint32_t type , GLboolean& normalized )
 {
+    normalized = VertexComponent::IsNormalizedFor( type ) ? GL_TRUE : GL_FALSE ;
+    
     switch ( type )
     {
         case VertexComponent::R32Float:
@@ -74,6 +82,26 @@ GLenum GlEnumFromVertexComponent( uint32_t type )
         case VertexComponent::R32G32B32A32Sint:
             return GL_INT ;
             
+        case VertexComponent::R16G16Float:
+        case VertexComponent::R16G16B16A16Float:
+            return GL_HALF_FLOAT ;
+            
+        case VertexComponent::R8G8B8A8Unorm:
+            return GL_UNSIGNED_BYTE ;
+            
+        case VertexComponent::R16G16Unorm:
+            return GL_UNSIGNED_SHORT ;
+            
+        case VertexComponent::R16G16Snorm:
+        case VertexComponent::R16G16B16A16Snorm:
+            return GL_SHORT ;
+            
+        case VertexComponent::R10G10B10A2Unorm:
+            return GL_UNSIGNED_INT_2_10_10_10_REV ;
+            
+        case VertexComponent::R10G10B10A2Snorm:
+            return GL_INT_2_10_10_10_REV ;
+            
         default:
             return GL_NONE ;
     }
@@ -196,26 +224,35 @@ void Gl3Context::DrawVertexCommand( const Shared < VertexCommand >& command , co
     glBindVertexArray( *VAO );
     assert( glGetError() == GL_NO_ERROR && "'glBindVertexArray()' failed." );
     
-    auto components = command -> GetVertexComponents();
-    auto layout     = program.GetVertexLayout().lock();
-    auto enabled    = Vector < GLuint >();
+    // Reads the interned format and raw buffers: no component is copied
+    // and no reference count is touched while drawing.
+    const VertexFormat* format = command -> GetVertexFormat();
+    std::size_t         count  = format ? format -> GetAttribsCount() : 0 ;
     
-    for ( auto const& component : components )
+    Buffer*     buffers[VertexFormat::MaxSlots] ;
+    std::size_t offsets[VertexFormat::MaxSlots] ;
+    uint32_t    slots   = command -> GetVertexBuffers( buffers , offsets , VertexFormat::MaxSlots );
+    auto     layout  = program.GetVertexLayout().lock();
+    auto     enabled = Vector < GLuint >();
+    
+    for ( std::size_t i = 0 ; i < count ; ++i )
     {
-        auto buffer = component.GetBuffer();
-        if ( buffer.expired() ) continue ;
+        const VertexAttribFormat& attrib = (*format)[i] ;
+        
+        Buffer* buffer = attrib.slot < slots ? buffers[attrib.slot] : nullptr ;
+        if ( !buffer ) continue ;
         
-        auto attribute = layout->GetAttribute( component.GetAttribute() );
+        auto attribute = layout->GetAttribute( attrib.attrib );
         if ( !attribute ) continue ;
         
-        buffer.lock()->Bind();
+        buffer->Bind();
         
         GLuint    index      = static_cast < GLuint >( attribute -> GetSlot() );
-        GLint     size       = static_cast < GLint >( component.GetElementCount() );
-        GLenum    type       = GlEnumFromVertexComponent( component.GetType() );
-        GLboolean normalized = false ;
-        GLsizei   stride     = static_cast < GLsizei >( component.GetStride() );
-        GLvoid*   pointer    = reinterpret_cast < GLvoid* >( component.GetOffset() );
+        GLint     size       = static_cast < GLint >( VertexComponent::GetElementCountFor( attrib.type ) );
+        GLboolean normalized = GL_FALSE ;
+        GLenum    type       = GlEnumFromVertexComponent( attrib.type , normalized );
+        GLsizei   stride     = static_cast < GLsizei >( attrib.stride );
+        GLvoid*   pointer    = reinterpret_cast < GLvoid* >( static_cast < uintptr_t >( offsets[attrib.slot] + attrib.offset ) );
         
         glEnableVertexAttribArray( index );
         enabled.push_back( index );
@@ -223,7 +260,7 @@ void Gl3Context::DrawVertexCommand( const Shared < VertexCommand >& command , co
         glVertexAttribPointer(index, size, type, normalized, stride, pointer);
         assert( glGetError() == GL_NO_ERROR && "'glVertexAttribPointer()' failed." );
         
-        buffer.lock()->Unbind();
+        buffer->Unbind();
     }
     
     if ( command -> GetIndexBuffer().expired() )
@@ -246,7 +283,7 @@ void Gl3Context::DrawVertexCommand( const Shared < VertexCommand >& command , co
         GLenum mode = GL_TRIANGLES ;
         GLsizei count = static_cast < GLsizei >( command -> GetIndexCount() );
         GLenum type = GlEnumFromIndexType( command -> GetIndexType() );
-        GLvoid* offset = (GLvoid*) 0 ;
+        GLvoid* offset = reinterpret_cast < GLvoid* >( static_cast < uintptr_t >( command -> GetIndexOffset() ) );
         
         glDrawElements(mode, count, type, offset);
         assert( glGetError() == GL_NO_ERROR && "'glDrawElements()' failed." );
@@ -15,14 +15,14 @@
 MimeType Gl3FragmentShader::s_mime = MimeType( "Gl3Driver/shader.fragment" , { "glsl" , "frag" , "fragment" } );
 
 ////////////////////////////////////////////////////////////
-Gl3FragmentShader::Gl3FragmentShader( const String& file , va_list& args )
+Gl3FragmentShader::Gl3FragmentShader( const String& file , const ResourceArgs& args )
 : Gl3Shader( file , s_mime , Stage::Fragment , GL_FRAGMENT_SHADER , args )
 {
     
 }
 
 ////////////////////////////////////////////////////////////
-Gl3FragmentShader::Gl3FragmentShader( std::istream& is , va_list& args )
+Gl3FragmentShader::Gl3FragmentShader( std::istream& is , const ResourceArgs& args )
 : Gl3Shader( is , s_mime , Stage::Fragment , GL_FRAGMENT_SHADER , args )
 {
     
@@ -12,7 +12,7 @@
 #include <Gl3Driver/Gl3IndexBuffer.h>
 
 ////////////////////////////////////////////////////////////
-Gl3IndexBuffer::Gl3IndexBuffer( const void* data , const size_t sz )
+Gl3IndexBuffer::Gl3IndexBuffer( const void* data , const size_t sz ) : Buffer( sz )
 {
     GLuint id = 0 ;
     glGenBuffers( 1 , &id );
@@ -45,3 +45,16 @@ void Gl3IndexBuffer::Unbind()
 {
     glBindBuffer( GL_ELEMENT_ARRAY_BUFFER , 0 );
 }
+
+////////////////////////////////////////////////////////////
+bool Gl3IndexBuffer::Write( std::size_t offset , const void* data , std::size_t size )
+{
+    if ( offset > GetSize() || size > GetSize() - offset )
+        return false ;
+    
+    glBindBuffer( GL_COPY_WRITE_BUFFER , m_glid.load() );
+    glBufferSubData( GL_COPY_WRITE_BUFFER , static_cast < GLintptr >( offset ) , static_cast < GLsizeiptr >( size ) , data );
+    glBindBuffer( GL_COPY_WRITE_BUFFER , 0 );
+    
+    return glGetError() == GL_NO_ERROR ;
+}
@@ -73,6 +73,21 @@ Gl3Program::Gl3Program( const SharedVector < Shader >& shaders , const Weak < Gl
 {
     assert( !context.expired() && "'context' has expired." );
     
+    GLuint glid = GlLink( shaders );
+    
+    m_glid.store( glid );
+    
+    glUseProgram( glid );
+    {
+        GlMakeLayout( glid );
+        GlMakeParameters( glid );
+    }
+    glUseProgram( 0 );
+}
+
+////////////////////////////////////////////////////////////
+GLuint Gl3Program::GlLink( const SharedVector < Shader >& shaders )
+{
     GLuint glid = glCreateProgram();
     CatchGlError( "glCreateProgram" );
     
@@ -96,17 +111,11 @@ Gl3Program::Gl3Program( const SharedVector < Shader >& shaders , const Weak < Gl
         GLsizei log_length = 0 ;
         GLchar message [1024];
         glGetProgramInfoLog( glid , 1024 , &log_length , message );
+        glDeleteProgram( glid );
         throw Gl3Exception( Gl3Error::GlLinkProgram , "Linker error: %s" , message );
     }
     
-    m_glid.store( glid );
-    
-    glUseProgram( glid );
-    {
-        GlMakeLayout( glid );
-        GlMakeParameters( glid );
-    }
-    glUseProgram( 0 );
+    return glid ;
 }
 
 ////////////////////////////////////////////////////////////
@@ -134,6 +143,44 @@ void Gl3Program::Prepare( const RenderTarget& target ) const
     glUseProgram( glid );
 }
 
+////////////////////////////////////////////////////////////
+bool Gl3Program::DRelink( const SharedVector < Shader >& shaders )
+{
+    GLuint glid ;
+    
+    try
+    {
+        glid = GlLink( shaders );
+    }
+    
+    catch( Gl3Exception const& e )
+    {
+        ErrorCenter::CatchException( e , Error::ProgramCreate , "Error while relinking Gl3Program." );
+        return false ;
+    }
+    
+    GLuint previous = m_glid.exchange( glid );
+    
+    if ( previous )
+        glDeleteProgram( previous );
+    
+    {
+        Spinlocker lck( m_spinlock );
+        m_texunits.clear();
+    }
+    
+    m_countunit.store( 0 );
+    
+    glUseProgram( glid );
+    {
+        GlMakeLayout( glid );
+        GlMakeParameters( glid );
+    }
+    glUseProgram( 0 );
+    
+    return true ;
+}
+
 ////////////////////////////////////////////////////////////
 void Gl3Program::BindParameter( const ConstantParameter* parameter , const ParameterValue& value ) const
 {
@@ -12,21 +12,21 @@
 #include <Gl3Driver/Gl3Shader.h>
 
 ////////////////////////////////////////////////////////////
-Gl3Shader::Gl3Shader( const String& file , const MimeType& mime , Stage stage , GLenum glstage , va_list& args )
+Gl3Shader::Gl3Shader( const String& file , const MimeType& mime , Stage stage , GLenum glstage , const ResourceArgs& args )
 : Shader( stage , file , mime ) , m_glid( 0 )
 {
-    auto filecontent = atl::LoadFileContent( file );
+    const atl::CBuffer filecontent = atl::CBuffer::MapFile( file );
     
-    if ( filecontent.empty() )
+    if ( filecontent.Empty() )
     {
         throw Gl3Exception( Gl3Error::EmptyFile , "File is empty: %s " , file.data() );
     }
     
-    iGl3Shader( filecontent , glstage , args );
+    iGl3Shader( filecontent.begin() , filecontent.GetSize() , glstage , args );
 }
 
 ////////////////////////////////////////////////////////////
-Gl3Shader::Gl3Shader( std::istream& is , const MimeType& mime , Stage stage , GLenum glstage , va_list& args )
+Gl3Shader::Gl3Shader( std::istream& is , const MimeType& mime , Stage stage , GLenum glstage , const ResourceArgs& args )
 : Shader( stage , "istream" , mime ) , m_glid( 0 )
 {
     is.seekg( 0 , is.end );
@@ -38,16 +38,12 @@ Gl3Shader::Gl3Shader( std::istream& is , const MimeType& mime , Stage stage , GL
         throw Gl3Exception( Gl3Error::EmptyStream , "Stream is empty." );
     }
     
-    char* buffer = new char [size+1];
-    assert( buffer && "Invalid allocation of buffer. (memory not sufficient)" );
-    memset( buffer , 0 , size+1 );
-    is.read( buffer , size );
-    
-    String source( buffer );
-    delete[] buffer ;
+    String source( size , '\0' );
+    is.read( &source[0] , size );
+    source.resize( static_cast < size_t >( is.gcount() ) );
     
     assert( source.size() && "Invalid input stream." );
-    iGl3Shader( source , glstage , args );
+    iGl3Shader( source.data() , source.size() , glstage , args );
 }
 
 ////////////////////////////////////////////////////////////
@@ -68,14 +64,14 @@ GLuint Gl3Shader::GetGlId() const
 }
 
 ////////////////////////////////////////////////////////////
-void Gl3Shader::iGl3Shader( const String& source , GLenum glstage , va_list& args )
+void Gl3Shader::iGl3Shader( const char* source , size_t length , GLenum glstage , const ResourceArgs& args )
 {
     GLuint shaderid = glCreateShader( glstage );
     
     if ( shaderid )
     {
-        GLint size = source.size();
-        const GLchar* data = source.data();
+        GLint size = static_cast < GLint >( length );
+        const GLchar* data = source ;
         
         glShaderSource( shaderid , 1 , &data , &size );
         glCompileShader( shaderid );
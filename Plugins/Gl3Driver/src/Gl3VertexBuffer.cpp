@@ -12,7 +12,7 @@
 #include <Gl3Driver/Gl3VertexBuffer.h>
 
 ////////////////////////////////////////////////////////////
-Gl3VertexBuffer::Gl3VertexBuffer( const void* data , const size_t sz )
+Gl3VertexBuffer::Gl3VertexBuffer( const void* data , const size_t sz ) : Buffer( sz )
 {
     assert( glGetError() == GL_NO_ERROR && "OpenGL error occured before this function." );
     
@@ -51,3 +51,16 @@ void Gl3VertexBuffer::Unbind()
 {
     glBindBuffer( GL_ARRAY_BUFFER , 0 );
 }
+
+////////////////////////////////////////////////////////////
+bool Gl3VertexBuffer::Write( std::size_t offset , const void* data , std::size_t size )
+{
+    if ( offset > GetSize() || size > GetSize() - offset )
+        return false ;
+    
+    glBindBuffer( GL_COPY_WRITE_BUFFER , m_glid.load() );
+    glBufferSubData( GL_COPY_WRITE_BUFFER , static_cast < GLintptr >( offset ) , static_cast < GLsizeiptr >( size ) , data );
+    glBindBuffer( GL_COPY_WRITE_BUFFER , 0 );
+    
+    return glGetError() == GL_NO_ERROR ;
+}
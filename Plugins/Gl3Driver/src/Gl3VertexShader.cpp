@@ -15,14 +15,14 @@
 MimeType Gl3VertexShader::s_mime = MimeType( "Gl3Driver/shader.vertex" , { "glsl" , "vert" , "vertex" } );
 
 ////////////////////////////////////////////////////////////
-Gl3VertexShader::Gl3VertexShader( const String& file , va_list& args )
+Gl3VertexShader::Gl3VertexShader( const String& file , const ResourceArgs& args )
 : Gl3Shader( file , s_mime , Stage::Vertex , GL_VERTEX_SHADER , args )
 {
     
 }
 
 ////////////////////////////////////////////////////////////
-Gl3VertexShader::Gl3VertexShader( std::istream& is , va_list& args )
+Gl3VertexShader::Gl3VertexShader( std::istream& is , const ResourceArgs& args )
 : Gl3Shader( is , s_mime , Stage::Vertex , GL_VERTEX_SHADER , args )
 {
     
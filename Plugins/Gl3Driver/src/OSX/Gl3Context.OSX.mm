@@ -34,6 +34,9 @@ Gl3Context::Gl3Context( const Weak < Surface >& surface , const ContextSettings&
 ////////////////////////////////////////////////////////////
 Gl3Context::~Gl3Context()
 {
+    // Objects only held by the pools are destroyed while our context still exists.
+    ClearHandlePools();
+    
     glDeleteVertexArrays( m_vaos.size() , &(m_vaos.at(0)) );
     
     if ( m_view )